@@ -0,0 +1,176 @@
+// Compares the query time of the XCSR spatial index with the vectorized population scan
+//   Usage: box_index_bench [seed]
+//   The populations imitate trained real multiplexer populations (6, 11, 20 and 37 dimensions):
+//   most classifiers specify half intervals on the address dimensions and the addressed data
+//   dimension, and the other dimensions cover the whole range. The same boxes are indexed in
+//   each representation (CSR/OBR/UBR).
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+namespace
+{
+    // Prevents the compiler from removing the measured calls
+    std::size_t g_sink = 0;
+
+    xcsr::Symbol MakeSymbol(double lower, double upper, XCSRRepr repr, Random & random)
+    {
+        switch (repr)
+        {
+        case XCSRRepr::kCSR:
+            return xcsr::Symbol((lower + upper) / 2, (upper - lower) / 2);
+
+        case XCSRRepr::kOBR:
+            return xcsr::Symbol(lower, upper);
+
+        default:
+            return (random.nextDouble() < 0.5) ? xcsr::Symbol(lower, upper) : xcsr::Symbol(upper, lower);
+        }
+    }
+
+    xcsr::Classifier RealMultiplexerLikeClassifier(std::size_t addressBitLength, std::size_t length, XCSRRepr repr, Random & random)
+    {
+        std::vector<xcsr::Symbol> symbols(length);
+        std::size_t address = 0;
+        bool isAddressSpecified = true;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            const bool isAddressBit = (i < addressBitLength);
+            const int bit = random.nextInt(0, 1);
+            if (random.nextDouble() < (isAddressBit ? 0.1 : 0.97))
+            {
+                symbols[i] = MakeSymbol(0.0, 1.0, repr, random);
+                isAddressSpecified &= !isAddressBit;
+            }
+            else
+            {
+                symbols[i] = MakeSymbol(0.5 * bit, 0.5 * bit + 0.5, repr, random);
+                if (isAddressBit)
+                {
+                    address = address * 2 + bit;
+                }
+            }
+        }
+
+        if (isAddressSpecified)
+        {
+            const int bit = random.nextInt(0, 1);
+            symbols[addressBitLength + address] = MakeSymbol(0.5 * bit, 0.5 * bit + 0.5, repr, random);
+        }
+
+        return xcsr::Classifier(xcsr::Condition(symbols), random.nextInt(0, 1), 500.0, 0.0, 0.1, 0);
+    }
+
+    template <class Function>
+    double MeasureNanosecondsPerQuery(const std::vector<std::vector<double>> & situations, Function func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto & situation : situations)
+        {
+            g_sink += func(situation);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / situations.size();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::uint32_t seed = (argc > 1) ? static_cast<std::uint32_t>(std::stoul(argv[1])) : 1;
+    Random random(seed);
+    const std::unordered_set<int> availableActions = { 0, 1 };
+
+    std::cout << std::setw(6) << "repr"
+              << std::setw(8) << "length"
+              << std::setw(10) << "size"
+              << std::setw(10) << "matches"
+              << std::setw(16) << "scan ns/query"
+              << std::setw(16) << "index ns/query"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "build ms" << std::endl;
+
+    for (const auto repr : { XCSRRepr::kCSR, XCSRRepr::kOBR, XCSRRepr::kUBR })
+    {
+        xcsr::XCSRParams scanParams;
+        scanParams.repr = repr;
+        xcsr::XCSRParams indexParams = scanParams;
+        indexParams.useSpatialIndex = true;
+
+        for (const std::size_t addressBitLength : { 2, 3, 4, 5 })
+        {
+            const std::size_t length = addressBitLength + (std::size_t{ 1 } << addressBitLength);
+
+            std::vector<std::vector<double>> situations(2000, std::vector<double>(length));
+            for (auto & situation : situations)
+            {
+                for (auto & s : situation)
+                {
+                    s = random.nextDouble();
+                }
+            }
+
+            for (std::size_t size = 1000; size <= 64000; size *= 4)
+            {
+                std::vector<xcsr::Classifier> classifiers;
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    classifiers.push_back(RealMultiplexerLikeClassifier(addressBitLength, length, repr, random));
+                }
+                const xcsr::Population scanPopulation(classifiers, &scanParams, availableActions);
+                const xcsr::Population indexPopulation(classifiers, &indexParams, availableActions);
+
+                // Time of a rebuild (paid after the GA has changed enough classifiers)
+                const auto buildStart = std::chrono::steady_clock::now();
+                const xcsr::BoxIndex index(classifiers, repr);
+                const auto buildEnd = std::chrono::steady_clock::now();
+                g_sink += index.nodeCount();
+
+                // Make sure that both return the same number of classifiers
+                std::size_t totalMatchCount = 0;
+                for (const auto & situation : situations)
+                {
+                    std::size_t scanMatchCount = 0;
+                    std::size_t indexMatchCount = 0;
+                    scanPopulation.forEachMatchingClassifier(situation, [&](const auto &) { ++scanMatchCount; });
+                    indexPopulation.forEachMatchingClassifier(situation, [&](const auto &) { ++indexMatchCount; });
+                    if (scanMatchCount != indexMatchCount)
+                    {
+                        std::cerr << "Error: The spatial index returned a different number of classifiers." << std::endl;
+                        return 1;
+                    }
+                    totalMatchCount += scanMatchCount;
+                }
+
+                const double scanNanoseconds = MeasureNanosecondsPerQuery(situations, [&](const std::vector<double> & situation) {
+                    std::size_t matchCount = 0;
+                    scanPopulation.forEachMatchingClassifier(situation, [&](const auto &) { ++matchCount; });
+                    return matchCount;
+                });
+                const double indexNanoseconds = MeasureNanosecondsPerQuery(situations, [&](const std::vector<double> & situation) {
+                    std::size_t matchCount = 0;
+                    indexPopulation.forEachMatchingClassifier(situation, [&](const auto &) { ++matchCount; });
+                    return matchCount;
+                });
+
+                std::cout << std::setw(6) << (repr == XCSRRepr::kCSR ? "CSR" : (repr == XCSRRepr::kOBR ? "OBR" : "UBR"))
+                          << std::setw(8) << length
+                          << std::setw(10) << size
+                          << std::setw(10) << std::fixed << std::setprecision(1) << totalMatchCount / static_cast<double>(situations.size())
+                          << std::setw(16) << std::setprecision(0) << scanNanoseconds
+                          << std::setw(16) << indexNanoseconds
+                          << std::setw(10) << std::setprecision(1) << scanNanoseconds / indexNanoseconds
+                          << std::setw(12) << std::chrono::duration<double, std::milli>(buildEnd - buildStart).count() << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Compares the time to load a dataset CSV with the previous loader (std::getline, std::istringstream
+// and std::stof for each line) and with CSV::ReadDatasetFromFile() (mmap and std::from_chars)
+//   Usage: csv_dataset_bench [row count (default: 1000000)] [situation size (default: 20)]
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio> // std::remove
+#include <cstddef> // std::size_t
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+namespace
+{
+    // Prevents the compiler from removing the measured calls
+    std::size_t g_sink = 0;
+
+    template <class Function>
+    double MeasureMilliseconds(Function func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    // The dataset before BasicDataset stored the situations in one buffer
+    template <typename T>
+    struct PreviousDataset
+    {
+        std::vector<std::vector<T>> situations;
+        std::vector<int> actions;
+    };
+
+    // The loader before CSV::ParseDataset() was introduced
+    template <typename T>
+    PreviousDataset<T> PreviousReadDatasetFromFile(const std::string & filename, bool rounds = false)
+    {
+        std::ifstream ifs(filename);
+        std::vector<std::vector<T>> situations;
+        std::vector<int> actions;
+
+        std::string line;
+        while (std::getline(ifs, line) && !line.empty())
+        {
+            std::istringstream iss(line);
+            std::string field;
+            double fieldValue = 0.0;
+            std::vector<T> situation;
+            while (std::getline(iss, field, ','))
+            {
+                fieldValue = std::stof(field);
+                situation.push_back(static_cast<T>(rounds ? std::round(fieldValue) : fieldValue));
+            }
+
+            if (situation.empty())
+            {
+                continue;
+            }
+
+            actions.push_back(static_cast<int>(fieldValue));
+            situation.pop_back();
+
+            situations.push_back(situation);
+        }
+
+        return { situations, actions };
+    }
+
+    template <typename T>
+    void Run(const std::string & name, const std::string & filename)
+    {
+        PreviousDataset<T> previousDataset;
+        BasicDataset<T> dataset;
+        const double previousMilliseconds = MeasureMilliseconds([&] { previousDataset = PreviousReadDatasetFromFile<T>(filename); });
+        const double milliseconds = MeasureMilliseconds([&] { dataset = CSV::ReadDatasetFromFile<T>(filename); });
+        g_sink += previousDataset.actions.size() + dataset.size();
+
+        std::cout << std::setw(12) << std::left << name << std::right
+                  << std::setw(14) << std::fixed << std::setprecision(1) << previousMilliseconds
+                  << std::setw(12) << milliseconds
+                  << std::setw(10) << previousMilliseconds / milliseconds << std::endl;
+
+        if (previousDataset.actions != dataset.actions())
+        {
+            std::cout << "  (the actions differ)" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t rowCount = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const std::size_t situationSize = (argc > 2) ? std::stoul(argv[2]) : 20;
+    Random random(1);
+
+    const std::string binaryFilename = "csv_dataset_bench_binary.csv";
+    const std::string realFilename = "csv_dataset_bench_real.csv";
+    {
+        std::ofstream binaryOfs(binaryFilename);
+        std::ofstream realOfs(realFilename);
+        realOfs << std::setprecision(17);
+        for (std::size_t i = 0; i < rowCount; ++i)
+        {
+            for (std::size_t j = 0; j < situationSize; ++j)
+            {
+                binaryOfs << random.nextInt(0, 1) << ',';
+                realOfs << random.nextDouble() << ',';
+            }
+            binaryOfs << random.nextInt(0, 1) << '\n';
+            realOfs << random.nextInt(0, 1) << '\n';
+        }
+    }
+
+    std::cout << rowCount << " rows x " << situationSize + 1 << " fields" << std::endl;
+    std::cout << std::setw(12) << std::left << "dataset" << std::right
+              << std::setw(14) << "previous ms"
+              << std::setw(12) << "new ms"
+              << std::setw(10) << "speedup" << std::endl;
+    Run<int>("binary", binaryFilename);
+    Run<double>("real", realFilename);
+
+    std::remove(binaryFilename.c_str());
+    std::remove(realFilename.c_str());
+
+    return 0;
+}
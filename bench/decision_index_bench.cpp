@@ -0,0 +1,141 @@
+// Compares the query time of DecisionIndex with the linear population scan
+//   Usage: decision_index_bench [seed]
+//   The populations imitate trained multiplexer populations (37, 70 and 135 bits): most
+//   classifiers specify the address bits and the addressed data bit, and a few other bits.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+namespace
+{
+    // Prevents the compiler from removing the measured calls
+    std::size_t g_sink = 0;
+
+    xcs::Classifier MultiplexerLikeClassifier(std::size_t addressBitLength, std::size_t length, Random & random)
+    {
+        std::vector<xcs::Symbol> symbols(length);
+        std::size_t address = 0;
+        bool isAddressSpecified = true;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            symbols[i] = xcs::Symbol(random.nextInt(0, 1));
+            const bool isAddressBit = (i < addressBitLength);
+            if (random.nextDouble() < (isAddressBit ? 0.1 : 0.97))
+            {
+                symbols[i].setToDontCare();
+                isAddressSpecified &= !isAddressBit;
+            }
+            else if (isAddressBit)
+            {
+                address = address * 2 + symbols[i].value();
+            }
+        }
+
+        if (isAddressSpecified)
+        {
+            symbols[addressBitLength + address] = xcs::Symbol(random.nextInt(0, 1));
+        }
+
+        return xcs::Classifier(xcs::Condition(symbols), random.nextInt(0, 1), 500.0, 0.0, 0.1, 0);
+    }
+
+    template <class Function>
+    double MeasureNanosecondsPerQuery(const std::vector<std::vector<int>> & situations, Function func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto & situation : situations)
+        {
+            g_sink += func(situation);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / situations.size();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::uint32_t seed = (argc > 1) ? static_cast<std::uint32_t>(std::stoul(argv[1])) : 1;
+    Random random(seed);
+
+    std::cout << std::setw(8) << "length"
+              << std::setw(10) << "size"
+              << std::setw(10) << "nodes"
+              << std::setw(10) << "matches"
+              << std::setw(16) << "scan ns/query"
+              << std::setw(16) << "index ns/query"
+              << std::setw(10) << "speedup" << std::endl;
+
+    for (const std::size_t addressBitLength : { 5, 6, 7 })
+    {
+        const std::size_t length = addressBitLength + (std::size_t{ 1 } << addressBitLength);
+
+        std::vector<std::vector<int>> situations(2000, std::vector<int>(length));
+        for (auto & situation : situations)
+        {
+            for (auto & s : situation)
+            {
+                s = random.nextInt(0, 1);
+            }
+        }
+
+        for (std::size_t size = 1000; size <= 64000; size *= 4)
+        {
+            std::vector<xcs::Classifier> classifiers;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                classifiers.push_back(MultiplexerLikeClassifier(addressBitLength, length, random));
+            }
+            const xcs::DecisionIndex index(classifiers);
+
+            // Make sure that both return the same classifiers
+            // (The average number of matching classifiers is the lower bound of the work of any index.)
+            std::vector<std::size_t> indices;
+            std::size_t totalMatchCount = 0;
+            for (const auto & situation : situations)
+            {
+                std::size_t matchCount = 0;
+                for (const auto & cl : classifiers)
+                {
+                    matchCount += cl.condition.matches(situation);
+                }
+                index.findMatching(situation, indices);
+                if (indices.size() != matchCount)
+                {
+                    std::cerr << "Error: DecisionIndex returned a different number of classifiers." << std::endl;
+                    return 1;
+                }
+                totalMatchCount += matchCount;
+            }
+
+            const double scanNanoseconds = MeasureNanosecondsPerQuery(situations, [&](const std::vector<int> & situation) {
+                std::size_t matchCount = 0;
+                for (const auto & cl : classifiers)
+                {
+                    matchCount += cl.condition.matches(situation);
+                }
+                return matchCount;
+            });
+            const double indexNanoseconds = MeasureNanosecondsPerQuery(situations, [&](const std::vector<int> & situation) {
+                index.findMatching(situation, indices);
+                return indices.size();
+            });
+
+            std::cout << std::setw(8) << length
+                      << std::setw(10) << size
+                      << std::setw(10) << index.nodeCount()
+                      << std::setw(10) << std::fixed << std::setprecision(1) << totalMatchCount / static_cast<double>(situations.size())
+                      << std::setw(16) << std::setprecision(0) << scanNanoseconds
+                      << std::setw(16) << indexNanoseconds
+                      << std::setw(10) << std::setprecision(1) << scanNanoseconds / indexNanoseconds << std::endl;
+        }
+    }
+
+    return 0;
+}
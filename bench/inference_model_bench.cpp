@@ -0,0 +1,123 @@
+// Measures the throughput of PackedInferenceModel::predict() on multiple threads
+//   Usage: inference_model_bench [multiplexer length (default: 20)] [training iterations (default: 50000)] [max threads]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm> // std::max
+#include <cstddef> // std::size_t
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+namespace
+{
+    int MultiplexerAnswer(const std::vector<int> & situation, std::size_t addressBitLength)
+    {
+        std::size_t address = 0;
+        for (std::size_t i = 0; i < addressBitLength; ++i)
+        {
+            address = address * 2 + situation[i];
+        }
+        return situation[addressBitLength + address];
+    }
+
+    std::vector<int> RandomSituation(std::size_t length, Random & random)
+    {
+        std::vector<int> situation(length);
+        for (auto & s : situation)
+        {
+            s = random.nextInt(0, 1);
+        }
+        return situation;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t length = (argc > 1) ? std::stoul(argv[1]) : 20;
+    const std::size_t iterations = (argc > 2) ? std::stoul(argv[2]) : 50000;
+    const std::size_t maxThreadCount = (argc > 3) ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::size_t addressBitLength = 0;
+    while (addressBitLength + (std::size_t{ 1 } << addressBitLength) < length)
+    {
+        ++addressBitLength;
+    }
+    if (addressBitLength + (std::size_t{ 1 } << addressBitLength) != length)
+    {
+        std::cerr << "Error: " << length << " is not a valid multiplexer length." << std::endl;
+        return 1;
+    }
+
+    // Train
+    Random random(1);
+    xcs::XCSParams params;
+    params.n = (length >= 20) ? 2000 : 800;
+    xcs::PackedXCS system({ 0, 1 }, params);
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        const auto situation = RandomSituation(length, random);
+        const int action = system.explore(situation);
+        system.reward((action == MultiplexerAnswer(situation, addressBitLength)) ? 1000.0 : 0.0);
+    }
+
+    const xcs::PackedInferenceModel model(system.population(), { 0, 1 }, params.initialPrediction);
+    std::vector<xcs::PackedSituation> situations;
+    for (std::size_t i = 0; i < 20000; ++i)
+    {
+        situations.emplace_back(RandomSituation(length, random));
+    }
+
+    std::cout << "multiplexer length: " << length << ", population size: " << model.size() << '\n' << std::endl;
+    std::cout << std::setw(8) << "threads"
+              << std::setw(16) << "predict/s"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "accuracy" << std::endl;
+
+    double singleThreadThroughput = 0.0;
+    for (std::size_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        // Each thread predicts all the situations, so the total work is proportional to the thread count
+        const std::size_t repeatCount = 5;
+        std::vector<std::size_t> correctCounts(threadCount, 0);
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                std::size_t correctCount = 0;
+                for (std::size_t repeat = 0; repeat < repeatCount; ++repeat)
+                {
+                    for (const auto & situation : situations)
+                    {
+                        const auto result = model.predict(situation);
+                        correctCount += (result.action == MultiplexerAnswer(situation.toVector(), addressBitLength));
+                    }
+                }
+                correctCounts[t] = correctCount;
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double predictionCount = static_cast<double>(threadCount * repeatCount * situations.size());
+        const double throughput = predictionCount / std::chrono::duration<double>(end - start).count();
+        if (threadCount == 1)
+        {
+            singleThreadThroughput = throughput;
+        }
+
+        std::cout << std::setw(8) << threadCount
+                  << std::setw(16) << std::fixed << std::setprecision(0) << throughput
+                  << std::setw(10) << std::setprecision(2) << throughput / singleThreadThroughput
+                  << std::setw(12) << std::setprecision(4) << correctCounts[0] / static_cast<double>(repeatCount * situations.size()) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Compares the time to save and load a population as CSV and as a binary snapshot
+//   Usage: population_snapshot_bench [population size (default: 100000)] [condition length (default: 20)]
+//   The XCSR population is random (the values have full precision, which the CSV text loses),
+//   and the XCS population is loaded both into [P] and into PackedInferenceModel.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio> // std::remove
+#include <cstddef> // std::size_t
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+namespace
+{
+    // Prevents the compiler from removing the measured calls
+    std::size_t g_sink = 0;
+
+    template <class Function>
+    double MeasureMilliseconds(Function func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    void PrintRow(const std::string & name, double csvMilliseconds, double binaryMilliseconds)
+    {
+        std::cout << std::setw(28) << std::left << name << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(1) << csvMilliseconds
+                  << std::setw(12) << binaryMilliseconds
+                  << std::setw(10) << csvMilliseconds / binaryMilliseconds << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t size = (argc > 1) ? std::stoul(argv[1]) : 100000;
+    const std::size_t length = (argc > 2) ? std::stoul(argv[2]) : 20;
+    Random random(1);
+
+    const std::string csvFilename = "population_snapshot_bench.csv";
+    const std::string binaryFilename = "population_snapshot_bench.bin";
+
+    std::cout << std::setw(28) << std::left << "operation" << std::right
+              << std::setw(12) << "csv ms"
+              << std::setw(12) << "binary ms"
+              << std::setw(10) << "speedup" << std::endl;
+
+    // XCSR
+    {
+        std::vector<xcsr::Classifier> classifiers;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            std::vector<xcsr::Symbol> symbols;
+            for (std::size_t j = 0; j < length; ++j)
+            {
+                symbols.emplace_back(random.nextDouble(), random.nextDouble() / 2);
+            }
+            classifiers.emplace_back(xcsr::Condition(symbols), random.nextInt(0, 1), random.nextDouble(0.0, 1000.0), random.nextDouble(), random.nextDouble(), i);
+        }
+
+        xcsr::XCSRParams params;
+        params.n = size * 2;
+        XCSR system({ 0, 1 }, params);
+        system.setPopulationClassifiers(classifiers);
+
+        const double csvSave = MeasureMilliseconds([&] { system.savePopulationCSVFile(csvFilename); });
+        const double binarySave = MeasureMilliseconds([&] { system.savePopulationBinaryFile(binaryFilename); });
+        PrintRow("XCSR save", csvSave, binarySave);
+
+        XCSR loaded({ 0, 1 }, params);
+        const double csvLoad = MeasureMilliseconds([&] { loaded.loadPopulationCSVFile(csvFilename); });
+        const double binaryLoad = MeasureMilliseconds([&] { loaded.loadPopulationBinaryFile(binaryFilename); });
+        PrintRow("XCSR load", csvLoad, binaryLoad);
+        g_sink += loaded.populationSize();
+    }
+
+    // XCS
+    {
+        std::vector<xcs::PackedClassifier> classifiers;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            std::vector<xcs::Symbol> symbols;
+            for (std::size_t j = 0; j < length; ++j)
+            {
+                symbols.push_back(random.nextDouble() < 0.5 ? xcs::Symbol('#') : xcs::Symbol(random.nextInt(0, 1)));
+            }
+            classifiers.emplace_back(xcs::PackedCondition(symbols), random.nextInt(0, 1), random.nextDouble(0.0, 1000.0), random.nextDouble(), random.nextDouble(), i);
+        }
+
+        xcs::XCSParams params;
+        params.n = size * 2;
+        PackedXCS system({ 0, 1 }, params);
+        system.setPopulationClassifiers(classifiers);
+
+        system.savePopulationCSVFile(csvFilename);
+        system.savePopulationBinaryFile(binaryFilename);
+
+        PackedXCS loaded({ 0, 1 }, params);
+        const double csvLoad = MeasureMilliseconds([&] { loaded.loadPopulationCSVFile(csvFilename); });
+        const double binaryLoad = MeasureMilliseconds([&] { loaded.loadPopulationBinaryFile(binaryFilename); });
+        PrintRow("PackedXCS load", csvLoad, binaryLoad);
+        g_sink += loaded.populationSize();
+
+        // The first prediction is included since the mapped pages are read on demand
+        const std::vector<int> situation(length, 1);
+        const double csvModel = MeasureMilliseconds([&] {
+            const auto model = xcs::PackedInferenceModel::FromCSVFile(csvFilename, { 0, 1 }, params.initialPrediction);
+            g_sink += model.predict(situation).action;
+        });
+        const double binaryModel = MeasureMilliseconds([&] {
+            const auto model = xcs::PackedInferenceModel::FromBinaryFile(binaryFilename, { 0, 1 }, params.initialPrediction);
+            g_sink += model.predict(situation).action;
+        });
+        PrintRow("PackedInferenceModel load", csvModel, binaryModel);
+    }
+
+    std::remove(csvFilename.c_str());
+    std::remove(binaryFilename.c_str());
+
+    return 0;
+}
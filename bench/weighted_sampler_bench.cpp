@@ -0,0 +1,90 @@
+// Compares Random::rouletteWheelSelection() with WeightedSampler
+//   Usage: weighted_sampler_bench [seed]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+namespace
+{
+    // Prevents the compiler from removing the measured calls
+    std::size_t g_sink = 0;
+
+    template <class Function>
+    double MeasureNanosecondsPerCall(std::size_t callCount, Function func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < callCount; ++i)
+        {
+            g_sink += func();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / callCount;
+    }
+
+    void PrintRow(const std::string & name, std::size_t size, double nanoseconds)
+    {
+        std::cout << std::left << std::setw(32) << name
+                  << std::right << std::setw(10) << size
+                  << std::setw(16) << std::fixed << std::setprecision(1) << nanoseconds << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::uint32_t seed = (argc > 1) ? static_cast<std::uint32_t>(std::stoul(argv[1])) : 1;
+    Random random(seed);
+
+    std::cout << std::left << std::setw(32) << "method"
+              << std::right << std::setw(10) << "size"
+              << std::setw(16) << "ns/call" << std::endl;
+
+    for (std::size_t size = 1000; size <= 1000000; size *= 10)
+    {
+        std::vector<double> weights(size);
+        for (auto & weight : weights)
+        {
+            weight = random.nextDouble();
+        }
+
+        // Keep the total work of the O(n) method roughly constant
+        const std::size_t linearCallCount = std::max<std::size_t>(10, 5000000 / size);
+        const std::size_t callCount = 1000000;
+
+        PrintRow("rouletteWheelSelection", size, MeasureNanosecondsPerCall(linearCallCount, [&] {
+            return random.rouletteWheelSelection(weights);
+        }));
+
+        WeightedSampler sumTreeSampler(weights);
+        PrintRow("WeightedSampler(kSumTree)", size, MeasureNanosecondsPerCall(callCount, [&] {
+            return sumTreeSampler.sample(random);
+        }));
+
+        // Update one weight before each sample (e.g., the fitness of a classifier changed)
+        PrintRow("WeightedSampler(kSumTree)+set", size, MeasureNanosecondsPerCall(callCount, [&] {
+            sumTreeSampler.set(random.nextInt<std::size_t>(0, size - 1), random.nextDouble());
+            return sumTreeSampler.sample(random);
+        }));
+
+        const WeightedSampler aliasSampler(weights, WeightedSampler::Mode::kAliasTable);
+        PrintRow("WeightedSampler(kAliasTable)", size, MeasureNanosecondsPerCall(callCount, [&] {
+            return aliasSampler.sample(random);
+        }));
+
+        WeightedSampler rebuiltSampler(WeightedSampler::Mode::kAliasTable);
+        PrintRow("WeightedSampler(kAliasTable)+build", size, MeasureNanosecondsPerCall(linearCallCount, [&] {
+            rebuiltSampler.assign(weights);
+            return rebuiltSampler.sample(random);
+        }));
+    }
+
+    std::cerr << "(checksum: " << g_sink << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cmath> // std::pow, std::floor
+
+namespace xcspp
+{
+
+    // Largest nu for which the power is calculated by multiplications
+    inline constexpr double kMaxIntegerNu = 64.0;
+
+    // Accuracy of a classifier with the prediction error epsilon
+    //   kappa = 1                                  (epsilon < epsilon_0)
+    //         = alpha * (epsilon / epsilon_0)^(-nu) (otherwise)
+    //   For a non-negative integer nu (e.g., the recommended nu = 5), the power is calculated
+    //   by exponentiation by squaring instead of std::pow().
+    inline double ComputeAccuracy(double epsilon, double epsilonZero, double alpha, double nu)
+    {
+        if (epsilon < epsilonZero)
+        {
+            return 1.0;
+        }
+
+        if (nu >= 0.0 && nu <= kMaxIntegerNu && nu == std::floor(nu))
+        {
+            double base = epsilonZero / epsilon;
+            double power = 1.0;
+            for (unsigned int exponent = static_cast<unsigned int>(nu); exponent > 0; exponent /= 2)
+            {
+                if (exponent & 1)
+                {
+                    power *= base;
+                }
+                base *= base;
+            }
+            return alpha * power;
+        }
+
+        return alpha * std::pow(epsilon / epsilonZero, -nu);
+    }
+
+}
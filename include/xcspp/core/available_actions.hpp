@@ -0,0 +1,232 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <unordered_set>
+#include <limits>
+#include <algorithm> // std::sort, std::lower_bound
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+#include <stdexcept>
+
+#include "xcspp/util/random.hpp"
+
+namespace xcspp
+{
+
+    // Available action choices of a classifier system
+    //   The actions are kept in ascending order in a small vector that is built once,
+    //   so covering, action mutation and random action selection need no heap allocation.
+    class AvailableActions
+    {
+    private:
+        std::vector<int> m_actions;
+
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        // Constructor
+        explicit AvailableActions(const std::unordered_set<int> & actions)
+            : m_actions(actions.begin(), actions.end())
+        {
+            std::sort(m_actions.begin(), m_actions.end());
+        }
+
+        // Destructor
+        ~AvailableActions() = default;
+
+        std::size_t size() const noexcept
+        {
+            return m_actions.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_actions.empty();
+        }
+
+        int operator[] (std::size_t idx) const
+        {
+            return m_actions[idx];
+        }
+
+        auto begin() const noexcept
+        {
+            return m_actions.begin();
+        }
+
+        auto end() const noexcept
+        {
+            return m_actions.end();
+        }
+
+        // Position of the action in begin()...end() (npos if it is not available)
+        std::size_t indexOf(int action) const noexcept
+        {
+            const auto it = std::lower_bound(m_actions.begin(), m_actions.end(), action);
+            return (it != m_actions.end() && *it == action) ? static_cast<std::size_t>(it - m_actions.begin()) : npos;
+        }
+
+        bool contains(int action) const noexcept
+        {
+            return indexOf(action) != npos;
+        }
+
+        // Choose an action at random
+        int choose(Random & random) const
+        {
+            if (m_actions.empty())
+            {
+                throw std::invalid_argument("AvailableActions::choose() was called with no available actions.");
+            }
+
+            return m_actions[random.nextInt<std::size_t>(0, m_actions.size() - 1)];
+        }
+
+        // Choose an action other than the given one at random
+        // (If the given action is not available, any available action can be chosen.)
+        int chooseOtherThan(int action, Random & random) const
+        {
+            const std::size_t excludedIdx = indexOf(action);
+            if (excludedIdx == npos)
+            {
+                return choose(random);
+            }
+
+            if (m_actions.size() < 2)
+            {
+                throw std::invalid_argument("AvailableActions::chooseOtherThan() was called with no other available actions.");
+            }
+
+            // Skip the excluded position
+            const std::size_t idx = random.nextInt<std::size_t>(0, m_actions.size() - 2);
+            return m_actions[(idx < excludedIdx) ? idx : idx + 1];
+        }
+    };
+
+    // Subset of AvailableActions (e.g., the actions that no classifier in [M] proposes)
+    //   This is a bitmask over the positions in AvailableActions. Up to kInlineCapacity
+    //   available actions, the bitmask is stored without heap allocation.
+    class ActionSubset
+    {
+    private:
+        static constexpr std::size_t kInlineWordCount = 4;
+
+        const AvailableActions * m_pAvailableActions;
+        std::size_t m_size;
+        std::array<std::uint64_t, kInlineWordCount> m_inlineWords;
+        std::vector<std::uint64_t> m_heapWords;
+
+        std::uint64_t * words() noexcept
+        {
+            return m_heapWords.empty() ? m_inlineWords.data() : m_heapWords.data();
+        }
+
+        const std::uint64_t * words() const noexcept
+        {
+            return m_heapWords.empty() ? m_inlineWords.data() : m_heapWords.data();
+        }
+
+        bool testAt(std::size_t idx) const noexcept
+        {
+            return (words()[idx / 64] >> (idx % 64)) & 1;
+        }
+
+    public:
+        static constexpr std::size_t kInlineCapacity = kInlineWordCount * 64;
+
+        // Constructor (contains all the available actions if isFull is true, or none otherwise)
+        ActionSubset(const AvailableActions & availableActions, bool isFull)
+            : m_pAvailableActions(&availableActions)
+            , m_size(isFull ? availableActions.size() : 0)
+            , m_inlineWords{}
+        {
+            const std::size_t wordCount = (availableActions.size() + 63) / 64;
+            if (wordCount > kInlineWordCount)
+            {
+                m_heapWords.resize(wordCount);
+            }
+
+            if (isFull)
+            {
+                std::uint64_t *w = words();
+                for (std::size_t i = 0; i < wordCount; ++i)
+                {
+                    const std::size_t bitCount = std::min<std::size_t>(64, availableActions.size() - i * 64);
+                    w[i] = (bitCount == 64) ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << bitCount) - 1;
+                }
+            }
+        }
+
+        // Destructor
+        ~ActionSubset() = default;
+
+        // Number of the actions in the subset
+        std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        bool contains(int action) const noexcept
+        {
+            const std::size_t idx = m_pAvailableActions->indexOf(action);
+            return idx != AvailableActions::npos && testAt(idx);
+        }
+
+        // Add the action (returns false if it is not available or already in the subset)
+        bool insert(int action) noexcept
+        {
+            const std::size_t idx = m_pAvailableActions->indexOf(action);
+            if (idx == AvailableActions::npos || testAt(idx))
+            {
+                return false;
+            }
+            words()[idx / 64] |= std::uint64_t{ 1 } << (idx % 64);
+            ++m_size;
+            return true;
+        }
+
+        // Remove the action (returns false if it is not in the subset)
+        bool erase(int action) noexcept
+        {
+            const std::size_t idx = m_pAvailableActions->indexOf(action);
+            if (idx == AvailableActions::npos || !testAt(idx))
+            {
+                return false;
+            }
+            words()[idx / 64] &= ~(std::uint64_t{ 1 } << (idx % 64));
+            --m_size;
+            return true;
+        }
+
+        // Choose an action in the subset at random
+        int choose(Random & random) const
+        {
+            if (m_size == 0)
+            {
+                throw std::invalid_argument("ActionSubset::choose() was called on an empty subset.");
+            }
+
+            // Find the k-th action in the subset
+            std::size_t k = random.nextInt<std::size_t>(0, m_size - 1);
+            for (std::size_t idx = 0; idx < m_pAvailableActions->size(); ++idx)
+            {
+                if (testAt(idx))
+                {
+                    if (k == 0)
+                    {
+                        return (*m_pAvailableActions)[idx];
+                    }
+                    --k;
+                }
+            }
+
+            throw std::logic_error("ActionSubset::choose() could not find the selected action.");
+        }
+    };
+
+}
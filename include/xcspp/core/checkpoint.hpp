@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <fstream>
+#include <filesystem> // std::filesystem::rename
+#include <system_error> // std::error_code
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+#include "xcspp/util/binary_stream.hpp"
+
+namespace xcspp
+{
+
+    // Checkpoint of the whole training state
+    //   A checkpoint holds everything that the following steps depend on (e.g., [P] with the
+    //   running aggregates, [A] and [A]_-1, the random engine and the timestamp), so the
+    //   training resumed from it continues exactly in the same way as the one that saved it.
+    //   The values are written in the native binary layout after a header with the kind of the
+    //   object and the hash of its hyperparameters, and the byte order is checked on load.
+    enum class CheckpointKind : std::uint32_t
+    {
+        kXCS = 1,
+        kXCSR = 2,
+        kExperimentHelper = 3,
+    };
+
+    void WriteCheckpointHeader(BinaryWriter & writer, CheckpointKind kind, std::uint64_t paramsHash);
+
+    // (Throws std::runtime_error if the stream does not have a checkpoint of the kind,
+    //  and std::invalid_argument if it was saved with different hyperparameters.)
+    void ReadCheckpointHeader(BinaryReader & reader, CheckpointKind kind, std::uint64_t paramsHash);
+
+    // Write obj.outputCheckpoint() to the file
+    //   The checkpoint is written to a temporary file that replaces the file at the end,
+    //   so the previous checkpoint is kept if the process is killed while writing.
+    //   (Returns false if the file cannot be written.)
+    template <class T>
+    bool SaveCheckpointFile(const T & obj, const std::string & filename)
+    {
+        const std::string tmpFilename = filename + ".tmp";
+        {
+            std::ofstream ofs(tmpFilename, std::ios::binary);
+            if (!ofs.good())
+            {
+                return false;
+            }
+
+            obj.outputCheckpoint(ofs);
+            ofs.close();
+            if (ofs.fail())
+            {
+                return false;
+            }
+        }
+
+        std::error_code errorCode;
+        std::filesystem::rename(tmpFilename, filename, errorCode);
+        return !errorCode;
+    }
+
+    // Read the file with obj.inputCheckpoint()
+    // (Returns false if the file cannot be opened.)
+    template <class T>
+    bool LoadCheckpointFile(T & obj, const std::string & filename)
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs.good())
+        {
+            return false;
+        }
+
+        obj.inputCheckpoint(ifs);
+        return true;
+    }
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include <vector>
+#include <algorithm> // std::sort, std::unique, std::lower_bound, std::min, std::fill
+#include <cmath> // std::abs
+#include <cfloat> // DBL_EPSILON
+#include <cstddef> // std::size_t
+#include <stdexcept>
+
+#include "available_actions.hpp"
+
+namespace xcspp
+{
+
+    // Result of exploitBatch()
+    struct ExploitBatchResult
+    {
+        // Action of each prediction column (ascending order)
+        //   This contains the available actions, and the other actions in [P] if any.
+        std::vector<int> actionChoices;
+
+        // Greedy action for each situation
+        std::vector<int> actions;
+
+        // Prediction of each action for each situation (row-major: situations x actionChoices)
+        //   The values are the same as predictionFor() after exploit().
+        std::vector<double> predictions;
+
+        // Whether no classifier matched each situation
+        //   (exploit() would report covering and choose a random action in this case)
+        std::vector<bool> isMatchSetEmpty;
+
+        std::size_t size() const noexcept
+        {
+            return actions.size();
+        }
+
+        // Prediction of the action for the situation at the position
+        double predictionFor(std::size_t situationIdx, int action) const
+        {
+            const auto it = std::lower_bound(actionChoices.begin(), actionChoices.end(), action);
+            if (situationIdx >= actions.size() || it == actionChoices.end() || *it != action)
+            {
+                throw std::out_of_range("ExploitBatchResult::predictionFor() received an unknown situation index or action.");
+            }
+            return predictions[situationIdx * actionChoices.size() + static_cast<std::size_t>(it - actionChoices.begin())];
+        }
+    };
+
+    // Action columns of the prediction arrays for read-only inference
+    //   actionChoices gets the available actions and the other actions of the classifiers (if any)
+    //   in ascending order, and columns gets the position of the action of each classifier in it.
+    template <class ClassifierRange>
+    void MakeActionColumns(const ClassifierRange & classifiers, const AvailableActions & availableActions, std::vector<int> & actionChoices, std::vector<std::size_t> & columns)
+    {
+        actionChoices.assign(availableActions.begin(), availableActions.end());
+        for (const auto & cl : classifiers)
+        {
+            if (!availableActions.contains(cl.action))
+            {
+                actionChoices.push_back(cl.action);
+            }
+        }
+        std::sort(actionChoices.begin(), actionChoices.end());
+        actionChoices.erase(std::unique(actionChoices.begin(), actionChoices.end()), actionChoices.end());
+
+        columns.clear();
+        columns.reserve(classifiers.size());
+        for (const auto & cl : classifiers)
+        {
+            const auto it = std::lower_bound(actionChoices.begin(), actionChoices.end(), cl.action);
+            columns.push_back(static_cast<std::size_t>(it - actionChoices.begin()));
+        }
+    }
+
+    // FINALIZE PREDICTION ARRAY (for greedy read-only inference)
+    //   Divides the prediction sums by the fitness sums and writes the prediction of each
+    //   column to predictions (0 for the columns not in PA). Returns the column of the best
+    //   action (the first one among ties), or actionCount if no column is in PA.
+    inline std::size_t FinalizeGreedyPredictionArray(const double * pa, const double * fsa, const unsigned char * isInPA, std::size_t actionCount, double * predictions)
+    {
+        std::size_t bestCol = actionCount;
+        for (std::size_t col = 0; col < actionCount; ++col)
+        {
+            if (!isInPA[col])
+            {
+                predictions[col] = 0.0;
+                continue;
+            }
+
+            double prediction = pa[col];
+            if (std::abs(fsa[col]) > 0.0)
+            {
+                prediction /= fsa[col];
+            }
+            predictions[col] = prediction;
+
+            if (bestCol == actionCount || (predictions[bestCol] < prediction && std::abs(predictions[bestCol] - prediction) >= DBL_EPSILON))
+            {
+                bestCol = col;
+            }
+        }
+        return bestCol;
+    }
+
+    // Number of situations matched against each condition while it is in cache
+    inline constexpr std::size_t kExploitBatchTileSize = 64;
+
+    // Greedy action selection for many situations without updating [P] (shared by XCS and XCSR)
+    //   The situations are processed in tiles of kExploitBatchTileSize, and each tile is
+    //   matched against all the classifiers, so that each condition is loaded once per tile
+    //   instead of once per situation. The prediction of each action is accumulated in the
+    //   order of [P], so it is the same as the prediction array of exploit().
+    //   Ties are broken by the smallest action (exploit() chooses one at random), and the
+    //   first available action is chosen if no classifier matches, so the result is
+    //   deterministic and no random number generator is needed.
+    template <class ClassifierRange, class MatchFunction>
+    ExploitBatchResult ExploitBatch(
+        const ClassifierRange & classifiers,
+        std::size_t situationCount,
+        const AvailableActions & availableActions,
+        double initialPrediction,
+        MatchFunction matches)
+    {
+        if (availableActions.empty())
+        {
+            throw std::invalid_argument("ExploitBatch() was called with no available actions.");
+        }
+
+        ExploitBatchResult result;
+
+        // Column of each classifier (looked up once per batch instead of once per match)
+        std::vector<std::size_t> columns;
+        MakeActionColumns(classifiers, availableActions, result.actionChoices, columns);
+        const std::size_t actionCount = result.actionChoices.size();
+
+        result.actions.resize(situationCount);
+        result.predictions.resize(situationCount * actionCount);
+        result.isMatchSetEmpty.resize(situationCount);
+
+        // PA and FSA of the situations in the current tile
+        std::vector<double> pa(kExploitBatchTileSize * actionCount);
+        std::vector<double> fsa(kExploitBatchTileSize * actionCount);
+        std::vector<unsigned char> isInPA(kExploitBatchTileSize * actionCount);
+
+        for (std::size_t tileBegin = 0; tileBegin < situationCount; tileBegin += kExploitBatchTileSize)
+        {
+            const std::size_t tileEnd = std::min(tileBegin + kExploitBatchTileSize, situationCount);
+            std::fill(pa.begin(), pa.end(), 0.0);
+            std::fill(fsa.begin(), fsa.end(), 0.0);
+            std::fill(isInPA.begin(), isInPA.end(), 0);
+
+            // Accumulate the prediction arrays (classifier-major, so each condition is loaded once per tile)
+            std::size_t clIdx = 0;
+            for (const auto & cl : classifiers)
+            {
+                const double weightedPrediction = cl.prediction * cl.fitness;
+                for (std::size_t i = tileBegin; i < tileEnd; ++i)
+                {
+                    if (matches(cl, i))
+                    {
+                        const std::size_t cell = (i - tileBegin) * actionCount + columns[clIdx];
+                        pa[cell] += weightedPrediction;
+                        fsa[cell] += cl.fitness;
+                        isInPA[cell] = 1;
+                    }
+                }
+                ++clIdx;
+            }
+
+            // Finalize the prediction arrays and select the best actions
+            for (std::size_t i = tileBegin; i < tileEnd; ++i)
+            {
+                const std::size_t rowBegin = (i - tileBegin) * actionCount;
+                double * const predictions = result.predictions.data() + i * actionCount;
+
+                // The columns are in ascending order, so ties are broken by the smallest action
+                const std::size_t bestCol = FinalizeGreedyPredictionArray(&pa[rowBegin], &fsa[rowBegin], &isInPA[rowBegin], actionCount, predictions);
+                const bool isEmpty = (bestCol == actionCount);
+                if (isEmpty)
+                {
+                    std::fill(predictions, predictions + actionCount, initialPrediction);
+                }
+                result.actions[i] = isEmpty ? availableActions[0] : result.actionChoices[bestCol];
+                result.isMatchSetEmpty[i] = isEmpty;
+            }
+        }
+
+        return result;
+    }
+
+}
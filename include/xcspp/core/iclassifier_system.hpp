@@ -1,8 +1,15 @@
 #pragma once
-#include <iosfwd> // std::ostream
+#include <iosfwd> // std::istream, std::ostream
 #include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstdint> // std::uint32_t
 #include <cstddef> // std::size_t
 
+#include "exploit_batch.hpp"
+#include "match_set_cache.hpp"
+#include "xcspp/util/span.hpp"
+
 namespace xcspp
 {
 
@@ -22,6 +29,13 @@ namespace xcspp
         // Run with exploration
         virtual int explore(const std::vector<T> & situation) = 0;
 
+        // Run with exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        // (The default implementation copies the situation to a vector and calls explore() above.)
+        virtual int explore(Span<const T> situation)
+        {
+            return explore(std::vector<T>(situation.begin(), situation.end()));
+        }
+
         // Feedback reward to system
         virtual void reward(double value, bool isEndOfProblem = true) = 0;
 
@@ -29,6 +43,18 @@ namespace xcspp
         // (Set update to true when testing multi-step problems. If update is true, make sure to call reward() after this.)
         virtual int exploit(const std::vector<T> & situation, bool update = false) = 0;
 
+        // Run without exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        // (The default implementation copies the situation to a vector and calls exploit() above.)
+        virtual int exploit(Span<const T> situation, bool update = false)
+        {
+            return exploit(std::vector<T>(situation.begin(), situation.end()), update);
+        }
+
+        // Run without exploration for many situations at once (without updating [P])
+        // (Implementations must not change the results of prediction(), predictionFor() or isCoveringPerformed().
+        //  Whether they can be called from multiple threads depends on the implementation; refer to XCS and XCSR.)
+        virtual ExploitBatchResult exploitBatch(const std::vector<std::vector<T>> & situations) const = 0;
+
         // Get prediction value of the previous action decision
         // (Call this function after explore() or exploit())
         virtual double prediction() const = 0;
@@ -47,10 +73,61 @@ namespace xcspp
 
         virtual bool savePopulationCSVFile(const std::string & filename) const = 0;
 
+        // Load the population from a binary snapshot (exact values; refer to PopulationSnapshot)
+        // (The default implementations of the binary files throw std::domain_error.)
+        virtual bool loadPopulationBinaryFile(const std::string &, bool = false, bool = true)
+        {
+            throw std::domain_error("The classifier system does not support binary population files.");
+        }
+
+        virtual bool savePopulationBinaryFile(const std::string &) const
+        {
+            throw std::domain_error("The classifier system does not support binary population files.");
+        }
+
+        // Write the whole training state for a checkpoint (refer to CheckpointKind)
+        // (The default implementations of the checkpoints throw std::domain_error. Override this,
+        //  inputCheckpoint() and the file versions to save the checkpoints of ExperimentHelper.)
+        virtual void outputCheckpoint(std::ostream &) const
+        {
+            throw std::domain_error("The classifier system does not support checkpoints.");
+        }
+
+        // Read the training state written by outputCheckpoint()
+        virtual void inputCheckpoint(std::istream &)
+        {
+            throw std::domain_error("The classifier system does not support checkpoints.");
+        }
+
+        virtual bool saveCheckpointFile(const std::string &) const
+        {
+            throw std::domain_error("The classifier system does not support checkpoints.");
+        }
+
+        virtual bool loadCheckpointFile(const std::string &)
+        {
+            throw std::domain_error("The classifier system does not support checkpoints.");
+        }
+
         virtual std::size_t populationSize() const = 0;
 
         virtual std::size_t numerositySum() const = 0;
 
+        // Get the number of the lookups in the match set cache and the ones that hit
+        // (Both are zero if the cache is disabled. The default implementation returns zeros, since
+        //  ExperimentHelper calls this in every iteration.)
+        virtual MatchSetCacheStatistics matchSetCacheStatistics() const
+        {
+            return {};
+        }
+
+        // Seed the random engine of the system (e.g., with SeedSequence::seed())
+        // (The default implementation throws std::domain_error.)
+        virtual void seed(std::uint32_t)
+        {
+            throw std::domain_error("The classifier system does not support seeding.");
+        }
+
         virtual void switchToCondensationMode() = 0;
     };
 
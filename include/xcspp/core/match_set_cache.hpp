@@ -0,0 +1,214 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm> // std::lower_bound
+#include <type_traits> // std::is_floating_point_v
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "xcspp/util/hash.hpp"
+
+namespace xcspp
+{
+
+    // Number of the lookups in the match set cache and the ones that hit
+    struct MatchSetCacheStatistics
+    {
+        std::uint64_t lookupCount = 0;
+        std::uint64_t hitCount = 0;
+
+        double hitRate() const noexcept
+        {
+            return (lookupCount > 0) ? static_cast<double>(hitCount) / lookupCount : 0.0;
+        }
+    };
+
+    // Hash of a situation (std::vector<int>, std::vector<double> or xcs::PackedSituation)
+    struct SituationHash
+    {
+        template <class Situation>
+        std::size_t operator()(const Situation & situation) const
+        {
+            std::size_t seed = situation.size();
+            for (std::size_t i = 0; i < situation.size(); ++i)
+            {
+                const auto value = situation[i];
+                if constexpr (std::is_floating_point_v<decltype(value)>)
+                {
+                    // Adding 0.0 turns -0.0 into +0.0 so that equal values have the same hash
+                    HashCombine(seed, value + 0.0);
+                }
+                else
+                {
+                    HashCombine(seed, value);
+                }
+            }
+            return seed;
+        }
+    };
+
+    // Positions of the classifiers in [P] that match each situation
+    //   Environments that present a small number of distinct situations again and again (e.g.,
+    //   maze problems and small datasets) skip the population scan when the situation is cached.
+    //   [P] reports its changes, and only the affected entries are updated:
+    //     - insert: the new position is appended to the entries whose situation the new condition matches
+    //     - erase (swap-remove): the erased position is removed from the entries that contain it,
+    //       and the position of the last classifier is replaced with the erased one
+    //   The positions of each entry are thus always the same as the scan of [P] (ascending order).
+    //   The least recently used entry is evicted when the cache is full.
+    template <class Situation>
+    class MatchSetCache
+    {
+    private:
+        struct Entry
+        {
+            Situation situation;
+            std::vector<std::size_t> indices;
+            std::uint64_t lastUsedTime;
+        };
+
+        std::size_t m_capacity;
+
+        std::vector<Entry> m_entries;
+
+        // Position of the entry in m_entries for each situation
+        std::unordered_map<Situation, std::size_t, SituationHash> m_entryIndices;
+
+        // Incremented at each lookup (for the LRU eviction)
+        std::uint64_t m_time;
+
+        MatchSetCacheStatistics m_statistics;
+
+    public:
+        // Constructor
+        //   The cache is disabled if capacity is zero.
+        explicit MatchSetCache(std::size_t capacity = 0)
+            : m_capacity(capacity)
+            , m_time(0)
+        {
+        }
+
+        // Destructor
+        ~MatchSetCache() = default;
+
+        bool enabled() const noexcept
+        {
+            return m_capacity > 0;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        // Number of the cached situations
+        std::size_t size() const noexcept
+        {
+            return m_entries.size();
+        }
+
+        // Positions of the matching classifiers (nullptr if the situation is not cached)
+        const std::vector<std::size_t> * find(const Situation & situation)
+        {
+            ++m_time;
+            ++m_statistics.lookupCount;
+
+            const auto it = m_entryIndices.find(situation);
+            if (it == m_entryIndices.end())
+            {
+                return nullptr;
+            }
+
+            ++m_statistics.hitCount;
+            Entry & entry = m_entries[it->second];
+            entry.lastUsedTime = m_time;
+            return &entry.indices;
+        }
+
+        // Add an entry for the situation and return its empty positions to be filled by the caller
+        // (Call this after find() returned nullptr for the situation.)
+        std::vector<std::size_t> & emplace(const Situation & situation)
+        {
+            std::size_t entryIdx = m_entries.size();
+            if (entryIdx < m_capacity)
+            {
+                m_entries.push_back(Entry{ situation, {}, m_time });
+            }
+            else
+            {
+                // Evict the least recently used entry (and reuse its storage)
+                entryIdx = 0;
+                for (std::size_t i = 1; i < m_entries.size(); ++i)
+                {
+                    if (m_entries[i].lastUsedTime < m_entries[entryIdx].lastUsedTime)
+                    {
+                        entryIdx = i;
+                    }
+                }
+                m_entryIndices.erase(m_entries[entryIdx].situation);
+
+                Entry & entry = m_entries[entryIdx];
+                entry.situation = situation;
+                entry.indices.clear();
+                entry.lastUsedTime = m_time;
+            }
+            m_entryIndices[situation] = entryIdx;
+            return m_entries[entryIdx].indices;
+        }
+
+        // Reflect that a classifier was appended to [P] at the position
+        // (matches(situation) must return whether the condition of the classifier matches the situation)
+        template <class Predicate>
+        void notifyInsert(std::size_t idx, Predicate matches)
+        {
+            for (auto & entry : m_entries)
+            {
+                if (matches(entry.situation))
+                {
+                    entry.indices.push_back(idx);
+                }
+            }
+        }
+
+        // Reflect that the classifier at the position was erased from [P] and the last one
+        // (at lastIdx) was moved into its place
+        void notifySwapRemove(std::size_t idx, std::size_t lastIdx)
+        {
+            for (auto & entry : m_entries)
+            {
+                auto & indices = entry.indices;
+                const auto it = std::lower_bound(indices.begin(), indices.end(), idx);
+                if (it != indices.end() && *it == idx)
+                {
+                    indices.erase(it);
+                }
+
+                // lastIdx is the largest position, so it is at the back if the entry contains it
+                if (idx != lastIdx && !indices.empty() && indices.back() == lastIdx)
+                {
+                    indices.pop_back();
+                    indices.insert(std::lower_bound(indices.begin(), indices.end(), idx), idx);
+                }
+            }
+        }
+
+        // Remove all entries (the statistics are kept)
+        void clear() noexcept
+        {
+            m_entries.clear();
+            m_entryIndices.clear();
+        }
+
+        const MatchSetCacheStatistics & statistics() const noexcept
+        {
+            return m_statistics;
+        }
+
+        // Replace the statistics (for restoring a checkpoint, which does not include the entries)
+        void setStatistics(const MatchSetCacheStatistics & statistics) noexcept
+        {
+            m_statistics = statistics;
+        }
+    };
+
+}
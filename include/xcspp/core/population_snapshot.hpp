@@ -0,0 +1,229 @@
+#pragma once
+#include <iosfwd> // std::istream, std::ostream
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "xcspp/util/mapped_file.hpp"
+
+namespace xcspp
+{
+
+    // Binary snapshot of the classifiers in [P] (shared by XCS and XCSR)
+    //   The file consists of a 64-byte header followed by one section per classifier field.
+    //   Each section is an array of the field of all classifiers in the native layout
+    //   (structure of arrays) and starts at a multiple of 64 bytes, so that a mapped file can
+    //   be read in place without parsing. The values are stored bit for bit, so a population
+    //   saved and loaded again is exactly the same (unlike the CSV text).
+    //   The condition sections depend on the condition kind:
+    //     - kTernary:       values (int32) and cares (uint8), row-major (classifiers x length)
+    //     - kPackedTernary: value and care words (uint64) in the blocked layout of
+    //                       xcs::PackedConditionMatrix (the rows are padded to kPackedBlockSize)
+    //     - kInterval:      (v1, v2) pairs (double), row-major (classifiers x length); no cares
+    //   The byte order is recorded in the header, and a file written on a machine with
+    //   another byte order is rejected.
+    class PopulationSnapshot
+    {
+    public:
+        static constexpr std::uint32_t kVersion = 1;
+
+        // Number of the rows in a block of the kPackedTernary condition sections
+        static constexpr std::size_t kPackedBlockSize = 4;
+
+        enum class ConditionKind : std::uint32_t
+        {
+            kTernary = 1,
+            kPackedTernary = 2,
+            kInterval = 3,
+        };
+
+        enum class Section : std::size_t
+        {
+            kAction,
+            kPrediction,
+            kEpsilon,
+            kFitness,
+            kExperience,
+            kTimeStamp,
+            kActionSetSize,
+            kNumerosity,
+            kConditionValue,
+            kConditionCare,
+        };
+
+        static constexpr std::size_t kSectionCount = 10;
+
+        static constexpr std::size_t kHeaderSize = 64;
+
+        static constexpr std::size_t kSectionAlignment = 64;
+
+    private:
+        struct Header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrderMark;
+            std::uint32_t conditionKind;
+            std::uint32_t repr;
+            std::uint64_t paramsHash;
+            std::uint64_t conditionLength;
+            std::uint64_t size;
+            std::uint64_t fileSize;
+            std::uint64_t reserved;
+        };
+        static_assert(sizeof(Header) == kHeaderSize);
+
+        Header m_header;
+
+        // Byte offset and number of elements of each section
+        std::array<std::size_t, kSectionCount> m_sectionOffsets;
+        std::array<std::size_t, kSectionCount> m_sectionElementCounts;
+
+        // Storage of the whole file (either of them is used)
+        std::vector<std::uint64_t> m_buffer;
+        std::unique_ptr<const MappedFile> m_file;
+
+        // Compute the section offsets from the header and return the file size
+        std::size_t computeLayout();
+
+        const unsigned char * bytes() const noexcept
+        {
+            return m_file ? m_file->data() : reinterpret_cast<const unsigned char *>(m_buffer.data());
+        }
+
+        void checkElementSize(Section section, std::size_t elementSize) const;
+
+        // Throws std::runtime_error if the header is not valid for a file of the size
+        void validateHeader(std::uint64_t actualFileSize);
+
+        PopulationSnapshot()
+            : m_header{}
+        {
+        }
+
+        explicit PopulationSnapshot(std::unique_ptr<const MappedFile> && file);
+
+    public:
+        // Constructor (all the fields are zero-initialized and filled by the caller with mutableData())
+        PopulationSnapshot(ConditionKind conditionKind, std::uint32_t repr, std::uint64_t paramsHash, std::size_t conditionLength, std::size_t size);
+
+        PopulationSnapshot(PopulationSnapshot &&) = default;
+
+        PopulationSnapshot & operator= (PopulationSnapshot &&) = default;
+
+        // Destructor
+        ~PopulationSnapshot() = default;
+
+        // Map the file and read the sections in place
+        // (Throws std::runtime_error if the file cannot be opened or is not a valid snapshot.)
+        static PopulationSnapshot FromFile(const std::string & filename);
+
+        // Read the snapshot written by write() from the current position of the stream
+        // (Throws std::runtime_error if the stream does not have a valid snapshot.)
+        static PopulationSnapshot Read(std::istream & is);
+
+        // Write the whole snapshot (the same bytes as the file) to the stream
+        void write(std::ostream & os) const;
+
+        // Write the snapshot (returns false if the file cannot be opened)
+        bool saveFile(const std::string & filename) const;
+
+        // Size of each element of the section in bytes
+        static std::size_t ElementSize(ConditionKind conditionKind, Section section);
+
+        ConditionKind conditionKind() const noexcept
+        {
+            return static_cast<ConditionKind>(m_header.conditionKind);
+        }
+
+        // Representation of the interval conditions (XCSRRepr; zero for the other kinds)
+        std::uint32_t repr() const noexcept
+        {
+            return m_header.repr;
+        }
+
+        // Hash of the hyperparameters of the system that saved the snapshot
+        std::uint64_t paramsHash() const noexcept
+        {
+            return m_header.paramsHash;
+        }
+
+        std::size_t conditionLength() const noexcept
+        {
+            return static_cast<std::size_t>(m_header.conditionLength);
+        }
+
+        // Number of the classifiers
+        std::size_t size() const noexcept
+        {
+            return static_cast<std::size_t>(m_header.size);
+        }
+
+        bool empty() const noexcept
+        {
+            return m_header.size == 0;
+        }
+
+        // Whether the sections are read from a mapped file (i.e., the snapshot is read-only)
+        bool isMapped() const noexcept
+        {
+            return m_file != nullptr;
+        }
+
+        std::size_t elementCount(Section section) const noexcept
+        {
+            return m_sectionElementCounts[static_cast<std::size_t>(section)];
+        }
+
+        // Pointer to the first element of the section
+        // (Throws std::invalid_argument if the size of T is different from the element size.)
+        template <class T>
+        const T * data(Section section) const
+        {
+            checkElementSize(section, sizeof(T));
+            return reinterpret_cast<const T *>(bytes() + m_sectionOffsets[static_cast<std::size_t>(section)]);
+        }
+
+        // (Throws std::logic_error if the snapshot is mapped.)
+        template <class T>
+        T * mutableData(Section section)
+        {
+            if (m_file)
+            {
+                throw std::logic_error("PopulationSnapshot::mutableData() was called for a mapped snapshot.");
+            }
+            return const_cast<T *>(data<T>(section));
+        }
+    };
+
+    // FNV-1a hash of the hyperparameters stored in PopulationSnapshot
+    //   The values are hashed bit for bit in a fixed order, so the hash does not depend on
+    //   the compiler or the standard library (unlike std::hash).
+    class ParamsHasher
+    {
+    private:
+        std::uint64_t m_hash = 14695981039346656037ULL;
+
+        void addBytes(const void * data, std::size_t size) noexcept;
+
+    public:
+        ParamsHasher & add(std::uint64_t value) noexcept;
+
+        ParamsHasher & add(double value) noexcept;
+
+        ParamsHasher & add(bool value) noexcept
+        {
+            return add(static_cast<std::uint64_t>(value));
+        }
+
+        std::uint64_t hash() const noexcept
+        {
+            return m_hash;
+        }
+    };
+
+}
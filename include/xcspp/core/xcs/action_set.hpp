@@ -13,34 +13,48 @@
 namespace xcspp::xcs
 {
 
-    class ActionSet : public ClassifierPtrSet
+    template <class Condition>
+    class BasicActionSet : public BasicClassifierPtrSet<Condition>
     {
+    protected:
+        using BasicClassifierPtrSet<Condition>::m_set;
+        using BasicClassifierPtrSet<Condition>::m_pParams;
+        using BasicClassifierPtrSet<Condition>::m_availableActions;
+
     private:
-        // UPDATE FITNESS
-        void updateFitness();
+        // UPDATE FITNESS (also reflects the updated parameters in the aggregates of [P])
+        void updateFitness(double accuracySum, BasicPopulation<Condition> & population);
 
         // DO ACTION SET SUBSUMPTION
-        void doSubsumption(Population & population);
+        void doSubsumption(BasicPopulation<Condition> & population);
 
     public:
+        using SituationType = typename Condition::SituationType;
+
         // Constructor
-        ActionSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+        BasicActionSet(const XCSParams *pParams, const AvailableActions & availableActions);
 
-        ActionSet(const MatchSet & matchSet, int action, const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+        BasicActionSet(const BasicMatchSet<Condition> & matchSet, int action, const XCSParams *pParams, const AvailableActions & availableActions);
 
         // Destructor
-        virtual ~ActionSet() = default;
+        virtual ~BasicActionSet() = default;
 
         // GENERATE ACTION SET
-        void generateSet(const MatchSet & matchSet, int action);
+        void generateSet(const BasicMatchSet<Condition> & matchSet, int action);
 
-        void copyTo(ActionSet & dest);
+        // GENERATE ACTION SET (takes the partition of [M] in O(1) if available)
+        void generateSet(BasicMatchSet<Condition> & matchSet, int action);
+
+        void copyTo(BasicActionSet & dest);
 
         // RUN GA (refer to GA::Run() for the latter part)
-        void runGA(const std::vector<int> & situation, Population & population, std::uint64_t timeStamp, Random & random);
+        void runGA(const SituationType & situation, BasicPopulation<Condition> & population, std::uint64_t timeStamp, Random & random);
 
         // UPDATE SET
-        void update(double p, Population & population);
+        void update(double p, BasicPopulation<Condition> & population);
     };
 
+    using ActionSet = BasicActionSet<Condition>;
+    using PackedActionSet = BasicActionSet<PackedCondition>;
+
 }
@@ -4,12 +4,14 @@
 #include <cstdint> // std::uint64_t
 
 #include "condition.hpp"
+#include "packed_condition.hpp"
 #include "xcs_params.hpp"
 
 namespace xcspp::xcs
 {
 
-    struct ConditionActionPair
+    template <class Condition>
+    struct BasicConditionActionPair
     {
     public:
         // C
@@ -23,19 +25,29 @@ namespace xcspp::xcs
         int action;
 
         // Constructor
-        ConditionActionPair(const ConditionActionPair &) = default;
+        BasicConditionActionPair(const BasicConditionActionPair &) = default;
 
-        ConditionActionPair(const Condition & condition, int action);
+        BasicConditionActionPair(BasicConditionActionPair &&) = default;
 
-        ConditionActionPair(Condition && condition, int action);
+        BasicConditionActionPair(const Condition & condition, int action);
+
+        BasicConditionActionPair(Condition && condition, int action);
 
         // Destructor
-        virtual ~ConditionActionPair() = default;
+        virtual ~BasicConditionActionPair() = default;
+
+        BasicConditionActionPair & operator= (const BasicConditionActionPair &) = default;
 
-        friend std::ostream & operator<< (std::ostream & os, const ConditionActionPair & obj);
+        BasicConditionActionPair & operator= (BasicConditionActionPair &&) = default;
+
+        friend std::ostream & operator<< (std::ostream & os, const BasicConditionActionPair & obj)
+        {
+            return os << obj.condition << ':' << obj.action;
+        }
     };
 
-    struct Classifier : ConditionActionPair
+    template <class Condition>
+    struct BasicClassifier : BasicConditionActionPair<Condition>
     {
     public:
         // p
@@ -73,57 +85,93 @@ namespace xcspp::xcs
         std::uint64_t numerosity;
 
         // Constructor
-        Classifier(const Classifier &) = default;
+        BasicClassifier(const BasicClassifier &) = default;
+
+        BasicClassifier(BasicClassifier &&) = default;
 
-        Classifier(const Condition & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
+        BasicClassifier(const Condition & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
-        Classifier(const ConditionActionPair & conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
+        BasicClassifier(const BasicConditionActionPair<Condition> & conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
-        Classifier(ConditionActionPair && conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
+        BasicClassifier(BasicConditionActionPair<Condition> && conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
-        Classifier(const std::vector<int> & situation, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
+        BasicClassifier(const std::vector<int> & situation, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
-        Classifier(const std::string & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
+        BasicClassifier(const std::string & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
         // Destructor
-        virtual ~Classifier() = default;
+        virtual ~BasicClassifier() = default;
+
+        BasicClassifier & operator= (const BasicClassifier &) = default;
+
+        BasicClassifier & operator= (BasicClassifier &&) = default;
 
         double accuracy(double epsilonZero, double alpha, double nu) const;
     };
 
     // Classifier in [P] (have a reference to XCSParams)
-    struct StoredClassifier : Classifier
+    //   [P] keeps running aggregates of numerosity, fitness, actionSetSize and experience, so change
+    //   them through BasicPopulation::modify() while the classifier is in [P]. The other variables
+    //   can be changed directly.
+    template <class Condition>
+    struct BasicStoredClassifier : BasicClassifier<Condition>
     {
     private:
         // XCSParams
-        const XCSParams * const m_pParams;
+        //   (Non-const pointer so that [P] can move classifiers within its contiguous storage)
+        const XCSParams * m_pParams;
+
+        // Accuracy kappa calculated from the current epsilon (see updateAccuracy())
+        double m_accuracy;
 
     public:
         // Constructor
-        StoredClassifier(const StoredClassifier & obj) = default;
+        BasicStoredClassifier(const BasicStoredClassifier & obj) = default;
 
-        StoredClassifier(const Classifier & obj, const XCSParams *pParams);
+        BasicStoredClassifier(BasicStoredClassifier && obj) = default;
 
-        StoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams);
+        BasicStoredClassifier(const BasicClassifier<Condition> & obj, const XCSParams *pParams);
 
-        StoredClassifier(const ConditionActionPair & conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams);
+        BasicStoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams);
 
-        StoredClassifier(ConditionActionPair && conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams);
+        BasicStoredClassifier(const BasicConditionActionPair<Condition> & conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams);
 
-        StoredClassifier(const std::vector<int> & situation, int action, std::uint64_t timeStamp, const XCSParams *pParams);
+        BasicStoredClassifier(BasicConditionActionPair<Condition> && conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams);
 
-        StoredClassifier(const std::string & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams);
+        BasicStoredClassifier(const std::vector<int> & situation, int action, std::uint64_t timeStamp, const XCSParams *pParams);
+
+        BasicStoredClassifier(const std::string & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams);
 
         // Destructor
-        virtual ~StoredClassifier() = default;
+        virtual ~BasicStoredClassifier() = default;
+
+        BasicStoredClassifier & operator= (const BasicStoredClassifier &) = default;
+
+        BasicStoredClassifier & operator= (BasicStoredClassifier &&) = default;
 
         // COULD SUBSUME
         bool isSubsumer() const;
 
         // DOES SUBSUME
-        bool subsumes(const Classifier & cl) const;
+        bool subsumes(const BasicClassifier<Condition> & cl) const;
 
-        double accuracy() const;
+        // Cached accuracy (no std::pow() is called)
+        double accuracy() const noexcept
+        {
+            return m_accuracy;
+        }
+
+        // Recalculate the cached accuracy (call this after changing epsilon)
+        void updateAccuracy();
     };
 
+    using ConditionActionPair = BasicConditionActionPair<Condition>;
+    using Classifier = BasicClassifier<Condition>;
+    using StoredClassifier = BasicStoredClassifier<Condition>;
+
+    // Classifiers with the bit-packed condition (for binary problems)
+    using PackedConditionActionPair = BasicConditionActionPair<PackedCondition>;
+    using PackedClassifier = BasicClassifier<PackedCondition>;
+    using PackedStoredClassifier = BasicStoredClassifier<PackedCondition>;
+
 }
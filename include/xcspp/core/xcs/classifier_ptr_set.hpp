@@ -1,46 +1,111 @@
 #pragma once
 #include <vector>
 #include <unordered_set>
-#include <memory> // std::shared_ptr
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 
 #include "classifier.hpp"
 #include "xcs_params.hpp"
+#include "xcspp/core/available_actions.hpp"
+#include "xcspp/util/slot_map.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcs
 {
 
-    using ClassifierPtr = std::shared_ptr<StoredClassifier>;
+    // Contiguous storage of the classifiers in [P]
+    template <class Condition>
+    using BasicClassifierArena = SlotMap<BasicStoredClassifier<Condition>>;
 
-    class ClassifierPtrSet
+    // Reference to a classifier in [P] (generational index into the arena of [P])
+    //   This does not own the classifier. After the classifier is deleted from [P],
+    //   get() returns nullptr and the other accessors must not be used.
+    template <class Condition>
+    class BasicClassifierPtr
     {
-    protected:
-        std::unordered_set<ClassifierPtr> m_set;
-        const XCSParams * const m_pParams;
-        const std::unordered_set<int> m_availableActions;
+    private:
+        BasicClassifierArena<Condition> *m_pArena;
+        SlotHandle m_handle;
 
     public:
         // Constructor
-        ClassifierPtrSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+        BasicClassifierPtr() noexcept
+            : m_pArena(nullptr)
+        {
+        }
 
-        ClassifierPtrSet(const std::unordered_set<ClassifierPtr> & set, const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+        BasicClassifierPtr(BasicClassifierArena<Condition> *pArena, const SlotHandle & handle) noexcept
+            : m_pArena(pArena)
+            , m_handle(handle)
+        {
+        }
 
-        ClassifierPtrSet(const std::vector<Classifier> & initialClassifiers, const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+        const SlotHandle & handle() const noexcept
+        {
+            return m_handle;
+        }
 
-        // Destructor
-        virtual ~ClassifierPtrSet() = default;
+        // Returns nullptr if the classifier has been deleted from [P]
+        BasicStoredClassifier<Condition> * get() const noexcept
+        {
+            return (m_pArena == nullptr) ? nullptr : m_pArena->get(m_handle);
+        }
 
-        void setClassifiers(const std::vector<Classifier> & classifiers);
+        BasicStoredClassifier<Condition> & operator* () const
+        {
+            return (*m_pArena)[m_handle];
+        }
 
-        void inputCSV(std::istream & is, bool initClassifierVariables = false);
+        BasicStoredClassifier<Condition> * operator-> () const
+        {
+            return &(*m_pArena)[m_handle];
+        }
+
+        friend bool operator== (const BasicClassifierPtr & lhs, const BasicClassifierPtr & rhs) noexcept
+        {
+            return lhs.m_pArena == rhs.m_pArena && lhs.m_handle == rhs.m_handle;
+        }
 
-        void outputCSV(std::ostream & os) const;
+        friend bool operator!= (const BasicClassifierPtr & lhs, const BasicClassifierPtr & rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
 
-        bool loadCSVFile(const std::string & filename, bool initClassifierVariables = false);
+    using ClassifierPtr = BasicClassifierPtr<Condition>;
+    using PackedClassifierPtr = BasicClassifierPtr<PackedCondition>;
 
-        bool saveCSVFile(const std::string & filename) const;
+    // Set of references to classifiers in [P] (base class of [M] and [A])
+    template <class Condition>
+    class BasicClassifierPtrSet
+    {
+    public:
+        using ClassifierType = BasicClassifier<Condition>;
+        using ClassifierPtrType = BasicClassifierPtr<Condition>;
 
-        // --- The functions below are just the wrapper for std::unordered_set<ClassifierPtr> ---
+    protected:
+        std::vector<ClassifierPtrType> m_set;
+        const XCSParams * const m_pParams;
+        // Available action choices (owned by the classifier system)
+        const AvailableActions & m_availableActions;
+
+    public:
+        // Constructor
+        BasicClassifierPtrSet(const XCSParams *pParams, const AvailableActions & availableActions);
+
+        // Destructor
+        virtual ~BasicClassifierPtrSet() = default;
+
+        // Remove the references to the classifiers that have been deleted from [P]
+        // (Returns the numerosity sum of the remaining classifiers, which is calculated in the same pass.)
+        std::uint64_t removeDeletedClassifiers();
+
+        const AvailableActions & availableActions() const noexcept
+        {
+            return m_availableActions;
+        }
+
+        // --- The functions below are just the wrapper for std::vector<ClassifierPtr> ---
 
         auto empty() const noexcept
         {
@@ -72,46 +137,24 @@ namespace xcspp::xcs
             return m_set.cend();
         }
 
-        template <class... Args>
-        auto insert(Args && ... args)
-        {
-            return m_set.insert(std::forward<Args>(args)...);
-        }
-
-        template <class... Args>
-        auto emplace(Args && ... args)
+        // Add the classifier (the caller must make sure that it is not in the set yet)
+        void insert(const ClassifierPtrType & cl)
         {
-            return m_set.emplace(std::forward<Args>(args)...);
+            m_set.push_back(cl);
         }
 
-        template <class... Args>
-        auto erase(Args && ... args)
-        {
-            return m_set.erase(std::forward<Args>(args)...);
-        }
+        // Remove the classifier by moving the last element into its place
+        std::size_t erase(const ClassifierPtrType & cl);
 
         void clear() noexcept
         {
             m_set.clear();
         }
 
-        template <class... Args>
-        void swap(Args && ... args)
-        {
-            m_set.swap(std::forward<Args>(args)...);
-        }
-
-        template <class... Args>
-        auto find(Args && ... args) const
-        {
-            return m_set.find(std::forward<Args>(args)...);
-        }
-
-        template <class... Args>
-        auto count(Args && ... args) const
-        {
-            return m_set.count(std::forward<Args>(args)...);
-        }
+        std::size_t count(const ClassifierPtrType & cl) const;
     };
 
+    using ClassifierPtrSet = BasicClassifierPtrSet<Condition>;
+    using PackedClassifierPtrSet = BasicClassifierPtrSet<PackedCondition>;
+
 }
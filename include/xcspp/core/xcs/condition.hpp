@@ -11,6 +11,10 @@ namespace xcspp::xcs
 
     class Condition
     {
+    public:
+        // The situation type passed to matches() in the match loop
+        using SituationType = std::vector<int>;
+
     private:
         std::vector<Symbol> m_symbols;
 
@@ -0,0 +1,106 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+
+#include "classifier.hpp"
+#include "population.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Discrimination tree over the ternary conditions of a frozen population
+    //   Each internal node tests one position of the situation. The classifiers that specify
+    //   a value at the position go to the child of the value, and the ones with "#" go to the
+    //   wildcard child, so every classifier is stored in exactly one leaf (O(N) memory).
+    //   A query follows the child of the situation value and the wildcard child of each node,
+    //   and tests only the classifiers in the reached leaves, instead of scanning all of [P].
+    //   The index is immutable after construction, so it can be queried from multiple threads.
+    class DecisionIndex
+    {
+    public:
+        static constexpr std::size_t kDefaultLeafSize = 16;
+
+    private:
+        static constexpr std::uint32_t kNoNode = std::numeric_limits<std::uint32_t>::max();
+
+        struct Node
+        {
+            // Tested position (kNoNode for a leaf)
+            std::uint32_t position;
+
+            // Children for the specified values (range in m_edges, sorted by value)
+            std::uint32_t edgeBegin;
+            std::uint32_t edgeEnd;
+
+            // Child for "#" (kNoNode if no classifier has "#" at the position)
+            std::uint32_t wildcardChild;
+
+            // Classifiers of a leaf (range in m_items)
+            std::uint32_t itemBegin;
+            std::uint32_t itemEnd;
+        };
+
+        struct Edge
+        {
+            int value;
+            std::uint32_t child;
+        };
+
+        std::vector<Classifier> m_classifiers;
+
+        std::size_t m_conditionLength;
+
+        std::size_t m_leafSize;
+
+        std::vector<Node> m_nodes;
+
+        std::vector<Edge> m_edges;
+
+        // Positions in m_classifiers grouped by leaf
+        std::vector<std::uint32_t> m_items;
+
+        // Build the subtree for the classifiers and return its node index
+        std::uint32_t build(std::vector<std::uint32_t> & items);
+
+        std::uint32_t makeLeaf(const std::vector<std::uint32_t> & items);
+
+    public:
+        // Constructor
+        //   All the conditions must have the same length (throws std::invalid_argument otherwise).
+        explicit DecisionIndex(const std::vector<Classifier> & classifiers, std::size_t leafSize = kDefaultLeafSize);
+
+        explicit DecisionIndex(const Population & population, std::size_t leafSize = kDefaultLeafSize);
+
+        // Destructor
+        ~DecisionIndex() = default;
+
+        // Positions in classifiers() of the classifiers that match the situation (ascending order)
+        // (The storage of indices is reused. Throws std::invalid_argument if the length of the
+        //  situation is different from the conditions.)
+        void findMatching(const std::vector<int> & situation, std::vector<std::size_t> & indices) const;
+
+        std::vector<std::size_t> findMatching(const std::vector<int> & situation) const;
+
+        // Get all classifiers that match the given situation
+        // (The same classifiers in the same order as XCS::getMatchingClassifiers() for the indexed [P])
+        std::vector<Classifier> getMatchingClassifiers(const std::vector<int> & situation) const;
+
+        const std::vector<Classifier> & classifiers() const noexcept
+        {
+            return m_classifiers;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_classifiers.size();
+        }
+
+        std::size_t nodeCount() const noexcept
+        {
+            return m_nodes.size();
+        }
+    };
+
+}
@@ -15,11 +15,12 @@ namespace xcspp::xcs
     namespace GA
     {
         // RUN GA (refer to ActionSet::runGA() for the former part)
+        template <class Condition>
         void Run(
-            ClassifierPtrSet & actionSet,
-            const std::vector<int> & situation,
-            Population & population,
-            const std::unordered_set<int> & availableActions,
+            BasicClassifierPtrSet<Condition> & actionSet,
+            const typename Condition::SituationType & situation,
+            BasicPopulation<Condition> & population,
+            const AvailableActions & availableActions,
             const XCSParams *pParams,
             Random & random);
     };
@@ -0,0 +1,144 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include <string>
+#include <memory> // std::shared_ptr
+#include <type_traits> // std::is_same_v
+#include <cstdint> // std::int32_t, std::uint8_t, std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "classifier.hpp"
+#include "population.hpp"
+#include "packed_condition_matrix.hpp"
+#include "population_snapshot.hpp"
+#include "xcs_params.hpp"
+#include "xcspp/core/available_actions.hpp"
+#include "xcspp/core/exploit_batch.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Result of BasicInferenceModel::predict()
+    struct InferenceResult
+    {
+        // Greedy action
+        int action;
+
+        // Prediction of the greedy action
+        double prediction;
+
+        // Prediction of each action (same order as BasicInferenceModel::actionChoices())
+        std::vector<double> predictions;
+
+        // Whether no classifier matched the situation
+        bool isMatchSetEmpty;
+    };
+
+    // Frozen snapshot of a trained [P] for serving predictions
+    //   The classifiers are kept in the layout of PopulationSnapshot and never modified, so a
+    //   model can be shared by multiple threads, and predict() can be called from them concurrently.
+    //   FromBinaryFile() maps the snapshot file and reads the sections in place (no copy and no
+    //   parsing), and the copies of a model share the same snapshot.
+    //   The greedy action is the same as exploit() except that ties are broken by the smallest
+    //   action, and the first available action is chosen if no classifier matches.
+    template <class Condition>
+    class BasicInferenceModel
+    {
+    public:
+        using ClassifierType = BasicClassifier<Condition>;
+        using SituationType = typename Condition::SituationType;
+
+    private:
+        // Whether to scan the conditions in the blocked layout with the vectorized kernel
+        static constexpr bool kUsesConditionMatrix = std::is_same_v<Condition, PackedCondition>;
+
+        std::shared_ptr<const PopulationSnapshot> m_snapshot;
+
+        // Sections of m_snapshot
+        const double * m_predictions;
+        const double * m_fitnesses;
+
+        // Condition sections of m_snapshot
+        //   PackedCondition: care/value words in the blocked layout of PackedConditionMatrix
+        //   Condition: cares/values of the symbols (row-major)
+        const std::uint64_t * m_careWords;
+        const std::uint64_t * m_valueWords;
+        const std::uint8_t * m_cares;
+        const std::int32_t * m_values;
+
+        PackedConditionMatrix::Kernel m_kernel;
+
+        AvailableActions m_availableActions;
+
+        // Action of each prediction column, and the column of each classifier
+        std::vector<int> m_actionChoices;
+        std::vector<std::size_t> m_columns;
+
+        double m_initialPrediction;
+
+        // (The snapshot must have the condition kind of Condition.)
+        BasicInferenceModel(std::shared_ptr<const PopulationSnapshot> && snapshot, const std::unordered_set<int> & availableActions, double initialPrediction);
+
+        // DOES MATCH (for the classifier at the position)
+        bool matchesAt(std::size_t idx, const SituationType & situation) const;
+
+        void checkSituationLength(std::size_t length) const;
+
+        InferenceResult predictImpl(const SituationType & situation) const;
+
+    public:
+        // Constructor
+        BasicInferenceModel(const std::vector<ClassifierType> & classifiers, const std::unordered_set<int> & availableActions, double initialPrediction);
+
+        // Take a snapshot of [P] (e.g., BasicXCS::population() after training)
+        BasicInferenceModel(const BasicPopulation<Condition> & population, const std::unordered_set<int> & availableActions, double initialPrediction);
+
+        // Load the classifiers saved by BasicXCS::savePopulationCSVFile()
+        // (Throws std::runtime_error if the file cannot be opened.)
+        static BasicInferenceModel FromCSVFile(const std::string & filename, const std::unordered_set<int> & availableActions, double initialPrediction);
+
+        // Map the snapshot saved by BasicXCS::savePopulationBinaryFile()
+        //   The file is used in place if it was saved with the same condition type (e.g., PackedXCS
+        //   for PackedInferenceModel). Otherwise the conditions are converted into memory.
+        // (Throws std::runtime_error if the file cannot be opened or is not a valid snapshot, and
+        //  std::invalid_argument if it was saved by XCSR.)
+        static BasicInferenceModel FromBinaryFile(const std::string & filename, const std::unordered_set<int> & availableActions, double initialPrediction);
+
+        // Destructor
+        ~BasicInferenceModel() = default;
+
+        // Greedy action and the prediction of each action for the situation (thread-safe)
+        InferenceResult predict(const std::vector<int> & situation) const;
+
+        InferenceResult predict(const PackedSituation & situation) const;
+
+        // Greedy actions for many situations in tiles (thread-safe; refer to ExploitBatch())
+        ExploitBatchResult predictBatch(const std::vector<std::vector<int>> & situations) const;
+
+        // Action of each prediction column of InferenceResult (ascending order)
+        const std::vector<int> & actionChoices() const noexcept
+        {
+            return m_actionChoices;
+        }
+
+        // Copy of the classifiers (reconstructed from the snapshot)
+        std::vector<ClassifierType> classifiers() const
+        {
+            return ReadPopulationSnapshot<Condition>(*m_snapshot);
+        }
+
+        const PopulationSnapshot & snapshot() const noexcept
+        {
+            return *m_snapshot;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_snapshot->size();
+        }
+    };
+
+    using InferenceModel = BasicInferenceModel<Condition>;
+    using PackedInferenceModel = BasicInferenceModel<PackedCondition>;
+
+}
@@ -1,5 +1,7 @@
 ﻿#pragma once
+#include <vector>
 #include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 
 #include "classifier_ptr_set.hpp"
 #include "population.hpp"
@@ -9,26 +11,57 @@
 namespace xcspp::xcs
 {
 
-    class MatchSet : public ClassifierPtrSet
+    class PredictionArray;
+
+    template <class Condition>
+    class BasicMatchSet : public BasicClassifierPtrSet<Condition>
     {
     protected:
+        using BasicClassifierPtrSet<Condition>::m_set;
+        using BasicClassifierPtrSet<Condition>::m_pParams;
+        using BasicClassifierPtrSet<Condition>::m_availableActions;
+
         bool m_isCoveringPerformed;
 
+        // [M] partitioned by action (same order as m_availableActions)
+        //   The classifiers of each action are in the same order as in m_set.
+        //   This is valid only if m_isPartitioned is true.
+        std::vector<std::vector<BasicClassifierPtr<Condition>>> m_setsByAction;
+        bool m_isPartitioned = false;
+
     public:
+        using SituationType = typename Condition::SituationType;
+
         // Constructor
-        using ClassifierPtrSet::ClassifierPtrSet; // inherits all constructors from ClassifierPtrSet
+        using BasicClassifierPtrSet<Condition>::BasicClassifierPtrSet; // inherits all constructors from BasicClassifierPtrSet
 
-        MatchSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, const XCSParams *pParams, const std::unordered_set<int> & availableActions, Random & random);
+        BasicMatchSet(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, const XCSParams *pParams, const AvailableActions & availableActions, Random & random);
 
         // Destructor
-        virtual ~MatchSet() = default;
+        virtual ~BasicMatchSet() = default;
 
         // GENERATE MATCH SET
-        void generateSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, Random & random);
+        void generateSet(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, Random & random);
+
+        // GENERATE MATCH SET and PREDICTION ARRAY in a single scan of [P]
+        void generateSet(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, Random & random, PredictionArray & predictionArray);
 
         // Get if covering is performed in the previous match set generation
         // (Call this function after constructor or generateSet())
         bool isCoveringPerformed() const;
+
+        // Move the classifiers that propose the action to dest in O(1) (the storage is swapped)
+        // (Returns false if [M] has not been partitioned by action in generateSet(). The partition of
+        //  the action is consumed, but [M] itself is not changed.)
+        bool takeSetForAction(int action, std::vector<BasicClassifierPtr<Condition>> & dest);
+
+    private:
+        // GENERATE MATCH SET (calls accumulator.accumulate(cl) for each classifier added to [M])
+        template <class Accumulator>
+        void generateSetImpl(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, Random & random, Accumulator & accumulator);
     };
 
+    using MatchSet = BasicMatchSet<Condition>;
+    using PackedMatchSet = BasicMatchSet<PackedCondition>;
+
 }
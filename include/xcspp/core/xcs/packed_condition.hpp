@@ -0,0 +1,130 @@
+#pragma once
+#include <ostream> // operator<<
+#include <string>
+#include <vector>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "symbol.hpp"
+#include "packed_situation.hpp"
+
+namespace xcspp::xcs
+{
+
+    // The bit-packed ternary condition for binary problems
+    //   Each symbol ('0', '1' or '#') is stored as one bit of the care mask and one bit of the value mask.
+    //   A bit of the care mask is set if the symbol is '0' or '1', and the corresponding bit of the
+    //   value mask holds its value. Value bits are always kept zero where the care bit is zero, and
+    //   so are all bits beyond size(), so that two equal conditions have identical words.
+    class PackedCondition
+    {
+    public:
+        static constexpr std::size_t kWordBits = PackedSituation::kWordBits;
+
+        // The situation type passed to matches() in the match loop
+        using SituationType = PackedSituation;
+
+    private:
+        std::size_t m_size;
+        std::vector<std::uint64_t> m_careMask;
+        std::vector<std::uint64_t> m_valueMask;
+
+    public:
+        // Constructor
+        PackedCondition();
+
+        PackedCondition(const std::vector<Symbol> & symbols);
+
+        PackedCondition(const std::vector<int> & symbols);
+
+        explicit PackedCondition(const std::string & symbols);
+
+        // Constructor (all symbols are specified by the situation; used for covering)
+        explicit PackedCondition(const PackedSituation & situation);
+
+        // Destructor
+        ~PackedCondition() = default;
+
+        std::string toString() const;
+
+        // DOES MATCH
+        bool matches(const std::vector<int> & situation) const;
+
+        // DOES MATCH (word by word)
+        bool matches(const PackedSituation & situation) const
+        {
+            for (std::size_t w = 0; w < m_careMask.size(); ++w)
+            {
+                if ((situation.word(w) ^ m_valueMask[w]) & m_careMask[w])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // IS MORE GENERAL
+        bool isMoreGeneral(const PackedCondition & cond) const;
+
+        std::size_t dontCareCount() const;
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        std::size_t wordCount() const noexcept
+        {
+            return m_careMask.size();
+        }
+
+        std::uint64_t careMask(std::size_t wordIdx) const
+        {
+            return m_careMask[wordIdx];
+        }
+
+        std::uint64_t valueMask(std::size_t wordIdx) const
+        {
+            return m_valueMask[wordIdx];
+        }
+
+        bool isDontCare(std::size_t idx) const;
+
+        // Returns the symbol at the position (by value, since symbols are not stored as objects)
+        Symbol operator[] (std::size_t idx) const;
+
+        Symbol at(std::size_t idx) const;
+
+        void setSymbol(std::size_t idx, const Symbol & symbol);
+
+        // --- Word-level operations (bits beyond size() in the mask must be zero) ---
+
+        // Exchange the symbols selected by the mask with those of the other condition
+        void swapMasked(PackedCondition & other, std::size_t wordIdx, std::uint64_t mask);
+
+        // Set the symbols selected by the mask to "#"
+        void setToDontCareMasked(std::size_t wordIdx, std::uint64_t mask);
+
+        // Toggle the symbols selected by the mask between "#" and the value in situationBits
+        // (i.e., "0"/"1" becomes "#", and "#" becomes the corresponding bit of situationBits)
+        void toggleMasked(std::size_t wordIdx, std::uint64_t mask, std::uint64_t situationBits);
+
+        friend std::ostream & operator<< (std::ostream & os, const PackedCondition & obj);
+
+        friend bool operator== (const PackedCondition & lhs, const PackedCondition & rhs)
+        {
+            return lhs.m_size == rhs.m_size && lhs.m_careMask == rhs.m_careMask && lhs.m_valueMask == rhs.m_valueMask;
+        }
+
+        friend bool operator!= (const PackedCondition & lhs, const PackedCondition & rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+}
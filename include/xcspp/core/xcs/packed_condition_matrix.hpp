@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "packed_condition.hpp"
+#include "packed_situation.hpp"
+#include "xcspp/util/simd.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Contiguous storage of many PackedConditions for scanning the whole population at once
+    //   The care/value words are stored in blocks of kBlockSize rows (structure-of-arrays within
+    //   each block), so that one SIMD instruction can test kBlockSize classifiers for a word.
+    //   All rows must have the same length.
+    class PackedConditionMatrix
+    {
+    public:
+        static constexpr std::size_t kBlockSize = 4;
+
+        // Population-scan kernel
+        using Kernel = SIMDKernel;
+
+    private:
+        std::size_t m_wordCount;
+        std::size_t m_conditionLength;
+        std::size_t m_size;
+        std::vector<std::uint64_t> m_careMask;
+        std::vector<std::uint64_t> m_valueMask;
+        Kernel m_kernel;
+
+        std::size_t wordIndex(std::size_t rowIdx, std::size_t wordIdx) const noexcept
+        {
+            return WordIndex(rowIdx, wordIdx, m_wordCount);
+        }
+
+    public:
+        // Constructor (selects the fastest kernel supported by the CPU)
+        PackedConditionMatrix();
+
+        // Destructor
+        ~PackedConditionMatrix() = default;
+
+        // Returns the fastest kernel supported by the CPU
+        static Kernel DetectKernel()
+        {
+            return DetectSIMDKernel();
+        }
+
+        static bool IsKernelSupported(Kernel kernel)
+        {
+            return IsSIMDKernelSupported(kernel);
+        }
+
+        Kernel kernel() const noexcept
+        {
+            return m_kernel;
+        }
+
+        // Select the kernel explicitly (throws std::invalid_argument if it is not supported by the CPU)
+        void setKernel(Kernel kernel);
+
+        std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        // Append the condition as the last row
+        void pushBack(const PackedCondition & condition);
+
+        // Overwrite the row
+        void set(std::size_t rowIdx, const PackedCondition & condition);
+
+        // Remove the row by moving the last row into its place
+        void swapRemove(std::size_t rowIdx);
+
+        void clear() noexcept;
+
+        // DOES MATCH (for all rows)
+        //   Bit (i % 64) of bitmap[i / 64] is set if the i-th row matches the situation.
+        void match(const PackedSituation & situation, std::vector<std::uint64_t> & bitmap) const;
+
+        // --- The functions below work on the blocked layout stored outside of this class ---
+        //   (e.g., the condition sections of a mapped PopulationSnapshot)
+
+        // Position of the word of the row in the care/value arrays
+        static std::size_t WordIndex(std::size_t rowIdx, std::size_t wordIdx, std::size_t wordCount) noexcept
+        {
+            return (rowIdx / kBlockSize * wordCount + wordIdx) * kBlockSize + rowIdx % kBlockSize;
+        }
+
+        // Number of the words in each of the care/value arrays (the rows are padded to whole blocks)
+        static std::size_t StorageWordCount(std::size_t rowCount, std::size_t wordCount) noexcept
+        {
+            return (rowCount + kBlockSize - 1) / kBlockSize * kBlockSize * wordCount;
+        }
+
+        // DOES MATCH (for the rows in the arrays; the padding rows must be all zero)
+        static void Match(const std::uint64_t * careMask, const std::uint64_t * valueMask, std::size_t wordCount, std::size_t conditionLength, std::size_t rowCount, Kernel kernel, const PackedSituation & situation, std::vector<std::uint64_t> & bitmap);
+    };
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "xcspp/util/span.hpp"
+
+namespace xcspp::xcs
+{
+
+    // The bit-packed binary situation
+    //   The bit layout is the same as that of PackedCondition, so a condition
+    //   can be matched against the situation word by word.
+    //   (Bits beyond size() are always kept zero.)
+    class PackedSituation
+    {
+    public:
+        static constexpr std::size_t kWordBits = 64;
+
+    private:
+        std::size_t m_size;
+        std::vector<std::uint64_t> m_words;
+
+    public:
+        // Constructor
+        PackedSituation();
+
+        explicit PackedSituation(std::size_t size);
+
+        PackedSituation(const std::vector<int> & situation);
+
+        // Destructor
+        ~PackedSituation() = default;
+
+        // Overwrite with the given situation (reuses the allocated words)
+        void assign(Span<const int> situation);
+
+        std::vector<int> toVector() const;
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        std::size_t wordCount() const noexcept
+        {
+            return m_words.size();
+        }
+
+        std::uint64_t word(std::size_t wordIdx) const
+        {
+            return m_words[wordIdx];
+        }
+
+        int operator[] (std::size_t idx) const
+        {
+            return static_cast<int>((m_words[idx / kWordBits] >> (idx % kWordBits)) & 1);
+        }
+
+        void set(std::size_t idx, int value)
+        {
+            const std::uint64_t bit = std::uint64_t{ 1 } << (idx % kWordBits);
+            if (value)
+            {
+                m_words[idx / kWordBits] |= bit;
+            }
+            else
+            {
+                m_words[idx / kWordBits] &= ~bit;
+            }
+        }
+
+        friend bool operator== (const PackedSituation & lhs, const PackedSituation & rhs)
+        {
+            return lhs.m_size == rhs.m_size && lhs.m_words == rhs.m_words;
+        }
+
+        friend bool operator!= (const PackedSituation & lhs, const PackedSituation & rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+}
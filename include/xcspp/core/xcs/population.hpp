@@ -1,24 +1,345 @@
 #pragma once
+#include <vector>
+#include <set>
+#include <unordered_set>
+#include <unordered_map>
+#include <utility> // std::pair
+#include <string>
+#include <iostream>
+#include <type_traits> // std::is_same_v
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "classifier.hpp"
 #include "classifier_ptr_set.hpp"
+#include "packed_condition_matrix.hpp"
+#include "xcspp/core/match_set_cache.hpp"
+#include "xcs_params.hpp"
+#include "xcspp/util/slot_map.hpp"
+#include "xcspp/util/sum_tree.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcs
 {
 
-    class Population : public ClassifierPtrSet
+    // [P]
+    //   The classifiers are stored contiguously in a slot map, and [M]/[A] refer to them
+    //   with generational indices (ClassifierPtr). Deleting a classifier is O(1) since the
+    //   last classifier is moved into its place.
+    template <class Condition>
+    class BasicPopulation
     {
+    public:
+        using ClassifierType = BasicClassifier<Condition>;
+        using StoredClassifierType = BasicStoredClassifier<Condition>;
+        using ClassifierPtrType = BasicClassifierPtr<Condition>;
+        using SituationType = typename Condition::SituationType;
+
+    protected:
+        // Whether to keep the conditions in a contiguous matrix for the vectorized population scan
+        static constexpr bool kUsesConditionMatrix = std::is_same_v<Condition, PackedCondition>;
+
+        const XCSParams * const m_pParams;
+        const std::unordered_set<int> m_availableActions;
+
+        BasicClassifierArena<Condition> m_arena;
+
+        // Conditions in the same order as m_arena (rows are swap-removed together with the arena)
+        // (This is used only if kUsesConditionMatrix is true)
+        PackedConditionMatrix m_conditionMatrix;
+
+        // Positions of the matching classifiers for recently presented situations
+        // (enabled only if m_pParams->matchSetCacheCapacity is not zero)
+        MatchSetCache<SituationType> m_matchSetCache;
+
+        // Bitmap of the matching classifiers, reused between the scans of [P] to avoid allocations
+        // (Only the non-const scans use this, so the const member functions can be called concurrently.)
+        std::vector<std::uint64_t> m_matchBitmap;
+
+        // Hash index of the classifiers keyed on the hash of (condition, action)
+        // (Classifiers with colliding hashes share a key, so the condition and action must be compared.)
+        std::unordered_multimap<std::size_t, SlotHandle> m_index;
+
+        // Values of each classifier last reflected in the running aggregates (same order as m_arena)
+        struct AggregateEntry
+        {
+            std::uint64_t numerosity;
+            double fitness;
+            bool isExperienced;
+        };
+        std::vector<AggregateEntry> m_aggregateEntries;
+
+        // Running totals of numerosity and fitness in [P]
+        std::uint64_t m_numerositySum;
+        double m_fitnessSum;
+
+        // Deletion votes without the fitness factor (actionSetSize * numerosity; same order as m_arena)
+        SumTree<double> m_baseVoteTree;
+
+        // Experienced classifiers (exp >= theta_del) ordered by fitness per numerosity, with their positions
+        // (Only the ones below delta * averageFitness get the additional deletion vote.)
+        std::set<std::pair<double, std::size_t>> m_experiencedClassifiers;
+
+        // Number of incremental updates since the floating-point aggregates were recomputed
+        std::size_t m_aggregateUpdateCount;
+
+        // Remove the classifier at the position in begin()...end()
+        void eraseAt(std::size_t idx);
+
+        // Set the classifier variables to the initial values (for loading with initClassifierVariables)
+        void resetClassifierVariables(std::vector<ClassifierType> & classifiers) const;
+
+        // Positions of the classifiers that match the situation (scans [P] only if the situation is not cached)
+        const std::vector<std::size_t> & cachedMatchingIndices(const SituationType & situation);
+
+        // --- The functions below keep the running aggregates consistent with m_arena ---
+
+        void pushBackAggregates(const StoredClassifierType & cl);
+
+        void updateAggregatesAt(std::size_t idx);
+
+        void swapRemoveAggregates(std::size_t idx);
+
+        void recomputeAggregates();
+
+        // Select the classifier to delete by roulette-wheel selection on deletion votes in O(log N + K)
+        // (K is the number of the experienced classifiers whose fitness is below delta * averageFitness)
+        std::size_t selectDeletionTarget(Random & random) const;
+
+        // Calls validateIndex() and validateAggregates() in debug builds
+        void validateInDebugBuild() const;
+
+        // Returns the classifier that has the same condition and action (nullptr if not found)
+        StoredClassifierType * findSameConditionAction(const BasicConditionActionPair<Condition> & cl);
+
+        // Calls func(idx) for the position of each classifier that matches the situation
+        // (matchBitmap is the buffer of the SIMD scan; its contents are overwritten.)
+        template <class Function>
+        void forEachMatchingIndex(const SituationType & situation, std::vector<std::uint64_t> & matchBitmap, Function func) const
+        {
+            if constexpr (kUsesConditionMatrix)
+            {
+                m_conditionMatrix.match(situation, matchBitmap);
+                ForEachSetBit(matchBitmap, func);
+            }
+            else
+            {
+                std::size_t idx = 0;
+                for (const auto & cl : m_arena)
+                {
+                    if (cl.condition.matches(situation))
+                    {
+                        func(idx);
+                    }
+                    ++idx;
+                }
+            }
+        }
+
     public:
         // Constructor
-        using ClassifierPtrSet::ClassifierPtrSet;
+        BasicPopulation(const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+
+        BasicPopulation(const std::vector<ClassifierType> & initialClassifiers, const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+
+        // ClassifierPtrs refer to the arena of this object, so [P] is neither copyable nor movable
+        BasicPopulation(const BasicPopulation &) = delete;
+
+        BasicPopulation & operator= (const BasicPopulation &) = delete;
 
         // Destructor
-        virtual ~Population() = default;
+        virtual ~BasicPopulation() = default;
+
+        void setClassifiers(const std::vector<ClassifierType> & classifiers);
+
+        void inputCSV(std::istream & is, bool initClassifierVariables = false);
+
+        void outputCSV(std::ostream & os) const;
+
+        bool loadCSVFile(const std::string & filename, bool initClassifierVariables = false);
+
+        bool saveCSVFile(const std::string & filename) const;
+
+        // Load the classifiers from a binary snapshot saved by saveBinaryFile()
+        // (Returns false if the file cannot be opened. Throws std::runtime_error if it is not a valid
+        //  snapshot, and std::invalid_argument if it has the conditions of another system.)
+        bool loadBinaryFile(const std::string & filename, bool initClassifierVariables = false);
+
+        // Save the classifiers as a binary snapshot (refer to PopulationSnapshot)
+        bool saveBinaryFile(const std::string & filename) const;
+
+        // Write the classifiers and the running aggregates for a checkpoint
+        // (The aggregates are written as they are, including the rounding errors of the
+        //  incremental updates, so the deletion votes after inputCheckpoint() are exactly the same.)
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Read the classifiers and the running aggregates written by outputCheckpoint()
+        // (Throws std::runtime_error if the stream does not have a valid checkpoint.)
+        void inputCheckpoint(std::istream & is);
+
+        // --- The functions below iterate over the classifiers in contiguous storage ---
+
+        bool empty() const noexcept
+        {
+            return m_arena.empty();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_arena.size();
+        }
+
+        auto begin() noexcept
+        {
+            return m_arena.begin();
+        }
+
+        auto begin() const noexcept
+        {
+            return m_arena.begin();
+        }
+
+        auto end() noexcept
+        {
+            return m_arena.end();
+        }
+
+        auto end() const noexcept
+        {
+            return m_arena.end();
+        }
+
+        // Reference to the classifier at the position in begin()...end()
+        // (The position may change after insert() or erase(), but the reference does not.)
+        ClassifierPtrType ptrAt(std::size_t idx)
+        {
+            return ClassifierPtrType(&m_arena, m_arena.handleAt(idx));
+        }
+
+        bool contains(const ClassifierPtrType & cl) const;
+
+        // Position of the classifier in begin()...end() (the classifier must be in [P])
+        std::size_t indexOf(const ClassifierPtrType & cl) const
+        {
+            return m_arena.denseIndex(cl.handle());
+        }
+
+        ClassifierPtrType insert(const StoredClassifierType & cl);
+
+        ClassifierPtrType insert(StoredClassifierType && cl);
+
+        // Remove the classifier (O(1); returns the number of removed classifiers)
+        std::size_t erase(const ClassifierPtrType & cl);
+
+        void clear();
+
+        // Write access to a classifier in [P] that reflects the changes of its numerosity, fitness,
+        // actionSetSize and experience in the running aggregates when it goes out of scope
+        // (Do not insert or erase classifiers while it is alive, since they may move the classifier.)
+        class ScopedModifier
+        {
+        private:
+            BasicPopulation & m_population;
+
+            const std::size_t m_idx;
+
+        public:
+            ScopedModifier(BasicPopulation & population, std::size_t idx) noexcept
+                : m_population(population)
+                , m_idx(idx)
+            {
+            }
+
+            ScopedModifier(const ScopedModifier &) = delete;
+
+            ScopedModifier & operator= (const ScopedModifier &) = delete;
+
+            ~ScopedModifier()
+            {
+                m_population.updateAggregatesAt(m_idx);
+            }
+
+            StoredClassifierType & operator*() const
+            {
+                return m_population.m_arena.begin()[m_idx];
+            }
+
+            StoredClassifierType * operator->() const
+            {
+                return &**this;
+            }
+        };
+
+        // Start modifying the classifier in [P] (e.g. "population.modify(*cl)->fitness = 1.0;")
+        ScopedModifier modify(const StoredClassifierType & cl);
+
+        std::uint64_t numerositySum() const noexcept
+        {
+            return m_numerositySum;
+        }
+
+        double fitnessSum() const noexcept
+        {
+            return m_fitnessSum;
+        }
+
+        // Select the population-scan kernel (only for PackedCondition)
+        void setMatchKernel(PackedConditionMatrix::Kernel kernel);
+
+        // Calls func(cl) with the ClassifierPtr of each classifier that matches the situation
+        // (For PackedCondition, the whole population is scanned at once with the SIMD kernel.
+        //  The scan is skipped if the situation is in the match set cache. The order is the
+        //  same in both cases. func must not insert or erase classifiers.)
+        template <class Function>
+        void forEachMatchingClassifier(const SituationType & situation, Function func)
+        {
+            if (m_matchSetCache.enabled())
+            {
+                for (const std::size_t idx : cachedMatchingIndices(situation))
+                {
+                    func(ptrAt(idx));
+                }
+            }
+            else
+            {
+                forEachMatchingIndex(situation, m_matchBitmap, [&](std::size_t idx) { func(ptrAt(idx)); });
+            }
+        }
+
+        // Calls func(cl) with the const reference to each classifier that matches the situation
+        // (This uses its own buffer instead of m_matchBitmap so that it can be called concurrently.)
+        template <class Function>
+        void forEachMatchingClassifier(const SituationType & situation, Function func) const
+        {
+            std::vector<std::uint64_t> matchBitmap;
+            const auto it = m_arena.begin();
+            forEachMatchingIndex(situation, matchBitmap, [&](std::size_t idx) { func(it[idx]); });
+        }
 
         // INSERT IN POPULATION
-        void insertOrIncrementNumerosity(const ClassifierPtr & cl);
+        //   Duplicates are detected in expected O(1) time with the hash index.
+        void insertOrIncrementNumerosity(const ClassifierType & cl);
+
+        // Throws std::logic_error if the hash index is not consistent with the classifiers
+        // (In debug builds, this is called at the end of setClassifiers(), erase(),
+        //  insertOrIncrementNumerosity() and deleteExtraClassifiers().)
+        void validateIndex() const;
+
+        // Throws std::logic_error if the running aggregates are not consistent with the classifiers
+        // (In debug builds, this is called together with validateIndex().)
+        void validateAggregates() const;
 
         // DELETE FROM POPULATION
         bool deleteExtraClassifiers(Random & random);
+
+        // Number of the lookups in the match set cache and the ones that hit (since construction)
+        const MatchSetCacheStatistics & matchSetCacheStatistics() const noexcept
+        {
+            return m_matchSetCache.statistics();
+        }
     };
 
+    using Population = BasicPopulation<Condition>;
+    using PackedPopulation = BasicPopulation<PackedCondition>;
+
 }
@@ -0,0 +1,107 @@
+#pragma once
+#include <vector>
+#include <iterator> // std::begin
+#include <type_traits> // std::is_same_v, std::decay_t
+#include <stdexcept>
+#include <cstdint> // std::int32_t, std::uint8_t, std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "classifier.hpp"
+#include "packed_condition_matrix.hpp"
+#include "xcs_params.hpp"
+#include "xcspp/core/population_snapshot.hpp"
+
+namespace xcspp::xcs
+{
+
+    static_assert(PopulationSnapshot::kPackedBlockSize == PackedConditionMatrix::kBlockSize);
+
+    // Condition kind of the snapshot written from the classifiers with the condition
+    template <class Condition>
+    inline constexpr PopulationSnapshot::ConditionKind kSnapshotConditionKind =
+        std::is_same_v<Condition, PackedCondition> ? PopulationSnapshot::ConditionKind::kPackedTernary : PopulationSnapshot::ConditionKind::kTernary;
+
+    // Hash of the hyperparameters stored in the snapshot (the options that do not affect learning are excluded)
+    std::uint64_t HashParams(const XCSParams & params);
+
+    // Snapshot of the classifiers (a range of BasicClassifier or BasicStoredClassifier, e.g., [P])
+    // (All the conditions must have the same length. Throws std::invalid_argument otherwise.)
+    template <class ClassifierRange>
+    PopulationSnapshot MakePopulationSnapshot(const ClassifierRange & classifiers, std::uint64_t paramsHash)
+    {
+        using Condition = std::decay_t<decltype(std::begin(classifiers)->condition)>;
+        using Section = PopulationSnapshot::Section;
+
+        const std::size_t size = classifiers.size();
+        const std::size_t conditionLength = (size > 0) ? std::begin(classifiers)->condition.size() : 0;
+        PopulationSnapshot snapshot(kSnapshotConditionKind<Condition>, 0, paramsHash, conditionLength, size);
+
+        auto * const actions = snapshot.mutableData<std::int32_t>(Section::kAction);
+        auto * const predictions = snapshot.mutableData<double>(Section::kPrediction);
+        auto * const epsilons = snapshot.mutableData<double>(Section::kEpsilon);
+        auto * const fitnesses = snapshot.mutableData<double>(Section::kFitness);
+        auto * const experiences = snapshot.mutableData<std::uint64_t>(Section::kExperience);
+        auto * const timeStamps = snapshot.mutableData<std::uint64_t>(Section::kTimeStamp);
+        auto * const actionSetSizes = snapshot.mutableData<double>(Section::kActionSetSize);
+        auto * const numerosities = snapshot.mutableData<std::uint64_t>(Section::kNumerosity);
+
+        std::size_t idx = 0;
+        for (const auto & cl : classifiers)
+        {
+            if (cl.condition.size() != conditionLength)
+            {
+                throw std::invalid_argument("MakePopulationSnapshot() received conditions with different lengths.");
+            }
+
+            actions[idx] = cl.action;
+            predictions[idx] = cl.prediction;
+            epsilons[idx] = cl.epsilon;
+            fitnesses[idx] = cl.fitness;
+            experiences[idx] = cl.experience;
+            timeStamps[idx] = cl.timeStamp;
+            actionSetSizes[idx] = cl.actionSetSize;
+            numerosities[idx] = cl.numerosity;
+            ++idx;
+        }
+
+        if constexpr (std::is_same_v<Condition, PackedCondition>)
+        {
+            // The words of the padding rows are left zero
+            auto * const careWords = snapshot.mutableData<std::uint64_t>(Section::kConditionCare);
+            auto * const valueWords = snapshot.mutableData<std::uint64_t>(Section::kConditionValue);
+            const std::size_t wordCount = (conditionLength + 63) / 64;
+            idx = 0;
+            for (const auto & cl : classifiers)
+            {
+                for (std::size_t w = 0; w < wordCount; ++w)
+                {
+                    careWords[PackedConditionMatrix::WordIndex(idx, w, wordCount)] = cl.condition.careMask(w);
+                    valueWords[PackedConditionMatrix::WordIndex(idx, w, wordCount)] = cl.condition.valueMask(w);
+                }
+                ++idx;
+            }
+        }
+        else
+        {
+            auto * cares = snapshot.mutableData<std::uint8_t>(Section::kConditionCare);
+            auto * values = snapshot.mutableData<std::int32_t>(Section::kConditionValue);
+            for (const auto & cl : classifiers)
+            {
+                for (const auto & symbol : cl.condition)
+                {
+                    *cares++ = !symbol.isDontCare();
+                    *values++ = symbol.isDontCare() ? 0 : symbol.value();
+                }
+            }
+        }
+
+        return snapshot;
+    }
+
+    // Classifiers in the snapshot
+    // (The conditions of the other ternary kind are converted. Throws std::invalid_argument
+    //  if the snapshot does not have ternary conditions.)
+    template <class Condition>
+    std::vector<BasicClassifier<Condition>> ReadPopulationSnapshot(const PopulationSnapshot & snapshot);
+
+}
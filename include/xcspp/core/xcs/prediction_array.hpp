@@ -1,9 +1,10 @@
 #pragma once
 #include <vector>
-#include <unordered_map>
+#include <cstddef> // std::size_t
 
 #include "match_set.hpp"
 #include "xcs_params.hpp"
+#include "xcspp/core/available_actions.hpp"
 
 namespace xcspp::xcs
 {
@@ -13,8 +14,21 @@ namespace xcspp::xcs
     private:
         const XCSParams * const m_pParams;
 
-        // PA (Prediction Array)
-        std::unordered_map<int, double> m_pa;
+        const AvailableActions * const m_pAvailableActions;
+
+        // Action of each dense id
+        //   The ids of the available actions are their positions in AvailableActions,
+        //   and the other actions found in [M] (if any) are appended after them.
+        std::vector<int> m_actions;
+
+        // PA (Prediction Array) and FSA (Fitness Sum Array) indexed by dense id
+        // (The storage is reused across steps, and only the entries of m_paActionIds are valid.)
+        std::vector<double> m_pa;
+        std::vector<double> m_fsa;
+
+        // Dense ids of the actions in [M] (in order of first appearance)
+        std::vector<std::size_t> m_paActionIds;
+        std::vector<bool> m_isInPA;
 
         // Array of PA keys (for random action selection)
         std::vector<int> m_paActions;
@@ -25,13 +39,58 @@ namespace xcspp::xcs
         // The best actions of PA
         std::vector<int> m_maxPAActions;
 
+        // Returns AvailableActions::npos if the action has no dense id
+        std::size_t findDenseId(int action) const noexcept;
+
+        // Assigns a new dense id if the action has none
+        std::size_t denseIdOf(int action);
+
     public:
+        // Constructor (empty prediction array)
+        //   Use generate(), or clear(), accumulate() and finalize() to fill it.
+        PredictionArray(const AvailableActions & availableActions, const XCSParams *pParams);
+
         // GENERATE PREDICTION ARRAY
-        PredictionArray(const MatchSet & matchSet, const XCSParams *pParams);
+        template <class Condition>
+        PredictionArray(const BasicMatchSet<Condition> & matchSet, const XCSParams *pParams);
 
         // Destructor
         ~PredictionArray() = default;
 
+        // GENERATE PREDICTION ARRAY (reusing the storage)
+        template <class Condition>
+        void generate(const BasicMatchSet<Condition> & matchSet);
+
+        // --- The functions below build the prediction array while scanning [P] for [M] ---
+
+        void clear();
+
+        // Add the classifier in [M] to the fitness-weighted sums
+        template <class Condition>
+        void accumulate(const BasicClassifier<Condition> & cl)
+        {
+            const std::size_t id = denseIdOf(cl.action);
+            if (!m_isInPA[id])
+            {
+                m_isInPA[id] = true;
+                m_paActionIds.push_back(id);
+                m_paActions.push_back(cl.action);
+                m_pa[id] = 0.0;
+                m_fsa[id] = 0.0;
+            }
+
+            m_pa[id] += cl.prediction * cl.fitness;
+            m_fsa[id] += cl.fitness;
+        }
+
+        // Divide the sums by the fitness sums and find the best actions
+        void finalize();
+
+        bool empty() const noexcept
+        {
+            return m_paActions.empty();
+        }
+
         double max() const;
 
         double predictionFor(int action) const;
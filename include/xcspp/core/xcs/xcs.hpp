@@ -1,20 +1,27 @@
 #pragma once
-#include <iosfwd> // std::ostream
+#include <iosfwd> // std::istream, std::ostream
 #include <vector>
-#include <cstdint> // std::uint64_t
+#include <cstdint> // std::uint32_t, std::uint64_t
 #include <cstddef> // std::size_t
 
 #include "xcspp/core/iclassifier_system.hpp"
+#include "xcspp/core/available_actions.hpp"
 #include "xcs_params.hpp"
 #include "population.hpp"
 #include "action_set.hpp"
 #include "prediction_array.hpp"
+#include "packed_situation.hpp"
 
 namespace xcspp::xcs
 {
 
-    class XCS : public IClassifierSystem
+    template <class Condition>
+    class BasicXCS : public IClassifierSystem
     {
+    public:
+        // The situation type used in the match loop (std::vector<int> or PackedSituation)
+        using SituationType = typename Condition::SituationType;
+
     private:
         // Random utility instance
         Random m_random;
@@ -22,22 +29,27 @@ namespace xcspp::xcs
         // Hyperparameters
         XCSParams m_params;
 
+        // Available action choices
+        //   (Declared before [A] and [A]_-1 since they refer to this.)
+        const AvailableActions m_availableActions;
+
         // [P]
         //   The population [P] consists of all classifier that exist in XCS at any time.
-        Population m_population;
+        BasicPopulation<Condition> m_population;
 
         // [A]
         //   The action set [A] is formed out of the current [M].
         //   It includes all classifiers of [M] that propose the executed action.
-        ActionSet m_actionSet;
+        BasicActionSet<Condition> m_actionSet;
 
         // [A]_-1
         //   The previous action set [A]_-1 is the action set that was active in the last
         //   execution cycle.
-        ActionSet m_prevActionSet;
+        BasicActionSet<Condition> m_prevActionSet;
 
-        // Available action choices
-        const std::unordered_set<int> m_availableActions;
+        // [M] and PA of the current step (the storage is reused across steps)
+        BasicMatchSet<Condition> m_matchSet;
+        PredictionArray m_predictionArray;
 
         std::uint64_t m_timeStamp;
 
@@ -45,11 +57,16 @@ namespace xcspp::xcs
         double m_prevReward;
         bool m_isPrevModeExplore;
 
-        std::vector<int> m_prevSituation;
+        SituationType m_prevSituation;
+
+        // Situation of the current step
+        //   This is swapped with m_prevSituation at the end of the step, so neither buffer is
+        //   reallocated once it has grown to the situation size.
+        SituationType m_situation;
 
         // Prediction value of the previous action decision (just for logging)
         double m_prediction;
-        std::unordered_map<int, double> m_predictions;
+        std::vector<double> m_predictions; // same order as m_availableActions
 
         // Covering occurrence of the previous action decision (just for logging)
         bool m_isCoveringPerformed;
@@ -57,16 +74,30 @@ namespace xcspp::xcs
         // Set system timestamp to the same as the latest classifier in [P]
         void syncTimeStampWithPopulation();
 
+        // Store the prediction of each available action (just for logging)
+        void storePredictions();
+
+        // Run explore() or exploit() for m_situation
+        int exploreImpl();
+
+        int exploitImpl(bool update);
+
     public:
         // Constructor
-        XCS(const std::unordered_set<int> & availableActions, const XCSParams & params);
+        BasicXCS(const std::unordered_set<int> & availableActions, const XCSParams & params);
 
         // Destructor
-        ~XCS() = default;
+        ~BasicXCS() = default;
 
         // Run with exploration
         int explore(const std::vector<int> & situation);
 
+        // Run with exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        int explore(Span<const int> situation);
+
+        // Run with exploration (with the packed situation built once per step)
+        int explore(const PackedSituation & situation);
+
         // Feedback reward to system
         void reward(double value, bool isEndOfProblem = true);
 
@@ -74,6 +105,18 @@ namespace xcspp::xcs
         // (Set update to true when testing multi-step problems. If update is true, make sure to call reward() after this.)
         int exploit(const std::vector<int> & situation, bool update = false);
 
+        // Run without exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        int exploit(Span<const int> situation, bool update = false);
+
+        // Run without exploration (with the packed situation built once per step)
+        int exploit(const PackedSituation & situation, bool update = false);
+
+        // Run without exploration for many situations at once (without updating [P])
+        // (Ties are broken by the smallest action. Refer to ExploitBatch() for details.)
+        // (This is read-only, so it can be called from multiple threads at the same time as long as
+        //  no other member function that modifies the system is called concurrently.)
+        ExploitBatchResult exploitBatch(const std::vector<std::vector<int>> & situations) const;
+
         // Get prediction value of the previous action decision
         // (Call this function after explore() or exploit())
         double prediction() const;
@@ -87,12 +130,12 @@ namespace xcspp::xcs
         bool isCoveringPerformed() const;
 
         // Get all classifiers that match the given situation
-        std::vector<Classifier> getMatchingClassifiers(const std::vector<int> & situation) const;
+        std::vector<BasicClassifier<Condition>> getMatchingClassifiers(const std::vector<int> & situation) const;
 
         // Get const reference to population
-        const Population & population() const;
+        const BasicPopulation<Condition> & population() const;
 
-        void setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp = true);
+        void setPopulationClassifiers(const std::vector<BasicClassifier<Condition>> & classifiers, bool syncTimeStamp = true);
 
         [[deprecated("use XCS::outputPopulationCSV() instead")]]
         void dumpPopulation(std::ostream & os) const;
@@ -103,11 +146,41 @@ namespace xcspp::xcs
 
         bool savePopulationCSVFile(const std::string & filename) const;
 
+        bool loadPopulationBinaryFile(const std::string & filename, bool initClassifierVariables = false, bool syncTimeStamp = true);
+
+        bool savePopulationBinaryFile(const std::string & filename) const;
+
+        // Write the whole training state for a checkpoint (refer to CheckpointKind)
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Read the training state written by outputCheckpoint(), after which the training continues
+        // exactly in the same way as the system that wrote it
+        // (The hyperparameters must be the same, including the change by switchToCondensationMode().
+        //  Throws std::invalid_argument otherwise, and std::runtime_error if the stream does not have
+        //  a valid checkpoint.)
+        void inputCheckpoint(std::istream & is);
+
+        // Save the checkpoint (returns false if the file cannot be written)
+        bool saveCheckpointFile(const std::string & filename) const;
+
+        // Load the checkpoint (returns false if the file cannot be opened)
+        bool loadCheckpointFile(const std::string & filename);
+
         std::size_t populationSize() const;
 
         std::size_t numerositySum() const;
 
+        MatchSetCacheStatistics matchSetCacheStatistics() const;
+
+        // Seed the random engine (e.g., with SeedSequence::seed() to reproduce the training)
+        void seed(std::uint32_t seed);
+
         void switchToCondensationMode();
     };
 
+    using XCS = BasicXCS<Condition>;
+
+    // XCS with the bit-packed condition (for binary problems)
+    using PackedXCS = BasicXCS<PackedCondition>;
+
 }
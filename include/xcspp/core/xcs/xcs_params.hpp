@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 
 #include "xcspp/util/random.hpp"
 
@@ -138,6 +139,16 @@ namespace xcspp::xcs
         //   Whether to use the moyenne adaptive modifee (MAM) for updating the
         //   prediction and the prediction error of classifiers
         bool useMAM = true;
+
+        // matchSetCacheCapacity
+        //   The maximum number of situations whose matching classifiers are cached
+        //   (set "0" to disable the cache)
+        //   The cache skips the population scan when the same situation is presented
+        //   again, which pays off in environments with a small number of distinct
+        //   situations (e.g., maze problems and small datasets). [M] is the same as
+        //   without the cache. Each classifier inserted into [P] is tested against
+        //   all the cached situations, so a large capacity slows down the GA.
+        std::size_t matchSetCacheCapacity = 0;
     };
 
 }
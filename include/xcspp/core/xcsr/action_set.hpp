@@ -16,17 +16,18 @@ namespace xcspp::xcsr
     class ActionSet : public ClassifierPtrSet
     {
     private:
-        // UPDATE FITNESS
-        void updateFitness();
+        // UPDATE FITNESS (also reflects the updated parameters in the aggregates of [P])
+        void updateFitness(double accuracySum, Population & population);
 
         // DO ACTION SET SUBSUMPTION
+        template <XCSRRepr Repr>
         void doSubsumption(Population & population);
 
     public:
         // Constructor
-        ActionSet(const XCSRParams *pParams, const std::unordered_set<int> & availableActions);
+        ActionSet(const XCSRParams *pParams, const AvailableActions & availableActions);
 
-        ActionSet(const MatchSet & matchSet, int action, const XCSRParams *pParams, const std::unordered_set<int> & availableActions);
+        ActionSet(const MatchSet & matchSet, int action, const XCSRParams *pParams, const AvailableActions & availableActions);
 
         // Destructor
         virtual ~ActionSet() = default;
@@ -34,13 +35,22 @@ namespace xcspp::xcsr
         // GENERATE ACTION SET
         void generateSet(const MatchSet & matchSet, int action);
 
+        // GENERATE ACTION SET (takes the partition of [M] in O(1) if available)
+        void generateSet(MatchSet & matchSet, int action);
+
         void copyTo(ActionSet & dest);
 
         // RUN GA (refer to GA::Run() for the latter part)
         void runGA(const std::vector<double> & situation, Population & population, std::uint64_t timeStamp, Random & random);
 
+        template <XCSRRepr Repr>
+        void runGA(const std::vector<double> & situation, Population & population, std::uint64_t timeStamp, Random & random);
+
         // UPDATE SET
         void update(double p, Population & population);
+
+        template <XCSRRepr Repr>
+        void update(double p, Population & population);
     };
 
 }
@@ -0,0 +1,174 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+
+#include "classifier.hpp"
+#include "condition.hpp"
+#include "xcsr_repr.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Bounding volume hierarchy (static R-tree) over the [lower, upper) boxes of XCSR conditions
+    //   The boxes are converted from the representation (CSR/OBR/UBR) when they are added, and
+    //   build() bulk-loads the tree top-down by splitting the boxes by their centers in the
+    //   dimension and at the position that minimize the expected number of the boxes to test.
+    //   Each node stores the bounding box of its subtree, so a query skips the subtrees whose
+    //   bounding box does not contain the point.
+    //   The containment test is lower <= x < upper, which is the same as Condition::matches().
+    //   The index is immutable after build(), so it can be queried from multiple threads.
+    class BoxIndex
+    {
+    public:
+        static constexpr std::size_t kDefaultLeafSize = 8;
+
+    private:
+        static constexpr std::uint32_t kNoNode = std::numeric_limits<std::uint32_t>::max();
+
+        // Maximum depth of the tree (the nodes at this depth become leaves regardless of their size)
+        static constexpr std::size_t kMaxDepth = 64;
+
+        struct Node
+        {
+            // Boxes of the subtree (range in m_ids)
+            std::uint32_t itemBegin;
+            std::uint32_t itemEnd;
+
+            // Children (kNoNode for a leaf)
+            std::uint32_t leftChild;
+            std::uint32_t rightChild;
+        };
+
+        std::size_t m_dimension;
+
+        std::size_t m_leafSize;
+
+        std::vector<Node> m_nodes;
+
+        // Bounding box of each node (row-major: nodes x dimension)
+        std::vector<double> m_nodeLowerBounds;
+        std::vector<double> m_nodeUpperBounds;
+
+        // Bounds and ids of the boxes in the order of the leaves (row-major: boxes x dimension)
+        std::vector<double> m_lowerBounds;
+        std::vector<double> m_upperBounds;
+        std::vector<std::uint32_t> m_ids;
+
+        // Boxes added after the last build()
+        std::size_t m_addedDimension;
+        std::vector<double> m_addedLowerBounds;
+        std::vector<double> m_addedUpperBounds;
+        std::vector<double> m_addedCenters;
+        std::vector<std::uint32_t> m_addedIds;
+
+        // Build the subtree for order[begin, end) and return its node index
+        std::uint32_t build(std::vector<std::uint32_t> & order, std::uint32_t begin, std::uint32_t end, std::size_t depth);
+
+        // Partition order[begin, end) for the children and return the position of the boundary
+        // (Returns end if the node should be a leaf.)
+        std::uint32_t findSplit(std::vector<std::uint32_t> & order, std::uint32_t begin, std::uint32_t end) const;
+
+        static bool Contains(const double * lower, const double * upper, const double * point, std::size_t dimension) noexcept
+        {
+            for (std::size_t d = 0; d < dimension; ++d)
+            {
+                if (!(lower[d] <= point[d] && point[d] < upper[d]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    public:
+        // Constructor
+        explicit BoxIndex(std::size_t leafSize = kDefaultLeafSize);
+
+        // Build the index of the conditions (the id of each box is its position in classifiers)
+        BoxIndex(const std::vector<Classifier> & classifiers, XCSRRepr repr, std::size_t leafSize = kDefaultLeafSize);
+
+        // Destructor
+        ~BoxIndex() = default;
+
+        // Add the box of the condition (it is not queried until the next build())
+        // (All the conditions must have the same length. Throws std::invalid_argument otherwise.)
+        void add(const Condition & condition, XCSRRepr repr, std::uint32_t id);
+
+        // Replace the tree with the boxes added since the last build()
+        void build();
+
+        void clear() noexcept;
+
+        // Number of the boxes in the tree
+        std::size_t size() const noexcept
+        {
+            return m_ids.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_ids.empty();
+        }
+
+        std::size_t nodeCount() const noexcept
+        {
+            return m_nodes.size();
+        }
+
+        // Calls func(id) for each box that contains the point (in no particular order)
+        // (Throws std::invalid_argument if the length of the point is different from the boxes.)
+        template <class Function>
+        void forEachContaining(const std::vector<double> & point, Function func) const
+        {
+            if (m_nodes.empty())
+            {
+                return;
+            }
+
+            if (point.size() != m_dimension)
+            {
+                throw std::invalid_argument("BoxIndex::forEachContaining() received a point with a different length.");
+            }
+
+            std::array<std::uint32_t, kMaxDepth + 1> stack;
+            std::size_t stackSize = 0;
+            stack[stackSize++] = 0;
+            while (stackSize > 0)
+            {
+                const std::uint32_t nodeIdx = stack[--stackSize];
+                const Node & node = m_nodes[nodeIdx];
+                if (!Contains(m_nodeLowerBounds.data() + nodeIdx * m_dimension, m_nodeUpperBounds.data() + nodeIdx * m_dimension, point.data(), m_dimension))
+                {
+                    continue;
+                }
+
+                if (node.leftChild == kNoNode)
+                {
+                    for (std::uint32_t i = node.itemBegin; i < node.itemEnd; ++i)
+                    {
+                        if (Contains(m_lowerBounds.data() + i * m_dimension, m_upperBounds.data() + i * m_dimension, point.data(), m_dimension))
+                        {
+                            func(m_ids[i]);
+                        }
+                    }
+                }
+                else
+                {
+                    stack[stackSize++] = node.rightChild;
+                    stack[stackSize++] = node.leftChild;
+                }
+            }
+        }
+
+        // Ids of the boxes that contain the situation (ascending order)
+        // (The storage of ids is reused.)
+        void findMatching(const std::vector<double> & situation, std::vector<std::size_t> & ids) const;
+
+        std::vector<std::size_t> findMatching(const std::vector<double> & situation) const;
+    };
+
+}
@@ -25,6 +25,8 @@ namespace xcspp::xcsr
         // Constructor
         ConditionActionPair(const ConditionActionPair &) = default;
 
+        ConditionActionPair(ConditionActionPair &&) = default;
+
         ConditionActionPair(const Condition & condition, int action);
 
         ConditionActionPair(Condition && condition, int action);
@@ -32,6 +34,10 @@ namespace xcspp::xcsr
         // Destructor
         virtual ~ConditionActionPair() = default;
 
+        ConditionActionPair & operator= (const ConditionActionPair &) = default;
+
+        ConditionActionPair & operator= (ConditionActionPair &&) = default;
+
         friend std::ostream & operator<< (std::ostream & os, const ConditionActionPair & obj);
     };
 
@@ -75,6 +81,8 @@ namespace xcspp::xcsr
         // Constructor
         Classifier(const Classifier &) = default;
 
+        Classifier(Classifier &&) = default;
+
         Classifier(const Condition & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
         Classifier(const ConditionActionPair & conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
@@ -86,20 +94,33 @@ namespace xcspp::xcsr
         // Destructor
         virtual ~Classifier() = default;
 
+        Classifier & operator= (const Classifier &) = default;
+
+        Classifier & operator= (Classifier &&) = default;
+
         double accuracy(double epsilonZero, double alpha, double nu) const;
     };
 
     // Classifier in [P] (have a reference to XCSRParams)
+    //   [P] keeps running aggregates of numerosity, fitness, actionSetSize and experience, so change
+    //   them through Population::modify() while the classifier is in [P]. The other variables
+    //   can be changed directly.
     struct StoredClassifier : Classifier
     {
     private:
         // XCSRParams
-        const XCSRParams * const m_pParams;
+        //   (Non-const pointer so that [P] can move classifiers within its contiguous storage)
+        const XCSRParams * m_pParams;
+
+        // Accuracy kappa calculated from the current epsilon (see updateAccuracy())
+        double m_accuracy;
 
     public:
         // Constructor
         StoredClassifier(const StoredClassifier & obj) = default;
 
+        StoredClassifier(StoredClassifier && obj) = default;
+
         StoredClassifier(const Classifier & obj, const XCSRParams *pParams);
 
         StoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSRParams *pParams);
@@ -113,13 +134,27 @@ namespace xcspp::xcsr
         // Destructor
         virtual ~StoredClassifier() = default;
 
+        StoredClassifier & operator= (const StoredClassifier &) = default;
+
+        StoredClassifier & operator= (StoredClassifier &&) = default;
+
         // COULD SUBSUME
         bool isSubsumer() const;
 
         // DOES SUBSUME
         bool subsumes(const Classifier & cl) const;
 
-        double accuracy() const;
+        template <XCSRRepr Repr>
+        bool subsumes(const Classifier & cl) const;
+
+        // Cached accuracy (no std::pow() is called)
+        double accuracy() const noexcept
+        {
+            return m_accuracy;
+        }
+
+        // Recalculate the cached accuracy (call this after changing epsilon)
+        void updateAccuracy();
     };
 
 }
@@ -30,9 +30,15 @@ namespace xcspp::xcsr
         // DOES MATCH
         bool matches(const std::vector<double> & situation, XCSRRepr repr) const;
 
+        template <XCSRRepr Repr>
+        bool matches(const std::vector<double> & situation) const;
+
         // IS MORE GENERAL
         bool isMoreGeneral(const Condition & cl, XCSRRepr repr) const;
 
+        template <XCSRRepr Repr>
+        bool isMoreGeneral(const Condition & cl) const;
+
         friend std::ostream & operator<< (std::ostream & os, const Condition & obj);
 
         // --- The functions below are just wrappers for std::vector<Symbol> ---
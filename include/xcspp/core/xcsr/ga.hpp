@@ -19,7 +19,17 @@ namespace xcspp::xcsr
             ClassifierPtrSet & actionSet,
             const std::vector<double> & situation,
             Population & population,
-            const std::unordered_set<int> & availableActions,
+            const AvailableActions & availableActions,
+            const XCSRParams *pParams,
+            Random & random);
+
+        // RUN GA (the representation is resolved at compile time)
+        template <XCSRRepr Repr>
+        void Run(
+            ClassifierPtrSet & actionSet,
+            const std::vector<double> & situation,
+            Population & population,
+            const AvailableActions & availableActions,
             const XCSRParams *pParams,
             Random & random);
     };
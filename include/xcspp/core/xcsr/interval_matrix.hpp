@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "condition.hpp"
+#include "xcsr_repr.hpp"
+#include "xcspp/util/simd.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Contiguous storage of the [lower, upper) intervals of many conditions for scanning the whole population at once
+    //   The bounds are converted from the representation (CSR/OBR/UBR) when a row is written, and
+    //   stored in blocks of kBlockSize rows (structure-of-arrays within each block), so that one
+    //   SIMD compare tests kBlockSize classifiers for a dimension.
+    //   All rows must have the same length.
+    class IntervalMatrix
+    {
+    public:
+        static constexpr std::size_t kBlockSize = 4;
+
+        // Population-scan kernel
+        using Kernel = SIMDKernel;
+
+    private:
+        std::size_t m_conditionLength;
+        std::size_t m_size;
+        std::vector<double> m_lowerBounds;
+        std::vector<double> m_upperBounds;
+        Kernel m_kernel;
+
+        std::size_t boundIndex(std::size_t rowIdx, std::size_t dimIdx) const noexcept
+        {
+            return (rowIdx / kBlockSize * m_conditionLength + dimIdx) * kBlockSize + rowIdx % kBlockSize;
+        }
+
+    public:
+        // Constructor (selects the fastest kernel supported by the CPU)
+        IntervalMatrix();
+
+        // Destructor
+        ~IntervalMatrix() = default;
+
+        Kernel kernel() const noexcept
+        {
+            return m_kernel;
+        }
+
+        // Select the kernel explicitly (throws std::invalid_argument if it is not supported by the CPU)
+        void setKernel(Kernel kernel);
+
+        std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        // Append the condition as the last row
+        void pushBack(const Condition & condition, XCSRRepr repr);
+
+        // Overwrite the row
+        void set(std::size_t rowIdx, const Condition & condition, XCSRRepr repr);
+
+        // Remove the row by moving the last row into its place
+        void swapRemove(std::size_t rowIdx);
+
+        void clear() noexcept;
+
+        // DOES MATCH (for all rows)
+        //   Bit (i % 64) of bitmap[i / 64] is set if the i-th row matches the situation.
+        void match(const std::vector<double> & situation, std::vector<std::uint64_t> & bitmap) const;
+    };
+
+}
@@ -1,5 +1,7 @@
 ﻿#pragma once
+#include <vector>
 #include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 
 #include "classifier_ptr_set.hpp"
 #include "population.hpp"
@@ -9,16 +11,24 @@
 namespace xcspp::xcsr
 {
 
+    class PredictionArray;
+
     class MatchSet : public ClassifierPtrSet
     {
     protected:
         bool m_isCoveringPerformed;
 
+        // [M] partitioned by action (same order as m_availableActions)
+        //   The classifiers of each action are in the same order as in m_set.
+        //   This is valid only if m_isPartitioned is true.
+        std::vector<std::vector<ClassifierPtr>> m_setsByAction;
+        bool m_isPartitioned = false;
+
     public:
         // Constructor
         using ClassifierPtrSet::ClassifierPtrSet; // inherits all constructors from ClassifierPtrSet
 
-        MatchSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, const XCSRParams *pParams, const std::unordered_set<int> & availableActions, Random & random);
+        MatchSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, const XCSRParams *pParams, const AvailableActions & availableActions, Random & random);
 
         // Destructor
         virtual ~MatchSet() = default;
@@ -26,9 +36,26 @@ namespace xcspp::xcsr
         // GENERATE MATCH SET
         void generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random);
 
+        template <XCSRRepr Repr>
+        void generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random);
+
+        // GENERATE MATCH SET and PREDICTION ARRAY in a single scan of [P]
+        template <XCSRRepr Repr>
+        void generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, PredictionArray & predictionArray);
+
         // Get if covering is performed in the previous match set generation
         // (Call this function after constructor or generateSet())
         bool isCoveringPerformed() const;
+
+        // Move the classifiers that propose the action to dest in O(1) (the storage is swapped)
+        // (Returns false if [M] has not been partitioned by action in generateSet(). The partition of
+        //  the action is consumed, but [M] itself is not changed.)
+        bool takeSetForAction(int action, std::vector<ClassifierPtr> & dest);
+
+    private:
+        // GENERATE MATCH SET (calls accumulator.accumulate(cl) for each classifier added to [M])
+        template <XCSRRepr Repr, class Accumulator>
+        void generateSetImpl(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, Accumulator & accumulator);
     };
 
 }
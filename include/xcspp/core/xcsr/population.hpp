@@ -1,24 +1,337 @@
 #pragma once
+#include <vector>
+#include <set>
+#include <unordered_set>
+#include <unordered_map>
+#include <utility> // std::pair
+#include <string>
+#include <iostream>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "classifier.hpp"
 #include "classifier_ptr_set.hpp"
+#include "interval_matrix.hpp"
+#include "box_index.hpp"
+#include "xcspp/core/match_set_cache.hpp"
+#include "xcsr_params.hpp"
+#include "xcspp/util/slot_map.hpp"
+#include "xcspp/util/sum_tree.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcsr
 {
 
-    class Population : public ClassifierPtrSet
+    // [P]
+    //   The classifiers are stored contiguously in a slot map, and [M]/[A] refer to them
+    //   with generational indices (ClassifierPtr). Deleting a classifier is O(1) since the
+    //   last classifier is moved into its place.
+    class Population
     {
+    private:
+        const XCSRParams * const m_pParams;
+        const std::unordered_set<int> m_availableActions;
+
+        ClassifierArena m_arena;
+
+        // Conditions in the same order as m_arena (rows are swap-removed together with the arena)
+        IntervalMatrix m_intervalMatrix;
+
+        // Spatial index over the condition boxes (used only if m_pParams->useSpatialIndex is true)
+        //   The index is not updated by insert() and erase(). The classifiers inserted since the
+        //   last rebuild are kept in m_unindexedHandles and tested one by one, and the erased ones
+        //   are skipped since their handles are no longer valid.
+        BoxIndex m_boxIndex;
+
+        // Handle of each box in m_boxIndex (indexed by the id of the box)
+        std::vector<SlotHandle> m_boxIndexHandles;
+
+        // Classifiers inserted since the last rebuild of m_boxIndex
+        std::vector<SlotHandle> m_unindexedHandles;
+
+        // Number of classifiers erased since the last rebuild of m_boxIndex
+        std::size_t m_boxIndexErasedCount;
+
+        // Positions of the matching classifiers for recently presented situations
+        // (enabled only if m_pParams->matchSetCacheCapacity is not zero)
+        MatchSetCache<std::vector<double>> m_matchSetCache;
+
+        // Bitmap of the matching classifiers, reused between the scans of [P] to avoid allocations
+        // (Only the non-const scans use this, so the const member functions can be called concurrently.)
+        std::vector<std::uint64_t> m_matchBitmap;
+
+        // Hash index of the classifiers keyed on the hash of (condition, action)
+        // (Classifiers with colliding hashes share a key, so the condition and action must be compared.)
+        std::unordered_multimap<std::size_t, SlotHandle> m_index;
+
+        // Values of each classifier last reflected in the running aggregates (same order as m_arena)
+        struct AggregateEntry
+        {
+            std::uint64_t numerosity;
+            double fitness;
+            bool isExperienced;
+        };
+        std::vector<AggregateEntry> m_aggregateEntries;
+
+        // Running totals of numerosity and fitness in [P]
+        std::uint64_t m_numerositySum;
+        double m_fitnessSum;
+
+        // Deletion votes without the fitness factor (actionSetSize * numerosity; same order as m_arena)
+        SumTree<double> m_baseVoteTree;
+
+        // Experienced classifiers (exp >= theta_del) ordered by fitness per numerosity, with their positions
+        // (Only the ones below delta * averageFitness get the additional deletion vote.)
+        std::set<std::pair<double, std::size_t>> m_experiencedClassifiers;
+
+        // Number of incremental updates since the floating-point aggregates were recomputed
+        std::size_t m_aggregateUpdateCount;
+
+        // Remove the classifier at the position in begin()...end()
+        void eraseAt(std::size_t idx);
+
+        // Set the classifier variables to the initial values (for loading with initClassifierVariables)
+        void resetClassifierVariables(std::vector<Classifier> & classifiers) const;
+
+        bool usesBoxIndex() const noexcept;
+
+        // Rebuild m_boxIndex if many classifiers have been inserted or erased since the last rebuild
+        void refreshBoxIndex();
+
+        void rebuildBoxIndex();
+
+        // DOES MATCH (for all classifiers)
+        //   Bit (i % 64) of bitmap[i / 64] is set if the i-th classifier matches the situation.
+        void match(const std::vector<double> & situation, std::vector<std::uint64_t> & bitmap) const;
+
+        // Positions of the classifiers that match the situation (scans [P] only if the situation is not cached)
+        const std::vector<std::size_t> & cachedMatchingIndices(const std::vector<double> & situation);
+
+        // --- The functions below keep the running aggregates consistent with m_arena ---
+
+        void pushBackAggregates(const StoredClassifier & cl);
+
+        void updateAggregatesAt(std::size_t idx);
+
+        void swapRemoveAggregates(std::size_t idx);
+
+        void recomputeAggregates();
+
+        // Select the classifier to delete by roulette-wheel selection on deletion votes in O(log N + K)
+        // (K is the number of the experienced classifiers whose fitness is below delta * averageFitness)
+        std::size_t selectDeletionTarget(Random & random) const;
+
+        // Calls validateIndex() and validateAggregates() in debug builds
+        void validateInDebugBuild() const;
+
+        // Returns the classifier that has the same condition and action (nullptr if not found)
+        StoredClassifier * findSameConditionAction(const ConditionActionPair & cl);
+
     public:
         // Constructor
-        using ClassifierPtrSet::ClassifierPtrSet;
+        Population(const XCSRParams *pParams, const std::unordered_set<int> & availableActions);
+
+        Population(const std::vector<Classifier> & initialClassifiers, const XCSRParams *pParams, const std::unordered_set<int> & availableActions);
+
+        // ClassifierPtrs refer to the arena of this object, so [P] is neither copyable nor movable
+        Population(const Population &) = delete;
+
+        Population & operator= (const Population &) = delete;
 
         // Destructor
         virtual ~Population() = default;
 
+        void setClassifiers(const std::vector<Classifier> & classifiers);
+
+        void inputCSV(std::istream & is, bool initClassifierVariables = false);
+
+        void outputCSV(std::ostream & os) const;
+
+        bool loadCSVFile(const std::string & filename, bool initClassifierVariables = false);
+
+        bool saveCSVFile(const std::string & filename) const;
+
+        // Load the classifiers from a binary snapshot saved by saveBinaryFile()
+        // (Returns false if the file cannot be opened. Throws std::runtime_error if it is not a valid
+        //  snapshot, and std::invalid_argument if it has the conditions of another system or representation.)
+        bool loadBinaryFile(const std::string & filename, bool initClassifierVariables = false);
+
+        // Save the classifiers as a binary snapshot (refer to PopulationSnapshot)
+        bool saveBinaryFile(const std::string & filename) const;
+
+        // Write the classifiers and the running aggregates for a checkpoint
+        // (The aggregates are written as they are, including the rounding errors of the
+        //  incremental updates, so the deletion votes after inputCheckpoint() are exactly the same.)
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Read the classifiers and the running aggregates written by outputCheckpoint()
+        // (Throws std::runtime_error if the stream does not have a valid checkpoint.)
+        void inputCheckpoint(std::istream & is);
+
+        // --- The functions below iterate over the classifiers in contiguous storage ---
+
+        bool empty() const noexcept
+        {
+            return m_arena.empty();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_arena.size();
+        }
+
+        auto begin() noexcept
+        {
+            return m_arena.begin();
+        }
+
+        auto begin() const noexcept
+        {
+            return m_arena.begin();
+        }
+
+        auto end() noexcept
+        {
+            return m_arena.end();
+        }
+
+        auto end() const noexcept
+        {
+            return m_arena.end();
+        }
+
+        // Reference to the classifier at the position in begin()...end()
+        // (The position may change after insert() or erase(), but the reference does not.)
+        ClassifierPtr ptrAt(std::size_t idx)
+        {
+            return ClassifierPtr(&m_arena, m_arena.handleAt(idx));
+        }
+
+        bool contains(const ClassifierPtr & cl) const;
+
+        // Position of the classifier in begin()...end() (the classifier must be in [P])
+        std::size_t indexOf(const ClassifierPtr & cl) const
+        {
+            return m_arena.denseIndex(cl.handle());
+        }
+
+        ClassifierPtr insert(const StoredClassifier & cl);
+
+        ClassifierPtr insert(StoredClassifier && cl);
+
+        // Remove the classifier (O(1); returns the number of removed classifiers)
+        std::size_t erase(const ClassifierPtr & cl);
+
+        void clear();
+
+        // Write access to a classifier in [P] that reflects the changes of its numerosity, fitness,
+        // actionSetSize and experience in the running aggregates when it goes out of scope
+        // (Do not insert or erase classifiers while it is alive, since they may move the classifier.)
+        class ScopedModifier
+        {
+        private:
+            Population & m_population;
+
+            const std::size_t m_idx;
+
+        public:
+            ScopedModifier(Population & population, std::size_t idx) noexcept
+                : m_population(population)
+                , m_idx(idx)
+            {
+            }
+
+            ScopedModifier(const ScopedModifier &) = delete;
+
+            ScopedModifier & operator= (const ScopedModifier &) = delete;
+
+            ~ScopedModifier()
+            {
+                m_population.updateAggregatesAt(m_idx);
+            }
+
+            StoredClassifier & operator*() const
+            {
+                return m_population.m_arena.begin()[m_idx];
+            }
+
+            StoredClassifier * operator->() const
+            {
+                return &**this;
+            }
+        };
+
+        // Start modifying the classifier in [P] (e.g. "population.modify(*cl)->fitness = 1.0;")
+        ScopedModifier modify(const StoredClassifier & cl);
+
+        std::uint64_t numerositySum() const noexcept
+        {
+            return m_numerositySum;
+        }
+
+        double fitnessSum() const noexcept
+        {
+            return m_fitnessSum;
+        }
+
+        // Select the population-scan kernel
+        void setMatchKernel(IntervalMatrix::Kernel kernel);
+
+        // Calls func(cl) with the ClassifierPtr of each classifier that matches the situation
+        // (The whole population is scanned at once with the SIMD kernel, or the spatial index
+        //  is queried if useSpatialIndex is true. Both are skipped if the situation is in the
+        //  match set cache. The order is the same in all cases. func must not insert or erase
+        //  classifiers.)
+        template <class Function>
+        void forEachMatchingClassifier(const std::vector<double> & situation, Function func)
+        {
+            if (m_matchSetCache.enabled())
+            {
+                for (const std::size_t idx : cachedMatchingIndices(situation))
+                {
+                    func(ptrAt(idx));
+                }
+                return;
+            }
+
+            refreshBoxIndex();
+            match(situation, m_matchBitmap);
+            ForEachSetBit(m_matchBitmap, [&](std::size_t idx) { func(ptrAt(idx)); });
+        }
+
+        // Calls func(cl) with the const reference to each classifier that matches the situation
+        // (The spatial index is not rebuilt here. This uses its own buffer instead of m_matchBitmap
+        //  so that it can be called concurrently.)
+        template <class Function>
+        void forEachMatchingClassifier(const std::vector<double> & situation, Function func) const
+        {
+            std::vector<std::uint64_t> matchBitmap;
+            match(situation, matchBitmap);
+            const auto it = m_arena.begin();
+            ForEachSetBit(matchBitmap, [&](std::size_t idx) { func(it[idx]); });
+        }
+
         // INSERT IN POPULATION
-        void insertOrIncrementNumerosity(const ClassifierPtr & cl);
+        //   Duplicates are detected in expected O(1) time with the hash index.
+        void insertOrIncrementNumerosity(const Classifier & cl);
+
+        // Throws std::logic_error if the hash index is not consistent with the classifiers
+        // (In debug builds, this is called at the end of setClassifiers(), erase(),
+        //  insertOrIncrementNumerosity() and deleteExtraClassifiers().)
+        void validateIndex() const;
+
+        // Throws std::logic_error if the running aggregates are not consistent with the classifiers
+        // (In debug builds, this is called together with validateIndex().)
+        void validateAggregates() const;
 
         // DELETE FROM POPULATION
         bool deleteExtraClassifiers(Random & random);
+
+        // Number of the lookups in the match set cache and the ones that hit (since construction)
+        const MatchSetCacheStatistics & matchSetCacheStatistics() const noexcept
+        {
+            return m_matchSetCache.statistics();
+        }
     };
 
 }
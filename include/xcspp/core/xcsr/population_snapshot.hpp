@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include <iterator> // std::begin
+#include <stdexcept>
+#include <cstdint> // std::int32_t, std::uint32_t, std::uint64_t
+#include <cstddef> // std::size_t
+
+#include "classifier.hpp"
+#include "xcsr_params.hpp"
+#include "xcsr_repr.hpp"
+#include "xcspp/core/population_snapshot.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Hash of the hyperparameters stored in the snapshot (the options that do not affect learning are excluded)
+    std::uint64_t HashParams(const XCSRParams & params);
+
+    // Snapshot of the classifiers (a range of Classifier or StoredClassifier, e.g., [P])
+    // (All the conditions must have the same length. Throws std::invalid_argument otherwise.)
+    template <class ClassifierRange>
+    PopulationSnapshot MakePopulationSnapshot(const ClassifierRange & classifiers, XCSRRepr repr, std::uint64_t paramsHash)
+    {
+        using Section = PopulationSnapshot::Section;
+
+        const std::size_t size = classifiers.size();
+        const std::size_t conditionLength = (size > 0) ? std::begin(classifiers)->condition.size() : 0;
+        PopulationSnapshot snapshot(PopulationSnapshot::ConditionKind::kInterval, static_cast<std::uint32_t>(repr), paramsHash, conditionLength, size);
+
+        auto * const actions = snapshot.mutableData<std::int32_t>(Section::kAction);
+        auto * const predictions = snapshot.mutableData<double>(Section::kPrediction);
+        auto * const epsilons = snapshot.mutableData<double>(Section::kEpsilon);
+        auto * const fitnesses = snapshot.mutableData<double>(Section::kFitness);
+        auto * const experiences = snapshot.mutableData<std::uint64_t>(Section::kExperience);
+        auto * const timeStamps = snapshot.mutableData<std::uint64_t>(Section::kTimeStamp);
+        auto * const actionSetSizes = snapshot.mutableData<double>(Section::kActionSetSize);
+        auto * const numerosities = snapshot.mutableData<std::uint64_t>(Section::kNumerosity);
+        auto * values = snapshot.mutableData<double>(Section::kConditionValue);
+
+        std::size_t idx = 0;
+        for (const auto & cl : classifiers)
+        {
+            if (cl.condition.size() != conditionLength)
+            {
+                throw std::invalid_argument("MakePopulationSnapshot() received conditions with different lengths.");
+            }
+
+            actions[idx] = cl.action;
+            predictions[idx] = cl.prediction;
+            epsilons[idx] = cl.epsilon;
+            fitnesses[idx] = cl.fitness;
+            experiences[idx] = cl.experience;
+            timeStamps[idx] = cl.timeStamp;
+            actionSetSizes[idx] = cl.actionSetSize;
+            numerosities[idx] = cl.numerosity;
+            for (const auto & symbol : cl.condition)
+            {
+                *values++ = symbol.v1;
+                *values++ = symbol.v2;
+            }
+            ++idx;
+        }
+
+        return snapshot;
+    }
+
+    // Classifiers in the snapshot
+    // (Throws std::invalid_argument if the snapshot does not have interval conditions or
+    //  was saved with another representation.)
+    std::vector<Classifier> ReadPopulationSnapshot(const PopulationSnapshot & snapshot, XCSRRepr repr);
+
+}
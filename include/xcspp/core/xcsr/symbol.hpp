@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <stdexcept>
+#include <algorithm> // std::min, std::max
 
 #include "xcsr_repr.hpp"
 
@@ -42,6 +43,10 @@ namespace xcspp::xcsr
         // DOES MATCH
         bool matches(double value, XCSRRepr repr) const;
 
+        // DOES MATCH (the representation is resolved at compile time)
+        template <XCSRRepr Repr>
+        bool matches(double value) const;
+
         friend std::ostream & operator<< (std::ostream & os, const Symbol & obj);
 
         friend bool operator== (const Symbol & lhs, const Symbol & rhs);
@@ -49,4 +54,44 @@ namespace xcspp::xcsr
         friend bool operator!= (const Symbol & lhs, const Symbol & rhs);
     };
 
+    template <XCSRRepr Repr>
+    double GetLowerBound(const Symbol & s)
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            return s.v1 - s.v2;
+        }
+        else if constexpr (Repr == XCSRRepr::kOBR)
+        {
+            return s.v1;
+        }
+        else
+        {
+            return std::min(s.v1, s.v2);
+        }
+    }
+
+    template <XCSRRepr Repr>
+    double GetUpperBound(const Symbol & s)
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            return s.v1 + s.v2;
+        }
+        else if constexpr (Repr == XCSRRepr::kOBR)
+        {
+            return s.v2;
+        }
+        else
+        {
+            return std::max(s.v1, s.v2);
+        }
+    }
+
+    template <XCSRRepr Repr>
+    bool Symbol::matches(double value) const
+    {
+        return GetLowerBound<Repr>(*this) <= value && value < GetUpperBound<Repr>(*this);
+    }
+
 }
@@ -1,11 +1,14 @@
 #pragma once
-#include <iosfwd> // std::ostream
+#include <iosfwd> // std::istream, std::ostream
 #include <vector>
-#include <cstdint> // std::uint64_t
+#include <variant>
+#include <cstdint> // std::uint32_t, std::uint64_t
 #include <cstddef> // std::size_t
 
 #include "xcspp/core/iclassifier_system.hpp"
+#include "xcspp/core/available_actions.hpp"
 #include "xcsr_params.hpp"
+#include "xcsr_repr.hpp"
 #include "population.hpp"
 #include "action_set.hpp"
 #include "prediction_array.hpp"
@@ -13,7 +16,10 @@
 namespace xcspp::xcsr
 {
 
-    class XCSR : public IRealClassifierSystem
+    // XCSR specialized for the representation at compile time
+    //   (params.repr must be the same as Repr.)
+    template <XCSRRepr Repr>
+    class BasicXCSR : public IRealClassifierSystem
     {
     private:
         // Random utility instance
@@ -22,6 +28,10 @@ namespace xcspp::xcsr
         // Hyperparameters
         XCSRParams m_params;
 
+        // Available action choices
+        //   (Declared before [A] and [A]_-1 since they refer to this.)
+        const AvailableActions m_availableActions;
+
         // [P]
         //   The population [P] consists of all classifier that exist in XCS at any time.
         Population m_population;
@@ -36,8 +46,9 @@ namespace xcspp::xcsr
         //   execution cycle.
         ActionSet m_prevActionSet;
 
-        // Available action choices
-        const std::unordered_set<int> m_availableActions;
+        // [M] and PA of the current step (the storage is reused across steps)
+        MatchSet m_matchSet;
+        PredictionArray m_predictionArray;
 
         std::uint64_t m_timeStamp;
 
@@ -47,9 +58,14 @@ namespace xcspp::xcsr
 
         std::vector<double> m_prevSituation;
 
+        // Situation of the current step
+        //   This is swapped with m_prevSituation at the end of the step, so neither buffer is
+        //   reallocated once it has grown to the situation size.
+        std::vector<double> m_situation;
+
         // Prediction value of the previous action decision (just for logging)
         double m_prediction;
-        std::unordered_map<int, double> m_predictions;
+        std::vector<double> m_predictions; // same order as m_availableActions
 
         // Covering occurrence of the previous action decision (just for logging)
         bool m_isCoveringPerformed;
@@ -57,6 +73,115 @@ namespace xcspp::xcsr
         // Set system timestamp to the same as the latest classifier in [P]
         void syncTimeStampWithPopulation();
 
+        // Store the prediction of each available action (just for logging)
+        void storePredictions();
+
+        // Run explore() or exploit() for m_situation
+        int exploreImpl();
+
+        int exploitImpl(bool update);
+
+    public:
+        // Constructor
+        BasicXCSR(const std::unordered_set<int> & availableActions, const XCSRParams & params);
+
+        // Destructor
+        ~BasicXCSR() = default;
+
+        // Run with exploration
+        int explore(const std::vector<double> & situation);
+
+        // Run with exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        int explore(Span<const double> situation);
+
+        // Feedback reward to system
+        void reward(double value, bool isEndOfProblem = true);
+
+        // Run without exploration
+        // (Set update to true when testing multi-step problems. If update is true, make sure to call reward() after this.)
+        int exploit(const std::vector<double> & situation, bool update = false);
+
+        // Run without exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        int exploit(Span<const double> situation, bool update = false);
+
+        // Run without exploration for many situations at once (without updating [P])
+        // (Ties are broken by the smallest action. Refer to ExploitBatch() for details.)
+        // (This is read-only, so it can be called from multiple threads at the same time as long as
+        //  no other member function that modifies the system is called concurrently.)
+        ExploitBatchResult exploitBatch(const std::vector<std::vector<double>> & situations) const;
+
+        // Get prediction value of the previous action decision
+        // (Call this function after explore() or exploit())
+        double prediction() const;
+
+        // Get prediction value of the action
+        // (Call this function after explore() or exploit())
+        double predictionFor(int action) const;
+
+        // Get if covering is performed in the previous action decision
+        // (Call this function after explore() or exploit())
+        bool isCoveringPerformed() const;
+
+        // Get all classifiers that match the given situation
+        std::vector<Classifier> getMatchingClassifiers(const std::vector<double> & situation) const;
+
+        // Get const reference to population
+        const Population & population() const;
+
+        void setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp = true);
+
+        [[deprecated("use XCS::outputPopulationCSV() instead")]]
+        void dumpPopulation(std::ostream & os) const;
+
+        void outputPopulationCSV(std::ostream & os) const;
+
+        bool loadPopulationCSVFile(const std::string & filename, bool initClassifierVariables = false, bool syncTimeStamp = true);
+
+        bool savePopulationCSVFile(const std::string & filename) const;
+
+        bool loadPopulationBinaryFile(const std::string & filename, bool initClassifierVariables = false, bool syncTimeStamp = true);
+
+        bool savePopulationBinaryFile(const std::string & filename) const;
+
+        // Write the whole training state for a checkpoint (refer to CheckpointKind)
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Read the training state written by outputCheckpoint(), after which the training continues
+        // exactly in the same way as the system that wrote it
+        // (The hyperparameters must be the same, including the change by switchToCondensationMode().
+        //  Throws std::invalid_argument otherwise, and std::runtime_error if the stream does not have
+        //  a valid checkpoint.)
+        void inputCheckpoint(std::istream & is);
+
+        // Save the checkpoint (returns false if the file cannot be written)
+        bool saveCheckpointFile(const std::string & filename) const;
+
+        // Load the checkpoint (returns false if the file cannot be opened)
+        bool loadCheckpointFile(const std::string & filename);
+
+        std::size_t populationSize() const;
+
+        std::size_t numerositySum() const;
+
+        MatchSetCacheStatistics matchSetCacheStatistics() const;
+
+        // Seed the random engine (e.g., with SeedSequence::seed() to reproduce the training)
+        void seed(std::uint32_t seed);
+
+        void switchToCondensationMode();
+    };
+
+    // XCSR with the representation given at runtime (params.repr)
+    //   This dispatches to BasicXCSR<Repr> for the representation.
+    class XCSR : public IRealClassifierSystem
+    {
+    private:
+        using SystemVariant = std::variant<BasicXCSR<XCSRRepr::kCSR>, BasicXCSR<XCSRRepr::kOBR>, BasicXCSR<XCSRRepr::kUBR>>;
+
+        SystemVariant m_system;
+
+        static SystemVariant MakeSystem(const std::unordered_set<int> & availableActions, const XCSRParams & params);
+
     public:
         // Constructor
         XCSR(const std::unordered_set<int> & availableActions, const XCSRParams & params);
@@ -67,6 +192,9 @@ namespace xcspp::xcsr
         // Run with exploration
         int explore(const std::vector<double> & situation);
 
+        // Run with exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        int explore(Span<const double> situation);
+
         // Feedback reward to system
         void reward(double value, bool isEndOfProblem = true);
 
@@ -74,6 +202,15 @@ namespace xcspp::xcsr
         // (Set update to true when testing multi-step problems. If update is true, make sure to call reward() after this.)
         int exploit(const std::vector<double> & situation, bool update = false);
 
+        // Run without exploration (with a view of the situation, e.g., IBasicEnvironment::situationView())
+        int exploit(Span<const double> situation, bool update = false);
+
+        // Run without exploration for many situations at once (without updating [P])
+        // (Ties are broken by the smallest action. Refer to ExploitBatch() for details.)
+        // (This is read-only, so it can be called from multiple threads at the same time as long as
+        //  no other member function that modifies the system is called concurrently.)
+        ExploitBatchResult exploitBatch(const std::vector<std::vector<double>> & situations) const;
+
         // Get prediction value of the previous action decision
         // (Call this function after explore() or exploit())
         double prediction() const;
@@ -103,10 +240,35 @@ namespace xcspp::xcsr
 
         bool savePopulationCSVFile(const std::string & filename) const;
 
+        bool loadPopulationBinaryFile(const std::string & filename, bool initClassifierVariables = false, bool syncTimeStamp = true);
+
+        bool savePopulationBinaryFile(const std::string & filename) const;
+
+        // Write the whole training state for a checkpoint (refer to CheckpointKind)
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Read the training state written by outputCheckpoint(), after which the training continues
+        // exactly in the same way as the system that wrote it
+        // (The hyperparameters must be the same, including the change by switchToCondensationMode().
+        //  Throws std::invalid_argument otherwise, and std::runtime_error if the stream does not have
+        //  a valid checkpoint.)
+        void inputCheckpoint(std::istream & is);
+
+        // Save the checkpoint (returns false if the file cannot be written)
+        bool saveCheckpointFile(const std::string & filename) const;
+
+        // Load the checkpoint (returns false if the file cannot be opened)
+        bool loadCheckpointFile(const std::string & filename);
+
         std::size_t populationSize() const;
 
         std::size_t numerositySum() const;
 
+        MatchSetCacheStatistics matchSetCacheStatistics() const;
+
+        // Seed the random engine (e.g., with SeedSequence::seed() to reproduce the training)
+        void seed(std::uint32_t seed);
+
         void switchToCondensationMode();
     };
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 
 #include "xcsr_repr.hpp"
 #include "xcspp/util/random.hpp"
@@ -168,6 +169,25 @@ namespace xcspp::xcsr
         //   (max-value - min-value) / 2.
         //   Choose "true" to avoid the random bias in this situation.
         bool doCoveringRandomRangeTruncation = false;
+
+        // useSpatialIndex
+        //   Whether to find the matching classifiers with a spatial index over the condition
+        //   boxes (BoxIndex) instead of scanning the whole population.
+        //   The index is rebuilt lazily after the GA has changed enough classifiers, and the
+        //   classifiers inserted since the last rebuild are tested one by one, so [M] is always
+        //   the same as the scan. This pays off only for large populations with specific
+        //   conditions, since the scan is vectorized.
+        bool useSpatialIndex = false;
+
+        // matchSetCacheCapacity
+        //   The maximum number of situations whose matching classifiers are cached
+        //   (set "0" to disable the cache)
+        //   The cache skips the population scan when exactly the same situation is
+        //   presented again, which pays off in environments with a small number of
+        //   distinct situations (e.g., small datasets). [M] is the same as without
+        //   the cache. Each classifier inserted into [P] is tested against all the
+        //   cached situations, so a large capacity slows down the GA.
+        std::size_t matchSetCacheCapacity = 0;
     };
 
 }
@@ -1,5 +1,8 @@
 #pragma once
 #include <cmath>
+#include <algorithm> // std::clamp, std::max
+#include <stdexcept>
+#include <type_traits> // std::integral_constant
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcsr
@@ -17,7 +20,63 @@ namespace xcspp::xcsr
     class Symbol;
     struct XCSRParams;
 
+    // Calls func(std::integral_constant<XCSRRepr, repr>{}) so that the representation given at runtime
+    // can be used as a template argument (e.g., func = [&](auto r) { return f<decltype(r)::value>(); })
+    template <class Function>
+    decltype(auto) DispatchRepr(XCSRRepr repr, Function && func)
+    {
+        switch (repr)
+        {
+        case XCSRRepr::kCSR:
+            return func(std::integral_constant<XCSRRepr, XCSRRepr::kCSR>{});
+
+        case XCSRRepr::kOBR:
+            return func(std::integral_constant<XCSRRepr, XCSRRepr::kOBR>{});
+
+        case XCSRRepr::kUBR:
+            return func(std::integral_constant<XCSRRepr, XCSRRepr::kUBR>{});
+
+        default:
+            throw std::invalid_argument("DispatchRepr() received an unknown XCSRRepr value.");
+        }
+    }
+
     // --- Functions that depends on the representation ---
+    //   The template versions resolve the representation at compile time.
+    //   (GetLowerBound<Repr>() and GetUpperBound<Repr>() are defined in symbol.hpp.)
+
+    template <XCSRRepr Repr>
+    double ClampSymbolValue1(double v1, double minValue, double maxValue, bool doRangeRestriction)
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            // CSR
+            return std::clamp(v1, minValue, maxValue);
+        }
+        else
+        {
+            // OBR and UBR
+            return doRangeRestriction ? std::clamp(v1, minValue, maxValue) : v1;
+        }
+    }
+
+    template <XCSRRepr Repr>
+    double ClampSymbolValue2(double v2, double minValue, double maxValue, bool doRangeRestriction)
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            // CSR
+            return std::max(v2, 0.0);
+        }
+        else
+        {
+            // OBR and UBR
+            return doRangeRestriction ? std::clamp(v2, minValue, maxValue) : v2;
+        }
+    }
+
+    template <XCSRRepr Repr>
+    Symbol MakeCoveringSymbol(double inputValue, const XCSRParams *pParams, Random & random);
 
     double GetLowerBound(const Symbol & s, XCSRRepr repr);
 
@@ -1,7 +1,9 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include <cstdint> // std::uint32_t
 #include <cstddef> // std::size_t
 
 #include "ienvironment.hpp"
@@ -149,6 +151,15 @@ namespace xcspp
             return m_isEndOfProblem;
         }
 
+        // Writes the state for a checkpoint
+        virtual void outputCheckpoint(std::ostream & os) const override;
+
+        // Reads the state written by outputCheckpoint()
+        virtual void inputCheckpoint(std::istream & is) override;
+
+        // Seeds the random engine and starts again from a new situation
+        virtual void seed(std::uint32_t seed) override;
+
         virtual std::unordered_set<int> availableActions() const override
         {
             if (m_allowsDiagonalAction)
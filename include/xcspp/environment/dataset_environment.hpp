@@ -1,11 +1,17 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include <vector>
 #include <unordered_set>
+#include <utility> // std::move
+#include <stdexcept>
+#include <cstdint> // std::uint32_t, std::uint64_t
 #include <cstddef>
 
 #include "ienvironment.hpp"
+#include "xcspp/util/binary_stream.hpp"
 #include "xcspp/util/random.hpp"
 #include "xcspp/util/dataset.hpp"
+#include "xcspp/util/span.hpp"
 
 namespace xcspp
 {
@@ -16,8 +22,7 @@ namespace xcspp
     protected:
         const BasicDataset<T> m_dataset;
         const std::unordered_set<int> m_availableActions;
-        std::vector<T> m_situation;
-        int m_answer;
+        std::size_t m_situationIdx;
         std::size_t m_nextIdx;
         const bool m_chooseRandom;
         bool m_isEndOfProblem;
@@ -26,18 +31,30 @@ namespace xcspp
         std::size_t loadNext();
 
     public:
-        BasicDatasetEnvironment(const BasicDataset<T> & dataset, bool chooseRandom = true);
+        BasicDatasetEnvironment(BasicDataset<T> dataset, bool chooseRandom = true);
 
         virtual ~BasicDatasetEnvironment() = default;
 
         virtual std::vector<T> situation() const override;
 
+        // Returns current situation as a view of the row in the dataset (without copying)
+        virtual Span<const T> situationView() const override;
+
         virtual double executeAction(int action) override;
 
         virtual bool isEndOfProblem() const override;
 
         virtual std::unordered_set<int> availableActions() const override;
 
+        // Writes the state for a checkpoint (the dataset itself is not written)
+        virtual void outputCheckpoint(std::ostream & os) const override;
+
+        // Reads the state written by outputCheckpoint()
+        virtual void inputCheckpoint(std::istream & is) override;
+
+        // Seeds the random engine and starts again from the first situation (or a random one if chooseRandom is true)
+        virtual void seed(std::uint32_t seed) override;
+
         // Returns the answer
         int getAnswer() const;
     };
@@ -51,7 +68,7 @@ namespace xcspp
         std::unordered_set<int> GetAvailableActionsInDataset(const BasicDataset<T> & dataset)
         {
             std::unordered_set<int> availableActions;
-            for (const auto & action : dataset.actions)
+            for (const auto & action : dataset.actions())
             {
                 availableActions.insert(action); // already inserted items are ignored here
             }
@@ -64,38 +81,30 @@ namespace xcspp
     {
         if (m_chooseRandom)
         {
-            const auto idx = m_random.nextInt<std::size_t>(0UL, m_dataset.situations.size() - 1UL);
-            m_situation = m_dataset.situations[idx];
-            m_answer = m_dataset.actions[idx];
-            return idx;
+            m_situationIdx = m_random.nextInt<std::size_t>(0UL, m_dataset.size() - 1UL);
+            return m_situationIdx;
         }
         else
         {
-            m_situation = m_dataset.situations[m_nextIdx];
-            m_answer = m_dataset.actions[m_nextIdx];
-            const auto idx = m_nextIdx;
-            if (++m_nextIdx >= m_dataset.situations.size())
+            m_situationIdx = m_nextIdx;
+            if (++m_nextIdx >= m_dataset.size())
             {
                 m_nextIdx = 0;
             }
-            return idx;
+            return m_situationIdx;
         }
     }
 
     template <typename T>
-    BasicDatasetEnvironment<T>::BasicDatasetEnvironment(const BasicDataset<T> & dataset, bool chooseRandom)
-        : m_dataset(dataset)
-        , m_availableActions(detail::GetAvailableActionsInDataset(dataset))
+    BasicDatasetEnvironment<T>::BasicDatasetEnvironment(BasicDataset<T> dataset, bool chooseRandom)
+        : m_dataset(std::move(dataset))
+        , m_availableActions(detail::GetAvailableActionsInDataset(m_dataset))
+        , m_situationIdx(0)
         , m_nextIdx(0)
         , m_chooseRandom(chooseRandom)
         , m_isEndOfProblem(false)
     {
-        if (m_dataset.situations.size() != m_dataset.actions.size())
-        {
-            throw std::domain_error("The dataset size is invalid in DatasetEnvironment constructor (situations/actions size does not match).");
-        }
-
-        if (m_dataset.situations.empty() || m_dataset.actions.empty())
+        if (m_dataset.empty())
         {
             throw std::runtime_error("DatasetEnvironment constructor received an empty dataset.");
         }
@@ -106,13 +115,20 @@ namespace xcspp
     template <typename T>
     std::vector<T> BasicDatasetEnvironment<T>::situation() const
     {
-        return m_situation;
+        const auto view = situationView();
+        return std::vector<T>(view.begin(), view.end());
+    }
+
+    template <typename T>
+    Span<const T> BasicDatasetEnvironment<T>::situationView() const
+    {
+        return m_dataset.situation(m_situationIdx);
     }
 
     template <typename T>
     double BasicDatasetEnvironment<T>::executeAction(int action)
     {
-        const double reward = (action == m_answer) ? 1000.0 : 0.0;
+        const double reward = (action == getAnswer()) ? 1000.0 : 0.0;
 
         // Single-step problem
         m_isEndOfProblem = true;
@@ -134,9 +150,46 @@ namespace xcspp
         return m_availableActions;
     }
 
+    template <typename T>
+    void BasicDatasetEnvironment<T>::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        writer.write<std::uint64_t>(m_dataset.size());
+        writer.write<std::uint64_t>(m_situationIdx);
+        writer.write<std::uint64_t>(m_nextIdx);
+        writer.write(m_isEndOfProblem);
+        writer.writeString(m_random.state());
+    }
+
+    template <typename T>
+    void BasicDatasetEnvironment<T>::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        const auto datasetSize = reader.read<std::uint64_t>();
+        const auto situationIdx = reader.read<std::uint64_t>();
+        const auto nextIdx = reader.read<std::uint64_t>();
+        if (datasetSize != m_dataset.size() || situationIdx >= m_dataset.size() || nextIdx >= m_dataset.size())
+        {
+            throw std::invalid_argument("DatasetEnvironment::inputCheckpoint() received a checkpoint of a different dataset.");
+        }
+        m_isEndOfProblem = reader.read<bool>();
+        m_random.setState(reader.readString());
+        m_situationIdx = static_cast<std::size_t>(situationIdx);
+        m_nextIdx = static_cast<std::size_t>(nextIdx);
+    }
+
+    template <typename T>
+    void BasicDatasetEnvironment<T>::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+        m_nextIdx = 0;
+        m_isEndOfProblem = false;
+        loadNext();
+    }
+
     template <typename T>
     int BasicDatasetEnvironment<T>::getAnswer() const
     {
-        return m_answer;
+        return m_dataset.action(m_situationIdx);
     }
 }
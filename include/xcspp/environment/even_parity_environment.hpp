@@ -1,18 +1,20 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include <vector>
+#include <cstdint> // std::uint32_t
 #include <cstddef> // std::size_t
 
-#include "ienvironment.hpp"
+#include "ibinary_environment.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp
 {
 
-    class EvenParityEnvironment : public IEnvironment
+    class EvenParityEnvironment : public IBinaryEnvironment
     {
     private:
         const std::size_t m_length;
-        std::vector<int> m_situation;
+        xcs::PackedSituation m_situation;
         bool m_isEndOfProblem;
         Random m_random;
 
@@ -26,6 +28,9 @@ namespace xcspp
         // Returns current situation
         virtual std::vector<int> situation() const override;
 
+        // Returns current situation (bit-packed)
+        virtual const xcs::PackedSituation & packedSituation() const override;
+
         // Executes action (and update situation), and returns reward
         virtual double executeAction(int action) override;
 
@@ -33,6 +38,15 @@ namespace xcspp
         // (Since it is a single-step problem, this function always returns true after the first action execution)
         virtual bool isEndOfProblem() const override;
 
+        // Writes the state for a checkpoint
+        virtual void outputCheckpoint(std::ostream & os) const override;
+
+        // Reads the state written by outputCheckpoint()
+        virtual void inputCheckpoint(std::istream & is) override;
+
+        // Seeds the random engine and starts again from a new situation
+        virtual void seed(std::uint32_t seed) override;
+
         // Returns available action choices
         virtual std::unordered_set<int> availableActions() const override
         {
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+
+#include "ienvironment.hpp"
+#include "xcspp/core/xcs/packed_situation.hpp"
+
+namespace xcspp
+{
+
+    // Environment interface for binary problems
+    //   The current situation is also available as xcs::PackedSituation, which
+    //   xcs::PackedXCS can match without going through std::vector<int>.
+    class IBinaryEnvironment : public IEnvironment
+    {
+    private:
+        // Buffer of situationView()
+        mutable std::vector<int> m_unpackedSituation;
+
+    public:
+        IBinaryEnvironment() = default;
+
+        virtual ~IBinaryEnvironment() = default;
+
+        // Returns current situation (bit-packed)
+        virtual const xcs::PackedSituation & packedSituation() const = 0;
+
+        // Returns current situation unpacked from packedSituation() into a buffer reused across steps
+        virtual Span<const int> situationView() const override
+        {
+            const auto & situation = packedSituation();
+            m_unpackedSituation.resize(situation.size());
+            for (std::size_t i = 0; i < situation.size(); ++i)
+            {
+                m_unpackedSituation[i] = situation[i];
+            }
+            return m_unpackedSituation;
+        }
+    };
+
+}
@@ -1,6 +1,11 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include <vector>
 #include <unordered_set>
+#include <stdexcept>
+#include <cstdint> // std::uint32_t
+
+#include "xcspp/util/span.hpp"
 
 namespace xcspp
 {
@@ -11,6 +16,10 @@ namespace xcspp
     template <typename T>
     class IBasicEnvironment
     {
+    private:
+        // Buffer of the default situationView()
+        mutable std::vector<T> m_situationViewBuffer;
+
     public:
         using type = T;
 
@@ -21,6 +30,15 @@ namespace xcspp
         // Returns current situation
         virtual std::vector<T> situation() const = 0;
 
+        // Returns current situation as a view, which is valid until the environment is modified
+        // (The default implementation copies situation() into a buffer of this object. Override this
+        //  to return a view of your own storage so that ExperimentHelper does not copy the situation.)
+        virtual Span<const T> situationView() const
+        {
+            m_situationViewBuffer = situation();
+            return m_situationViewBuffer;
+        }
+
         // Executes action (and updates situation), and returns reward
         virtual double executeAction(int action) = 0;
 
@@ -30,6 +48,29 @@ namespace xcspp
 
         // Returns available action choices (e.g. { 0, 1 })
         virtual std::unordered_set<int> availableActions() const = 0;
+
+        // Writes the state (e.g., the current situation and the random engine) for a checkpoint
+        // (The default implementation throws std::domain_error. Override this and inputCheckpoint()
+        //  to save the checkpoints of ExperimentHelper with your own environment.)
+        virtual void outputCheckpoint(std::ostream &) const
+        {
+            throw std::domain_error("The environment does not support checkpoints.");
+        }
+
+        // Reads the state written by outputCheckpoint()
+        virtual void inputCheckpoint(std::istream &)
+        {
+            throw std::domain_error("The environment does not support checkpoints.");
+        }
+
+        // Seeds the random engine and starts again from a new situation, so that the environment
+        // generates the same problems as the ones seeded with the same value
+        // (The default implementation throws std::domain_error. Override this to set the seed of
+        //  ExperimentSettings with your own environment.)
+        virtual void seed(std::uint32_t)
+        {
+            throw std::domain_error("The environment does not support seeding.");
+        }
     };
 
     // Environment interface for XCS
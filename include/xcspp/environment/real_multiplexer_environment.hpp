@@ -1,5 +1,7 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include <vector>
+#include <cstdint> // std::uint32_t
 #include <cstddef> // std::size_t
 
 #include "ienvironment.hpp"
@@ -28,6 +30,9 @@ namespace xcspp
         // Returns current situation
         virtual std::vector<double> situation() const override;
 
+        // Returns current situation without copying
+        virtual Span<const double> situationView() const override;
+
         // Executes action (and update situation), and returns reward
         virtual double executeAction(int action) override;
 
@@ -35,6 +40,15 @@ namespace xcspp
         // (Since it is a single-step problem, this function always returns true after the first action execution)
         virtual bool isEndOfProblem() const override;
 
+        // Writes the state for a checkpoint
+        virtual void outputCheckpoint(std::ostream & os) const override;
+
+        // Reads the state written by outputCheckpoint()
+        virtual void inputCheckpoint(std::istream & is) override;
+
+        // Seeds the random engine and starts again from a new situation
+        virtual void seed(std::uint32_t seed) override;
+
         // Returns available action choices
         virtual std::unordered_set<int> availableActions() const override
         {
@@ -1,12 +1,18 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include <memory> // std::unique_ptr
 #include <functional> // std::function
 #include <vector>
 #include <unordered_set>
+#include <optional>
 #include <stdexcept>
+#include <cstdint> // std::uint32_t, std::uint64_t
 #include <cstddef> // std::size_t
 
-#include "xcspp/core/xcs/xcs.hpp"
+#include "xcspp/core/checkpoint.hpp"
+#include "xcspp/core/population_snapshot.hpp"
+#include "xcspp/core/iclassifier_system.hpp"
+#include "xcspp/util/random.hpp"
 #include "xcspp/environment/ienvironment.hpp"
 #include "experiment_settings.hpp"
 #include "experiment_log_stream.hpp"
@@ -16,6 +22,16 @@
 namespace xcspp
 {
 
+    // Streams of SeedSequence for the random engines of an experiment
+    //   BasicExperimentHelper seeds the system and the environments with
+    //   SeedSequence(ExperimentSettings::seed).seed(stream) when they are constructed.
+    enum class ExperimentSeedStream : std::uint64_t
+    {
+        kSystem = 0,
+        kTrainEnvironment = 1,
+        kTestEnvironment = 2,
+    };
+
     class IExperimentHelper
     {
     public:
@@ -33,6 +49,13 @@ namespace xcspp
 
         virtual void outputPopulationCSV(std::ostream & os) const = 0;
 
+        virtual bool savePopulationBinaryFile(const std::string & filename) const = 0;
+
+        // Save the whole state of the experiment (refer to BasicExperimentHelper::outputCheckpoint())
+        virtual bool saveCheckpointFile(const std::string & filename) const = 0;
+
+        virtual bool loadCheckpointFile(const std::string & filename) = 0;
+
         virtual std::size_t iterationCount() const = 0;
     };
 
@@ -52,6 +75,8 @@ namespace xcspp
 
         std::size_t m_iterationCount;
 
+        bool m_isCondensationMode;
+
         // Logger for every iteration
         // (reward, system error, population size, step count)
         ExperimentIterationLogger m_iterationLogger;
@@ -63,6 +88,12 @@ namespace xcspp
 
         void runTestIteration();
 
+        // Hash of the settings that the experiment depends on
+        std::uint64_t settingsHash() const;
+
+        // Seed of the stream derived from the seed in the settings (if any)
+        std::optional<std::uint32_t> streamSeed(ExperimentSeedStream stream) const;
+
     public:
         explicit BasicExperimentHelper(const ExperimentSettings & settings);
 
@@ -99,6 +130,26 @@ namespace xcspp
 
         virtual void outputPopulationCSV(std::ostream & os) const override;
 
+        virtual bool savePopulationBinaryFile(const std::string & filename) const override;
+
+        // Write the whole state of the experiment for a checkpoint
+        //   This includes the iteration count, the loggers, the system and the environments, so the
+        //   experiment resumed with inputCheckpoint() outputs exactly the same logs as the one that
+        //   saved it. (The environments must support checkpoints; refer to IBasicEnvironment.)
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Read the state written by outputCheckpoint()
+        //   The system and the environments must be constructed in the same way as the ones that
+        //   saved it. The log files are truncated to the checkpoint, so set appendLogFiles in
+        //   ExperimentSettings to keep the lines written before the checkpoint.
+        //   (Throws std::invalid_argument if the settings or the hyperparameters are different, and
+        //    std::runtime_error if the stream does not have a valid checkpoint.)
+        void inputCheckpoint(std::istream & is);
+
+        virtual bool saveCheckpointFile(const std::string & filename) const override;
+
+        virtual bool loadCheckpointFile(const std::string & filename) override;
+
         virtual std::size_t iterationCount() const override;
     };
 
@@ -110,7 +161,7 @@ namespace xcspp
             do
             {
                 // Choose action
-                const auto action = m_system->explore(m_trainEnvironment->situation());
+                const auto action = m_system->explore(m_trainEnvironment->situationView());
 
                 // Get reward
                 const double reward = m_trainEnvironment->executeAction(action);
@@ -135,7 +186,7 @@ namespace xcspp
                 do
                 {
                     // Choose action
-                    const auto action = m_system->exploit(m_testEnvironment->situation(), m_settings.updateInExploitation);
+                    const auto action = m_system->exploit(m_testEnvironment->situationView(), m_settings.updateInExploitation);
 
                     // Get reward
                     const double reward = m_testEnvironment->executeAction(action);
@@ -161,8 +212,30 @@ namespace xcspp
             }
 
             m_iterationLogger.oneIteration();
-            m_summaryLogger.oneIteration();
+            m_summaryLogger.oneIteration(m_system->matchSetCacheStatistics());
+        }
+    }
+
+    template <typename T>
+    std::uint64_t BasicExperimentHelper<T>::settingsHash() const
+    {
+        return ParamsHasher()
+            .add(static_cast<std::uint64_t>(m_settings.explorationRepeat))
+            .add(static_cast<std::uint64_t>(m_settings.exploitationRepeat))
+            .add(m_settings.updateInExploitation)
+            .add(static_cast<std::uint64_t>(m_settings.summaryInterval))
+            .add(static_cast<std::uint64_t>(m_settings.smaWidth))
+            .hash();
+    }
+
+    template <typename T>
+    std::optional<std::uint32_t> BasicExperimentHelper<T>::streamSeed(ExperimentSeedStream stream) const
+    {
+        if (!m_settings.seed)
+        {
+            return std::nullopt;
         }
+        return SeedSequence(*m_settings.seed).seed(static_cast<std::uint64_t>(stream));
     }
 
     template <typename T>
@@ -171,13 +244,10 @@ namespace xcspp
         , m_trainCallback(nullptr)
         , m_testCallback(nullptr)
         , m_iterationCount(0)
+        , m_isCondensationMode(false)
         , m_iterationLogger(settings)
         , m_summaryLogger(settings)
     {
-        if (!settings.inputClassifierFilename.empty())
-        {
-            m_system->loadPopulationCSVFile(settings.inputClassifierFilename, settings.initializeInputClassifier);
-        }
     }
 
     template <typename T>
@@ -206,6 +276,17 @@ namespace xcspp
         {
             throw std::bad_alloc();
         }
+
+        // Load the initial population
+        if (!m_settings.inputClassifierFilename.empty())
+        {
+            m_system->loadPopulationCSVFile(m_settings.inputClassifierFilename, m_settings.initializeInputClassifier);
+        }
+
+        if (const auto seed = streamSeed(ExperimentSeedStream::kSystem))
+        {
+            m_system->seed(*seed);
+        }
         return *dynamic_cast<ClassifierSystem *>(m_system.get());
     }
 
@@ -218,6 +299,10 @@ namespace xcspp
         {
             throw std::bad_alloc();
         }
+        if (const auto seed = streamSeed(ExperimentSeedStream::kTrainEnvironment))
+        {
+            m_trainEnvironment->seed(*seed);
+        }
         return *dynamic_cast<Environment *>(m_trainEnvironment.get());
     }
 
@@ -230,6 +315,10 @@ namespace xcspp
         {
             throw std::bad_alloc();
         }
+        if (const auto seed = streamSeed(ExperimentSeedStream::kTestEnvironment))
+        {
+            m_testEnvironment->seed(*seed);
+        }
         return *dynamic_cast<Environment *>(m_testEnvironment.get());
     }
 
@@ -275,6 +364,7 @@ namespace xcspp
     void BasicExperimentHelper<T>::switchToCondensationMode()
     {
         m_system->switchToCondensationMode();
+        m_isCondensationMode = true;
     }
 
     template <typename T>
@@ -319,6 +409,71 @@ namespace xcspp
         m_system->outputPopulationCSV(os);
     }
 
+    template <typename T>
+    bool BasicExperimentHelper<T>::savePopulationBinaryFile(const std::string & filename) const
+    {
+        return m_system->savePopulationBinaryFile(filename);
+    }
+
+    template <typename T>
+    void BasicExperimentHelper<T>::outputCheckpoint(std::ostream & os) const
+    {
+        if (!m_system || !m_trainEnvironment || !m_testEnvironment)
+        {
+            throw std::domain_error("ExperimentHelper: the system and the environments must be constructed before outputCheckpoint().");
+        }
+
+        BinaryWriter writer(os);
+        WriteCheckpointHeader(writer, CheckpointKind::kExperimentHelper, settingsHash());
+        writer.write<std::uint64_t>(m_iterationCount);
+        writer.write(m_isCondensationMode);
+        m_system->outputCheckpoint(os);
+        m_trainEnvironment->outputCheckpoint(os);
+        m_testEnvironment->outputCheckpoint(os);
+        m_iterationLogger.outputCheckpoint(os);
+        m_summaryLogger.outputCheckpoint(os);
+    }
+
+    template <typename T>
+    void BasicExperimentHelper<T>::inputCheckpoint(std::istream & is)
+    {
+        if (!m_system || !m_trainEnvironment || !m_testEnvironment)
+        {
+            throw std::domain_error("ExperimentHelper: the system and the environments must be constructed before inputCheckpoint().");
+        }
+
+        BinaryReader reader(is);
+        ReadCheckpointHeader(reader, CheckpointKind::kExperimentHelper, settingsHash());
+        const auto iterationCount = reader.read<std::uint64_t>();
+
+        // The hyperparameters of the system are changed in the condensation mode
+        if (reader.read<bool>() && !m_isCondensationMode)
+        {
+            switchToCondensationMode();
+        }
+
+        m_system->inputCheckpoint(is);
+        m_trainEnvironment->inputCheckpoint(is);
+        m_testEnvironment->inputCheckpoint(is);
+
+        // Read the loggers last since they truncate the log files
+        m_iterationLogger.inputCheckpoint(is);
+        m_summaryLogger.inputCheckpoint(is);
+        m_iterationCount = static_cast<std::size_t>(iterationCount);
+    }
+
+    template <typename T>
+    bool BasicExperimentHelper<T>::saveCheckpointFile(const std::string & filename) const
+    {
+        return SaveCheckpointFile(*this, filename);
+    }
+
+    template <typename T>
+    bool BasicExperimentHelper<T>::loadCheckpointFile(const std::string & filename)
+    {
+        return LoadCheckpointFile(*this, filename);
+    }
+
     template <typename T>
     std::size_t BasicExperimentHelper<T>::iterationCount() const
     {
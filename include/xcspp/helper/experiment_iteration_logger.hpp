@@ -1,4 +1,5 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include "experiment_log_stream.hpp"
 #include "experiment_settings.hpp"
 
@@ -27,6 +28,12 @@ namespace xcspp
         void oneExploitation(std::size_t populationSize);
 
         void oneIteration();
+
+        // Writes the accumulated values and the state of the log files for a checkpoint
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Reads the state written by outputCheckpoint() (the log files are truncated to the checkpoint)
+        void inputCheckpoint(std::istream & is);
     };
 
 }
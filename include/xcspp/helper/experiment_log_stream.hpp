@@ -1,5 +1,5 @@
 #pragma once
-#include <iosfwd> // std::ostream
+#include <iosfwd> // std::istream, std::ostream
 #include <fstream>
 #include <string>
 #include <cstddef>
@@ -11,13 +11,15 @@ namespace xcspp
     class ExperimentLogStream
     {
     private:
+        const std::string m_filename;
         std::ofstream m_ofs;
 
     protected:
         std::ostream & m_os;
 
     public:
-        explicit ExperimentLogStream(const std::string & filename = "", bool useStdoutWhenEmpty = true);
+        // (Set appendsToFile to true to keep the existing lines in the file, e.g., for resuming from a checkpoint.)
+        explicit ExperimentLogStream(const std::string & filename = "", bool useStdoutWhenEmpty = true, bool appendsToFile = false);
 
         virtual ~ExperimentLogStream() = default;
 
@@ -28,6 +30,13 @@ namespace xcspp
         virtual void write(double value);
 
         virtual void writeLine(double value);
+
+        // Writes the size of the log file for a checkpoint
+        virtual void outputCheckpoint(std::ostream & os) const;
+
+        // Truncates the log file to the size written by outputCheckpoint()
+        // (The lines written after the checkpoint are discarded so that they are not duplicated.)
+        virtual void inputCheckpoint(std::istream & is);
     };
 
     class SMAExperimentLogStream : public ExperimentLogStream
@@ -37,11 +46,16 @@ namespace xcspp
         std::size_t m_count;
 
     public:
-        explicit SMAExperimentLogStream(const std::string & filename = "", std::size_t smaWidth = 1, bool useStdoutWhenEmpty = true);
+        explicit SMAExperimentLogStream(const std::string & filename = "", std::size_t smaWidth = 1, bool useStdoutWhenEmpty = true, bool appendsToFile = false);
 
         virtual void write(double value) override;
 
         virtual void writeLine(double value) override;
+
+        // (The values in the moving average are also written.)
+        virtual void outputCheckpoint(std::ostream & os) const override;
+
+        virtual void inputCheckpoint(std::istream & is) override;
     };
 
 }
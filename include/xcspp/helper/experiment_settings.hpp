@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include <optional>
+#include <cstdint> // std::uint64_t
 #include <cstddef> // std::size_t
 
 namespace xcspp
@@ -40,6 +42,10 @@ namespace xcspp
         // The filename of number-of-step log csv output in multi-step problems
         std::string outputStepCountFilename = "";
 
+        // Whether to append the logs to the existing files instead of overwriting them
+        // (set "true" when resuming from a checkpoint)
+        bool appendLogFiles = false;
+
         // The classifier csv filename for initial population
         std::string inputClassifierFilename = "";
 
@@ -50,6 +56,10 @@ namespace xcspp
 
         // The width of the simple moving average for the reward log
         std::size_t smaWidth = 1;
+
+        // The master seed of the random engines of the system and the environments (refer to ExperimentSeedStream)
+        //   If this is empty, each of them is seeded by std::random_device.
+        std::optional<std::uint64_t> seed;
     };
 
 }
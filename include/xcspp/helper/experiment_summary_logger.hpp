@@ -1,7 +1,10 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
 #include <fstream> // std::ofstream
+#include <string>
 #include <cstddef> // std::size_t
 #include "experiment_settings.hpp"
+#include "xcspp/core/match_set_cache.hpp"
 
 namespace xcspp
 {
@@ -9,6 +12,7 @@ namespace xcspp
     class ExperimentSummaryLogger
     {
     private:
+        const std::string m_logFilename;
         std::ofstream m_logStream;
         const bool m_outputsToStdout;
         const std::size_t m_intervalIteration;
@@ -20,6 +24,13 @@ namespace xcspp
         double m_coveringOccurrenceRateSum;
         double m_stepCountSum;
 
+        // Cumulative statistics of the match set cache (current and at the previous log line)
+        MatchSetCacheStatistics m_matchSetCacheStatistics;
+        MatchSetCacheStatistics m_prevMatchSetCacheStatistics;
+
+        // Whether to output the hit rate of the match set cache (decided with the header)
+        bool m_outputsMatchSetCacheHitRate;
+
         bool m_alreadyOutputHeader;
         std::size_t m_currentIterationCount;
         std::size_t m_currentStepCount;
@@ -33,7 +44,14 @@ namespace xcspp
 
         void oneExploitation(std::size_t populationSize);
 
-        void oneIteration();
+        // (The hit rate of the match set cache is output if the statistics have any lookup.)
+        void oneIteration(const MatchSetCacheStatistics & matchSetCacheStatistics = MatchSetCacheStatistics());
+
+        // Writes the accumulated values and the size of the log file for a checkpoint
+        void outputCheckpoint(std::ostream & os) const;
+
+        // Reads the state written by outputCheckpoint() (the log file is truncated to the checkpoint)
+        void inputCheckpoint(std::istream & is);
     };
 
 }
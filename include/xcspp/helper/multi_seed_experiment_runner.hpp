@@ -0,0 +1,308 @@
+#pragma once
+#include <memory> // std::unique_ptr, std::make_unique
+#include <functional> // std::function
+#include <string>
+#include <vector>
+#include <initializer_list>
+#include <thread>
+#include <atomic>
+#include <exception> // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <algorithm> // std::min, std::max
+#include <stdexcept>
+#include <cstddef> // std::size_t
+
+#include "experiment_helper.hpp"
+#include "experiment_settings.hpp"
+
+namespace xcspp
+{
+
+    // Filename of the output of each seed (e.g., "log/reward.csv" -> "log/reward_seed3.csv")
+    std::string SeedFilename(const std::string & filename, std::size_t seedIdx);
+
+    // Write the average of the CSV log files line by line and field by field
+    //   A field that has the same text in all files (e.g., the header and the iteration count) is
+    //   copied as it is, and the other fields are averaged as numbers. The output ends at the
+    //   shortest file.
+    //   (Throws std::runtime_error if a file cannot be opened or a differing field is not a number.)
+    void AverageLogFiles(const std::vector<std::string> & inputFilenames, const std::string & outputFilename);
+
+    // Runner of the same experiment with multiple seeds
+    //   Each seed has its own BasicExperimentHelper (with its own system and environments), and
+    //   runIteration() runs them on a thread pool. The seeds never share any state, so the result of
+    //   each seed does not depend on the number of threads or the order in which they are scheduled.
+    //   With two or more seeds, the experiment of each seed writes its logs to the files named by
+    //   SeedFilename(), and outputAveragedLogs() writes their average to the files in the settings.
+    //   If ExperimentSettings::seed is set, the experiment of each seed is seeded with
+    //   SeedSequence(seed).child(seedIdx), so the whole result is reproducible.
+    //   With one seed, the runner works in the same way as a single BasicExperimentHelper
+    //   (with ExperimentSettings::seed as it is).
+    template <typename T>
+    class BasicMultiSeedExperimentRunner
+    {
+    public:
+        using type = T;
+
+        // Function to construct the system and the environments of the experiment of each seed
+        //   (Called in the order of the seed index on the thread that constructs the runner.)
+        using SetupFunction = std::function<void(BasicExperimentHelper<T> & helper, std::size_t seedIdx)>;
+
+    private:
+        const ExperimentSettings m_settings;
+        const std::size_t m_seedCount;
+        const std::size_t m_threadCount;
+        std::vector<std::unique_ptr<BasicExperimentHelper<T>>> m_helpers;
+
+        // Settings of the experiment of the seed (with the log filenames of the seed)
+        ExperimentSettings seedSettings(std::size_t seedIdx) const;
+
+        // Call func(helper) for each seed on the thread pool
+        template <class Function>
+        void forEachHelperInParallel(Function func);
+
+    public:
+        // Constructor
+        // (Set threadCount to 0 to use std::thread::hardware_concurrency() threads.)
+        BasicMultiSeedExperimentRunner(const ExperimentSettings & settings, std::size_t seedCount, const SetupFunction & setup, std::size_t threadCount = 0);
+
+        ~BasicMultiSeedExperimentRunner() = default;
+
+        std::size_t seedCount() const;
+
+        // The number of threads that run the seeds
+        std::size_t threadCount() const;
+
+        BasicExperimentHelper<T> & helper(std::size_t seedIdx);
+
+        const BasicExperimentHelper<T> & helper(std::size_t seedIdx) const;
+
+        // Filename of the output of the seed (the filename itself if there is only one seed)
+        std::string seedFilename(const std::string & filename, std::size_t seedIdx) const;
+
+        void runIteration(std::size_t repeat = 1);
+
+        void switchToCondensationMode();
+
+        std::size_t iterationCount() const;
+
+        // Write the average of the logs of all seeds (nothing is written if there is only one seed)
+        void outputAveragedLogs() const;
+
+        // Save the checkpoint of each seed to seedFilename(filename, seedIdx)
+        // (Returns false if any of the files cannot be written.)
+        bool saveCheckpointFile(const std::string & filename) const;
+
+        // Load the checkpoint of each seed from seedFilename(filename, seedIdx)
+        // (Returns false if any of the files cannot be opened.)
+        bool loadCheckpointFile(const std::string & filename);
+    };
+
+    using MultiSeedExperimentRunner = BasicMultiSeedExperimentRunner<int>;
+    using RealMultiSeedExperimentRunner = BasicMultiSeedExperimentRunner<double>;
+
+    template <typename T>
+    ExperimentSettings BasicMultiSeedExperimentRunner<T>::seedSettings(std::size_t seedIdx) const
+    {
+        ExperimentSettings settings = m_settings;
+        if (seedCount() > 1)
+        {
+            for (std::string * filename : {
+                &settings.outputSummaryFilename,
+                &settings.outputRewardFilename,
+                &settings.outputPopulationSizeFilename,
+                &settings.outputSystemErrorFilename,
+                &settings.outputStepCountFilename })
+            {
+                if (!filename->empty())
+                {
+                    *filename = SeedFilename(*filename, seedIdx);
+                }
+            }
+
+            // The summaries of the seeds would be mixed up in stdout
+            settings.outputSummaryToStdout = false;
+
+            // Each seed has its own sequence derived from the master seed
+            if (settings.seed)
+            {
+                settings.seed = SeedSequence(*settings.seed).child(seedIdx).masterSeed();
+            }
+        }
+        return settings;
+    }
+
+    template <typename T>
+    template <class Function>
+    void BasicMultiSeedExperimentRunner<T>::forEachHelperInParallel(Function func)
+    {
+        const std::size_t threadCount = std::min(m_threadCount, m_helpers.size());
+        if (threadCount <= 1)
+        {
+            for (auto & helper : m_helpers)
+            {
+                func(*helper);
+            }
+            return;
+        }
+
+        // Each thread takes the next seed until all seeds are done
+        std::atomic<std::size_t> nextSeedIdx(0);
+        std::vector<std::exception_ptr> exceptions(m_helpers.size());
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([this, &func, &nextSeedIdx, &exceptions]() {
+                std::size_t seedIdx;
+                while ((seedIdx = nextSeedIdx++) < m_helpers.size())
+                {
+                    try
+                    {
+                        func(*m_helpers[seedIdx]);
+                    }
+                    catch (...)
+                    {
+                        exceptions[seedIdx] = std::current_exception();
+                    }
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+
+        // Rethrow the exception of the smallest seed index
+        for (const auto & exception : exceptions)
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+
+    template <typename T>
+    BasicMultiSeedExperimentRunner<T>::BasicMultiSeedExperimentRunner(const ExperimentSettings & settings, std::size_t seedCount, const SetupFunction & setup, std::size_t threadCount)
+        : m_settings(settings)
+        , m_seedCount(seedCount)
+        , m_threadCount((threadCount > 0) ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+    {
+        if (seedCount == 0)
+        {
+            throw std::invalid_argument("MultiSeedExperimentRunner constructor received zero as seedCount.");
+        }
+
+        m_helpers.reserve(seedCount);
+        for (std::size_t i = 0; i < seedCount; ++i)
+        {
+            m_helpers.push_back(std::make_unique<BasicExperimentHelper<T>>(seedSettings(i)));
+            setup(*m_helpers.back(), i);
+        }
+    }
+
+    template <typename T>
+    std::size_t BasicMultiSeedExperimentRunner<T>::seedCount() const
+    {
+        return m_seedCount;
+    }
+
+    template <typename T>
+    std::size_t BasicMultiSeedExperimentRunner<T>::threadCount() const
+    {
+        return std::min(m_threadCount, m_seedCount);
+    }
+
+    template <typename T>
+    BasicExperimentHelper<T> & BasicMultiSeedExperimentRunner<T>::helper(std::size_t seedIdx)
+    {
+        return *m_helpers.at(seedIdx);
+    }
+
+    template <typename T>
+    const BasicExperimentHelper<T> & BasicMultiSeedExperimentRunner<T>::helper(std::size_t seedIdx) const
+    {
+        return *m_helpers.at(seedIdx);
+    }
+
+    template <typename T>
+    std::string BasicMultiSeedExperimentRunner<T>::seedFilename(const std::string & filename, std::size_t seedIdx) const
+    {
+        return (seedCount() > 1) ? SeedFilename(filename, seedIdx) : filename;
+    }
+
+    template <typename T>
+    void BasicMultiSeedExperimentRunner<T>::runIteration(std::size_t repeat)
+    {
+        forEachHelperInParallel([repeat](BasicExperimentHelper<T> & helper) {
+            helper.runIteration(repeat);
+        });
+    }
+
+    template <typename T>
+    void BasicMultiSeedExperimentRunner<T>::switchToCondensationMode()
+    {
+        for (auto & helper : m_helpers)
+        {
+            helper->switchToCondensationMode();
+        }
+    }
+
+    template <typename T>
+    std::size_t BasicMultiSeedExperimentRunner<T>::iterationCount() const
+    {
+        return m_helpers.front()->iterationCount();
+    }
+
+    template <typename T>
+    void BasicMultiSeedExperimentRunner<T>::outputAveragedLogs() const
+    {
+        if (seedCount() <= 1)
+        {
+            return;
+        }
+
+        for (const std::string * filename : {
+            &m_settings.outputSummaryFilename,
+            &m_settings.outputRewardFilename,
+            &m_settings.outputPopulationSizeFilename,
+            &m_settings.outputSystemErrorFilename,
+            &m_settings.outputStepCountFilename })
+        {
+            if (!filename->empty())
+            {
+                std::vector<std::string> seedFilenames;
+                for (std::size_t i = 0; i < seedCount(); ++i)
+                {
+                    seedFilenames.push_back(m_settings.outputFilenamePrefix + SeedFilename(*filename, i));
+                }
+                AverageLogFiles(seedFilenames, m_settings.outputFilenamePrefix + *filename);
+            }
+        }
+    }
+
+    template <typename T>
+    bool BasicMultiSeedExperimentRunner<T>::saveCheckpointFile(const std::string & filename) const
+    {
+        bool succeeded = true;
+        for (std::size_t i = 0; i < seedCount(); ++i)
+        {
+            succeeded = m_helpers[i]->saveCheckpointFile(seedFilename(filename, i)) && succeeded;
+        }
+        return succeeded;
+    }
+
+    template <typename T>
+    bool BasicMultiSeedExperimentRunner<T>::loadCheckpointFile(const std::string & filename)
+    {
+        for (std::size_t i = 0; i < seedCount(); ++i)
+        {
+            if (!m_helpers[i]->loadCheckpointFile(seedFilename(filename, i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
@@ -1,6 +1,11 @@
 #pragma once
+#include <iosfwd> // std::istream, std::ostream
+#include <stdexcept>
+#include <cstdint> // std::uint64_t
 #include <cstddef> // std::size_t
 
+#include "xcspp/util/binary_stream.hpp"
+
 namespace xcspp
 {
 
@@ -56,6 +61,36 @@ namespace xcspp
         {
             return m_order;
         }
+
+        // Writes the values in the buffer for a checkpoint
+        void outputCheckpoint(std::ostream & os) const
+        {
+            BinaryWriter writer(os);
+            writer.write<std::uint64_t>(m_cursor);
+            writer.write<std::uint64_t>(m_valueCount);
+            for (std::size_t i = 0; i < m_order; ++i)
+            {
+                writer.write(m_pBuffer[i]);
+            }
+        }
+
+        // Reads the values written by outputCheckpoint() (the filter must have the same order)
+        void inputCheckpoint(std::istream & is)
+        {
+            BinaryReader reader(is);
+            const auto cursor = reader.read<std::uint64_t>();
+            const auto valueCount = reader.read<std::uint64_t>();
+            if (cursor >= m_order || valueCount > m_order)
+            {
+                throw std::invalid_argument("UnrecursiveFilter::inputCheckpoint() received a checkpoint of a filter with a different order.");
+            }
+            m_cursor = static_cast<std::size_t>(cursor);
+            m_valueCount = static_cast<std::size_t>(valueCount);
+            for (std::size_t i = 0; i < m_order; ++i)
+            {
+                m_pBuffer[i] = reader.read<T>();
+            }
+        }
     };
 
     // Simple Moving Average
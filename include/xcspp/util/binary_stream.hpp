@@ -0,0 +1,114 @@
+#pragma once
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <algorithm> // std::min
+#include <stdexcept>
+#include <type_traits> // std::is_trivially_copyable_v
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+namespace xcspp
+{
+
+    // Writer of the values in the native binary layout (used for checkpoints)
+    //   The values are written bit for bit, so BinaryReader reads exactly the same values
+    //   on a machine with the same byte order.
+    class BinaryWriter
+    {
+    private:
+        std::ostream & m_os;
+
+    public:
+        // Constructor
+        explicit BinaryWriter(std::ostream & os)
+            : m_os(os)
+        {
+        }
+
+        template <class T>
+        void write(const T & value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter::write() requires a trivially copyable type.");
+            m_os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        // Write the number of the elements followed by the elements
+        template <class T>
+        void writeVector(const std::vector<T> & values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter::writeVector() requires a trivially copyable type.");
+            write<std::uint64_t>(values.size());
+            m_os.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        }
+
+        void writeString(const std::string & str)
+        {
+            write<std::uint64_t>(str.size());
+            m_os.write(str.data(), static_cast<std::streamsize>(str.size()));
+        }
+    };
+
+    // Reader of the values written by BinaryWriter
+    //   Throws std::runtime_error if the stream ends in the middle of a value.
+    class BinaryReader
+    {
+    private:
+        std::istream & m_is;
+
+        // Vectors are read in chunks of this size, so that a corrupted element count
+        // ends up with the end of the stream instead of allocating a huge buffer at once
+        static constexpr std::size_t kChunkByteSize = 1 << 20;
+
+        void readBytes(void * data, std::size_t size)
+        {
+            if (!m_is.read(static_cast<char *>(data), static_cast<std::streamsize>(size)))
+            {
+                throw std::runtime_error("BinaryReader could not read the stream (unexpected end of the stream).");
+            }
+        }
+
+    public:
+        // Constructor
+        explicit BinaryReader(std::istream & is)
+            : m_is(is)
+        {
+        }
+
+        template <class T>
+        T read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryReader::read() requires a trivially copyable type.");
+            T value;
+            readBytes(&value, sizeof(T));
+            return value;
+        }
+
+        template <class T>
+        std::vector<T> readVector()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryReader::readVector() requires a trivially copyable type.");
+            constexpr std::size_t kChunkSize = kChunkByteSize / sizeof(T) + 1;
+
+            std::uint64_t remainingCount = read<std::uint64_t>();
+            std::vector<T> values;
+            while (remainingCount > 0)
+            {
+                const std::size_t offset = values.size();
+                const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(remainingCount, kChunkSize));
+                values.resize(offset + count);
+                readBytes(values.data() + offset, count * sizeof(T));
+                remainingCount -= count;
+            }
+            return values;
+        }
+
+        std::string readString()
+        {
+            const auto chars = readVector<char>();
+            return std::string(chars.begin(), chars.end());
+        }
+    };
+
+}
@@ -3,11 +3,19 @@
 #include <sstream>
 #include <fstream>
 #include <vector>
+#include <string>
+#include <iterator> // std::istreambuf_iterator
+#include <algorithm> // std::count
+#include <charconv> // std::from_chars
 #include <stdexcept>
 #include <cmath>
+#include <cstdlib> // std::strtod
+#include <cerrno> // errno, ERANGE
+#include <cstring> // std::memchr
 #include <cstddef>
 
 #include "dataset.hpp"
+#include "mapped_file.hpp"
 #include "xcspp/core/xcs/classifier.hpp"
 
 namespace xcspp
@@ -27,9 +35,19 @@ namespace xcspp
         template <typename T>
         void SaveCSVFile(const std::string & filename, const std::vector<std::vector<T>> & data);
 
+        // Parse the dataset CSV in the memory range [first, last)
+        //   Each line has the situation followed by the action, and the lines after an empty line are ignored.
+        //   The fields are parsed with std::from_chars (or std::strtod if it does not support double)
+        //   into one row-major buffer, so no memory is allocated for each line. All lines must have
+        //   the same number of fields.
+        //   (Throws std::invalid_argument if a field is not a number or the numbers of fields differ.)
+        template <typename T>
+        BasicDataset<T> ParseDataset(const char * first, const char * last, bool rounds = false);
+
         template <typename T>
         BasicDataset<T> ReadDataset(std::istream & is, bool rounds = false);
 
+        // (The file is memory-mapped and parsed in place with ParseDataset().)
         template <typename T>
         BasicDataset<T> ReadDatasetFromFile(const std::string & filename, bool rounds = false);
 
@@ -114,43 +132,125 @@ namespace xcspp
             return SaveCSV(ofs, data);
         }
 
+        // Parse the number in [first, last) ignoring the surrounding spaces
+        // (Returns false if the field is not a number. Use this instead of std::from_chars for
+        //  floating-point numbers, which older standard libraries do not provide.)
+        inline bool ParseNumber(const char * first, const char * last, double & value)
+        {
+            while (first != last && (*first == ' ' || *first == '\t'))
+            {
+                ++first;
+            }
+            while (first != last && (last[-1] == ' ' || last[-1] == '\t'))
+            {
+                --last;
+            }
+
+            // std::from_chars does not accept the plus sign
+            // (It is skipped only if a sign does not follow it, so that "+-1" is rejected.)
+            if (first != last && *first == '+' && (first + 1 == last || (first[1] != '+' && first[1] != '-')))
+            {
+                ++first;
+            }
+
+#ifdef __cpp_lib_to_chars
+            const auto [ptr, errorCode] = std::from_chars(first, last, value);
+            return errorCode == std::errc() && ptr == last && first != last;
+#else
+            // std::from_chars for floating-point numbers is not available (e.g., older libc++),
+            // so std::strtod parses a NUL-terminated copy of the field
+            // (The decimal point is '.' unless LC_NUMERIC is changed by std::setlocale.)
+            if (first == last || *first == ' ' || *first == '\t')
+            {
+                return false;
+            }
+            const std::string field(first, last);
+            char * end = nullptr;
+            errno = 0;
+            value = std::strtod(field.c_str(), &end);
+            return errno != ERANGE && end == field.c_str() + field.size();
+#endif
+        }
+
         template <typename T>
-        BasicDataset<T> ReadDataset(std::istream & is, bool rounds)
+        BasicDataset<T> ParseDataset(const char * first, const char * last, bool rounds)
         {
-            static_assert(std::is_arithmetic_v<T>, "T of ReadDataset<T> must be an integer type or a floating-point type.");
+            static_assert(std::is_arithmetic_v<T>, "T of ParseDataset<T> must be an integer type or a floating-point type.");
 
-            std::vector<std::vector<T>> situations;
+            std::vector<T> values; // situations in row-major order
             std::vector<int> actions;
+            std::size_t situationSize = 0;
+            actions.reserve(static_cast<std::size_t>(std::count(first, last, '\n')) + 1);
 
-            // Read all lines in csv
-            std::string line;
-            while (std::getline(is, line) && !line.empty())
+            const char * lineFirst = first;
+            while (lineFirst != last)
             {
-                // Split comma-separated string
-                std::istringstream iss(line);
-                std::string field;
-                double fieldValue = 0.0;
-                std::vector<T> situation;
-                while (std::getline(iss, field, ','))
+                const char * const newline = static_cast<const char *>(std::memchr(lineFirst, '\n', static_cast<std::size_t>(last - lineFirst)));
+                const char * const nextLineFirst = (newline == nullptr) ? last : newline + 1;
+                const char * lineLast = (newline == nullptr) ? last : newline;
+                if (lineLast != lineFirst && lineLast[-1] == '\r')
                 {
-                    fieldValue = std::stof(field);
-                    situation.push_back(static_cast<T>(rounds ? std::round(fieldValue) : fieldValue));
+                    --lineLast;
                 }
 
-                // Skip line with no values
-                if (situation.empty())
+                // Stop at an empty line
+                if (lineFirst == lineLast)
                 {
-                    continue;
+                    break;
                 }
 
-                // Last field is action
-                actions.push_back(static_cast<int>(fieldValue));
-                situation.pop_back();
+                // Ignore a trailing comma
+                if (lineLast[-1] == ',')
+                {
+                    --lineLast;
+                }
+
+                // Split comma-separated fields (the last field is action)
+                const std::size_t lineIdx = actions.size();
+                std::size_t fieldCount = 0;
+                const char * fieldFirst = lineFirst;
+                while (true)
+                {
+                    const char * const comma = static_cast<const char *>(std::memchr(fieldFirst, ',', static_cast<std::size_t>(lineLast - fieldFirst)));
+                    const char * const fieldLast = (comma == nullptr) ? lineLast : comma;
+
+                    double fieldValue;
+                    if (!ParseNumber(fieldFirst, fieldLast, fieldValue))
+                    {
+                        throw std::invalid_argument("CSV::ParseDataset: Failed to parse the field '" + std::string(fieldFirst, fieldLast) + "' in line " + std::to_string(lineIdx + 1) + ".");
+                    }
+
+                    if (comma == nullptr)
+                    {
+                        actions.push_back(static_cast<int>(fieldValue));
+                        break;
+                    }
+
+                    values.push_back(static_cast<T>(rounds ? std::round(fieldValue) : fieldValue));
+                    ++fieldCount;
+                    fieldFirst = comma + 1;
+                }
 
-                situations.push_back(situation);
+                if (lineIdx == 0)
+                {
+                    situationSize = fieldCount;
+                }
+                else if (fieldCount != situationSize)
+                {
+                    throw std::invalid_argument("CSV::ParseDataset: Line " + std::to_string(lineIdx + 1) + " has " + std::to_string(fieldCount + 1) + " fields (expected " + std::to_string(situationSize + 1) + ").");
+                }
+
+                lineFirst = nextLineFirst;
             }
 
-            return { situations, actions };
+            return { situationSize, std::move(values), std::move(actions) };
+        }
+
+        template <typename T>
+        BasicDataset<T> ReadDataset(std::istream & is, bool rounds)
+        {
+            const std::string str((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+            return ParseDataset<T>(str.data(), str.data() + str.size(), rounds);
         }
 
         template <typename T>
@@ -161,7 +261,11 @@ namespace xcspp
             {
                 throw std::runtime_error("CSV::ReadDatasetFromFile: Failed to open the file '" + filename + "'.");
             }
-            return ReadDataset<T>(ifs, rounds);
+            ifs.close();
+
+            const MappedFile file(filename);
+            const char * const data = reinterpret_cast<const char *>(file.data());
+            return ParseDataset<T>(data, data + file.size(), rounds);
         }
 
         template <class Classifier>
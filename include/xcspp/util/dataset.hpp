@@ -1,16 +1,135 @@
 #pragma once
 #include <vector>
+#include <utility> // std::move
+#include <stdexcept>
+#include <type_traits> // std::is_arithmetic_v
+#include <cstddef> // std::size_t
+
+#include "span.hpp"
 
 namespace xcspp
 {
 
+    // Labeled situations for classification
+    //   All situations are stored in one row-major buffer with a fixed stride (= situationSize()),
+    //   and situation(idx) returns a view of a row in the buffer.
     template <typename T>
-    struct BasicDataset
+    class BasicDataset
     {
         static_assert(std::is_arithmetic_v<T>, "T of BasicDataset<T> must be an integer type or a floating-point type.");
 
-        std::vector<std::vector<T>> situations;
-        std::vector<int> actions;
+    private:
+        std::size_t m_situationSize;
+        std::vector<T> m_situationValues; // situations in row-major order
+        std::vector<int> m_actions;
+
+    public:
+        // Constructor
+        BasicDataset()
+            : m_situationSize(0)
+        {
+        }
+
+        // Constructor from the row-major buffer of situations
+        // (Throws std::invalid_argument if the buffer size is not situationSize * actions.size().)
+        BasicDataset(std::size_t situationSize, std::vector<T> situationValues, std::vector<int> actions)
+            : m_situationSize(situationSize)
+            , m_situationValues(std::move(situationValues))
+            , m_actions(std::move(actions))
+        {
+            if (m_situationValues.size() != m_situationSize * m_actions.size())
+            {
+                throw std::invalid_argument("BasicDataset constructor received a situation buffer of an invalid size.");
+            }
+        }
+
+        // Constructor from a situation list
+        // (Throws std::invalid_argument if the sizes of the situations differ or the numbers of situations and actions do not match.)
+        BasicDataset(const std::vector<std::vector<T>> & situations, std::vector<int> actions)
+            : m_situationSize(situations.empty() ? 0 : situations.front().size())
+            , m_actions(std::move(actions))
+        {
+            if (situations.size() != m_actions.size())
+            {
+                throw std::invalid_argument("BasicDataset constructor received different numbers of situations and actions.");
+            }
+
+            m_situationValues.reserve(m_situationSize * situations.size());
+            for (const auto & situation : situations)
+            {
+                if (situation.size() != m_situationSize)
+                {
+                    throw std::invalid_argument("BasicDataset constructor received situations of different sizes.");
+                }
+                m_situationValues.insert(m_situationValues.end(), situation.begin(), situation.end());
+            }
+        }
+
+        // Add a labeled situation
+        // (Throws std::invalid_argument if the situation size differs from the ones already added.)
+        void add(Span<const T> situation, int action)
+        {
+            if (m_actions.empty())
+            {
+                m_situationSize = situation.size();
+            }
+            else if (situation.size() != m_situationSize)
+            {
+                throw std::invalid_argument("BasicDataset::add() received a situation of a different size.");
+            }
+            m_situationValues.insert(m_situationValues.end(), situation.begin(), situation.end());
+            m_actions.push_back(action);
+        }
+
+        // The number of labeled situations
+        std::size_t size() const noexcept
+        {
+            return m_actions.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_actions.empty();
+        }
+
+        std::size_t situationSize() const noexcept
+        {
+            return m_situationSize;
+        }
+
+        Span<const T> situation(std::size_t idx) const noexcept
+        {
+            return Span<const T>::FromPointer(m_situationValues.data() + idx * m_situationSize, m_situationSize);
+        }
+
+        int action(std::size_t idx) const noexcept
+        {
+            return m_actions[idx];
+        }
+
+        const std::vector<T> & situationValues() const noexcept
+        {
+            return m_situationValues;
+        }
+
+        const std::vector<int> & actions() const noexcept
+        {
+            return m_actions;
+        }
+
+        // Copy of the situations as a list (BasicDataset used to store them as the member "situations")
+        [[deprecated("use BasicDataset::situation() instead")]]
+        std::vector<std::vector<T>> situations() const
+        {
+            std::vector<std::vector<T>> situations;
+            situations.reserve(m_actions.size());
+            for (std::size_t i = 0; i < m_actions.size(); ++i)
+            {
+                const Span<const T> row = situation(i);
+                situations.emplace_back(row.begin(), row.end());
+            }
+            return situations;
+        }
     };
 
     using Dataset = BasicDataset<int>;
@@ -0,0 +1,15 @@
+#pragma once
+#include <functional> // std::hash
+#include <cstddef> // std::size_t
+
+namespace xcspp
+{
+
+    // Mix the hash value of an element into the seed (same as boost::hash_combine)
+    template <class T>
+    void HashCombine(std::size_t & seed, const T & value)
+    {
+        seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+}
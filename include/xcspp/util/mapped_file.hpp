@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+namespace xcspp
+{
+
+    // Read-only memory mapping of a whole file
+    //   The file is mapped with mmap() on POSIX systems, so the pages are loaded on demand and
+    //   shared with the page cache. On the other systems, the file is read into a buffer.
+    //   The data is aligned to at least 8 bytes (the page size when it is mapped).
+    class MappedFile
+    {
+    private:
+        const unsigned char * m_data;
+        std::size_t m_size;
+
+        // Whether m_data points to a mapping (otherwise it points to m_buffer)
+        bool m_isMapped;
+
+        std::vector<unsigned long long> m_buffer;
+
+    public:
+        // Constructor
+        // (Throws std::runtime_error if the file cannot be opened or mapped.)
+        explicit MappedFile(const std::string & filename);
+
+        // The mapping is owned by this object, so it is neither copyable nor movable
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile & operator= (const MappedFile &) = delete;
+
+        // Destructor
+        ~MappedFile();
+
+        const unsigned char * data() const noexcept
+        {
+            return m_data;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        bool isMapped() const noexcept
+        {
+            return m_isMapped;
+        }
+    };
+
+}
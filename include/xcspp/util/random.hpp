@@ -1,5 +1,7 @@
 #pragma once
 #include <random>
+#include <string>
+#include <sstream>
 #include <vector>
 #include <set>
 #include <unordered_set>
@@ -7,6 +9,10 @@
 #include <cstddef> // std::size_t
 #include <cstdint> // std::uint32_t, std::uint64_t
 #include <algorithm>
+#include <iterator> // std::next
+#include <stdexcept>
+
+#include "sum_tree.hpp"
 
 namespace xcspp
 {
@@ -28,6 +34,33 @@ namespace xcspp
         {
         }
 
+        // Restart the engine with the seed
+        void seed(std::uint32_t seed)
+        {
+            m_engine.seed(seed);
+        }
+
+        // State of the engine (for checkpoints; in the text format of std::mt19937)
+        std::string state() const
+        {
+            std::ostringstream oss;
+            oss << m_engine;
+            return oss.str();
+        }
+
+        // Restore the state returned by state()
+        // (Throws std::invalid_argument if the text is not a state of the engine.)
+        void setState(const std::string & state)
+        {
+            std::istringstream iss(state);
+            std::mt19937 engine;
+            if (!(iss >> engine))
+            {
+                throw std::invalid_argument("Random::setState() received an invalid engine state.");
+            }
+            m_engine = engine;
+        }
+
         template <typename T = double>
         T nextDouble(T min = 0.0, T max = 1.0)
         {
@@ -51,20 +84,30 @@ namespace xcspp
             return *(container.cbegin() + nextInt<std::size_t>(0, container.size() - 1));
         }
 
+        // Note: This is O(n) since std::set has no random access, but it does not allocate memory
+        //       and returns the same element as choosing from a std::vector copy of the container.
         template <typename T>
-        T chooseFrom(const std::set<T> & container)
+        const T & chooseFrom(const std::set<T> & container)
         {
-            // Create temporary std::vector from std::set and call the first chooseFrom function
-            std::vector<T> vec(container.cbegin(), container.cend());
-            return chooseFrom(vec);
+            if (container.empty())
+            {
+                throw std::invalid_argument("Random::chooseFrom() received an empty container.");
+            }
+
+            return *std::next(container.cbegin(), nextInt<std::size_t>(0, container.size() - 1));
         }
 
+        // Note: This is O(n) since std::unordered_set has no random access, but it does not allocate memory
+        //       and returns the same element as choosing from a std::vector copy of the container.
         template <typename T>
-        T chooseFrom(const std::unordered_set<T> & container)
+        const T & chooseFrom(const std::unordered_set<T> & container)
         {
-            // Create temporary std::vector from std::unordered_set and call the first chooseFrom function
-            std::vector<T> vec(container.cbegin(), container.cend());
-            return chooseFrom(vec);
+            if (container.empty())
+            {
+                throw std::invalid_argument("Random::chooseFrom() received an empty container.");
+            }
+
+            return *std::next(container.cbegin(), nextInt<std::size_t>(0, container.size() - 1));
         }
 
         template <typename T>
@@ -203,4 +246,270 @@ namespace xcspp
         }
     };
 
+    // Seeds of independent random streams derived from one master seed
+    //   The seed of each stream is the master seed and the stream index mixed with SplitMix64, so the
+    //   streams neither depend on each other nor on the order in which they are taken. child() derives
+    //   another sequence in the same way (e.g., for each run of an experiment with multiple seeds).
+    class SeedSequence
+    {
+    private:
+        std::uint64_t m_masterSeed;
+
+        // Output function of SplitMix64
+        static constexpr std::uint64_t Mix(std::uint64_t x) noexcept
+        {
+            x += 0x9E3779B97F4A7C15;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+            return x ^ (x >> 31);
+        }
+
+        // (The seeds and the children use different domains so that they never coincide.)
+        constexpr std::uint64_t derive(std::uint64_t idx, std::uint64_t domain) const noexcept
+        {
+            return Mix(Mix(m_masterSeed) ^ Mix((idx << 1) | domain));
+        }
+
+    public:
+        // Constructor
+        explicit constexpr SeedSequence(std::uint64_t masterSeed) noexcept
+            : m_masterSeed(masterSeed)
+        {
+        }
+
+        constexpr std::uint64_t masterSeed() const noexcept
+        {
+            return m_masterSeed;
+        }
+
+        // Seed of the stream (for Random)
+        constexpr std::uint32_t seed(std::uint64_t streamIdx) const noexcept
+        {
+            return static_cast<std::uint32_t>(derive(streamIdx, 0) >> 32);
+        }
+
+        // Sequence derived from this sequence
+        constexpr SeedSequence child(std::uint64_t childIdx) const noexcept
+        {
+            return SeedSequence(derive(childIdx, 1));
+        }
+    };
+
+    // Sampler of indices with probability proportional to their weights
+    //   Unlike Random::rouletteWheelSelection(), the sampler can be kept alive between calls:
+    //   - Mode::kSumTree: O(log n) sampling and O(log n) point updates (set(), pushBack(), popBack())
+    //   - Mode::kAliasTable: O(1) sampling for fixed weights (Walker's alias method; updates are not allowed)
+    //   Building the sampler (constructor and assign()) is O(n) in both modes.
+    class WeightedSampler
+    {
+    public:
+        enum class Mode
+        {
+            kSumTree,
+            kAliasTable,
+        };
+
+    private:
+        Mode m_mode;
+
+        // Weights and their partial sums (used in both modes)
+        SumTree<double> m_tree;
+
+        // Alias table (used only in Mode::kAliasTable)
+        std::vector<double> m_probabilities;
+        std::vector<std::size_t> m_aliases;
+
+        static void CheckWeight(double weight)
+        {
+            if (!(weight >= 0.0) || weight == std::numeric_limits<double>::infinity())
+            {
+                throw std::invalid_argument("WeightedSampler received a negative or non-finite weight.");
+            }
+        }
+
+        void checkUpdatable() const
+        {
+            if (m_mode != Mode::kSumTree)
+            {
+                throw std::logic_error("WeightedSampler cannot update the weights in Mode::kAliasTable. Use assign() instead.");
+            }
+        }
+
+        void buildAliasTable()
+        {
+            const std::size_t n = m_tree.size();
+            const double sum = m_tree.sum();
+            m_probabilities.resize(n);
+            m_aliases.resize(n);
+            if (n == 0 || sum <= 0.0)
+            {
+                return;
+            }
+
+            // Scale the weights so that their average is 1, and sort the columns into
+            // the ones below 1 (front of workList) and the others (back of workList)
+            std::vector<std::size_t> workList(n);
+            std::size_t smallEnd = 0;
+            std::size_t largeBegin = n;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                m_probabilities[i] = m_tree[i] * n / sum;
+                m_aliases[i] = i;
+                if (m_probabilities[i] < 1.0)
+                {
+                    workList[smallEnd++] = i;
+                }
+                else
+                {
+                    workList[--largeBegin] = i;
+                }
+            }
+
+            // Fill each column below 1 with a part of a column above 1
+            while (smallEnd > 0 && largeBegin < n)
+            {
+                const std::size_t s = workList[--smallEnd];
+                const std::size_t l = workList[largeBegin];
+                m_aliases[s] = l;
+                m_probabilities[l] -= 1.0 - m_probabilities[s];
+                if (m_probabilities[l] < 1.0)
+                {
+                    ++largeBegin;
+                    workList[smallEnd++] = l;
+                }
+            }
+
+            // The remaining columns are full (up to rounding errors)
+            for (std::size_t i = 0; i < smallEnd; ++i)
+            {
+                m_probabilities[workList[i]] = 1.0;
+            }
+            for (std::size_t i = largeBegin; i < n; ++i)
+            {
+                m_probabilities[workList[i]] = 1.0;
+            }
+        }
+
+    public:
+        // Constructor
+        explicit WeightedSampler(Mode mode = Mode::kSumTree)
+            : m_mode(mode)
+        {
+        }
+
+        explicit WeightedSampler(const std::vector<double> & weights, Mode mode = Mode::kSumTree)
+            : m_mode(mode)
+        {
+            assign(weights);
+        }
+
+        // Destructor
+        ~WeightedSampler() = default;
+
+        Mode mode() const noexcept
+        {
+            return m_mode;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_tree.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_tree.empty();
+        }
+
+        double weight(std::size_t idx) const
+        {
+            return m_tree[idx];
+        }
+
+        // Sum of all the weights
+        double sum() const
+        {
+            return m_tree.sum();
+        }
+
+        // Replace all the weights (O(n); reuses the allocated memory)
+        void assign(const std::vector<double> & weights)
+        {
+            for (const auto & weight : weights)
+            {
+                CheckWeight(weight);
+            }
+            m_tree.assign(weights);
+
+            if (m_mode == Mode::kAliasTable)
+            {
+                buildAliasTable();
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_tree.clear();
+            m_probabilities.clear();
+            m_aliases.clear();
+        }
+
+        // --- The functions below are available only in Mode::kSumTree (throw std::logic_error otherwise) ---
+
+        void set(std::size_t idx, double weight)
+        {
+            checkUpdatable();
+            CheckWeight(weight);
+            if (idx >= m_tree.size())
+            {
+                throw std::out_of_range("WeightedSampler::set() received an out-of-range index.");
+            }
+            m_tree.set(idx, weight);
+        }
+
+        void pushBack(double weight)
+        {
+            checkUpdatable();
+            CheckWeight(weight);
+            m_tree.pushBack(weight);
+        }
+
+        void popBack()
+        {
+            checkUpdatable();
+            if (m_tree.empty())
+            {
+                throw std::out_of_range("WeightedSampler::popBack() was called on an empty sampler.");
+            }
+            m_tree.popBack();
+        }
+
+        // Returns the index of the selected weight
+        std::size_t sample(Random & random) const
+        {
+            const double sum = m_tree.sum();
+            if (m_tree.empty() || !(sum > 0.0))
+            {
+                throw std::runtime_error("WeightedSampler::sample() found an invalid weight sum.");
+            }
+
+            if (m_mode == Mode::kAliasTable)
+            {
+                const std::size_t column = random.nextInt<std::size_t>(0, m_probabilities.size() - 1);
+                return (random.nextDouble() < m_probabilities[column]) ? column : m_aliases[column];
+            }
+            else
+            {
+                std::size_t idx = m_tree.find(random.nextDouble(0.0, sum));
+
+                // Never return an element of zero weight even if the rounding errors point to it
+                while (m_tree[idx] <= 0.0 && idx > 0)
+                {
+                    --idx;
+                }
+                return idx;
+            }
+        }
+    };
+
 }
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward64
+#endif
+
+namespace xcspp
+{
+
+    // Instruction set used by the vectorized matching kernels
+    enum class SIMDKernel
+    {
+        kScalar,
+        kSSE2,
+        kAVX2,
+    };
+
+    // Returns whether the CPU supports the kernel (kScalar is always supported)
+    bool IsSIMDKernelSupported(SIMDKernel kernel);
+
+    // Returns the fastest kernel supported by the CPU
+    SIMDKernel DetectSIMDKernel();
+
+    // Calls func(i) for each set bit i of the bitmap in ascending order
+    // (The bitmap is the result of the population scan; bit (i % 64) of bitmap[i / 64] is the i-th row.)
+    template <class Function>
+    void ForEachSetBit(const std::vector<std::uint64_t> & bitmap, Function func)
+    {
+        for (std::size_t w = 0; w < bitmap.size(); ++w)
+        {
+            std::uint64_t bits = bitmap[w];
+            while (bits != 0)
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                const std::size_t bitIdx = static_cast<std::size_t>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && defined(_M_X64)
+                unsigned long bitIdx;
+                _BitScanForward64(&bitIdx, bits);
+#else
+                std::size_t bitIdx = 0;
+                while (((bits >> bitIdx) & 1) == 0)
+                {
+                    ++bitIdx;
+                }
+#endif
+                func(w * 64 + bitIdx);
+                bits &= bits - 1;
+            }
+        }
+    }
+
+}
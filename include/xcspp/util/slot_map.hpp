@@ -0,0 +1,209 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <utility> // std::move, std::forward
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+#include <stdexcept>
+
+namespace xcspp
+{
+
+    // Generational index of an element in SlotMap
+    //   The generation is increased every time the slot is freed, so a handle to
+    //   an erased element never refers to another element later stored in the same slot.
+    struct SlotHandle
+    {
+        static constexpr std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index = kInvalidIndex;
+        std::uint32_t generation = 0;
+
+        friend bool operator== (const SlotHandle & lhs, const SlotHandle & rhs) noexcept
+        {
+            return lhs.index == rhs.index && lhs.generation == rhs.generation;
+        }
+
+        friend bool operator!= (const SlotHandle & lhs, const SlotHandle & rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    // Arena that stores the elements contiguously and addresses them with stable SlotHandles
+    //   - The elements are kept dense (begin() to end()) without holes.
+    //   - erase() is O(1): the last element is moved into the erased position,
+    //     so the dense index of an element may change but its handle does not.
+    template <class T>
+    class SlotMap
+    {
+    private:
+        struct Slot
+        {
+            std::uint32_t denseIdx;
+            std::uint32_t generation;
+        };
+
+        std::vector<T> m_values;
+        std::vector<std::uint32_t> m_denseToSlot;
+        std::vector<Slot> m_slots;
+        std::vector<std::uint32_t> m_freeSlots;
+
+    public:
+        // Constructor
+        SlotMap() = default;
+
+        // Destructor
+        ~SlotMap() = default;
+
+        template <class... Args>
+        SlotHandle emplace(Args && ... args)
+        {
+            std::uint32_t slotIdx;
+            if (m_freeSlots.empty())
+            {
+                if (m_slots.size() >= SlotHandle::kInvalidIndex)
+                {
+                    throw std::length_error("SlotMap::emplace() exceeded the maximum number of slots.");
+                }
+                slotIdx = static_cast<std::uint32_t>(m_slots.size());
+                m_slots.push_back({ 0, 0 });
+            }
+            else
+            {
+                slotIdx = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+
+            m_values.emplace_back(std::forward<Args>(args)...);
+            m_denseToSlot.push_back(slotIdx);
+            m_slots[slotIdx].denseIdx = static_cast<std::uint32_t>(m_values.size() - 1);
+
+            return { slotIdx, m_slots[slotIdx].generation };
+        }
+
+        SlotHandle insert(const T & value)
+        {
+            return emplace(value);
+        }
+
+        SlotHandle insert(T && value)
+        {
+            return emplace(std::move(value));
+        }
+
+        bool contains(const SlotHandle & handle) const noexcept
+        {
+            return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+        }
+
+        // Remove the element by moving the last element into its place (O(1))
+        //   Returns false if the handle does not refer to an element.
+        bool erase(const SlotHandle & handle)
+        {
+            if (!contains(handle))
+            {
+                return false;
+            }
+
+            const std::uint32_t denseIdx = m_slots[handle.index].denseIdx;
+            const std::uint32_t lastIdx = static_cast<std::uint32_t>(m_values.size() - 1);
+            if (denseIdx != lastIdx)
+            {
+                m_values[denseIdx] = std::move(m_values.back());
+                m_denseToSlot[denseIdx] = m_denseToSlot[lastIdx];
+                m_slots[m_denseToSlot[denseIdx]].denseIdx = denseIdx;
+            }
+            m_values.pop_back();
+            m_denseToSlot.pop_back();
+
+            ++m_slots[handle.index].generation;
+            m_freeSlots.push_back(handle.index);
+
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            // Invalidate all the handles given so far
+            for (const auto & slotIdx : m_denseToSlot)
+            {
+                ++m_slots[slotIdx].generation;
+                m_freeSlots.push_back(slotIdx);
+            }
+            m_values.clear();
+            m_denseToSlot.clear();
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            m_values.reserve(capacity);
+            m_denseToSlot.reserve(capacity);
+        }
+
+        // Returns nullptr if the handle does not refer to an element
+        T * get(const SlotHandle & handle) noexcept
+        {
+            return contains(handle) ? &m_values[m_slots[handle.index].denseIdx] : nullptr;
+        }
+
+        const T * get(const SlotHandle & handle) const noexcept
+        {
+            return contains(handle) ? &m_values[m_slots[handle.index].denseIdx] : nullptr;
+        }
+
+        T & operator[] (const SlotHandle & handle)
+        {
+            return m_values[m_slots[handle.index].denseIdx];
+        }
+
+        const T & operator[] (const SlotHandle & handle) const
+        {
+            return m_values[m_slots[handle.index].denseIdx];
+        }
+
+        // Position of the element in begin()...end()
+        std::size_t denseIndex(const SlotHandle & handle) const
+        {
+            return m_slots[handle.index].denseIdx;
+        }
+
+        // Handle of the element at the position in begin()...end()
+        SlotHandle handleAt(std::size_t denseIdx) const
+        {
+            const std::uint32_t slotIdx = m_denseToSlot[denseIdx];
+            return { slotIdx, m_slots[slotIdx].generation };
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_values.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_values.empty();
+        }
+
+        auto begin() noexcept
+        {
+            return m_values.begin();
+        }
+
+        auto begin() const noexcept
+        {
+            return m_values.begin();
+        }
+
+        auto end() noexcept
+        {
+            return m_values.end();
+        }
+
+        auto end() const noexcept
+        {
+            return m_values.end();
+        }
+    };
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <iterator> // std::data, std::size
+#include <type_traits> // std::is_convertible_v, std::remove_cv_t
+#include <utility> // std::declval
+#include <cstddef> // std::size_t
+
+namespace xcspp
+{
+
+    // Non-owning view of a contiguous sequence (a subset of C++20 std::span)
+    //   Span<const T> is constructible from std::vector<T> (including a temporary one, which
+    //   stays alive until the end of the full expression), so a function taking Span<const T>
+    //   accepts both a vector and a row of a larger buffer without copying.
+    //   A view of (pointer, size) is made by Span::FromPointer() instead of a constructor, so that a
+    //   braced list like { 0, 1 } never converts to a Span (0 would be a null pointer).
+    template <typename T>
+    class Span
+    {
+    private:
+        T * m_data;
+        std::size_t m_size;
+
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using iterator = T *;
+
+        // Constructor
+        constexpr Span() noexcept
+            : m_data(nullptr)
+            , m_size(0)
+        {
+        }
+
+        // Constructor from a contiguous container (e.g., std::vector or Span)
+        template <class Container, std::enable_if_t<std::is_convertible_v<decltype(std::data(std::declval<Container &>())), T *>, std::nullptr_t> = nullptr>
+        constexpr Span(Container && container) noexcept
+            : m_data(std::data(container))
+            , m_size(std::size(container))
+        {
+        }
+
+        // View of size elements from data
+        static constexpr Span FromPointer(T * data, std::size_t size) noexcept
+        {
+            Span span;
+            span.m_data = data;
+            span.m_size = size;
+            return span;
+        }
+
+        constexpr T * data() const noexcept
+        {
+            return m_data;
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        constexpr T & operator[] (std::size_t idx) const noexcept
+        {
+            return m_data[idx];
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        constexpr iterator end() const noexcept
+        {
+            return m_data + m_size;
+        }
+    };
+
+}
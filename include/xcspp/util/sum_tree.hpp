@@ -0,0 +1,193 @@
+#pragma once
+#include <vector>
+#include <stdexcept>
+#include <cstddef> // std::size_t
+
+namespace xcspp
+{
+
+    // Fenwick tree (binary indexed tree) of non-negative weights
+    //   Supports O(log n) point updates, prefix sums and weighted search.
+    //   Appending and removing the last element are also O(log n), so the order of
+    //   the weights can follow a container that erases by moving its last element.
+    template <class T>
+    class SumTree
+    {
+    private:
+        // Weights
+        std::vector<T> m_values;
+
+        // m_tree[i - 1] holds the sum of the weights in (i - lowbit(i), i] (1-based)
+        std::vector<T> m_tree;
+
+        static std::size_t LowBit(std::size_t i) noexcept
+        {
+            return i & (~i + 1);
+        }
+
+        void add(std::size_t idx, T delta)
+        {
+            for (std::size_t i = idx + 1; i <= m_tree.size(); i += LowBit(i))
+            {
+                m_tree[i - 1] += delta;
+            }
+        }
+
+    public:
+        // Constructor
+        SumTree() = default;
+
+        explicit SumTree(const std::vector<T> & values)
+            : m_values(values)
+        {
+            rebuild();
+        }
+
+        // Destructor
+        ~SumTree() = default;
+
+        std::size_t size() const noexcept
+        {
+            return m_values.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_values.empty();
+        }
+
+        const T & operator[] (std::size_t idx) const
+        {
+            return m_values[idx];
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            m_values.reserve(capacity);
+            m_tree.reserve(capacity);
+        }
+
+        void clear() noexcept
+        {
+            m_values.clear();
+            m_tree.clear();
+        }
+
+        // Replace all the weights in O(n)
+        void assign(const std::vector<T> & values)
+        {
+            m_values.assign(values.begin(), values.end());
+            rebuild();
+        }
+
+        // Replace the weights and the nodes as they are (for restoring the ones saved with values() and nodes())
+        // (Throws std::invalid_argument if the sizes are different.)
+        void assign(const std::vector<T> & values, const std::vector<T> & nodes)
+        {
+            if (values.size() != nodes.size())
+            {
+                throw std::invalid_argument("SumTree::assign() received the weights and the nodes with different sizes.");
+            }
+            m_values = values;
+            m_tree = nodes;
+        }
+
+        const std::vector<T> & values() const noexcept
+        {
+            return m_values;
+        }
+
+        // Nodes of the tree (unlike after rebuild(), they include the rounding errors of set())
+        const std::vector<T> & nodes() const noexcept
+        {
+            return m_tree;
+        }
+
+        // Set the weight of the element
+        void set(std::size_t idx, T value)
+        {
+            add(idx, value - m_values[idx]);
+            m_values[idx] = value;
+        }
+
+        // Append an element
+        void pushBack(T value)
+        {
+            const std::size_t i = m_tree.size() + 1;
+            m_values.push_back(value);
+            m_tree.push_back(value + prefixSum(i - 1) - prefixSum(i - LowBit(i)));
+        }
+
+        // Remove the last element
+        //   (No node before the last one covers the last element, so the tree stays valid.)
+        void popBack()
+        {
+            m_values.pop_back();
+            m_tree.pop_back();
+        }
+
+        // Remove the element by moving the last element into its place
+        void swapRemove(std::size_t idx)
+        {
+            set(idx, m_values.back());
+            popBack();
+        }
+
+        // Sum of the weights of the first count elements
+        T prefixSum(std::size_t count) const
+        {
+            T sum = 0;
+            for (std::size_t i = count; i > 0; i -= LowBit(i))
+            {
+                sum += m_tree[i - 1];
+            }
+            return sum;
+        }
+
+        // Sum of all the weights
+        T sum() const
+        {
+            return prefixSum(m_tree.size());
+        }
+
+        // Returns the smallest index whose prefix sum (including itself) exceeds the value
+        //   For a value drawn uniformly from [0, sum()), each index is returned with
+        //   probability proportional to its weight. The result is clamped to size() - 1.
+        std::size_t find(T value) const
+        {
+            std::size_t pos = 0;
+            std::size_t step = 1;
+            while (step * 2 <= m_tree.size())
+            {
+                step *= 2;
+            }
+
+            for (; step > 0; step /= 2)
+            {
+                if (pos + step <= m_tree.size() && m_tree[pos + step - 1] <= value)
+                {
+                    pos += step;
+                    value -= m_tree[pos - 1];
+                }
+            }
+
+            return (pos < m_tree.size()) ? pos : m_tree.size() - 1;
+        }
+
+        // Recompute all the nodes from the weights in O(n)
+        // (Call this occasionally to discard the rounding errors accumulated by set())
+        void rebuild()
+        {
+            m_tree = m_values;
+            for (std::size_t i = 1; i <= m_tree.size(); ++i)
+            {
+                const std::size_t parent = i + LowBit(i);
+                if (parent <= m_tree.size())
+                {
+                    m_tree[parent - 1] += m_tree[i - 1];
+                }
+            }
+        }
+    };
+
+}
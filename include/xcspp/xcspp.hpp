@@ -1,12 +1,24 @@
 #pragma once
 
+#include "core/accuracy.hpp"
+#include "core/available_actions.hpp"
+#include "core/checkpoint.hpp"
+#include "core/exploit_batch.hpp"
+#include "core/match_set_cache.hpp"
+#include "core/population_snapshot.hpp"
 #include "core/xcs/action_set.hpp"
 #include "core/xcs/classifier.hpp"
 #include "core/xcs/classifier_ptr_set.hpp"
 #include "core/xcs/condition.hpp"
+#include "core/xcs/decision_index.hpp"
 #include "core/xcs/ga.hpp"
+#include "core/xcs/inference_model.hpp"
 #include "core/xcs/match_set.hpp"
+#include "core/xcs/packed_condition.hpp"
+#include "core/xcs/packed_condition_matrix.hpp"
+#include "core/xcs/packed_situation.hpp"
 #include "core/xcs/population.hpp"
+#include "core/xcs/population_snapshot.hpp"
 #include "core/xcs/prediction_array.hpp"
 #include "core/xcs/symbol.hpp"
 #include "core/xcs/xcs.hpp"
@@ -15,16 +27,20 @@
 namespace xcspp
 {
     using xcs::XCS;
+    using xcs::PackedXCS;
     using xcs::XCSParams;
 }
 
 #include "core/xcsr/action_set.hpp"
+#include "core/xcsr/box_index.hpp"
 #include "core/xcsr/classifier.hpp"
 #include "core/xcsr/classifier_ptr_set.hpp"
 #include "core/xcsr/condition.hpp"
+#include "core/xcsr/interval_matrix.hpp"
 #include "core/xcsr/ga.hpp"
 #include "core/xcsr/match_set.hpp"
 #include "core/xcsr/population.hpp"
+#include "core/xcsr/population_snapshot.hpp"
 #include "core/xcsr/prediction_array.hpp"
 #include "core/xcsr/symbol.hpp"
 #include "core/xcsr/xcsr.hpp"
@@ -39,6 +55,7 @@ namespace xcspp
 }
 
 #include "environment/ienvironment.hpp"
+#include "environment/ibinary_environment.hpp"
 #include "environment/multiplexer_environment.hpp"
 #include "environment/real_multiplexer_environment.hpp"
 #include "environment/even_parity_environment.hpp"
@@ -49,8 +66,16 @@ namespace xcspp
 #include "helper/experiment_helper.hpp"
 #include "helper/experiment_log_stream.hpp"
 #include "helper/experiment_settings.hpp"
+#include "helper/multi_seed_experiment_runner.hpp"
 #include "helper/simple_moving_average.hpp"
 
+#include "util/binary_stream.hpp"
 #include "util/csv.hpp"
 #include "util/dataset.hpp"
+#include "util/hash.hpp"
+#include "util/mapped_file.hpp"
 #include "util/random.hpp"
+#include "util/simd.hpp"
+#include "util/slot_map.hpp"
+#include "util/span.hpp"
+#include "util/sum_tree.hpp"
@@ -0,0 +1,63 @@
+#include "xcspp/core/checkpoint.hpp"
+#include <cstring> // std::memcmp
+
+namespace xcspp
+{
+
+    namespace
+    {
+        constexpr char kMagic[8] = { 'X', 'C', 'S', 'P', 'P', 'C', 'K', 'P' };
+
+        constexpr std::uint32_t kVersion = 1;
+
+        // Written as a native integer and compared on load to detect a different byte order
+        constexpr std::uint32_t kByteOrderMark = 0x01020304;
+    }
+
+    void WriteCheckpointHeader(BinaryWriter & writer, CheckpointKind kind, std::uint64_t paramsHash)
+    {
+        for (const char c : kMagic)
+        {
+            writer.write(c);
+        }
+        writer.write(kVersion);
+        writer.write(kByteOrderMark);
+        writer.write(static_cast<std::uint32_t>(kind));
+        writer.write(paramsHash);
+    }
+
+    void ReadCheckpointHeader(BinaryReader & reader, CheckpointKind kind, std::uint64_t paramsHash)
+    {
+        char magic[sizeof(kMagic)];
+        for (char & c : magic)
+        {
+            c = reader.read<char>();
+        }
+        if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+        {
+            throw std::runtime_error("ReadCheckpointHeader() could not read the stream (not a checkpoint).");
+        }
+
+        const auto version = reader.read<std::uint32_t>();
+        if (version != kVersion)
+        {
+            throw std::runtime_error("ReadCheckpointHeader() could not read the stream (unsupported version " + std::to_string(version) + ").");
+        }
+
+        if (reader.read<std::uint32_t>() != kByteOrderMark)
+        {
+            throw std::runtime_error("ReadCheckpointHeader() could not read the stream (written with a different byte order).");
+        }
+
+        if (reader.read<std::uint32_t>() != static_cast<std::uint32_t>(kind))
+        {
+            throw std::runtime_error("ReadCheckpointHeader() could not read the stream (a checkpoint of another kind of object).");
+        }
+
+        if (reader.read<std::uint64_t>() != paramsHash)
+        {
+            throw std::invalid_argument("ReadCheckpointHeader() received a checkpoint saved with different hyperparameters.");
+        }
+    }
+
+}
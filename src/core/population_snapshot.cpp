@@ -0,0 +1,269 @@
+#include "xcspp/core/population_snapshot.hpp"
+#include <fstream>
+#include <algorithm> // std::min
+#include <cstring> // std::memcpy, std::memcmp
+
+namespace xcspp
+{
+
+    namespace
+    {
+        constexpr char kMagic[8] = { 'X', 'C', 'S', 'P', 'P', 'P', 'O', 'P' };
+
+        // Written as a native integer and compared on load to detect a different byte order
+        constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+        constexpr std::size_t AlignSection(std::size_t offset) noexcept
+        {
+            return (offset + PopulationSnapshot::kSectionAlignment - 1) / PopulationSnapshot::kSectionAlignment * PopulationSnapshot::kSectionAlignment;
+        }
+
+        bool IsValidConditionKind(std::uint32_t conditionKind) noexcept
+        {
+            return conditionKind == static_cast<std::uint32_t>(PopulationSnapshot::ConditionKind::kTernary)
+                || conditionKind == static_cast<std::uint32_t>(PopulationSnapshot::ConditionKind::kPackedTernary)
+                || conditionKind == static_cast<std::uint32_t>(PopulationSnapshot::ConditionKind::kInterval);
+        }
+    }
+
+    std::size_t PopulationSnapshot::ElementSize(ConditionKind conditionKind, Section section)
+    {
+        switch (section)
+        {
+        case Section::kAction:
+            return sizeof(std::int32_t);
+
+        case Section::kPrediction:
+        case Section::kEpsilon:
+        case Section::kFitness:
+        case Section::kActionSetSize:
+            return sizeof(double);
+
+        case Section::kExperience:
+        case Section::kTimeStamp:
+        case Section::kNumerosity:
+            return sizeof(std::uint64_t);
+
+        case Section::kConditionValue:
+            if (conditionKind == ConditionKind::kTernary)
+            {
+                return sizeof(std::int32_t);
+            }
+            return (conditionKind == ConditionKind::kPackedTernary) ? sizeof(std::uint64_t) : sizeof(double);
+
+        case Section::kConditionCare:
+            return (conditionKind == ConditionKind::kTernary) ? sizeof(std::uint8_t) : sizeof(std::uint64_t);
+
+        default:
+            throw std::invalid_argument("PopulationSnapshot::ElementSize() received an unknown section.");
+        }
+    }
+
+    std::size_t PopulationSnapshot::computeLayout()
+    {
+        const std::size_t size = static_cast<std::size_t>(m_header.size);
+        const std::size_t conditionLength = static_cast<std::size_t>(m_header.conditionLength);
+        const ConditionKind kind = conditionKind();
+
+        std::size_t conditionElementCount;
+        std::size_t careElementCount;
+        switch (kind)
+        {
+        case ConditionKind::kTernary:
+            conditionElementCount = size * conditionLength;
+            careElementCount = conditionElementCount;
+            break;
+
+        case ConditionKind::kPackedTernary:
+            {
+                const std::size_t paddedSize = (size + kPackedBlockSize - 1) / kPackedBlockSize * kPackedBlockSize;
+                conditionElementCount = paddedSize * ((conditionLength + 63) / 64);
+                careElementCount = conditionElementCount;
+            }
+            break;
+
+        default:
+            conditionElementCount = size * conditionLength * 2;
+            careElementCount = 0;
+            break;
+        }
+
+        std::size_t offset = kHeaderSize;
+        for (std::size_t i = 0; i < kSectionCount; ++i)
+        {
+            const auto section = static_cast<Section>(i);
+            std::size_t elementCount = size;
+            if (section == Section::kConditionValue)
+            {
+                elementCount = conditionElementCount;
+            }
+            else if (section == Section::kConditionCare)
+            {
+                elementCount = careElementCount;
+            }
+
+            offset = AlignSection(offset);
+            m_sectionOffsets[i] = offset;
+            m_sectionElementCounts[i] = elementCount;
+            offset += elementCount * ElementSize(kind, section);
+        }
+        return offset;
+    }
+
+    void PopulationSnapshot::checkElementSize(Section section, std::size_t elementSize) const
+    {
+        if (elementSize != ElementSize(conditionKind(), section))
+        {
+            throw std::invalid_argument("PopulationSnapshot::data() was called with a type of a different size from the section elements.");
+        }
+    }
+
+    PopulationSnapshot::PopulationSnapshot(ConditionKind conditionKind, std::uint32_t repr, std::uint64_t paramsHash, std::size_t conditionLength, std::size_t size)
+        : m_header{}
+    {
+        std::memcpy(m_header.magic, kMagic, sizeof(kMagic));
+        m_header.version = kVersion;
+        m_header.byteOrderMark = kByteOrderMark;
+        m_header.conditionKind = static_cast<std::uint32_t>(conditionKind);
+        m_header.repr = repr;
+        m_header.paramsHash = paramsHash;
+        m_header.conditionLength = conditionLength;
+        m_header.size = size;
+
+        if (!IsValidConditionKind(m_header.conditionKind))
+        {
+            throw std::invalid_argument("PopulationSnapshot was constructed with an unknown condition kind.");
+        }
+
+        m_header.fileSize = computeLayout();
+        m_buffer.assign((m_header.fileSize + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t), 0);
+        std::memcpy(m_buffer.data(), &m_header, sizeof(Header));
+    }
+
+    void PopulationSnapshot::validateHeader(std::uint64_t actualFileSize)
+    {
+        if (std::memcmp(m_header.magic, kMagic, sizeof(kMagic)) != 0)
+        {
+            throw std::runtime_error("PopulationSnapshot could not read the file (not a population snapshot).");
+        }
+
+        if (m_header.byteOrderMark != kByteOrderMark)
+        {
+            throw std::runtime_error("PopulationSnapshot could not read the file (written with a different byte order).");
+        }
+
+        if (m_header.version != kVersion)
+        {
+            throw std::runtime_error("PopulationSnapshot could not read the file (unsupported version " + std::to_string(m_header.version) + ").");
+        }
+
+        if (!IsValidConditionKind(m_header.conditionKind))
+        {
+            throw std::runtime_error("PopulationSnapshot could not read the file (unknown condition kind).");
+        }
+
+        // The sizes in the header must be consistent with each other and with the actual file
+        // (Limit the counts first so that the layout computation cannot overflow.)
+        if (m_header.size > actualFileSize || m_header.conditionLength > actualFileSize
+            || (m_header.conditionLength > 0 && m_header.size > actualFileSize / m_header.conditionLength)
+            || computeLayout() != m_header.fileSize || m_header.fileSize != actualFileSize)
+        {
+            throw std::runtime_error("PopulationSnapshot could not read the file (truncated or inconsistent sizes).");
+        }
+    }
+
+    PopulationSnapshot::PopulationSnapshot(std::unique_ptr<const MappedFile> && file)
+        : m_header{}
+        , m_file(std::move(file))
+    {
+        if (m_file->size() < kHeaderSize)
+        {
+            throw std::runtime_error("PopulationSnapshot could not read the file (too short for the header).");
+        }
+        std::memcpy(&m_header, m_file->data(), sizeof(Header));
+        validateHeader(m_file->size());
+    }
+
+    PopulationSnapshot PopulationSnapshot::FromFile(const std::string & filename)
+    {
+        return PopulationSnapshot(std::make_unique<const MappedFile>(filename));
+    }
+
+    PopulationSnapshot PopulationSnapshot::Read(std::istream & is)
+    {
+        // Read the header first to know the size of the rest
+        Header header;
+        if (!is.read(reinterpret_cast<char *>(&header), sizeof(Header)))
+        {
+            throw std::runtime_error("PopulationSnapshot could not read the stream (too short for the header).");
+        }
+
+        PopulationSnapshot snapshot;
+        snapshot.m_header = header;
+        snapshot.validateHeader(header.fileSize);
+
+        // Grow the buffer in chunks so that a corrupted size ends up with the end of the stream
+        // instead of allocating a huge buffer at once
+        constexpr std::size_t kChunkWordCount = (1 << 20) / sizeof(std::uint64_t);
+        const std::size_t wordCount = static_cast<std::size_t>((header.fileSize + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+        snapshot.m_buffer.resize(kHeaderSize / sizeof(std::uint64_t));
+        std::memcpy(snapshot.m_buffer.data(), &header, sizeof(Header));
+        std::size_t byteCount = kHeaderSize;
+        while (byteCount < header.fileSize)
+        {
+            const std::size_t offset = snapshot.m_buffer.size();
+            snapshot.m_buffer.resize(std::min(offset + kChunkWordCount, wordCount));
+            const std::size_t readSize = std::min<std::size_t>(snapshot.m_buffer.size() * sizeof(std::uint64_t), static_cast<std::size_t>(header.fileSize)) - byteCount;
+            if (!is.read(reinterpret_cast<char *>(snapshot.m_buffer.data()) + byteCount, static_cast<std::streamsize>(readSize)))
+            {
+                throw std::runtime_error("PopulationSnapshot could not read the stream (truncated).");
+            }
+            byteCount += readSize;
+        }
+        return snapshot;
+    }
+
+    void PopulationSnapshot::write(std::ostream & os) const
+    {
+        // Write the header and the sections at once (the header in m_buffer is up to date)
+        os.write(reinterpret_cast<const char *>(bytes()), static_cast<std::streamsize>(m_header.fileSize));
+    }
+
+    bool PopulationSnapshot::saveFile(const std::string & filename) const
+    {
+        // Open file stream
+        std::ofstream ofs(filename, std::ios::binary);
+        if (!ofs.good())
+        {
+            return false;
+        }
+
+        write(ofs);
+        return ofs.good();
+    }
+
+    void ParamsHasher::addBytes(const void * data, std::size_t size) noexcept
+    {
+        const auto * p = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_hash ^= p[i];
+            m_hash *= 1099511628211ULL;
+        }
+    }
+
+    ParamsHasher & ParamsHasher::add(std::uint64_t value) noexcept
+    {
+        addBytes(&value, sizeof(value));
+        return *this;
+    }
+
+    ParamsHasher & ParamsHasher::add(double value) noexcept
+    {
+        // Hash -0.0 and +0.0 equally
+        value += 0.0;
+        addBytes(&value, sizeof(value));
+        return *this;
+    }
+
+}
@@ -5,24 +5,22 @@ namespace xcspp::xcs
 {
 
     // UPDATE FITNESS
-    void ActionSet::updateFitness()
+    template <class Condition>
+    void BasicActionSet<Condition>::updateFitness(double accuracySum, BasicPopulation<Condition> & population)
     {
-        double accuracySum = 0.0;
-        for (const auto & cl : m_set)
-        {
-            accuracySum += cl->accuracy() * cl->numerosity;
-        }
-
+        // The modifier also reflects the experience and actionSetSize changed in update() in [P]
         for (const auto & cl : m_set)
         {
-            cl->fitness += m_pParams->beta * (cl->accuracy() * cl->numerosity / accuracySum - cl->fitness);
+            const auto modifier = population.modify(*cl);
+            modifier->fitness += m_pParams->beta * (modifier->accuracy() * modifier->numerosity / accuracySum - modifier->fitness);
         }
     }
 
     // DO ACTION SET SUBSUMPTION
-    void ActionSet::doSubsumption(Population & population)
+    template <class Condition>
+    void BasicActionSet<Condition>::doSubsumption(BasicPopulation<Condition> & population)
     {
-        ClassifierPtr cl;
+        BasicClassifierPtr<Condition> cl;
         for (const auto & c : m_set)
         {
             if (c->isSubsumer())
@@ -36,38 +34,37 @@ namespace xcspp::xcs
 
         if (cl.get() != nullptr)
         {
-            std::vector<ClassifierPtr> removedClassifiers;
             for (const auto & c : m_set)
             {
                 // Since all classifiers in [A] should have the same action, "cl->action == c->action" check is skipped
                 if (cl->condition.isMoreGeneral(c->condition))
                 {
-                    cl->numerosity += c->numerosity;
-                    removedClassifiers.push_back(c);
+                    population.modify(*cl)->numerosity += c->numerosity;
+                    population.erase(c); // O(1)
                 }
             }
 
-            for (const auto & removedClassifier : removedClassifiers)
-            {
-                population.erase(removedClassifier);
-                m_set.erase(removedClassifier);
-            }
+            // Remove the subsumed classifiers from [A] in a single pass
+            this->removeDeletedClassifiers();
         }
     }
 
-    ActionSet::ActionSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions)
-        : ClassifierPtrSet(pParams, availableActions)
+    template <class Condition>
+    BasicActionSet<Condition>::BasicActionSet(const XCSParams *pParams, const AvailableActions & availableActions)
+        : BasicClassifierPtrSet<Condition>(pParams, availableActions)
     {
     }
 
-    ActionSet::ActionSet(const MatchSet & matchSet, int action, const XCSParams *pParams, const std::unordered_set<int> & availableActions)
-        : ClassifierPtrSet(pParams, availableActions)
+    template <class Condition>
+    BasicActionSet<Condition>::BasicActionSet(const BasicMatchSet<Condition> & matchSet, int action, const XCSParams *pParams, const AvailableActions & availableActions)
+        : BasicClassifierPtrSet<Condition>(pParams, availableActions)
     {
         generateSet(matchSet, action);
     }
 
     // GENERATE ACTION SET
-    void ActionSet::generateSet(const MatchSet & matchSet, int action)
+    template <class Condition>
+    void BasicActionSet<Condition>::generateSet(const BasicMatchSet<Condition> & matchSet, int action)
     {
         m_set.clear();
 
@@ -75,23 +72,36 @@ namespace xcspp::xcs
         {
             if (cl->action == action)
             {
-                m_set.insert(cl);
+                m_set.push_back(cl);
             }
         }
     }
 
-    void ActionSet::copyTo(ActionSet & dest)
+    template <class Condition>
+    void BasicActionSet<Condition>::generateSet(BasicMatchSet<Condition> & matchSet, int action)
+    {
+        if (!matchSet.takeSetForAction(action, m_set))
+        {
+            generateSet(static_cast<const BasicMatchSet<Condition> &>(matchSet), action);
+        }
+    }
+
+    template <class Condition>
+    void BasicActionSet<Condition>::copyTo(BasicActionSet & dest)
     {
         dest.m_set = m_set;
     }
 
     // RUN GA (refer to GA::Run() for the latter part)
-    void ActionSet::runGA(const std::vector<int> & situation, Population & population, std::uint64_t timeStamp, Random & random)
+    template <class Condition>
+    void BasicActionSet<Condition>::runGA(const SituationType & situation, BasicPopulation<Condition> & population, std::uint64_t timeStamp, Random & random)
     {
-        double numerositySum = 0.0;
-        for (const auto & cl : m_set)
+        // Skip the classifiers deleted from [P] since this set was generated
+        // (There is nothing to evolve if all of them have been deleted.)
+        const double numerositySum = static_cast<double>(this->removeDeletedClassifiers());
+        if (m_set.empty())
         {
-            numerositySum += cl->numerosity;
+            return;
         }
         if (numerositySum <= 0.0)
         {
@@ -120,15 +130,15 @@ namespace xcspp::xcs
     }
 
     // UPDATE SET
-    void ActionSet::update(double p, Population & population)
+    template <class Condition>
+    void BasicActionSet<Condition>::update(double p, BasicPopulation<Condition> & population)
     {
-        // Calculate numerosity sum used for updating action set size estimate
-        std::uint64_t numerositySum = 0;
-        for (const auto & cl : m_set)
-        {
-            numerositySum += cl->numerosity;
-        }
+        // Skip the classifiers deleted from [P] since this set was generated
+        // (The numerosity sum used for updating action set size estimate is calculated in the same pass)
+        const std::uint64_t numerositySum = this->removeDeletedClassifiers();
 
+        // (The changes of experience and actionSetSize are reflected in [P] by updateFitness().)
+        double accuracySum = 0.0;
         for (const auto & cl : m_set)
         {
             ++cl->experience;
@@ -144,6 +154,7 @@ namespace xcspp::xcs
                 cl->epsilon += m_pParams->beta * (std::abs(p - cl->prediction) - cl->epsilon);
                 cl->prediction += m_pParams->beta * (p - cl->prediction);
             }
+            cl->updateAccuracy();
 
             // Update action set size estimate
             if (cl->experience < 1.0 / m_pParams->beta)
@@ -154,9 +165,12 @@ namespace xcspp::xcs
             {
                 cl->actionSetSize += m_pParams->beta * (numerositySum - cl->actionSetSize);
             }
+
+            // The accuracy of this classifier does not change in the rest of this loop
+            accuracySum += cl->accuracy() * cl->numerosity;
         }
 
-        updateFitness();
+        updateFitness(accuracySum, population);
 
         if (m_pParams->doActionSetSubsumption)
         {
@@ -164,4 +178,7 @@ namespace xcspp::xcs
         }
     }
 
+    template class BasicActionSet<Condition>;
+    template class BasicActionSet<PackedCondition>;
+
 }
@@ -1,30 +1,29 @@
 #include "xcspp/core/xcs/classifier.hpp"
 #include <utility> // std::move
 #include <cstddef> // std::size_t
-#include <cmath> // std::pow
+
+#include "xcspp/core/accuracy.hpp"
 
 namespace xcspp::xcs
 {
 
-    ConditionActionPair::ConditionActionPair(const Condition & condition, int action)
+    template <class Condition>
+    BasicConditionActionPair<Condition>::BasicConditionActionPair(const Condition & condition, int action)
         : condition(condition)
         , action(action)
     {
     }
 
-    ConditionActionPair::ConditionActionPair(Condition && condition, int action)
+    template <class Condition>
+    BasicConditionActionPair<Condition>::BasicConditionActionPair(Condition && condition, int action)
         : condition(std::move(condition))
         , action(action)
     {
     }
 
-    std::ostream & operator<< (std::ostream & os, const ConditionActionPair & obj)
-    {
-        return os << obj.condition << ':' << obj.action;
-    }
-
-    Classifier::Classifier(const Condition & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
-        : ConditionActionPair(condition, action)
+    template <class Condition>
+    BasicClassifier<Condition>::BasicClassifier(const Condition & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
+        : BasicConditionActionPair<Condition>(condition, action)
         , prediction(prediction)
         , epsilon(epsilon)
         , fitness(fitness)
@@ -35,8 +34,9 @@ namespace xcspp::xcs
     {
     }
 
-    Classifier::Classifier(const ConditionActionPair & conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
-        : ConditionActionPair(conditionActionPair)
+    template <class Condition>
+    BasicClassifier<Condition>::BasicClassifier(const BasicConditionActionPair<Condition> & conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
+        : BasicConditionActionPair<Condition>(conditionActionPair)
         , prediction(prediction)
         , epsilon(epsilon)
         , fitness(fitness)
@@ -47,8 +47,9 @@ namespace xcspp::xcs
     {
     }
 
-    Classifier::Classifier(ConditionActionPair && conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
-        : ConditionActionPair(std::move(conditionActionPair))
+    template <class Condition>
+    BasicClassifier<Condition>::BasicClassifier(BasicConditionActionPair<Condition> && conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
+        : BasicConditionActionPair<Condition>(std::move(conditionActionPair))
         , prediction(prediction)
         , epsilon(epsilon)
         , fitness(fitness)
@@ -59,79 +60,98 @@ namespace xcspp::xcs
     {
     }
 
-    Classifier::Classifier(const std::vector<int> & situation, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
-        : Classifier(Condition(situation), action, prediction, epsilon, fitness, timeStamp)
+    template <class Condition>
+    BasicClassifier<Condition>::BasicClassifier(const std::vector<int> & situation, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
+        : BasicClassifier(Condition(situation), action, prediction, epsilon, fitness, timeStamp)
     {
     }
 
-    Classifier::Classifier(const std::string & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
-        : Classifier(Condition(condition), action, prediction, epsilon, fitness, timeStamp)
+    template <class Condition>
+    BasicClassifier<Condition>::BasicClassifier(const std::string & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp)
+        : BasicClassifier(Condition(condition), action, prediction, epsilon, fitness, timeStamp)
     {
     }
 
-    double Classifier::accuracy(double epsilonZero, double alpha, double nu) const
+    template <class Condition>
+    double BasicClassifier<Condition>::accuracy(double epsilonZero, double alpha, double nu) const
     {
-        if (epsilon < epsilonZero)
-        {
-            return 1.0;
-        }
-        else
-        {
-            return alpha * std::pow(epsilon / epsilonZero, -nu);
-        }
+        return ComputeAccuracy(epsilon, epsilonZero, alpha, nu);
     }
 
-    StoredClassifier::StoredClassifier(const Classifier & obj, const XCSParams *pParams)
-        : Classifier(obj)
+    template <class Condition>
+    BasicStoredClassifier<Condition>::BasicStoredClassifier(const BasicClassifier<Condition> & obj, const XCSParams *pParams)
+        : BasicClassifier<Condition>(obj)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
-    StoredClassifier::StoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
+    template <class Condition>
+    BasicStoredClassifier<Condition>::BasicStoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams)
+        : BasicClassifier<Condition>(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
-    StoredClassifier::StoredClassifier(const ConditionActionPair & conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(conditionActionPair, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
+    template <class Condition>
+    BasicStoredClassifier<Condition>::BasicStoredClassifier(const BasicConditionActionPair<Condition> & conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams)
+        : BasicClassifier<Condition>(conditionActionPair, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
-    StoredClassifier::StoredClassifier(ConditionActionPair && conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(std::move(conditionActionPair), pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
+    template <class Condition>
+    BasicStoredClassifier<Condition>::BasicStoredClassifier(BasicConditionActionPair<Condition> && conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams)
+        : BasicClassifier<Condition>(std::move(conditionActionPair), pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
-    StoredClassifier::StoredClassifier(const std::vector<int> & situation, int action, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(situation, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
+    template <class Condition>
+    BasicStoredClassifier<Condition>::BasicStoredClassifier(const std::vector<int> & situation, int action, std::uint64_t timeStamp, const XCSParams *pParams)
+        : BasicClassifier<Condition>(situation, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
-    StoredClassifier::StoredClassifier(const std::string & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
+    template <class Condition>
+    BasicStoredClassifier<Condition>::BasicStoredClassifier(const std::string & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams)
+        : BasicClassifier<Condition>(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
     // COULD SUBSUME
-    bool StoredClassifier::isSubsumer() const
+    template <class Condition>
+    bool BasicStoredClassifier<Condition>::isSubsumer() const
     {
-        return experience > m_pParams->thetaSub && epsilon < m_pParams->epsilonZero;
+        return this->experience > m_pParams->thetaSub && this->epsilon < m_pParams->epsilonZero;
     }
 
     // DOES SUBSUME
-    bool StoredClassifier::subsumes(const Classifier & cl) const
+    template <class Condition>
+    bool BasicStoredClassifier<Condition>::subsumes(const BasicClassifier<Condition> & cl) const
     {
-        return action == cl.action && isSubsumer() && condition.isMoreGeneral(cl.condition);
+        return this->action == cl.action && isSubsumer() && this->condition.isMoreGeneral(cl.condition);
     }
 
-    double StoredClassifier::accuracy() const
+    template <class Condition>
+    void BasicStoredClassifier<Condition>::updateAccuracy()
     {
-        return Classifier::accuracy(m_pParams->epsilonZero, m_pParams->alpha, m_pParams->nu);
+        m_accuracy = BasicClassifier<Condition>::accuracy(m_pParams->epsilonZero, m_pParams->alpha, m_pParams->nu);
     }
 
+    template struct BasicConditionActionPair<Condition>;
+    template struct BasicClassifier<Condition>;
+    template struct BasicStoredClassifier<Condition>;
+
+    template struct BasicConditionActionPair<PackedCondition>;
+    template struct BasicClassifier<PackedCondition>;
+    template struct BasicStoredClassifier<PackedCondition>;
+
 }
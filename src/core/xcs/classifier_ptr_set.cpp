@@ -1,116 +1,55 @@
 #include "xcspp/core/xcs/classifier_ptr_set.hpp"
-#include "xcspp/util/csv.hpp"
+#include <algorithm> // std::find, std::count
 
 namespace xcspp::xcs
 {
 
-    namespace
-    {
-        std::unordered_set<ClassifierPtr> MakeSetFromClassifiers(const std::vector<Classifier> & classifiers, const XCSParams *pParams)
-        {
-            std::unordered_set<ClassifierPtr> set;
-            for (const auto & cl : classifiers)
-            {
-                set.emplace(std::make_shared<StoredClassifier>(cl, pParams));
-            }
-            return set;
-        }
-    }
-
-    ClassifierPtrSet::ClassifierPtrSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions)
+    template <class Condition>
+    BasicClassifierPtrSet<Condition>::BasicClassifierPtrSet(const XCSParams *pParams, const AvailableActions & availableActions)
         : m_pParams(pParams)
         , m_availableActions(availableActions)
     {
     }
 
-    ClassifierPtrSet::ClassifierPtrSet(const std::unordered_set<ClassifierPtr> & set, const XCSParams *pParams, const std::unordered_set<int> & availableActions)
-        : m_set(set)
-        , m_pParams(pParams)
-        , m_availableActions(availableActions)
-    {
-    }
-
-    ClassifierPtrSet::ClassifierPtrSet(const std::vector<Classifier> & initialClassifiers, const XCSParams *pParams, const std::unordered_set<int> & availableActions)
-        : m_set(MakeSetFromClassifiers(initialClassifiers, pParams))
-        , m_pParams(pParams)
-        , m_availableActions(availableActions)
-    {
-    }
-
-    void ClassifierPtrSet::setClassifiers(const std::vector<Classifier> & classifiers)
+    template <class Condition>
+    std::uint64_t BasicClassifierPtrSet<Condition>::removeDeletedClassifiers()
     {
-        // Replace classifiers
-        m_set.clear();
-        m_set.reserve(classifiers.size());
-        for (const auto & cl : classifiers)
+        std::uint64_t numerositySum = 0;
+        std::size_t remainingCount = 0;
+        for (std::size_t i = 0; i < m_set.size(); ++i)
         {
-            m_set.emplace(std::make_shared<StoredClassifier>(cl, m_pParams));
-        }
-    }
-
-    void ClassifierPtrSet::inputCSV(std::istream & is, bool initClassifierVariables)
-    {
-        auto classifiers = CSV::ReadClassifiers<Classifier>(is);
-        if (initClassifierVariables)
-        {
-            for (auto & cl : classifiers)
+            if (const auto pClassifier = m_set[i].get())
             {
-                cl.prediction = m_pParams->initialPrediction;
-                cl.epsilon = m_pParams->initialEpsilon;
-                cl.fitness = m_pParams->initialFitness;
-                cl.experience = 0;
-                cl.timeStamp = 0;
-                cl.actionSetSize = 1;
-                //cl.numerosity = 1; // commented out to keep macroclassifier as is
+                numerositySum += pClassifier->numerosity;
+                m_set[remainingCount++] = m_set[i];
             }
         }
-        setClassifiers(classifiers);
-    }
+        m_set.resize(remainingCount);
 
-    void ClassifierPtrSet::outputCSV(std::ostream & os) const
-    {
-        os << "Condition,Action,prediction,epsilon,F,exp,ts,as,n,acc\n";
-        for (const auto & cl : m_set)
-        {
-            os  << cl->condition << ','
-                << cl->action << ','
-                << cl->prediction << ','
-                << cl->epsilon << ','
-                << cl->fitness << ','
-                << cl->experience << ','
-                << cl->timeStamp << ','
-                << cl->actionSetSize << ','
-                << cl->numerosity << ','
-                << cl->accuracy() << '\n';
-        }
+        return numerositySum;
     }
 
-    bool ClassifierPtrSet::loadCSVFile(const std::string & filename, bool initClassifierVariables)
+    template <class Condition>
+    std::size_t BasicClassifierPtrSet<Condition>::erase(const ClassifierPtrType & cl)
     {
-        // Open file stream
-        std::ifstream ifs(filename);
-        if (!ifs.good())
+        const auto it = std::find(m_set.begin(), m_set.end(), cl);
+        if (it == m_set.end())
         {
-            return false;
+            return 0;
         }
 
-        // Read CSV
-        inputCSV(ifs, initClassifierVariables);
-        return true;
+        *it = m_set.back();
+        m_set.pop_back();
+        return 1;
     }
 
-    bool ClassifierPtrSet::saveCSVFile(const std::string & filename) const
+    template <class Condition>
+    std::size_t BasicClassifierPtrSet<Condition>::count(const ClassifierPtrType & cl) const
     {
-        // Open file stream
-        std::ofstream ofs(filename);
-        if (!ofs.good())
-        {
-            return false;
-        }
-
-        // Write CSV
-        outputCSV(ofs);
-        return true;
+        return static_cast<std::size_t>(std::count(m_set.begin(), m_set.end(), cl));
     }
 
+    template class BasicClassifierPtrSet<Condition>;
+    template class BasicClassifierPtrSet<PackedCondition>;
+
 }
@@ -0,0 +1,224 @@
+#include "xcspp/core/xcs/decision_index.hpp"
+#include <algorithm> // std::sort, std::lower_bound
+#include <stdexcept>
+
+namespace xcspp::xcs
+{
+
+    DecisionIndex::DecisionIndex(const std::vector<Classifier> & classifiers, std::size_t leafSize)
+        : m_classifiers(classifiers)
+        , m_conditionLength(classifiers.empty() ? 0 : classifiers.front().condition.size())
+        , m_leafSize(std::max<std::size_t>(leafSize, 1))
+    {
+        if (m_classifiers.size() >= kNoNode)
+        {
+            throw std::length_error("DecisionIndex could not index the classifiers since there are too many of them.");
+        }
+
+        for (const auto & cl : m_classifiers)
+        {
+            if (cl.condition.size() != m_conditionLength)
+            {
+                throw std::invalid_argument("DecisionIndex requires all the conditions to have the same length.");
+            }
+        }
+
+        if (!m_classifiers.empty())
+        {
+            std::vector<std::uint32_t> items(m_classifiers.size());
+            for (std::size_t i = 0; i < items.size(); ++i)
+            {
+                items[i] = static_cast<std::uint32_t>(i);
+            }
+            build(items);
+        }
+    }
+
+    DecisionIndex::DecisionIndex(const Population & population, std::size_t leafSize)
+        : DecisionIndex(std::vector<Classifier>(population.begin(), population.end()), leafSize)
+    {
+    }
+
+    std::uint32_t DecisionIndex::makeLeaf(const std::vector<std::uint32_t> & items)
+    {
+        const auto itemBegin = static_cast<std::uint32_t>(m_items.size());
+        m_items.insert(m_items.end(), items.begin(), items.end());
+        m_nodes.push_back({ kNoNode, 0, 0, kNoNode, itemBegin, static_cast<std::uint32_t>(m_items.size()) });
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    std::uint32_t DecisionIndex::build(std::vector<std::uint32_t> & items)
+    {
+        if (items.size() <= m_leafSize)
+        {
+            return makeLeaf(items);
+        }
+
+        // CHOOSE THE POSITION TO TEST
+        //   A query visits the wildcard child and at most one value child, so the position that
+        //   minimizes (wildcard count + largest value count) is tested. If no position reduces
+        //   the number of the classifiers to visit, the node becomes a leaf.
+        std::size_t bestPosition = m_conditionLength;
+        std::size_t bestCost = items.size();
+        std::vector<int> values;
+        for (std::size_t p = 0; p < m_conditionLength; ++p)
+        {
+            std::size_t wildcardCount = 0;
+            values.clear();
+            for (const auto & item : items)
+            {
+                const Symbol & symbol = m_classifiers[item].condition[p];
+                if (symbol.isDontCare())
+                {
+                    ++wildcardCount;
+                }
+                else
+                {
+                    values.push_back(symbol.value());
+                }
+            }
+
+            std::sort(values.begin(), values.end());
+            std::size_t maxValueCount = 0;
+            for (std::size_t i = 0; i < values.size();)
+            {
+                std::size_t j = i;
+                while (j < values.size() && values[j] == values[i])
+                {
+                    ++j;
+                }
+                maxValueCount = std::max(maxValueCount, j - i);
+                i = j;
+            }
+
+            if (wildcardCount + maxValueCount < bestCost)
+            {
+                bestCost = wildcardCount + maxValueCount;
+                bestPosition = p;
+            }
+        }
+
+        if (bestPosition == m_conditionLength)
+        {
+            return makeLeaf(items);
+        }
+
+        // Group the classifiers by the symbol at the position (values in ascending order, then "#")
+        const auto position = bestPosition;
+        std::stable_sort(items.begin(), items.end(), [this, position](std::uint32_t lhs, std::uint32_t rhs) {
+            const Symbol & l = m_classifiers[lhs].condition[position];
+            const Symbol & r = m_classifiers[rhs].condition[position];
+            if (l.isDontCare() || r.isDontCare())
+            {
+                return !l.isDontCare() && r.isDontCare();
+            }
+            return l.value() < r.value();
+        });
+
+        m_nodes.push_back({ static_cast<std::uint32_t>(position), 0, 0, kNoNode, 0, 0 });
+        const auto nodeIdx = static_cast<std::uint32_t>(m_nodes.size() - 1);
+
+        // The edges of the descendants are appended while building the children, so the
+        // edges of this node are collected here and appended at the end
+        std::vector<Edge> edges;
+        std::vector<std::uint32_t> childItems;
+        for (std::size_t i = 0; i < items.size();)
+        {
+            const Symbol & symbol = m_classifiers[items[i]].condition[position];
+            std::size_t j = i;
+            while (j < items.size() && m_classifiers[items[j]].condition[position] == symbol)
+            {
+                ++j;
+            }
+
+            childItems.assign(items.begin() + i, items.begin() + j);
+            const std::uint32_t child = build(childItems);
+            if (symbol.isDontCare())
+            {
+                m_nodes[nodeIdx].wildcardChild = child;
+            }
+            else
+            {
+                edges.push_back({ symbol.value(), child });
+            }
+            i = j;
+        }
+
+        m_nodes[nodeIdx].edgeBegin = static_cast<std::uint32_t>(m_edges.size());
+        m_edges.insert(m_edges.end(), edges.begin(), edges.end());
+        m_nodes[nodeIdx].edgeEnd = static_cast<std::uint32_t>(m_edges.size());
+
+        return nodeIdx;
+    }
+
+    void DecisionIndex::findMatching(const std::vector<int> & situation, std::vector<std::size_t> & indices) const
+    {
+        indices.clear();
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        if (situation.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("DecisionIndex::findMatching() could not process the situation with a different length.");
+        }
+
+        // Depth-first traversal (each node pushes at most two children, and the depth is at most the condition length)
+        std::vector<std::uint32_t> stack;
+        stack.reserve(m_conditionLength + 2);
+        stack.push_back(0);
+        while (!stack.empty())
+        {
+            const Node & node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if (node.position == kNoNode)
+            {
+                for (std::uint32_t i = node.itemBegin; i < node.itemEnd; ++i)
+                {
+                    if (m_classifiers[m_items[i]].condition.matches(situation))
+                    {
+                        indices.push_back(m_items[i]);
+                    }
+                }
+                continue;
+            }
+
+            const int value = situation[node.position];
+            const auto edgeEnd = m_edges.begin() + node.edgeEnd;
+            const auto it = std::lower_bound(m_edges.begin() + node.edgeBegin, edgeEnd, value, [](const Edge & edge, int v) {
+                return edge.value < v;
+            });
+            if (it != edgeEnd && it->value == value)
+            {
+                stack.push_back(it->child);
+            }
+            if (node.wildcardChild != kNoNode)
+            {
+                stack.push_back(node.wildcardChild);
+            }
+        }
+
+        // Same order as the population scan
+        std::sort(indices.begin(), indices.end());
+    }
+
+    std::vector<std::size_t> DecisionIndex::findMatching(const std::vector<int> & situation) const
+    {
+        std::vector<std::size_t> indices;
+        findMatching(situation, indices);
+        return indices;
+    }
+
+    std::vector<Classifier> DecisionIndex::getMatchingClassifiers(const std::vector<int> & situation) const
+    {
+        std::vector<Classifier> classifiers;
+        for (const auto & idx : findMatching(situation))
+        {
+            classifiers.push_back(m_classifiers[idx]);
+        }
+        return classifiers;
+    }
+
+}
@@ -1,9 +1,9 @@
 #include "xcspp/core/xcs/ga.hpp"
-#include <memory> // std::shared_ptr, std::make_shared
 #include <vector>
 #include <unordered_set>
 #include <cstdint> // std::uint64_t
 #include <cstddef> // std::size_t
+#include <algorithm> // std::min, std::max
 
 namespace xcspp::xcs
 {
@@ -11,9 +11,10 @@ namespace xcspp::xcs
     namespace
     {
         // SELECT OFFSPRING
-        ClassifierPtr SelectOffspring(const ClassifierPtrSet & actionSet, double tau, Random & random)
+        template <class Condition>
+        BasicClassifierPtr<Condition> SelectOffspring(const BasicClassifierPtrSet<Condition> & actionSet, double tau, Random & random)
         {
-            std::vector<const ClassifierPtr *> targets;
+            std::vector<const BasicClassifierPtr<Condition> *> targets;
             for (const auto & cl : actionSet)
             {
                 targets.push_back(&cl);
@@ -45,28 +46,126 @@ namespace xcspp::xcs
             return *targets[selectedIdx];
         }
 
-        // APPLY CROSSOVER (uniform crossover)
-        bool UniformCrossover(Classifier & cl1, Classifier & cl2, Random & random)
+        // Returns the bits of the word wordIdx that lie in [begin, end)
+        std::uint64_t RangeMask(std::size_t wordIdx, std::size_t begin, std::size_t end)
         {
-            if (cl1.condition.size() != cl2.condition.size())
+            const std::size_t wordBegin = wordIdx * PackedCondition::kWordBits;
+            const std::size_t wordEnd = wordBegin + PackedCondition::kWordBits;
+            const std::size_t b = std::max(begin, wordBegin);
+            const std::size_t e = std::min(end, wordEnd);
+            if (b >= e)
             {
-                throw std::invalid_argument("The condition lengths do not match in GA::UniformCrossover().");
+                return 0;
+            }
+
+            const std::size_t width = e - b;
+            const std::uint64_t mask = (width == PackedCondition::kWordBits) ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << width) - 1);
+            return mask << (b - wordBegin);
+        }
+
+        // Swap the symbols in [begin, end)
+        void SwapSymbols(Condition & cond1, Condition & cond2, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::swap(cond1[i], cond2[i]);
+            }
+        }
+
+        void SwapSymbols(PackedCondition & cond1, PackedCondition & cond2, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t w = begin / PackedCondition::kWordBits; w < cond1.wordCount() && w * PackedCondition::kWordBits < end; ++w)
+            {
+                cond1.swapMasked(cond2, w, RangeMask(w, begin, end));
             }
+        }
 
+        // Swap each symbol with probability 0.5
+        bool UniformSwapSymbols(Condition & cond1, Condition & cond2, Random & random)
+        {
             bool isChanged = false;
-            for (std::size_t i = 0; i < cl1.condition.size(); ++i)
+            for (std::size_t i = 0; i < cond1.size(); ++i)
             {
                 if (random.nextDouble() < 0.5)
                 {
-                    std::swap(cl1.condition[i], cl2.condition[i]);
+                    std::swap(cond1[i], cond2[i]);
                     isChanged = true;
                 }
             }
             return isChanged;
         }
 
+        bool UniformSwapSymbols(PackedCondition & cond1, PackedCondition & cond2, Random & random)
+        {
+            bool isChanged = false;
+            for (std::size_t w = 0; w < cond1.wordCount(); ++w)
+            {
+                const std::size_t bitCount = std::min(PackedCondition::kWordBits, cond1.size() - w * PackedCondition::kWordBits);
+                std::uint64_t mask = 0;
+                for (std::size_t i = 0; i < bitCount; ++i)
+                {
+                    if (random.nextDouble() < 0.5)
+                    {
+                        mask |= std::uint64_t{ 1 } << i;
+                    }
+                }
+                cond1.swapMasked(cond2, w, mask);
+                isChanged = isChanged || (mask != 0);
+            }
+            return isChanged;
+        }
+
+        // Toggle each symbol between "#" and the situation value with probability mu
+        void MutateSymbols(Condition & cond, const std::vector<int> & situation, double mu, Random & random)
+        {
+            for (std::size_t i = 0; i < cond.size(); ++i)
+            {
+                if (random.nextDouble() < mu)
+                {
+                    if (cond[i].isDontCare())
+                    {
+                        cond[i] = Symbol(situation.at(i));
+                    }
+                    else
+                    {
+                        cond[i].setToDontCare();
+                    }
+                }
+            }
+        }
+
+        void MutateSymbols(PackedCondition & cond, const PackedSituation & situation, double mu, Random & random)
+        {
+            for (std::size_t w = 0; w < cond.wordCount(); ++w)
+            {
+                const std::size_t bitCount = std::min(PackedCondition::kWordBits, cond.size() - w * PackedCondition::kWordBits);
+                std::uint64_t mask = 0;
+                for (std::size_t i = 0; i < bitCount; ++i)
+                {
+                    if (random.nextDouble() < mu)
+                    {
+                        mask |= std::uint64_t{ 1 } << i;
+                    }
+                }
+                cond.toggleMasked(w, mask, situation.word(w));
+            }
+        }
+
+        // APPLY CROSSOVER (uniform crossover)
+        template <class Condition>
+        bool UniformCrossover(BasicClassifier<Condition> & cl1, BasicClassifier<Condition> & cl2, Random & random)
+        {
+            if (cl1.condition.size() != cl2.condition.size())
+            {
+                throw std::invalid_argument("The condition lengths do not match in GA::UniformCrossover().");
+            }
+
+            return UniformSwapSymbols(cl1.condition, cl2.condition, random);
+        }
+
         // APPLY CROSSOVER (one point crossover)
-        bool OnePointCrossover(Classifier & cl1, Classifier & cl2, Random & random)
+        template <class Condition>
+        bool OnePointCrossover(BasicClassifier<Condition> & cl1, BasicClassifier<Condition> & cl2, Random & random)
         {
             if (cl1.condition.size() != cl2.condition.size())
             {
@@ -75,17 +174,18 @@ namespace xcspp::xcs
 
             std::size_t x = random.nextInt<std::size_t>(0, cl1.condition.size());
 
-            bool isChanged = false;
-            for (std::size_t i = x + 1; i < cl1.condition.size(); ++i)
+            if (x + 1 >= cl1.condition.size())
             {
-                std::swap(cl1.condition[i], cl2.condition[i]);
-                isChanged = true;
+                return false;
             }
-            return isChanged;
+
+            SwapSymbols(cl1.condition, cl2.condition, x + 1, cl1.condition.size());
+            return true;
         }
 
         // APPLY CROSSOVER (two point crossover)
-        bool TwoPointCrossover(Classifier & cl1, Classifier & cl2, Random & random)
+        template <class Condition>
+        bool TwoPointCrossover(BasicClassifier<Condition> & cl1, BasicClassifier<Condition> & cl2, Random & random)
         {
             if (cl1.condition.size() != cl2.condition.size())
             {
@@ -100,17 +200,18 @@ namespace xcspp::xcs
                 std::swap(x, y);
             }
 
-            bool isChanged = false;
-            for (std::size_t i = x + 1; i < y; ++i)
+            if (x + 1 >= y)
             {
-                std::swap(cl1.condition[i], cl2.condition[i]);
-                isChanged = true;
+                return false;
             }
-            return isChanged;
+
+            SwapSymbols(cl1.condition, cl2.condition, x + 1, y);
+            return true;
         }
 
         // APPLY CROSSOVER
-        bool Crossover(Classifier & cl1, Classifier & cl2, XCSParams::CrossoverMethod crossoverMethod, Random & random)
+        template <class Condition>
+        bool Crossover(BasicClassifier<Condition> & cl1, BasicClassifier<Condition> & cl2, XCSParams::CrossoverMethod crossoverMethod, Random & random)
         {
             switch (crossoverMethod)
             {
@@ -129,67 +230,55 @@ namespace xcspp::xcs
         }
 
         // APPLY MUTATION
-        void mutate(Classifier & cl, const std::vector<int> & situation, const std::unordered_set<int> & availableActions, double mu, bool doActionMutation, Random & random)
+        template <class Condition>
+        void mutate(BasicClassifier<Condition> & cl, const typename Condition::SituationType & situation, const AvailableActions & availableActions, double mu, bool doActionMutation, Random & random)
         {
             if (cl.condition.size() != situation.size())
             {
                 std::invalid_argument("GA::mutate() could not process the situation with a different length.");
             }
 
-            for (std::size_t i = 0; i < cl.condition.size(); ++i)
-            {
-                if (random.nextDouble() < mu)
-                {
-                    if (cl.condition[i].isDontCare())
-                    {
-                        cl.condition[i] = Symbol(situation.at(i));
-                    }
-                    else
-                    {
-                        cl.condition[i].setToDontCare();
-                    }
-                }
-            }
+            MutateSymbols(cl.condition, situation, mu, random);
 
             if (doActionMutation && (random.nextDouble() < mu) && (availableActions.size() >= 2))
             {
-                std::unordered_set<int> otherPossibleActions(availableActions);
-                otherPossibleActions.erase(cl.action);
-                cl.action = random.chooseFrom(otherPossibleActions);
+                cl.action = availableActions.chooseOtherThan(cl.action, random);
             }
         }
 
-        void subsumeClassifier(const Classifier & child, Population & population, const XCSParams *pParams, Random & random)
+        template <class Condition>
+        void subsumeClassifier(const BasicClassifier<Condition> & child, BasicPopulation<Condition> & population, const XCSParams *pParams, Random & random)
         {
-            std::vector<ClassifierPtr> choices;
+            std::vector<BasicStoredClassifier<Condition> *> choices;
 
-            for (const auto & cl : population)
+            for (auto & cl : population)
             {
-                if (cl->subsumes(child))
+                if (cl.subsumes(child))
                 {
-                    choices.push_back(cl);
+                    choices.push_back(&cl);
                 }
             }
 
             if (!choices.empty())
             {
                 std::size_t choice = random.nextInt<std::size_t>(0, choices.size() - 1);
-                ++choices[choice]->numerosity;
+                ++population.modify(*choices[choice])->numerosity;
                 return;
             }
 
-            population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child, pParams));
+            population.insertOrIncrementNumerosity(child);
         }
 
-        void subsumeClassifier(const Classifier & child, const ClassifierPtr & parent1, const ClassifierPtr & parent2, Population & population, const XCSParams *pParams, Random & random)
+        template <class Condition>
+        void subsumeClassifier(const BasicClassifier<Condition> & child, const BasicClassifierPtr<Condition> & parent1, const BasicClassifierPtr<Condition> & parent2, BasicPopulation<Condition> & population, const XCSParams *pParams, Random & random)
         {
             if (parent1->subsumes(child))
             {
-                ++parent1->numerosity;
+                ++population.modify(*parent1)->numerosity;
             }
             else if (parent2->subsumes(child))
             {
-                ++parent2->numerosity;
+                ++population.modify(*parent2)->numerosity;
             }
             else
             {
@@ -197,7 +286,8 @@ namespace xcspp::xcs
             }
         }
 
-        void insertDiscoveredClassifiers(const Classifier & child1, const Classifier & child2, const ClassifierPtr & parent1, const ClassifierPtr & parent2, Population & population, const XCSParams *pParams, Random & random)
+        template <class Condition>
+        void insertDiscoveredClassifiers(const BasicClassifier<Condition> & child1, const BasicClassifier<Condition> & child2, const BasicClassifierPtr<Condition> & parent1, const BasicClassifierPtr<Condition> & parent2, BasicPopulation<Condition> & population, const XCSParams *pParams, Random & random)
         {
             if (pParams->doGASubsumption)
             {
@@ -206,8 +296,8 @@ namespace xcspp::xcs
             }
             else
             {
-                population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child1, pParams));
-                population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child2, pParams));
+                population.insertOrIncrementNumerosity(child1);
+                population.insertOrIncrementNumerosity(child2);
             }
 
             while (population.deleteExtraClassifiers(random)) {}
@@ -217,17 +307,18 @@ namespace xcspp::xcs
     namespace GA
     {
         // RUN GA (refer to ActionSet::runGA() for the former part)
-        void Run(ClassifierPtrSet & actionSet, const std::vector<int> & situation, Population & population, const std::unordered_set<int> & availableActions, const XCSParams *pParams, Random & random)
+        template <class Condition>
+        void Run(BasicClassifierPtrSet<Condition> & actionSet, const typename Condition::SituationType & situation, BasicPopulation<Condition> & population, const AvailableActions & availableActions, const XCSParams *pParams, Random & random)
         {
-            const ClassifierPtr parent1 = SelectOffspring(actionSet, pParams->tau, random);
-            const ClassifierPtr parent2 = SelectOffspring(actionSet, pParams->tau, random);
+            const BasicClassifierPtr<Condition> parent1 = SelectOffspring(actionSet, pParams->tau, random);
+            const BasicClassifierPtr<Condition> parent2 = SelectOffspring(actionSet, pParams->tau, random);
             if (parent1->condition.size() != parent2->condition.size())
             {
                 std::domain_error("The condition lengths of selected parents do not match in GA::Run().");
             }
 
-            Classifier child1(*parent1);
-            Classifier child2(*parent2);
+            BasicClassifier<Condition> child1(*parent1);
+            BasicClassifier<Condition> child2(*parent2);
             child1.fitness = parent1->fitness / parent1->numerosity;
             child2.fitness = parent2->fitness / parent2->numerosity;
             child1.numerosity = child2.numerosity = 1;
@@ -265,6 +356,9 @@ namespace xcspp::xcs
 
             insertDiscoveredClassifiers(child1, child2, parent1, parent2, population, pParams, random);
         }
+
+        template void Run(ClassifierPtrSet & actionSet, const std::vector<int> & situation, Population & population, const AvailableActions & availableActions, const XCSParams *pParams, Random & random);
+        template void Run(PackedClassifierPtrSet & actionSet, const PackedSituation & situation, PackedPopulation & population, const AvailableActions & availableActions, const XCSParams *pParams, Random & random);
     }
 
 }
@@ -0,0 +1,294 @@
+#include "xcspp/core/xcs/inference_model.hpp"
+#include <algorithm> // std::fill
+#include <utility> // std::move
+#include <cstdint> // std::uint64_t
+
+#include "xcspp/util/csv.hpp"
+#include "xcspp/util/simd.hpp"
+
+namespace xcspp::xcs
+{
+
+    namespace
+    {
+        // Classifier fields read by ExploitBatch() and MakeActionColumns()
+        struct SnapshotClassifierView
+        {
+            int action;
+            double prediction;
+            double fitness;
+            std::size_t idx;
+        };
+
+        // Range of the classifiers in a snapshot (without constructing the conditions)
+        class SnapshotClassifierRange
+        {
+        private:
+            const std::int32_t * m_actions;
+            const double * m_predictions;
+            const double * m_fitnesses;
+            std::size_t m_size;
+
+        public:
+            class Iterator
+            {
+            private:
+                const SnapshotClassifierRange * m_pRange;
+                std::size_t m_idx;
+
+            public:
+                Iterator(const SnapshotClassifierRange * pRange, std::size_t idx)
+                    : m_pRange(pRange)
+                    , m_idx(idx)
+                {
+                }
+
+                SnapshotClassifierView operator*() const
+                {
+                    return { m_pRange->m_actions[m_idx], m_pRange->m_predictions[m_idx], m_pRange->m_fitnesses[m_idx], m_idx };
+                }
+
+                Iterator & operator++()
+                {
+                    ++m_idx;
+                    return *this;
+                }
+
+                bool operator!=(const Iterator & other) const
+                {
+                    return m_idx != other.m_idx;
+                }
+            };
+
+            explicit SnapshotClassifierRange(const PopulationSnapshot & snapshot)
+                : m_actions(snapshot.data<std::int32_t>(PopulationSnapshot::Section::kAction))
+                , m_predictions(snapshot.data<double>(PopulationSnapshot::Section::kPrediction))
+                , m_fitnesses(snapshot.data<double>(PopulationSnapshot::Section::kFitness))
+                , m_size(snapshot.size())
+            {
+            }
+
+            Iterator begin() const
+            {
+                return Iterator(this, 0);
+            }
+
+            Iterator end() const
+            {
+                return Iterator(this, m_size);
+            }
+
+            std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+        };
+    }
+
+    template <class Condition>
+    BasicInferenceModel<Condition>::BasicInferenceModel(std::shared_ptr<const PopulationSnapshot> && snapshot, const std::unordered_set<int> & availableActions, double initialPrediction)
+        : m_snapshot(std::move(snapshot))
+        , m_predictions(m_snapshot->data<double>(PopulationSnapshot::Section::kPrediction))
+        , m_fitnesses(m_snapshot->data<double>(PopulationSnapshot::Section::kFitness))
+        , m_careWords(nullptr)
+        , m_valueWords(nullptr)
+        , m_cares(nullptr)
+        , m_values(nullptr)
+        , m_kernel(PackedConditionMatrix::DetectKernel())
+        , m_availableActions(availableActions)
+        , m_initialPrediction(initialPrediction)
+    {
+        if (m_availableActions.empty())
+        {
+            throw std::invalid_argument("InferenceModel was constructed with no available actions.");
+        }
+
+        if constexpr (kUsesConditionMatrix)
+        {
+            m_careWords = m_snapshot->data<std::uint64_t>(PopulationSnapshot::Section::kConditionCare);
+            m_valueWords = m_snapshot->data<std::uint64_t>(PopulationSnapshot::Section::kConditionValue);
+        }
+        else
+        {
+            m_cares = m_snapshot->data<std::uint8_t>(PopulationSnapshot::Section::kConditionCare);
+            m_values = m_snapshot->data<std::int32_t>(PopulationSnapshot::Section::kConditionValue);
+        }
+
+        MakeActionColumns(SnapshotClassifierRange(*m_snapshot), m_availableActions, m_actionChoices, m_columns);
+    }
+
+    template <class Condition>
+    BasicInferenceModel<Condition>::BasicInferenceModel(const std::vector<ClassifierType> & classifiers, const std::unordered_set<int> & availableActions, double initialPrediction)
+        : BasicInferenceModel(std::make_shared<const PopulationSnapshot>(MakePopulationSnapshot(classifiers, 0)), availableActions, initialPrediction)
+    {
+    }
+
+    template <class Condition>
+    BasicInferenceModel<Condition>::BasicInferenceModel(const BasicPopulation<Condition> & population, const std::unordered_set<int> & availableActions, double initialPrediction)
+        : BasicInferenceModel(std::make_shared<const PopulationSnapshot>(MakePopulationSnapshot(population, 0)), availableActions, initialPrediction)
+    {
+    }
+
+    template <class Condition>
+    BasicInferenceModel<Condition> BasicInferenceModel<Condition>::FromCSVFile(const std::string & filename, const std::unordered_set<int> & availableActions, double initialPrediction)
+    {
+        return BasicInferenceModel(CSV::ReadClassifiersFromFile<ClassifierType>(filename), availableActions, initialPrediction);
+    }
+
+    template <class Condition>
+    BasicInferenceModel<Condition> BasicInferenceModel<Condition>::FromBinaryFile(const std::string & filename, const std::unordered_set<int> & availableActions, double initialPrediction)
+    {
+        auto snapshot = std::make_shared<const PopulationSnapshot>(PopulationSnapshot::FromFile(filename));
+        if (snapshot->conditionKind() != kSnapshotConditionKind<Condition>)
+        {
+            // Convert the conditions (e.g., a snapshot of XCS for PackedInferenceModel)
+            snapshot = std::make_shared<const PopulationSnapshot>(MakePopulationSnapshot(ReadPopulationSnapshot<Condition>(*snapshot), snapshot->paramsHash()));
+        }
+        return BasicInferenceModel(std::move(snapshot), availableActions, initialPrediction);
+    }
+
+    template <class Condition>
+    bool BasicInferenceModel<Condition>::matchesAt(std::size_t idx, const SituationType & situation) const
+    {
+        if constexpr (kUsesConditionMatrix)
+        {
+            const std::size_t wordCount = situation.wordCount();
+            for (std::size_t w = 0; w < wordCount; ++w)
+            {
+                const std::size_t wordIdx = PackedConditionMatrix::WordIndex(idx, w, wordCount);
+                if ((situation.word(w) ^ m_valueWords[wordIdx]) & m_careWords[wordIdx])
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            const std::size_t conditionLength = situation.size();
+            const std::uint8_t * const cares = m_cares + idx * conditionLength;
+            const std::int32_t * const values = m_values + idx * conditionLength;
+            for (std::size_t i = 0; i < conditionLength; ++i)
+            {
+                if (cares[i] && values[i] != situation[i])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <class Condition>
+    void BasicInferenceModel<Condition>::checkSituationLength(std::size_t length) const
+    {
+        if (!m_snapshot->empty() && length != m_snapshot->conditionLength())
+        {
+            throw std::invalid_argument("InferenceModel could not process the situation with a different length.");
+        }
+    }
+
+    template <class Condition>
+    InferenceResult BasicInferenceModel<Condition>::predictImpl(const SituationType & situation) const
+    {
+        const std::size_t actionCount = m_actionChoices.size();
+
+        // PA and FSA of this call only (nothing in the model is modified)
+        std::vector<double> pa(actionCount, 0.0);
+        std::vector<double> fsa(actionCount, 0.0);
+        std::vector<unsigned char> isInPA(actionCount, 0);
+        const auto accumulate = [&](std::size_t idx) {
+            const std::size_t col = m_columns[idx];
+            pa[col] += m_predictions[idx] * m_fitnesses[idx];
+            fsa[col] += m_fitnesses[idx];
+            isInPA[col] = 1;
+        };
+
+        checkSituationLength(situation.size());
+        if constexpr (kUsesConditionMatrix)
+        {
+            std::vector<std::uint64_t> matchBitmap;
+            PackedConditionMatrix::Match(m_careWords, m_valueWords, situation.wordCount(), m_snapshot->conditionLength(), m_snapshot->size(), m_kernel, situation, matchBitmap);
+            ForEachSetBit(matchBitmap, accumulate);
+        }
+        else
+        {
+            for (std::size_t idx = 0; idx < m_snapshot->size(); ++idx)
+            {
+                if (matchesAt(idx, situation))
+                {
+                    accumulate(idx);
+                }
+            }
+        }
+
+        InferenceResult result;
+        result.predictions.resize(actionCount);
+        const std::size_t bestCol = FinalizeGreedyPredictionArray(pa.data(), fsa.data(), isInPA.data(), actionCount, result.predictions.data());
+        result.isMatchSetEmpty = (bestCol == actionCount);
+        if (result.isMatchSetEmpty)
+        {
+            std::fill(result.predictions.begin(), result.predictions.end(), m_initialPrediction);
+            result.action = m_availableActions[0];
+            result.prediction = m_initialPrediction;
+        }
+        else
+        {
+            result.action = m_actionChoices[bestCol];
+            result.prediction = result.predictions[bestCol];
+        }
+        return result;
+    }
+
+    template <class Condition>
+    InferenceResult BasicInferenceModel<Condition>::predict(const std::vector<int> & situation) const
+    {
+        if constexpr (std::is_same_v<SituationType, std::vector<int>>)
+        {
+            return predictImpl(situation);
+        }
+        else
+        {
+            return predictImpl(SituationType(situation));
+        }
+    }
+
+    template <class Condition>
+    InferenceResult BasicInferenceModel<Condition>::predict(const PackedSituation & situation) const
+    {
+        if constexpr (std::is_same_v<SituationType, PackedSituation>)
+        {
+            return predictImpl(situation);
+        }
+        else
+        {
+            return predictImpl(situation.toVector());
+        }
+    }
+
+    template <class Condition>
+    ExploitBatchResult BasicInferenceModel<Condition>::predictBatch(const std::vector<std::vector<int>> & situations) const
+    {
+        for (const auto & situation : situations)
+        {
+            checkSituationLength(situation.size());
+        }
+
+        const SnapshotClassifierRange classifiers(*m_snapshot);
+        if constexpr (std::is_same_v<SituationType, std::vector<int>>)
+        {
+            return ExploitBatch(classifiers, situations.size(), m_availableActions, m_initialPrediction,
+                [this, &situations](const SnapshotClassifierView & cl, std::size_t idx) { return matchesAt(cl.idx, situations[idx]); });
+        }
+        else
+        {
+            // Pack the situations once per batch
+            const std::vector<SituationType> situationsForMatch(situations.begin(), situations.end());
+            return ExploitBatch(classifiers, situations.size(), m_availableActions, m_initialPrediction,
+                [this, &situationsForMatch](const SnapshotClassifierView & cl, std::size_t idx) { return matchesAt(cl.idx, situationsForMatch[idx]); });
+        }
+    }
+
+    template class BasicInferenceModel<Condition>;
+    template class BasicInferenceModel<PackedCondition>;
+
+}
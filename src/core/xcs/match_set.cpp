@@ -1,86 +1,174 @@
 #include "xcspp/core/xcs/match_set.hpp"
-#include <memory> // std::make_shared
 #include <sstream> // std::ostringstream
+#include <algorithm> // std::min
+#include <utility> // std::move
+
+#include "xcspp/core/xcs/prediction_array.hpp"
 
 namespace xcspp::xcs
 {
 
     namespace
     {
-        // GENERATE COVERING CLASSIFIER
-        ClassifierPtr GenerateCoveringClassifier(
-            const std::vector<int> & situation,
-            const std::unordered_set<int> & unselectedActions,
-            std::uint64_t timeStamp,
-            const XCSParams *pParams,
-            Random & random)
+        // Set to "#" (don't care) at random
+        void SetRandomDontCare(Condition & condition, double dontCareProbability, Random & random)
         {
-            const auto cl = std::make_shared<StoredClassifier>(situation, random.chooseFrom(unselectedActions), timeStamp, pParams);
-
-            // Set to "#" (don't care) at random
-            for (auto & symbol : cl->condition)
+            for (auto & symbol : condition)
             {
-                if (random.nextDouble() < pParams->dontCareProbability)
+                if (random.nextDouble() < dontCareProbability)
                 {
                     symbol.setToDontCare();
                 }
             }
+        }
+
+        // Set to "#" (don't care) at random (PackedCondition version; consumes the same random numbers as above)
+        void SetRandomDontCare(PackedCondition & condition, double dontCareProbability, Random & random)
+        {
+            for (std::size_t w = 0; w < condition.wordCount(); ++w)
+            {
+                const std::size_t bitCount = std::min(PackedCondition::kWordBits, condition.size() - w * PackedCondition::kWordBits);
+                std::uint64_t mask = 0;
+                for (std::size_t i = 0; i < bitCount; ++i)
+                {
+                    if (random.nextDouble() < dontCareProbability)
+                    {
+                        mask |= std::uint64_t{ 1 } << i;
+                    }
+                }
+                condition.setToDontCareMasked(w, mask);
+            }
+        }
+
+        void OutputSituation(std::ostream & os, const std::vector<int> & situation)
+        {
+            for (const auto & s : situation)
+            {
+                os << s << ' ';
+            }
+        }
+
+        void OutputSituation(std::ostream & os, const PackedSituation & situation)
+        {
+            OutputSituation(os, situation.toVector());
+        }
+
+        // GENERATE COVERING CLASSIFIER
+        template <class Condition>
+        BasicStoredClassifier<Condition> GenerateCoveringClassifier(
+            const typename Condition::SituationType & situation,
+            const ActionSubset & unselectedActions,
+            std::uint64_t timeStamp,
+            const XCSParams *pParams,
+            Random & random)
+        {
+            BasicStoredClassifier<Condition> cl(Condition(situation), unselectedActions.choose(random), timeStamp, pParams);
+
+            SetRandomDontCare(cl.condition, pParams->dontCareProbability, random);
 
             return cl;
         }
+
+        // Accumulator that ignores the classifiers (for generating [M] only)
+        struct NullAccumulator
+        {
+            void clear() noexcept
+            {
+            }
+
+            template <class Classifier>
+            void accumulate(const Classifier &) noexcept
+            {
+            }
+        };
     }
 
-    MatchSet::MatchSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, const XCSParams *pParams, const std::unordered_set<int> & availableActions, Random & random)
-        : ClassifierPtrSet(pParams, availableActions)
+    template <class Condition>
+    BasicMatchSet<Condition>::BasicMatchSet(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, const XCSParams *pParams, const AvailableActions & availableActions, Random & random)
+        : BasicClassifierPtrSet<Condition>(pParams, availableActions)
         , m_isCoveringPerformed(false)
     {
         generateSet(population, situation, timeStamp, random);
     }
 
     // GENERATE MATCH SET
-    void MatchSet::generateSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, Random & random)
+    template <class Condition>
+    void BasicMatchSet<Condition>::generateSet(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, Random & random)
+    {
+        NullAccumulator accumulator;
+        generateSetImpl(population, situation, timeStamp, random, accumulator);
+    }
+
+    template <class Condition>
+    void BasicMatchSet<Condition>::generateSet(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, Random & random, PredictionArray & predictionArray)
+    {
+        generateSetImpl(population, situation, timeStamp, random, predictionArray);
+        predictionArray.finalize();
+    }
+
+    template <class Condition>
+    template <class Accumulator>
+    void BasicMatchSet<Condition>::generateSetImpl(BasicPopulation<Condition> & population, const SituationType & situation, std::uint64_t timeStamp, Random & random, Accumulator & accumulator)
     {
         // Set theta_mna (the minimal number of actions) to the number of action choices if theta_mna is 0
         auto thetaMna = (m_pParams->thetaMna == 0) ? m_availableActions.size() : m_pParams->thetaMna;
 
-        auto unselectedActions = m_availableActions;
+        ActionSubset unselectedActions(m_availableActions, true);
+
+        // Partition [M] by action in the same scan of [P]
+        m_setsByAction.resize(m_availableActions.size());
+        const auto clearSets = [this]() {
+            m_set.clear();
+            for (auto & set : m_setsByAction)
+            {
+                set.clear();
+            }
+            m_isPartitioned = true;
+        };
 
-        m_set.clear();
+        clearSets();
+        accumulator.clear();
 
         while (m_set.empty())
         {
-            for (const auto & cl : population)
-            {
-                if (cl->condition.matches(situation))
+            population.forEachMatchingClassifier(situation, [&](const auto & cl) {
+                m_set.push_back(cl);
+                accumulator.accumulate(*cl);
+                unselectedActions.erase(cl->action);
+
+                const std::size_t actionIdx = m_availableActions.indexOf(cl->action);
+                if (actionIdx != AvailableActions::npos)
                 {
-                    m_set.insert(cl);
-                    unselectedActions.erase(cl->action);
+                    m_setsByAction[actionIdx].push_back(cl);
                 }
-            }
+                else
+                {
+                    // The classifier has an action that is not available (e.g., loaded from a file)
+                    m_isPartitioned = false;
+                }
+            });
 
             // Generate classifiers covering the unselected actions
             if (m_availableActions.size() - unselectedActions.size() < thetaMna)
             {
-                const auto coveringClassifier = GenerateCoveringClassifier(situation, unselectedActions, timeStamp, m_pParams, random);
+                auto coveringClassifier = GenerateCoveringClassifier<Condition>(situation, unselectedActions, timeStamp, m_pParams, random);
 
                 // Make sure the generated covering classifier covers the given input
-                if (!coveringClassifier->condition.matches(situation))
+                if (!coveringClassifier.condition.matches(situation))
                 {
                     std::ostringstream oss;
                     oss <<
                         "The covering classifier does not contain the current situation!\n"
                         "  - Current situation: ";
-                    for (const auto & s : situation)
-                    {
-                        oss << s << ' ';
-                    }
-                    oss << "\n  - Covering classifier: " << *coveringClassifier << '\n' << std::endl;
+                    OutputSituation(oss, situation);
+                    oss << "\n  - Covering classifier: " << coveringClassifier << '\n' << std::endl;
                     throw std::runtime_error(oss.str());
                 }
 
-                population.insert(coveringClassifier);
+                population.insert(std::move(coveringClassifier));
                 population.deleteExtraClassifiers(random);
-                m_set.clear();
+                clearSets();
+                accumulator.clear();
                 m_isCoveringPerformed = true;
             }
             else
@@ -90,9 +178,28 @@ namespace xcspp::xcs
         }
     }
 
-    bool MatchSet::isCoveringPerformed() const
+    template <class Condition>
+    bool BasicMatchSet<Condition>::isCoveringPerformed() const
     {
         return m_isCoveringPerformed;
     }
 
+    template <class Condition>
+    bool BasicMatchSet<Condition>::takeSetForAction(int action, std::vector<BasicClassifierPtr<Condition>> & dest)
+    {
+        const std::size_t actionIdx = m_availableActions.indexOf(action);
+        if (!m_isPartitioned || actionIdx == AvailableActions::npos)
+        {
+            return false;
+        }
+
+        dest.swap(m_setsByAction[actionIdx]);
+        m_setsByAction[actionIdx].clear();
+        m_isPartitioned = false;
+        return true;
+    }
+
+    template class BasicMatchSet<Condition>;
+    template class BasicMatchSet<PackedCondition>;
+
 }
@@ -0,0 +1,265 @@
+#include "xcspp/core/xcs/packed_condition.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <algorithm> // std::min
+
+namespace xcspp::xcs
+{
+
+    namespace
+    {
+        std::size_t WordCount(std::size_t size)
+        {
+            return (size + PackedCondition::kWordBits - 1) / PackedCondition::kWordBits;
+        }
+
+        std::size_t PopCount(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_popcountll(x));
+#else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<std::size_t>((x * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+    }
+
+    PackedCondition::PackedCondition() : m_size(0) {}
+
+    PackedCondition::PackedCondition(const std::vector<Symbol> & symbols)
+        : m_size(symbols.size())
+        , m_careMask(WordCount(symbols.size()), 0)
+        , m_valueMask(WordCount(symbols.size()), 0)
+    {
+        for (std::size_t i = 0; i < symbols.size(); ++i)
+        {
+            setSymbol(i, symbols[i]);
+        }
+    }
+
+    PackedCondition::PackedCondition(const std::vector<int> & symbols)
+        : m_size(symbols.size())
+        , m_careMask(WordCount(symbols.size()), 0)
+        , m_valueMask(WordCount(symbols.size()), 0)
+    {
+        for (std::size_t i = 0; i < symbols.size(); ++i)
+        {
+            setSymbol(i, Symbol(symbols[i]));
+        }
+    }
+
+    PackedCondition::PackedCondition(const std::string & symbols) : m_size(0)
+    {
+        std::vector<Symbol> symbolVec;
+        std::istringstream iss(symbols);
+        std::string symbol;
+        while (std::getline(iss, symbol, ' '))
+        {
+            if (symbol.empty())
+            {
+                continue;
+            }
+
+            symbolVec.emplace_back(symbol);
+        }
+
+        *this = PackedCondition(symbolVec);
+    }
+
+    PackedCondition::PackedCondition(const PackedSituation & situation)
+        : m_size(situation.size())
+        , m_careMask(situation.wordCount())
+        , m_valueMask(situation.wordCount())
+    {
+        for (std::size_t w = 0; w < situation.wordCount(); ++w)
+        {
+            const std::size_t bitCount = std::min(kWordBits, m_size - w * kWordBits);
+            m_careMask[w] = (bitCount == kWordBits) ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << bitCount) - 1);
+            m_valueMask[w] = situation.word(w);
+        }
+    }
+
+    std::string PackedCondition::toString() const
+    {
+        std::string str;
+        str.reserve(m_size * 2);
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            str += (*this)[i].toString();
+            str += ' ';
+        }
+
+        // Erase last whitespace
+        if (!str.empty() && str.back() == ' ')
+        {
+            str.pop_back();
+        }
+
+        return str;
+    }
+
+    // DOES MATCH
+    bool PackedCondition::matches(const std::vector<int> & situation) const
+    {
+        if (m_size != situation.size())
+        {
+            throw std::invalid_argument("PackedCondition::matches() could not process the situation with a different length.");
+        }
+
+        for (std::size_t w = 0; w < m_careMask.size(); ++w)
+        {
+            // Pack the situation word (any value other than 0/1 never matches "0" or "1")
+            const std::size_t begin = w * kWordBits;
+            const std::size_t end = std::min(begin + kWordBits, m_size);
+            std::uint64_t situationBits = 0;
+            std::uint64_t invalidBits = 0;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const std::uint64_t bit = std::uint64_t{ 1 } << (i - begin);
+                if (situation[i] == 1)
+                {
+                    situationBits |= bit;
+                }
+                else if (situation[i] != 0)
+                {
+                    invalidBits |= bit;
+                }
+            }
+
+            if (((situationBits ^ m_valueMask[w]) | invalidBits) & m_careMask[w])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool PackedCondition::isMoreGeneral(const PackedCondition & cond) const
+    {
+        if (m_size != cond.m_size)
+        {
+            throw std::invalid_argument("In PackedCondition::isMoreGeneral(), both conditions must have the same length.");
+        }
+
+        bool ret = false;
+
+        for (std::size_t w = 0; w < m_careMask.size(); ++w)
+        {
+            // Specified here but "#" or a different value in the other
+            if ((m_careMask[w] & ~cond.m_careMask[w]) || ((m_valueMask[w] ^ cond.m_valueMask[w]) & m_careMask[w]))
+            {
+                return false;
+            }
+
+            // "#" here but specified in the other
+            if (cond.m_careMask[w] & ~m_careMask[w])
+            {
+                ret = true;
+            }
+        }
+
+        return ret;
+    }
+
+    std::size_t PackedCondition::dontCareCount() const
+    {
+        std::size_t careCount = 0;
+        for (const auto & word : m_careMask)
+        {
+            careCount += PopCount(word);
+        }
+
+        return m_size - careCount;
+    }
+
+    bool PackedCondition::isDontCare(std::size_t idx) const
+    {
+        return !((m_careMask[idx / kWordBits] >> (idx % kWordBits)) & 1);
+    }
+
+    Symbol PackedCondition::operator[] (std::size_t idx) const
+    {
+        if (isDontCare(idx))
+        {
+            return Symbol();
+        }
+        else
+        {
+            return Symbol(static_cast<int>((m_valueMask[idx / kWordBits] >> (idx % kWordBits)) & 1));
+        }
+    }
+
+    Symbol PackedCondition::at(std::size_t idx) const
+    {
+        if (idx >= m_size)
+        {
+            throw std::out_of_range("PackedCondition::at() received an out-of-range index.");
+        }
+
+        return (*this)[idx];
+    }
+
+    void PackedCondition::setSymbol(std::size_t idx, const Symbol & symbol)
+    {
+        const std::uint64_t bit = std::uint64_t{ 1 } << (idx % kWordBits);
+        auto & careWord = m_careMask[idx / kWordBits];
+        auto & valueWord = m_valueMask[idx / kWordBits];
+
+        if (symbol.isDontCare())
+        {
+            careWord &= ~bit;
+            valueWord &= ~bit;
+        }
+        else
+        {
+            const int value = symbol.value();
+            if (value != 0 && value != 1)
+            {
+                throw std::invalid_argument("PackedCondition only supports the symbols '0', '1' and '#'.");
+            }
+
+            careWord |= bit;
+            if (value == 1)
+            {
+                valueWord |= bit;
+            }
+            else
+            {
+                valueWord &= ~bit;
+            }
+        }
+    }
+
+    void PackedCondition::swapMasked(PackedCondition & other, std::size_t wordIdx, std::uint64_t mask)
+    {
+        const std::uint64_t careDiff = (m_careMask[wordIdx] ^ other.m_careMask[wordIdx]) & mask;
+        const std::uint64_t valueDiff = (m_valueMask[wordIdx] ^ other.m_valueMask[wordIdx]) & mask;
+        m_careMask[wordIdx] ^= careDiff;
+        other.m_careMask[wordIdx] ^= careDiff;
+        m_valueMask[wordIdx] ^= valueDiff;
+        other.m_valueMask[wordIdx] ^= valueDiff;
+    }
+
+    void PackedCondition::setToDontCareMasked(std::size_t wordIdx, std::uint64_t mask)
+    {
+        m_careMask[wordIdx] &= ~mask;
+        m_valueMask[wordIdx] &= ~mask;
+    }
+
+    void PackedCondition::toggleMasked(std::size_t wordIdx, std::uint64_t mask, std::uint64_t situationBits)
+    {
+        // Bits becoming specified take the situation value, and the others are cleared
+        const std::uint64_t newlySpecified = mask & ~m_careMask[wordIdx];
+        m_careMask[wordIdx] ^= mask;
+        m_valueMask[wordIdx] = (m_valueMask[wordIdx] & ~mask) | (situationBits & newlySpecified);
+    }
+
+    std::ostream & operator<< (std::ostream & os, const PackedCondition & obj)
+    {
+        return os << obj.toString();
+    }
+
+}
@@ -0,0 +1,243 @@
+#include "xcspp/core/xcs/packed_condition_matrix.hpp"
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define XCSPP_XCS_MATRIX_X86
+#include <immintrin.h>
+#endif
+
+#if defined(XCSPP_XCS_MATRIX_X86) && (defined(__GNUC__) || defined(__clang__))
+#define XCSPP_XCS_MATRIX_TARGET(arch) __attribute__((target(arch)))
+#else
+#define XCSPP_XCS_MATRIX_TARGET(arch)
+#endif
+
+namespace xcspp::xcs
+{
+
+    namespace
+    {
+        constexpr std::size_t kBlockSize = PackedConditionMatrix::kBlockSize;
+
+        void MatchScalar(const std::uint64_t *careMask, const std::uint64_t *valueMask, std::size_t wordCount, std::size_t blockCount, const PackedSituation & situation, std::uint64_t *bitmap)
+        {
+            for (std::size_t b = 0; b < blockCount; ++b)
+            {
+                const std::uint64_t *care = careMask + b * wordCount * kBlockSize;
+                const std::uint64_t *value = valueMask + b * wordCount * kBlockSize;
+                for (std::size_t lane = 0; lane < kBlockSize; ++lane)
+                {
+                    std::uint64_t mismatch = 0;
+                    for (std::size_t w = 0; w < wordCount; ++w)
+                    {
+                        mismatch |= (situation.word(w) ^ value[w * kBlockSize + lane]) & care[w * kBlockSize + lane];
+                    }
+
+                    if (mismatch == 0)
+                    {
+                        const std::size_t rowIdx = b * kBlockSize + lane;
+                        bitmap[rowIdx / 64] |= std::uint64_t{ 1 } << (rowIdx % 64);
+                    }
+                }
+            }
+        }
+
+#ifdef XCSPP_XCS_MATRIX_X86
+        XCSPP_XCS_MATRIX_TARGET("sse2")
+        void MatchSSE2(const std::uint64_t *careMask, const std::uint64_t *valueMask, std::size_t wordCount, std::size_t blockCount, const PackedSituation & situation, std::uint64_t *bitmap)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            for (std::size_t b = 0; b < blockCount; ++b)
+            {
+                const std::uint64_t *care = careMask + b * wordCount * kBlockSize;
+                const std::uint64_t *value = valueMask + b * wordCount * kBlockSize;
+                __m128i mismatchLo = _mm_setzero_si128();
+                __m128i mismatchHi = _mm_setzero_si128();
+                for (std::size_t w = 0; w < wordCount; ++w)
+                {
+                    const __m128i s = _mm_set1_epi64x(static_cast<long long>(situation.word(w)));
+                    const __m128i cLo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(care + w * kBlockSize));
+                    const __m128i cHi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(care + w * kBlockSize + 2));
+                    const __m128i vLo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value + w * kBlockSize));
+                    const __m128i vHi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value + w * kBlockSize + 2));
+                    mismatchLo = _mm_or_si128(mismatchLo, _mm_and_si128(_mm_xor_si128(s, vLo), cLo));
+                    mismatchHi = _mm_or_si128(mismatchHi, _mm_and_si128(_mm_xor_si128(s, vHi), cHi));
+                }
+
+                // A 64-bit lane is zero if all of its 8 bytes compare equal to zero
+                const int maskLo = _mm_movemask_epi8(_mm_cmpeq_epi32(mismatchLo, zero));
+                const int maskHi = _mm_movemask_epi8(_mm_cmpeq_epi32(mismatchHi, zero));
+                const std::uint64_t matched =
+                    static_cast<std::uint64_t>((maskLo & 0x00FF) == 0x00FF) |
+                    (static_cast<std::uint64_t>((maskLo & 0xFF00) == 0xFF00) << 1) |
+                    (static_cast<std::uint64_t>((maskHi & 0x00FF) == 0x00FF) << 2) |
+                    (static_cast<std::uint64_t>((maskHi & 0xFF00) == 0xFF00) << 3);
+
+                const std::size_t rowIdx = b * kBlockSize;
+                bitmap[rowIdx / 64] |= matched << (rowIdx % 64);
+            }
+        }
+
+        XCSPP_XCS_MATRIX_TARGET("avx2")
+        void MatchAVX2(const std::uint64_t *careMask, const std::uint64_t *valueMask, std::size_t wordCount, std::size_t blockCount, const PackedSituation & situation, std::uint64_t *bitmap)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            for (std::size_t b = 0; b < blockCount; ++b)
+            {
+                const std::uint64_t *care = careMask + b * wordCount * kBlockSize;
+                const std::uint64_t *value = valueMask + b * wordCount * kBlockSize;
+                __m256i mismatch = _mm256_setzero_si256();
+                for (std::size_t w = 0; w < wordCount; ++w)
+                {
+                    const __m256i s = _mm256_set1_epi64x(static_cast<long long>(situation.word(w)));
+                    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(care + w * kBlockSize));
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value + w * kBlockSize));
+                    mismatch = _mm256_or_si256(mismatch, _mm256_and_si256(_mm256_xor_si256(s, v), c));
+                }
+
+                const int matched = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(mismatch, zero)));
+
+                const std::size_t rowIdx = b * kBlockSize;
+                bitmap[rowIdx / 64] |= static_cast<std::uint64_t>(matched) << (rowIdx % 64);
+            }
+        }
+#endif
+    }
+
+    PackedConditionMatrix::PackedConditionMatrix()
+        : m_wordCount(0)
+        , m_conditionLength(0)
+        , m_size(0)
+        , m_kernel(DetectSIMDKernel())
+    {
+    }
+
+    void PackedConditionMatrix::setKernel(Kernel kernel)
+    {
+        if (!IsSIMDKernelSupported(kernel))
+        {
+            throw std::invalid_argument("PackedConditionMatrix::setKernel() received a kernel that is not supported by the CPU.");
+        }
+        m_kernel = kernel;
+    }
+
+    void PackedConditionMatrix::pushBack(const PackedCondition & condition)
+    {
+        if (m_size == 0)
+        {
+            m_wordCount = condition.wordCount();
+            m_conditionLength = condition.size();
+            m_careMask.clear();
+            m_valueMask.clear();
+        }
+        else if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("PackedConditionMatrix::pushBack() received a condition with a different length.");
+        }
+
+        if (m_size % kBlockSize == 0)
+        {
+            m_careMask.resize(m_careMask.size() + m_wordCount * kBlockSize, 0);
+            m_valueMask.resize(m_valueMask.size() + m_wordCount * kBlockSize, 0);
+        }
+
+        ++m_size;
+        set(m_size - 1, condition);
+    }
+
+    void PackedConditionMatrix::set(std::size_t rowIdx, const PackedCondition & condition)
+    {
+        if (rowIdx >= m_size)
+        {
+            throw std::out_of_range("PackedConditionMatrix::set() received an out-of-range index.");
+        }
+
+        if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("PackedConditionMatrix::set() received a condition with a different length.");
+        }
+
+        for (std::size_t w = 0; w < m_wordCount; ++w)
+        {
+            m_careMask[wordIndex(rowIdx, w)] = condition.careMask(w);
+            m_valueMask[wordIndex(rowIdx, w)] = condition.valueMask(w);
+        }
+    }
+
+    void PackedConditionMatrix::swapRemove(std::size_t rowIdx)
+    {
+        if (rowIdx >= m_size)
+        {
+            throw std::out_of_range("PackedConditionMatrix::swapRemove() received an out-of-range index.");
+        }
+
+        const std::size_t lastIdx = m_size - 1;
+        for (std::size_t w = 0; w < m_wordCount; ++w)
+        {
+            // Move the last row into the removed row, and clear the last row
+            m_careMask[wordIndex(rowIdx, w)] = m_careMask[wordIndex(lastIdx, w)];
+            m_valueMask[wordIndex(rowIdx, w)] = m_valueMask[wordIndex(lastIdx, w)];
+            m_careMask[wordIndex(lastIdx, w)] = 0;
+            m_valueMask[wordIndex(lastIdx, w)] = 0;
+        }
+
+        --m_size;
+        if (m_size % kBlockSize == 0)
+        {
+            m_careMask.resize(m_careMask.size() - m_wordCount * kBlockSize);
+            m_valueMask.resize(m_valueMask.size() - m_wordCount * kBlockSize);
+        }
+    }
+
+    void PackedConditionMatrix::clear() noexcept
+    {
+        m_size = 0;
+        m_careMask.clear();
+        m_valueMask.clear();
+    }
+
+    // DOES MATCH (for all rows)
+    void PackedConditionMatrix::match(const PackedSituation & situation, std::vector<std::uint64_t> & bitmap) const
+    {
+        Match(m_careMask.data(), m_valueMask.data(), m_wordCount, m_conditionLength, m_size, m_kernel, situation, bitmap);
+    }
+
+    void PackedConditionMatrix::Match(const std::uint64_t * careMask, const std::uint64_t * valueMask, std::size_t wordCount, std::size_t conditionLength, std::size_t rowCount, Kernel kernel, const PackedSituation & situation, std::vector<std::uint64_t> & bitmap)
+    {
+        bitmap.assign((rowCount + 63) / 64, 0);
+        if (rowCount == 0)
+        {
+            return;
+        }
+
+        if (situation.size() != conditionLength)
+        {
+            throw std::invalid_argument("PackedConditionMatrix::match() could not process the situation with a different length.");
+        }
+
+        const std::size_t blockCount = (rowCount + kBlockSize - 1) / kBlockSize;
+        switch (kernel)
+        {
+#ifdef XCSPP_XCS_MATRIX_X86
+        case Kernel::kAVX2:
+            MatchAVX2(careMask, valueMask, wordCount, blockCount, situation, bitmap.data());
+            break;
+
+        case Kernel::kSSE2:
+            MatchSSE2(careMask, valueMask, wordCount, blockCount, situation, bitmap.data());
+            break;
+#endif
+
+        default:
+            MatchScalar(careMask, valueMask, wordCount, blockCount, situation, bitmap.data());
+            break;
+        }
+
+        // Clear the bits of the padding rows in the last block (they have no specified symbols and always match)
+        if (rowCount % 64 != 0)
+        {
+            bitmap.back() &= (std::uint64_t{ 1 } << (rowCount % 64)) - 1;
+        }
+    }
+
+}
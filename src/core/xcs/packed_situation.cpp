@@ -0,0 +1,47 @@
+#include "xcspp/core/xcs/packed_situation.hpp"
+#include <stdexcept>
+
+namespace xcspp::xcs
+{
+
+    PackedSituation::PackedSituation() : m_size(0) {}
+
+    PackedSituation::PackedSituation(std::size_t size)
+        : m_size(size)
+        , m_words((size + kWordBits - 1) / kWordBits, 0)
+    {
+    }
+
+    PackedSituation::PackedSituation(const std::vector<int> & situation) : m_size(0)
+    {
+        assign(situation);
+    }
+
+    void PackedSituation::assign(Span<const int> situation)
+    {
+        m_size = situation.size();
+        m_words.assign((m_size + kWordBits - 1) / kWordBits, 0);
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            if (situation[i] == 1)
+            {
+                m_words[i / kWordBits] |= std::uint64_t{ 1 } << (i % kWordBits);
+            }
+            else if (situation[i] != 0)
+            {
+                throw std::invalid_argument("PackedSituation only supports the values 0 and 1.");
+            }
+        }
+    }
+
+    std::vector<int> PackedSituation::toVector() const
+    {
+        std::vector<int> situation(m_size);
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            situation[i] = (*this)[i];
+        }
+        return situation;
+    }
+
+}
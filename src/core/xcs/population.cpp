@@ -1,7 +1,15 @@
 #include "xcspp/core/xcs/population.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <cmath> // std::abs
+#include <algorithm> // std::max
+#include <utility> // std::move
 #include <cstdint> // std::uint64_t
 
-#include "xcspp/core/xcs/classifier_ptr_set.hpp"
+#include "xcspp/core/xcs/population_snapshot.hpp"
+#include "xcspp/util/binary_stream.hpp"
+#include "xcspp/util/csv.hpp"
+#include "xcspp/util/hash.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcs
@@ -9,81 +17,666 @@ namespace xcspp::xcs
 
     namespace
     {
-        // DELETION VOTE
-        double DeletionVote(const Classifier & cl, double averageFitness, std::uint64_t thetaDel, double delta)
+        std::size_t HashCondition(const Condition & condition)
         {
-            double vote = cl.actionSetSize * cl.numerosity;
+            std::size_t seed = condition.size();
+            for (const auto & symbol : condition)
+            {
+                // All "#" symbols are equal regardless of their value
+                HashCombine(seed, symbol.isDontCare() ? -1 : symbol.value());
+            }
+            return seed;
+        }
 
-            // Consider fitness for deletion vote
-            if ((cl.experience >= thetaDel) && (cl.fitness / cl.numerosity < delta * averageFitness))
+        std::size_t HashCondition(const PackedCondition & condition)
+        {
+            // Value bits are kept zero where the care bits are zero, so equal conditions have identical words
+            std::size_t seed = condition.size();
+            for (std::size_t w = 0; w < condition.wordCount(); ++w)
             {
-                vote *= averageFitness / (cl.fitness / cl.numerosity);
+                HashCombine(seed, condition.careMask(w));
+                HashCombine(seed, condition.valueMask(w));
             }
+            return seed;
+        }
 
-            return vote;
+        template <class Condition>
+        std::size_t HashConditionAction(const BasicConditionActionPair<Condition> & cl)
+        {
+            std::size_t seed = HashCondition(cl.condition);
+            HashCombine(seed, cl.action);
+            return seed;
+        }
+
+        // DELETION VOTE (without the fitness factor)
+        //   The vote is multiplied by averageFitness / (fitness / numerosity) if the classifier is
+        //   experienced and its fitness / numerosity is below delta * averageFitness.
+        template <class Condition>
+        double BaseDeletionVote(const BasicClassifier<Condition> & cl)
+        {
+            return cl.actionSetSize * cl.numerosity;
+        }
+
+        bool IsNearlyEqual(double a, double b)
+        {
+            return std::abs(a - b) <= 1e-9 * std::max({ 1.0, std::abs(a), std::abs(b) });
         }
     }
 
-    // INSERT IN POPULATION
-    void Population::insertOrIncrementNumerosity(const ClassifierPtr & cl)
+    template <class Condition>
+    BasicPopulation<Condition>::BasicPopulation(const XCSParams *pParams, const std::unordered_set<int> & availableActions)
+        : m_pParams(pParams)
+        , m_availableActions(availableActions)
+        , m_matchSetCache(pParams->matchSetCacheCapacity)
+        , m_numerositySum(0)
+        , m_fitnessSum(0.0)
+        , m_aggregateUpdateCount(0)
+    {
+    }
+
+    template <class Condition>
+    BasicPopulation<Condition>::BasicPopulation(const std::vector<ClassifierType> & initialClassifiers, const XCSParams *pParams, const std::unordered_set<int> & availableActions)
+        : m_pParams(pParams)
+        , m_availableActions(availableActions)
+        , m_matchSetCache(pParams->matchSetCacheCapacity)
+        , m_numerositySum(0)
+        , m_fitnessSum(0.0)
+        , m_aggregateUpdateCount(0)
+    {
+        setClassifiers(initialClassifiers);
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::setClassifiers(const std::vector<ClassifierType> & classifiers)
+    {
+        // Replace classifiers
+        clear();
+        m_arena.reserve(classifiers.size());
+        m_aggregateEntries.reserve(classifiers.size());
+        m_baseVoteTree.reserve(classifiers.size());
+        for (const auto & cl : classifiers)
+        {
+            insert(StoredClassifierType(cl, m_pParams));
+        }
+
+        validateInDebugBuild();
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::resetClassifierVariables(std::vector<ClassifierType> & classifiers) const
+    {
+        for (auto & cl : classifiers)
+        {
+            cl.prediction = m_pParams->initialPrediction;
+            cl.epsilon = m_pParams->initialEpsilon;
+            cl.fitness = m_pParams->initialFitness;
+            cl.experience = 0;
+            cl.timeStamp = 0;
+            cl.actionSetSize = 1;
+            //cl.numerosity = 1; // commented out to keep macroclassifier as is
+        }
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::inputCSV(std::istream & is, bool initClassifierVariables)
     {
-        for (auto & c : m_set)
+        auto classifiers = CSV::ReadClassifiers<ClassifierType>(is);
+        if (initClassifierVariables)
         {
-            if (c->condition == cl->condition && c->action == cl->action)
+            resetClassifierVariables(classifiers);
+        }
+        setClassifiers(classifiers);
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::outputCSV(std::ostream & os) const
+    {
+        os << "Condition,Action,prediction,epsilon,F,exp,ts,as,n,acc\n";
+        for (const auto & cl : m_arena)
+        {
+            os  << cl.condition << ','
+                << cl.action << ','
+                << cl.prediction << ','
+                << cl.epsilon << ','
+                << cl.fitness << ','
+                << cl.experience << ','
+                << cl.timeStamp << ','
+                << cl.actionSetSize << ','
+                << cl.numerosity << ','
+                << cl.accuracy() << '\n';
+        }
+    }
+
+    template <class Condition>
+    bool BasicPopulation<Condition>::loadCSVFile(const std::string & filename, bool initClassifierVariables)
+    {
+        // Open file stream
+        std::ifstream ifs(filename);
+        if (!ifs.good())
+        {
+            return false;
+        }
+
+        // Read CSV
+        inputCSV(ifs, initClassifierVariables);
+        return true;
+    }
+
+    template <class Condition>
+    bool BasicPopulation<Condition>::saveCSVFile(const std::string & filename) const
+    {
+        // Open file stream
+        std::ofstream ofs(filename);
+        if (!ofs.good())
+        {
+            return false;
+        }
+
+        // Write CSV
+        outputCSV(ofs);
+        return true;
+    }
+
+    template <class Condition>
+    bool BasicPopulation<Condition>::loadBinaryFile(const std::string & filename, bool initClassifierVariables)
+    {
+        // Check that the file can be opened (PopulationSnapshot throws otherwise)
+        if (!std::ifstream(filename).good())
+        {
+            return false;
+        }
+
+        // Read the snapshot in place
+        auto classifiers = ReadPopulationSnapshot<Condition>(PopulationSnapshot::FromFile(filename));
+        if (initClassifierVariables)
+        {
+            resetClassifierVariables(classifiers);
+        }
+        setClassifiers(classifiers);
+        return true;
+    }
+
+    template <class Condition>
+    bool BasicPopulation<Condition>::saveBinaryFile(const std::string & filename) const
+    {
+        return MakePopulationSnapshot(m_arena, HashParams(*m_pParams)).saveFile(filename);
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::outputCheckpoint(std::ostream & os) const
+    {
+        MakePopulationSnapshot(m_arena, HashParams(*m_pParams)).write(os);
+
+        // Running aggregates
+        std::vector<std::uint64_t> numerosities;
+        std::vector<double> fitnesses;
+        std::vector<std::uint8_t> experiencedFlags;
+        numerosities.reserve(m_aggregateEntries.size());
+        fitnesses.reserve(m_aggregateEntries.size());
+        experiencedFlags.reserve(m_aggregateEntries.size());
+        for (const auto & entry : m_aggregateEntries)
+        {
+            numerosities.push_back(entry.numerosity);
+            fitnesses.push_back(entry.fitness);
+            experiencedFlags.push_back(entry.isExperienced);
+        }
+
+        BinaryWriter writer(os);
+        writer.writeVector(numerosities);
+        writer.writeVector(fitnesses);
+        writer.writeVector(experiencedFlags);
+        writer.write(m_fitnessSum);
+        writer.write<std::uint64_t>(m_aggregateUpdateCount);
+        writer.writeVector(m_baseVoteTree.values());
+        writer.writeVector(m_baseVoteTree.nodes());
+
+        // The cached match sets are not written (they are found again by scanning [P])
+        writer.write(m_matchSetCache.statistics());
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::inputCheckpoint(std::istream & is)
+    {
+        setClassifiers(ReadPopulationSnapshot<Condition>(PopulationSnapshot::Read(is)));
+
+        BinaryReader reader(is);
+        const auto numerosities = reader.readVector<std::uint64_t>();
+        const auto fitnesses = reader.readVector<double>();
+        const auto experiencedFlags = reader.readVector<std::uint8_t>();
+        const auto fitnessSum = reader.read<double>();
+        const auto aggregateUpdateCount = reader.read<std::uint64_t>();
+        const auto baseVotes = reader.readVector<double>();
+        const auto baseVoteNodes = reader.readVector<double>();
+        const std::size_t size = m_arena.size();
+        if (numerosities.size() != size || fitnesses.size() != size || experiencedFlags.size() != size
+            || baseVotes.size() != size || baseVoteNodes.size() != size)
+        {
+            throw std::runtime_error("Population::inputCheckpoint() could not read the stream (inconsistent sizes of the aggregates).");
+        }
+
+        // Replace the aggregates computed by setClassifiers() with the saved ones
+        m_numerositySum = 0;
+        m_experiencedClassifiers.clear();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_aggregateEntries[i] = { numerosities[i], fitnesses[i], experiencedFlags[i] != 0 };
+            m_numerositySum += numerosities[i];
+            if (experiencedFlags[i])
             {
-                ++c->numerosity;
-                return;
+                m_experiencedClassifiers.emplace(fitnesses[i] / numerosities[i], i);
             }
         }
-        m_set.insert(cl);
+        m_fitnessSum = fitnessSum;
+        m_aggregateUpdateCount = static_cast<std::size_t>(aggregateUpdateCount);
+        m_baseVoteTree.assign(baseVotes, baseVoteNodes);
+        m_matchSetCache.setStatistics(reader.read<MatchSetCacheStatistics>());
+
+        validateInDebugBuild();
     }
 
-    // DELETE FROM POPULATION
-    bool Population::deleteExtraClassifiers(Random & random)
+    template <class Condition>
+    bool BasicPopulation<Condition>::contains(const ClassifierPtrType & cl) const
     {
-        uint64_t numerositySum = 0;
-        double fitnessSum = 0.0;
-        for (const auto & c : m_set)
+        return cl.get() != nullptr && &*cl == m_arena.get(cl.handle());
+    }
+
+    template <class Condition>
+    typename BasicPopulation<Condition>::ClassifierPtrType BasicPopulation<Condition>::insert(const StoredClassifierType & cl)
+    {
+        return insert(StoredClassifierType(cl));
+    }
+
+    template <class Condition>
+    typename BasicPopulation<Condition>::ClassifierPtrType BasicPopulation<Condition>::insert(StoredClassifierType && cl)
+    {
+        if constexpr (kUsesConditionMatrix)
         {
-            numerositySum += c->numerosity;
-            fitnessSum += c->fitness;
+            m_conditionMatrix.pushBack(cl.condition);
         }
+        pushBackAggregates(cl);
+        const std::size_t hash = HashConditionAction(cl);
+        const SlotHandle handle = m_arena.insert(std::move(cl));
+        m_index.emplace(hash, handle);
 
-        // Return false if the sum of numerosity has not met its maximum limit
-        if (numerositySum <= m_pParams->n)
+        const auto & condition = m_arena[handle].condition;
+        m_matchSetCache.notifyInsert(m_arena.size() - 1, [&condition](const SituationType & situation) {
+            return condition.matches(situation);
+        });
+
+        return ClassifierPtrType(&m_arena, handle);
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::eraseAt(std::size_t idx)
+    {
+        if constexpr (kUsesConditionMatrix)
         {
-            return false;
+            m_conditionMatrix.swapRemove(idx);
+        }
+        swapRemoveAggregates(idx);
+        m_matchSetCache.notifySwapRemove(idx, m_arena.size() - 1);
+
+        const SlotHandle handle = m_arena.handleAt(idx);
+        const auto range = m_index.equal_range(HashConditionAction(m_arena[handle]));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == handle)
+            {
+                m_index.erase(it);
+                break;
+            }
+        }
+
+        m_arena.erase(handle);
+    }
+
+    template <class Condition>
+    const std::vector<std::size_t> & BasicPopulation<Condition>::cachedMatchingIndices(const SituationType & situation)
+    {
+        if (const auto pIndices = m_matchSetCache.find(situation))
+        {
+            return *pIndices;
+        }
+
+        auto & indices = m_matchSetCache.emplace(situation);
+        forEachMatchingIndex(situation, m_matchBitmap, [&indices](std::size_t idx) { indices.push_back(idx); });
+        return indices;
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::pushBackAggregates(const StoredClassifierType & cl)
+    {
+        const AggregateEntry entry = { cl.numerosity, cl.fitness, cl.experience >= m_pParams->thetaDel };
+        m_numerositySum += entry.numerosity;
+        m_fitnessSum += entry.fitness;
+        if (entry.isExperienced)
+        {
+            m_experiencedClassifiers.emplace(entry.fitness / entry.numerosity, m_aggregateEntries.size());
+        }
+        m_aggregateEntries.push_back(entry);
+        m_baseVoteTree.pushBack(BaseDeletionVote(cl));
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::updateAggregatesAt(std::size_t idx)
+    {
+        const auto & cl = m_arena.begin()[idx];
+        auto & entry = m_aggregateEntries[idx];
+
+        m_numerositySum = m_numerositySum - entry.numerosity + cl.numerosity;
+        m_fitnessSum += cl.fitness - entry.fitness;
+        m_baseVoteTree.set(idx, BaseDeletionVote(cl));
+
+        // Reorder the experienced classifier only if its key has changed
+        // (e.g. only the experience or actionSetSize has changed)
+        const AggregateEntry newEntry = { cl.numerosity, cl.fitness, cl.experience >= m_pParams->thetaDel };
+        const bool isKeyUnchanged = entry.isExperienced && newEntry.isExperienced
+            && entry.fitness == newEntry.fitness && entry.numerosity == newEntry.numerosity;
+        if (!isKeyUnchanged)
+        {
+            if (entry.isExperienced)
+            {
+                m_experiencedClassifiers.erase({ entry.fitness / entry.numerosity, idx });
+            }
+            if (newEntry.isExperienced)
+            {
+                m_experiencedClassifiers.emplace(newEntry.fitness / newEntry.numerosity, idx);
+            }
+        }
+        entry = newEntry;
+
+        // Discard the rounding errors of the incremental updates once in a while (amortized O(1))
+        if (++m_aggregateUpdateCount > m_arena.size())
+        {
+            recomputeAggregates();
+        }
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::swapRemoveAggregates(std::size_t idx)
+    {
+        const std::size_t lastIdx = m_aggregateEntries.size() - 1;
+        const AggregateEntry entry = m_aggregateEntries[idx];
+        m_numerositySum -= entry.numerosity;
+        m_fitnessSum -= entry.fitness;
+        if (entry.isExperienced)
+        {
+            m_experiencedClassifiers.erase({ entry.fitness / entry.numerosity, idx });
+        }
+
+        // Move the last classifier into the removed position
+        if (idx != lastIdx)
+        {
+            const AggregateEntry lastEntry = m_aggregateEntries[lastIdx];
+            if (lastEntry.isExperienced)
+            {
+                m_experiencedClassifiers.erase({ lastEntry.fitness / lastEntry.numerosity, lastIdx });
+                m_experiencedClassifiers.emplace(lastEntry.fitness / lastEntry.numerosity, idx);
+            }
+            m_aggregateEntries[idx] = lastEntry;
         }
+        m_aggregateEntries.pop_back();
+        m_baseVoteTree.swapRemove(idx);
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::recomputeAggregates()
+    {
+        m_fitnessSum = 0.0;
+        for (const auto & entry : m_aggregateEntries)
+        {
+            m_fitnessSum += entry.fitness;
+        }
+        m_baseVoteTree.rebuild();
+        m_aggregateUpdateCount = 0;
+    }
 
+    template <class Condition>
+    std::size_t BasicPopulation<Condition>::selectDeletionTarget(Random & random) const
+    {
         // The average fitness in the population
-        double averageFitness = fitnessSum / numerositySum;
+        const double averageFitness = m_fitnessSum / m_numerositySum;
 
-        std::vector<const ClassifierPtr *> targets;
-        for (const auto & cl : m_set)
+        // Additional votes of the experienced classifiers with low fitness
+        //   vote = baseVote * averageFitness / (fitness / numerosity)
+        //        = baseVote + baseVote * (averageFitness / (fitness / numerosity) - 1)
+        const double threshold = m_pParams->delta * averageFitness;
+        double additionalVoteSum = 0.0;
+        for (auto it = m_experiencedClassifiers.begin(); it != m_experiencedClassifiers.end() && it->first < threshold; ++it)
         {
-            targets.push_back(&cl);
+            additionalVoteSum += m_baseVoteTree[it->second] * (averageFitness / it->first - 1.0);
         }
 
         // Roulette-wheel selection
-        std::vector<double> votes;
-        votes.reserve(targets.size());
-        for (const auto & target : targets)
+        const double baseVoteSum = m_baseVoteTree.sum();
+        const double voteSum = baseVoteSum + additionalVoteSum;
+        if (voteSum <= 0.0)
+        {
+            throw std::runtime_error("Population::deleteExtraClassifiers() generated an invalid deletion vote sum.");
+        }
+
+        double randValue = random.nextDouble(0.0, voteSum);
+        if (randValue < baseVoteSum)
+        {
+            return m_baseVoteTree.find(randValue);
+        }
+
+        randValue -= baseVoteSum;
+        std::size_t selectedIdx = m_baseVoteTree.size() - 1;
+        for (auto it = m_experiencedClassifiers.begin(); it != m_experiencedClassifiers.end() && it->first < threshold; ++it)
+        {
+            selectedIdx = it->second;
+            randValue -= m_baseVoteTree[it->second] * (averageFitness / it->first - 1.0);
+            if (randValue < 0.0)
+            {
+                break;
+            }
+        }
+        return selectedIdx;
+    }
+
+    template <class Condition>
+    typename BasicPopulation<Condition>::ScopedModifier BasicPopulation<Condition>::modify(const StoredClassifierType & cl)
+    {
+        const auto first = &*m_arena.begin();
+        if (&cl < first || &cl >= first + m_arena.size())
+        {
+            throw std::invalid_argument("Population::modify() received a classifier that is not in the population.");
+        }
+        return ScopedModifier(*this, static_cast<std::size_t>(&cl - first));
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::validateInDebugBuild() const
+    {
+#ifndef NDEBUG
+        validateIndex();
+        validateAggregates();
+#endif
+    }
+
+    template <class Condition>
+    typename BasicPopulation<Condition>::StoredClassifierType * BasicPopulation<Condition>::findSameConditionAction(const BasicConditionActionPair<Condition> & cl)
+    {
+        const auto range = m_index.equal_range(HashConditionAction(cl));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            auto & c = m_arena[it->second];
+            if (c.condition == cl.condition && c.action == cl.action)
+            {
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    template <class Condition>
+    std::size_t BasicPopulation<Condition>::erase(const ClassifierPtrType & cl)
+    {
+        if (!contains(cl))
         {
-            votes.push_back(DeletionVote(**target, averageFitness, m_pParams->thetaDel, m_pParams->delta));
+            return 0;
         }
-        std::size_t selectedIdx = random.rouletteWheelSelection(votes);
+
+        eraseAt(m_arena.denseIndex(cl.handle()));
+
+        validateInDebugBuild();
+
+        return 1;
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::clear()
+    {
+        m_arena.clear();
+        m_conditionMatrix.clear();
+        m_matchSetCache.clear();
+        m_index.clear();
+        m_aggregateEntries.clear();
+        m_baseVoteTree.clear();
+        m_experiencedClassifiers.clear();
+        m_numerositySum = 0;
+        m_fitnessSum = 0.0;
+        m_aggregateUpdateCount = 0;
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::setMatchKernel(PackedConditionMatrix::Kernel kernel)
+    {
+        m_conditionMatrix.setKernel(kernel);
+    }
+
+    // INSERT IN POPULATION
+    template <class Condition>
+    void BasicPopulation<Condition>::insertOrIncrementNumerosity(const ClassifierType & cl)
+    {
+        StoredClassifierType * const c = findSameConditionAction(cl);
+        if (c != nullptr)
+        {
+            ++modify(*c)->numerosity;
+        }
+        else
+        {
+            insert(StoredClassifierType(cl, m_pParams));
+        }
+
+        validateInDebugBuild();
+    }
+
+    // DELETE FROM POPULATION
+    template <class Condition>
+    bool BasicPopulation<Condition>::deleteExtraClassifiers(Random & random)
+    {
+        // Return false if the sum of numerosity has not met its maximum limit
+        if (m_numerositySum <= m_pParams->n)
+        {
+            return false;
+        }
+
+        const std::size_t selectedIdx = selectDeletionTarget(random);
 
         // Distrust the selected classifier
-        if ((*targets[selectedIdx])->numerosity > 1)
+        auto & selected = m_arena.begin()[selectedIdx];
+        if (selected.numerosity > 1)
         {
-            (*targets[selectedIdx])->numerosity--;
+            selected.numerosity--;
+            updateAggregatesAt(selectedIdx);
         }
         else
         {
-            m_set.erase(*targets[selectedIdx]);
+            eraseAt(selectedIdx);
         }
 
-        return (numerositySum - 1) > m_pParams->n;
+        validateInDebugBuild();
+
+        return m_numerositySum > m_pParams->n;
     }
 
+    template <class Condition>
+    void BasicPopulation<Condition>::validateIndex() const
+    {
+        if (m_index.size() != m_arena.size())
+        {
+            throw std::logic_error("Population::validateIndex() detected that the hash index size differs from the population size.");
+        }
+
+        for (std::size_t i = 0; i < m_arena.size(); ++i)
+        {
+            const SlotHandle handle = m_arena.handleAt(i);
+            const auto range = m_index.equal_range(HashConditionAction(m_arena[handle]));
+            bool found = false;
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == handle)
+                {
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                throw std::logic_error("Population::validateIndex() detected a classifier that is missing from the hash index.");
+            }
+        }
+    }
+
+    template <class Condition>
+    void BasicPopulation<Condition>::validateAggregates() const
+    {
+        if (m_aggregateEntries.size() != m_arena.size() || m_baseVoteTree.size() != m_arena.size())
+        {
+            throw std::logic_error("Population::validateAggregates() detected that the aggregate size differs from the population size.");
+        }
+
+        std::uint64_t numerositySum = 0;
+        double fitnessSum = 0.0;
+        std::size_t experiencedCount = 0;
+        for (std::size_t i = 0; i < m_arena.size(); ++i)
+        {
+            const auto & cl = m_arena.begin()[i];
+            const auto & entry = m_aggregateEntries[i];
+            if (entry.numerosity != cl.numerosity || entry.fitness != cl.fitness || m_baseVoteTree[i] != BaseDeletionVote(cl)
+                || entry.isExperienced != (cl.experience >= m_pParams->thetaDel))
+            {
+                throw std::logic_error("Population::validateAggregates() detected a classifier that was changed without modify().");
+            }
+
+            if (entry.isExperienced)
+            {
+                if (m_experiencedClassifiers.count({ entry.fitness / entry.numerosity, i }) == 0)
+                {
+                    throw std::logic_error("Population::validateAggregates() detected an experienced classifier that is missing from the ordered set.");
+                }
+                ++experiencedCount;
+            }
+
+            numerositySum += cl.numerosity;
+            fitnessSum += cl.fitness;
+        }
+
+        if (experiencedCount != m_experiencedClassifiers.size())
+        {
+            throw std::logic_error("Population::validateAggregates() detected an invalid number of experienced classifiers.");
+        }
+
+        if (numerositySum != m_numerositySum || !IsNearlyEqual(fitnessSum, m_fitnessSum))
+        {
+            throw std::logic_error("Population::validateAggregates() detected invalid running totals.");
+        }
+
+        double baseVoteSum = 0.0;
+        for (std::size_t i = 0; i < m_baseVoteTree.size(); ++i)
+        {
+            baseVoteSum += m_baseVoteTree[i];
+        }
+        if (!IsNearlyEqual(baseVoteSum, m_baseVoteTree.sum()))
+        {
+            throw std::logic_error("Population::validateAggregates() detected an invalid deletion vote sum.");
+        }
+    }
+
+    template class BasicPopulation<Condition>;
+    template class BasicPopulation<PackedCondition>;
+
 }
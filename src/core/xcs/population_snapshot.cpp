@@ -0,0 +1,110 @@
+#include "xcspp/core/xcs/population_snapshot.hpp"
+
+namespace xcspp::xcs
+{
+
+    namespace
+    {
+        // Symbols of the condition at the position in the snapshot
+        std::vector<Symbol> ReadSymbols(const PopulationSnapshot & snapshot, std::size_t idx)
+        {
+            using Section = PopulationSnapshot::Section;
+
+            const std::size_t conditionLength = snapshot.conditionLength();
+            std::vector<Symbol> symbols(conditionLength);
+            if (snapshot.conditionKind() == PopulationSnapshot::ConditionKind::kPackedTernary)
+            {
+                const auto * const careWords = snapshot.data<std::uint64_t>(Section::kConditionCare);
+                const auto * const valueWords = snapshot.data<std::uint64_t>(Section::kConditionValue);
+                const std::size_t wordCount = (conditionLength + 63) / 64;
+                for (std::size_t i = 0; i < conditionLength; ++i)
+                {
+                    const std::size_t wordIdx = PackedConditionMatrix::WordIndex(idx, i / 64, wordCount);
+                    if ((careWords[wordIdx] >> (i % 64)) & 1)
+                    {
+                        symbols[i].setValue(static_cast<int>((valueWords[wordIdx] >> (i % 64)) & 1));
+                    }
+                }
+            }
+            else
+            {
+                const auto * const cares = snapshot.data<std::uint8_t>(Section::kConditionCare) + idx * conditionLength;
+                const auto * const values = snapshot.data<std::int32_t>(Section::kConditionValue) + idx * conditionLength;
+                for (std::size_t i = 0; i < conditionLength; ++i)
+                {
+                    if (cares[i])
+                    {
+                        symbols[i].setValue(values[i]);
+                    }
+                }
+            }
+            return symbols;
+        }
+    }
+
+    std::uint64_t HashParams(const XCSParams & params)
+    {
+        return ParamsHasher()
+            .add(params.n)
+            .add(params.beta)
+            .add(params.alpha)
+            .add(params.epsilonZero)
+            .add(params.nu)
+            .add(params.gamma)
+            .add(params.thetaGA)
+            .add(params.chi)
+            .add(static_cast<std::uint64_t>(params.crossoverMethod))
+            .add(params.mu)
+            .add(params.thetaDel)
+            .add(params.delta)
+            .add(params.thetaSub)
+            .add(params.tau)
+            .add(params.dontCareProbability)
+            .add(params.initialPrediction)
+            .add(params.initialEpsilon)
+            .add(params.initialFitness)
+            .add(params.exploreProbability)
+            .add(params.thetaMna)
+            .add(params.doGASubsumption)
+            .add(params.doActionSetSubsumption)
+            .add(params.doActionMutation)
+            .add(params.useMAM)
+            .hash();
+    }
+
+    template <class Condition>
+    std::vector<BasicClassifier<Condition>> ReadPopulationSnapshot(const PopulationSnapshot & snapshot)
+    {
+        using Section = PopulationSnapshot::Section;
+
+        if (snapshot.conditionKind() != PopulationSnapshot::ConditionKind::kTernary
+            && snapshot.conditionKind() != PopulationSnapshot::ConditionKind::kPackedTernary)
+        {
+            throw std::invalid_argument("ReadPopulationSnapshot() received a snapshot without ternary conditions (saved by XCSR?).");
+        }
+
+        const auto * const actions = snapshot.data<std::int32_t>(Section::kAction);
+        const auto * const predictions = snapshot.data<double>(Section::kPrediction);
+        const auto * const epsilons = snapshot.data<double>(Section::kEpsilon);
+        const auto * const fitnesses = snapshot.data<double>(Section::kFitness);
+        const auto * const experiences = snapshot.data<std::uint64_t>(Section::kExperience);
+        const auto * const timeStamps = snapshot.data<std::uint64_t>(Section::kTimeStamp);
+        const auto * const actionSetSizes = snapshot.data<double>(Section::kActionSetSize);
+        const auto * const numerosities = snapshot.data<std::uint64_t>(Section::kNumerosity);
+
+        std::vector<BasicClassifier<Condition>> classifiers;
+        classifiers.reserve(snapshot.size());
+        for (std::size_t idx = 0; idx < snapshot.size(); ++idx)
+        {
+            auto & cl = classifiers.emplace_back(Condition(ReadSymbols(snapshot, idx)), actions[idx], predictions[idx], epsilons[idx], fitnesses[idx], timeStamps[idx]);
+            cl.experience = experiences[idx];
+            cl.actionSetSize = actionSetSizes[idx];
+            cl.numerosity = numerosities[idx];
+        }
+        return classifiers;
+    }
+
+    template std::vector<BasicClassifier<Condition>> ReadPopulationSnapshot<Condition>(const PopulationSnapshot & snapshot);
+    template std::vector<BasicClassifier<PackedCondition>> ReadPopulationSnapshot<PackedCondition>(const PopulationSnapshot & snapshot);
+
+}
@@ -1,31 +1,117 @@
 #include "xcspp/core/xcs/xcs.hpp"
 #include <iostream>
-#include <memory> // std::make_shared
+#include <type_traits> // std::is_same_v
+#include <utility> // std::move, std::swap
+#include <stdexcept>
+#include <cstdint> // std::uint64_t
 
+#include "xcspp/core/checkpoint.hpp"
 #include "xcspp/core/xcs/match_set.hpp"
+#include "xcspp/core/xcs/population_snapshot.hpp"
+#include "xcspp/util/binary_stream.hpp"
 #include "xcspp/util/csv.hpp"
 
 namespace xcspp::xcs
 {
 
-    void XCS::syncTimeStampWithPopulation()
+    namespace
+    {
+        // Position written for a reference to a classifier that has been deleted from [P]
+        //   Such references are left in [A] and [A]_-1 until they are updated, so they are
+        //   restored as references whose get() returns nullptr.
+        constexpr std::uint64_t kDeletedClassifierPosition = ~std::uint64_t{ 0 };
+
+        // Overwrite the situation buffer (reusing its storage)
+        void AssignSituation(std::vector<int> & dest, Span<const int> situation)
+        {
+            dest.assign(situation.begin(), situation.end());
+        }
+
+        void AssignSituation(std::vector<int> & dest, const PackedSituation & situation)
+        {
+            dest.resize(situation.size());
+            for (std::size_t i = 0; i < situation.size(); ++i)
+            {
+                dest[i] = situation[i];
+            }
+        }
+
+        void AssignSituation(PackedSituation & dest, Span<const int> situation)
+        {
+            dest.assign(situation);
+        }
+
+        void AssignSituation(PackedSituation & dest, const PackedSituation & situation)
+        {
+            dest = situation;
+        }
+
+        template <class Condition>
+        void WriteClassifierPositions(BinaryWriter & writer, const BasicClassifierPtrSet<Condition> & set, const BasicPopulation<Condition> & population)
+        {
+            std::vector<std::uint64_t> positions;
+            positions.reserve(set.size());
+            for (const auto & cl : set)
+            {
+                positions.push_back(population.contains(cl) ? population.indexOf(cl) : kDeletedClassifierPosition);
+            }
+            writer.writeVector(positions);
+        }
+
+        template <class Condition>
+        void ReadClassifierPositions(BinaryReader & reader, BasicClassifierPtrSet<Condition> & set, BasicPopulation<Condition> & population)
+        {
+            set.clear();
+            for (const auto position : reader.readVector<std::uint64_t>())
+            {
+                if (position == kDeletedClassifierPosition)
+                {
+                    set.insert(BasicClassifierPtr<Condition>());
+                }
+                else if (position < population.size())
+                {
+                    set.insert(population.ptrAt(static_cast<std::size_t>(position)));
+                }
+                else
+                {
+                    throw std::runtime_error("XCS::inputCheckpoint() could not read the stream (invalid position of a classifier).");
+                }
+            }
+        }
+    }
+
+    template <class Condition>
+    void BasicXCS<Condition>::syncTimeStampWithPopulation()
     {
         m_timeStamp = 0;
         for (const auto & cl : m_population)
         {
-            if (m_timeStamp < cl->timeStamp)
+            if (m_timeStamp < cl.timeStamp)
             {
-                m_timeStamp = cl->timeStamp;
+                m_timeStamp = cl.timeStamp;
             }
         }
     }
 
-    XCS::XCS(const std::unordered_set<int> & availableActions, const XCSParams & params)
+    template <class Condition>
+    void BasicXCS<Condition>::storePredictions()
+    {
+        m_predictions.resize(m_availableActions.size());
+        for (std::size_t i = 0; i < m_availableActions.size(); ++i)
+        {
+            m_predictions[i] = m_predictionArray.predictionFor(m_availableActions[i]);
+        }
+    }
+
+    template <class Condition>
+    BasicXCS<Condition>::BasicXCS(const std::unordered_set<int> & availableActions, const XCSParams & params)
         : m_params(params)
-        , m_population(&m_params, availableActions)
-        , m_actionSet(&m_params, availableActions)
-        , m_prevActionSet(&m_params, availableActions)
         , m_availableActions(availableActions)
+        , m_population(&m_params, availableActions)
+        , m_actionSet(&m_params, m_availableActions)
+        , m_prevActionSet(&m_params, m_availableActions)
+        , m_matchSet(&m_params, m_availableActions)
+        , m_predictionArray(m_availableActions, &m_params)
         , m_timeStamp(0)
         , m_expectsReward(false)
         , m_prevReward(0.0)
@@ -35,8 +121,31 @@ namespace xcspp::xcs
     {
     }
 
-    int XCS::explore(const std::vector<int> & situation)
+    template <class Condition>
+    int BasicXCS<Condition>::explore(const std::vector<int> & situation)
+    {
+        return explore(Span<const int>(situation));
+    }
+
+    template <class Condition>
+    int BasicXCS<Condition>::explore(Span<const int> situation)
     {
+        AssignSituation(m_situation, situation);
+        return exploreImpl();
+    }
+
+    template <class Condition>
+    int BasicXCS<Condition>::explore(const PackedSituation & situation)
+    {
+        AssignSituation(m_situation, situation);
+        return exploreImpl();
+    }
+
+    template <class Condition>
+    int BasicXCS<Condition>::exploreImpl()
+    {
+        const SituationType & situation = m_situation;
+
         if (m_expectsReward)
         {
             throw std::domain_error("XCS::explore() is called although XCS expects reward() to be called.");
@@ -45,36 +154,33 @@ namespace xcspp::xcs
         // [M]
         //   The match set [M] is formed out of the current [P].
         //   It includes all classifiers that match the current situation.
-        const MatchSet matchSet(m_population, situation, m_timeStamp, &m_params, m_availableActions, m_random);
-        m_isCoveringPerformed = matchSet.isCoveringPerformed();
-
-        const PredictionArray predictionArray(matchSet, &m_params);
+        //   The prediction array is accumulated in the same scan of [P].
+        m_matchSet.generateSet(m_population, situation, m_timeStamp, m_random, m_predictionArray);
+        m_isCoveringPerformed = m_matchSet.isCoveringPerformed();
 
-        const int action = predictionArray.selectAction(m_params.exploreProbability, m_random);
-        m_prediction = predictionArray.predictionFor(action);
-        for (const auto & a : m_availableActions)
-        {
-            m_predictions[a] = predictionArray.predictionFor(a);
-        }
+        const int action = m_predictionArray.selectAction(m_params.exploreProbability, m_random);
+        m_prediction = m_predictionArray.predictionFor(action);
+        storePredictions();
 
-        m_actionSet.generateSet(matchSet, action);
+        m_actionSet.generateSet(m_matchSet, action);
 
         m_expectsReward = true;
         m_isPrevModeExplore = true;
 
         if (!m_prevActionSet.empty())
         {
-            double p = m_prevReward + m_params.gamma * predictionArray.max();
+            double p = m_prevReward + m_params.gamma * m_predictionArray.max();
             m_prevActionSet.update(p, m_population);
             m_prevActionSet.runGA(m_prevSituation, m_population, m_timeStamp, m_random);
         }
 
-        m_prevSituation = situation;
+        std::swap(m_prevSituation, m_situation);
 
         return action;
     }
 
-    void XCS::reward(double value, bool isEndOfProblem)
+    template <class Condition>
+    void BasicXCS<Condition>::reward(double value, bool isEndOfProblem)
     {
         if (!m_expectsReward)
         {
@@ -104,8 +210,31 @@ namespace xcspp::xcs
         m_expectsReward = false;
     }
 
-    int XCS::exploit(const std::vector<int> & situation, bool update)
+    template <class Condition>
+    int BasicXCS<Condition>::exploit(const std::vector<int> & situation, bool update)
+    {
+        return exploit(Span<const int>(situation), update);
+    }
+
+    template <class Condition>
+    int BasicXCS<Condition>::exploit(Span<const int> situation, bool update)
     {
+        AssignSituation(m_situation, situation);
+        return exploitImpl(update);
+    }
+
+    template <class Condition>
+    int BasicXCS<Condition>::exploit(const PackedSituation & situation, bool update)
+    {
+        AssignSituation(m_situation, situation);
+        return exploitImpl(update);
+    }
+
+    template <class Condition>
+    int BasicXCS<Condition>::exploitImpl(bool update)
+    {
+        const SituationType & situation = m_situation;
+
         if (update)
         {
             if (m_expectsReward)
@@ -116,102 +245,116 @@ namespace xcspp::xcs
             // [M]
             //   The match set [M] is formed out of the current [P].
             //   It includes all classifiers that match the current situation.
-            const MatchSet matchSet(m_population, situation, m_timeStamp, &m_params, m_availableActions, m_random);
-            m_isCoveringPerformed = matchSet.isCoveringPerformed();
-
-            const PredictionArray predictionArray(matchSet, &m_params);
+            //   The prediction array is accumulated in the same scan of [P].
+            m_matchSet.generateSet(m_population, situation, m_timeStamp, m_random, m_predictionArray);
+            m_isCoveringPerformed = m_matchSet.isCoveringPerformed();
 
-            const int action = predictionArray.selectAction(0.0, m_random);
+            const int action = m_predictionArray.selectAction(0.0, m_random);
 
-            m_actionSet.generateSet(matchSet, action);
+            m_actionSet.generateSet(m_matchSet, action);
 
             m_expectsReward = true;
             m_isPrevModeExplore = false;
 
             if (!m_prevActionSet.empty())
             {
-                double p = m_prevReward + m_params.gamma * predictionArray.max();
+                double p = m_prevReward + m_params.gamma * m_predictionArray.max();
                 m_prevActionSet.update(p, m_population);
 
                 // Do not perform GA operations in exploitation
             }
 
-            m_prevSituation = situation;
+            std::swap(m_prevSituation, m_situation);
 
             return action;
         }
         else
         {
-            // Create new match set as sandbox
-            MatchSet matchSet(&m_params, m_availableActions);
-            for (const auto & cl : m_population)
-            {
-                if (cl->condition.matches(situation))
-                {
-                    matchSet.insert(cl);
-                }
-            }
+            // Accumulate the prediction array directly from [P] (no match set is needed since [P] is not updated)
+            m_predictionArray.clear();
+            m_population.forEachMatchingClassifier(situation, [this](const auto & cl) {
+                m_predictionArray.accumulate(*cl);
+            });
 
-            if (!matchSet.empty())
+            if (!m_predictionArray.empty())
             {
                 m_isCoveringPerformed = false;
 
-                PredictionArray predictionArray(matchSet, &m_params);
-                const int action = predictionArray.selectAction(0.0, m_random);
-                m_prediction = predictionArray.predictionFor(action);
-                for (const auto & a : m_availableActions)
-                {
-                    m_predictions[a] = predictionArray.predictionFor(a);
-                }
+                m_predictionArray.finalize();
+                const int action = m_predictionArray.selectAction(0.0, m_random);
+                m_prediction = m_predictionArray.predictionFor(action);
+                storePredictions();
                 return action;
             }
             else
             {
                 m_isCoveringPerformed = true;
                 m_prediction = m_params.initialPrediction;
-                for (const auto & action : m_availableActions)
-                {
-                    m_predictions[action] = m_params.initialPrediction;
-                }
-                return m_random.chooseFrom(m_availableActions);
+                m_predictions.assign(m_availableActions.size(), m_params.initialPrediction);
+                return m_availableActions.choose(m_random);
             }
         }
     }
 
-    double XCS::prediction() const
+    template <class Condition>
+    ExploitBatchResult BasicXCS<Condition>::exploitBatch(const std::vector<std::vector<int>> & situations) const
+    {
+        if constexpr (std::is_same_v<SituationType, std::vector<int>>)
+        {
+            return ExploitBatch(m_population, situations.size(), m_availableActions, m_params.initialPrediction,
+                [&situations](const auto & cl, std::size_t idx) { return cl.condition.matches(situations[idx]); });
+        }
+        else
+        {
+            // Pack the situations once per batch
+            const std::vector<SituationType> situationsForMatch(situations.begin(), situations.end());
+            return ExploitBatch(m_population, situations.size(), m_availableActions, m_params.initialPrediction,
+                [&situationsForMatch](const auto & cl, std::size_t idx) { return cl.condition.matches(situationsForMatch[idx]); });
+        }
+    }
+
+    template <class Condition>
+    double BasicXCS<Condition>::prediction() const
     {
         return m_prediction;
     }
 
-    double XCS::predictionFor(int action) const
+    template <class Condition>
+    double BasicXCS<Condition>::predictionFor(int action) const
     {
-        return m_predictions.at(action);
+        const std::size_t idx = m_availableActions.indexOf(action);
+        if (idx == AvailableActions::npos || idx >= m_predictions.size())
+        {
+            throw std::out_of_range("XCS::predictionFor() received an unavailable action or was called before explore() or exploit().");
+        }
+        return m_predictions[idx];
     }
 
-    bool XCS::isCoveringPerformed() const
+    template <class Condition>
+    bool BasicXCS<Condition>::isCoveringPerformed() const
     {
         return m_isCoveringPerformed;
     }
 
-    std::vector<Classifier> XCS::getMatchingClassifiers(const std::vector<int> & situation) const
+    template <class Condition>
+    std::vector<BasicClassifier<Condition>> BasicXCS<Condition>::getMatchingClassifiers(const std::vector<int> & situation) const
     {
-        std::vector<Classifier> classifiers;
-        for (const auto & cl : m_population)
-        {
-            if (cl->condition.matches(situation))
-            {
-                classifiers.emplace_back(*cl);
-            }
-        }
+        const SituationType situationForMatch(situation);
+        std::vector<BasicClassifier<Condition>> classifiers;
+        m_population.forEachMatchingClassifier(situationForMatch, [&classifiers](const auto & cl) {
+            classifiers.emplace_back(cl);
+        });
         return classifiers;
     }
 
-    const Population & XCS::population() const
+    template <class Condition>
+    const BasicPopulation<Condition> & BasicXCS<Condition>::population() const
     {
         return m_population;
     }
 
-    void XCS::setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp)
+    template <class Condition>
+    void BasicXCS<Condition>::setPopulationClassifiers(const std::vector<BasicClassifier<Condition>> & classifiers, bool syncTimeStamp)
     {
         m_population.setClassifiers(classifiers);
 
@@ -229,17 +372,20 @@ namespace xcspp::xcs
     }
 
     // deprecated
-    void XCS::dumpPopulation(std::ostream & os) const
+    template <class Condition>
+    void BasicXCS<Condition>::dumpPopulation(std::ostream & os) const
     {
         m_population.outputCSV(os);
     }
 
-    void XCS::outputPopulationCSV(std::ostream & os) const
+    template <class Condition>
+    void BasicXCS<Condition>::outputPopulationCSV(std::ostream & os) const
     {
         m_population.outputCSV(os);
     }
 
-    bool XCS::loadPopulationCSVFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
+    template <class Condition>
+    bool BasicXCS<Condition>::loadPopulationCSVFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
     {
         bool ret = m_population.loadCSVFile(filename, initClassifierVariables);
 
@@ -258,30 +404,147 @@ namespace xcspp::xcs
         return ret;
     }
 
-    bool XCS::savePopulationCSVFile(const std::string & filename) const
+    template <class Condition>
+    bool BasicXCS<Condition>::savePopulationCSVFile(const std::string & filename) const
     {
         return m_population.saveCSVFile(filename);
     }
 
-    std::size_t XCS::populationSize() const
+    template <class Condition>
+    bool BasicXCS<Condition>::loadPopulationBinaryFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
     {
-        return m_population.size();
+        bool ret = m_population.loadBinaryFile(filename, initClassifierVariables);
+
+        // Set system timestamp to the same as latest classifier
+        if (syncTimeStamp)
+        {
+            syncTimeStampWithPopulation();
+        }
+
+        // Clear action set and reset status
+        m_actionSet.clear();
+        m_prevActionSet.clear();
+        m_expectsReward = false;
+        m_isPrevModeExplore = false;
+
+        return ret;
     }
 
-    std::size_t XCS::numerositySum() const
+    template <class Condition>
+    bool BasicXCS<Condition>::savePopulationBinaryFile(const std::string & filename) const
     {
-        std::uint64_t sum = 0;
-        for (const auto & cl : m_population)
+        return m_population.saveBinaryFile(filename);
+    }
+
+    template <class Condition>
+    void BasicXCS<Condition>::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        WriteCheckpointHeader(writer, CheckpointKind::kXCS, HashParams(m_params));
+        writer.writeVector(std::vector<int>(m_availableActions.begin(), m_availableActions.end()));
+
+        writer.writeString(m_random.state());
+        writer.write(m_timeStamp);
+        writer.write(m_expectsReward);
+        writer.write(m_prevReward);
+        writer.write(m_isPrevModeExplore);
+        if constexpr (std::is_same_v<SituationType, std::vector<int>>)
         {
-            sum += cl->numerosity;
+            writer.writeVector(m_prevSituation);
         }
-        return sum;
+        else
+        {
+            writer.writeVector(m_prevSituation.toVector());
+        }
+        writer.write(m_prediction);
+        writer.writeVector(m_predictions);
+        writer.write(m_isCoveringPerformed);
+
+        // [P], and [A] and [A]_-1 as the positions in [P]
+        m_population.outputCheckpoint(os);
+        WriteClassifierPositions(writer, m_actionSet, m_population);
+        WriteClassifierPositions(writer, m_prevActionSet, m_population);
     }
 
-    void XCS::switchToCondensationMode()
+    template <class Condition>
+    void BasicXCS<Condition>::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        ReadCheckpointHeader(reader, CheckpointKind::kXCS, HashParams(m_params));
+        if (reader.readVector<int>() != std::vector<int>(m_availableActions.begin(), m_availableActions.end()))
+        {
+            throw std::invalid_argument("XCS::inputCheckpoint() received a checkpoint saved with different available actions.");
+        }
+
+        const std::string randomState = reader.readString();
+        const auto timeStamp = reader.read<std::uint64_t>();
+        const auto expectsReward = reader.read<bool>();
+        const auto prevReward = reader.read<double>();
+        const auto isPrevModeExplore = reader.read<bool>();
+        const auto prevSituation = reader.readVector<int>();
+        const auto prediction = reader.read<double>();
+        auto predictions = reader.readVector<double>();
+        const auto isCoveringPerformed = reader.read<bool>();
+
+        m_population.inputCheckpoint(is);
+        ReadClassifierPositions(reader, m_actionSet, m_population);
+        ReadClassifierPositions(reader, m_prevActionSet, m_population);
+
+        m_random.setState(randomState);
+        m_timeStamp = timeStamp;
+        m_expectsReward = expectsReward;
+        m_prevReward = prevReward;
+        m_isPrevModeExplore = isPrevModeExplore;
+        m_prevSituation = SituationType(prevSituation);
+        m_prediction = prediction;
+        m_predictions = std::move(predictions);
+        m_isCoveringPerformed = isCoveringPerformed;
+    }
+
+    template <class Condition>
+    bool BasicXCS<Condition>::saveCheckpointFile(const std::string & filename) const
+    {
+        return SaveCheckpointFile(*this, filename);
+    }
+
+    template <class Condition>
+    bool BasicXCS<Condition>::loadCheckpointFile(const std::string & filename)
+    {
+        return LoadCheckpointFile(*this, filename);
+    }
+
+    template <class Condition>
+    std::size_t BasicXCS<Condition>::populationSize() const
+    {
+        return m_population.size();
+    }
+
+    template <class Condition>
+    std::size_t BasicXCS<Condition>::numerositySum() const
+    {
+        return m_population.numerositySum();
+    }
+
+    template <class Condition>
+    MatchSetCacheStatistics BasicXCS<Condition>::matchSetCacheStatistics() const
+    {
+        return m_population.matchSetCacheStatistics();
+    }
+
+    template <class Condition>
+    void BasicXCS<Condition>::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+    }
+
+    template <class Condition>
+    void BasicXCS<Condition>::switchToCondensationMode()
     {
         m_params.chi = 0.0;
         m_params.mu = 0.0;
     }
 
+    template class BasicXCS<Condition>;
+    template class BasicXCS<PackedCondition>;
+
 }
@@ -5,21 +5,18 @@ namespace xcspp::xcsr
 {
 
     // UPDATE FITNESS
-    void ActionSet::updateFitness()
+    void ActionSet::updateFitness(double accuracySum, Population & population)
     {
-        double accuracySum = 0.0;
-        for (const auto & cl : m_set)
-        {
-            accuracySum += cl->accuracy() * cl->numerosity;
-        }
-
+        // The modifier also reflects the experience and actionSetSize changed in update() in [P]
         for (const auto & cl : m_set)
         {
-            cl->fitness += m_pParams->beta * (cl->accuracy() * cl->numerosity / accuracySum - cl->fitness);
+            const auto modifier = population.modify(*cl);
+            modifier->fitness += m_pParams->beta * (modifier->accuracy() * modifier->numerosity / accuracySum - modifier->fitness);
         }
     }
 
     // DO ACTION SET SUBSUMPTION
+    template <XCSRRepr Repr>
     void ActionSet::doSubsumption(Population & population)
     {
         ClassifierPtr cl;
@@ -27,7 +24,7 @@ namespace xcspp::xcsr
         {
             if (c->isSubsumer())
             {
-                if ((cl.get() == nullptr) || c->condition.isMoreGeneral(cl->condition, m_pParams->repr))
+                if ((cl.get() == nullptr) || c->condition.isMoreGeneral<Repr>(cl->condition))
                 {
                     cl = c;
                 }
@@ -36,31 +33,27 @@ namespace xcspp::xcsr
 
         if (cl.get() != nullptr)
         {
-            std::vector<ClassifierPtr> removedClassifiers;
             for (const auto & c : m_set)
             {
                 // Since all classifiers in [A] should have the same action, "cl->action == c->action" check is skipped
-                if (cl->condition.isMoreGeneral(c->condition, m_pParams->repr))
+                if (cl->condition.isMoreGeneral<Repr>(c->condition))
                 {
-                    cl->numerosity += c->numerosity;
-                    removedClassifiers.push_back(c);
+                    population.modify(*cl)->numerosity += c->numerosity;
+                    population.erase(c); // O(1)
                 }
             }
 
-            for (const auto & removedClassifier : removedClassifiers)
-            {
-                population.erase(removedClassifier);
-                m_set.erase(removedClassifier);
-            }
+            // Remove the subsumed classifiers from [A] in a single pass
+            removeDeletedClassifiers();
         }
     }
 
-    ActionSet::ActionSet(const XCSRParams *pParams, const std::unordered_set<int> & availableActions)
+    ActionSet::ActionSet(const XCSRParams *pParams, const AvailableActions & availableActions)
         : ClassifierPtrSet(pParams, availableActions)
     {
     }
 
-    ActionSet::ActionSet(const MatchSet & matchSet, int action, const XCSRParams *pParams, const std::unordered_set<int> & availableActions)
+    ActionSet::ActionSet(const MatchSet & matchSet, int action, const XCSRParams *pParams, const AvailableActions & availableActions)
         : ClassifierPtrSet(pParams, availableActions)
     {
         generateSet(matchSet, action);
@@ -75,11 +68,19 @@ namespace xcspp::xcsr
         {
             if (cl->action == action)
             {
-                m_set.insert(cl);
+                m_set.push_back(cl);
             }
         }
     }
 
+    void ActionSet::generateSet(MatchSet & matchSet, int action)
+    {
+        if (!matchSet.takeSetForAction(action, m_set))
+        {
+            generateSet(static_cast<const MatchSet &>(matchSet), action);
+        }
+    }
+
     void ActionSet::copyTo(ActionSet & dest)
     {
         dest.m_set = m_set;
@@ -88,10 +89,18 @@ namespace xcspp::xcsr
     // RUN GA (refer to GA::Run() for the latter part)
     void ActionSet::runGA(const std::vector<double> & situation, Population & population, std::uint64_t timeStamp, Random & random)
     {
-        double numerositySum = 0.0;
-        for (const auto & cl : m_set)
+        DispatchRepr(m_pParams->repr, [&](auto r) { runGA<decltype(r)::value>(situation, population, timeStamp, random); });
+    }
+
+    template <XCSRRepr Repr>
+    void ActionSet::runGA(const std::vector<double> & situation, Population & population, std::uint64_t timeStamp, Random & random)
+    {
+        // Skip the classifiers deleted from [P] since this set was generated
+        // (There is nothing to evolve if all of them have been deleted.)
+        const double numerositySum = static_cast<double>(removeDeletedClassifiers());
+        if (m_set.empty())
         {
-            numerositySum += cl->numerosity;
+            return;
         }
         if (numerositySum <= 0.0)
         {
@@ -115,20 +124,25 @@ namespace xcspp::xcsr
                 cl->timeStamp = timeStamp;
             }
 
-            GA::Run(*this, situation, population, m_availableActions, m_pParams, random);
+            GA::Run<Repr>(*this, situation, population, m_availableActions, m_pParams, random);
         }
     }
 
     // UPDATE SET
     void ActionSet::update(double p, Population & population)
     {
-        // Calculate numerosity sum used for updating action set size estimate
-        std::uint64_t numerositySum = 0;
-        for (const auto & cl : m_set)
-        {
-            numerositySum += cl->numerosity;
-        }
+        DispatchRepr(m_pParams->repr, [&](auto r) { update<decltype(r)::value>(p, population); });
+    }
 
+    template <XCSRRepr Repr>
+    void ActionSet::update(double p, Population & population)
+    {
+        // Skip the classifiers deleted from [P] since this set was generated
+        // (The numerosity sum used for updating action set size estimate is calculated in the same pass)
+        const std::uint64_t numerositySum = removeDeletedClassifiers();
+
+        // (The changes of experience and actionSetSize are reflected in [P] by updateFitness().)
+        double accuracySum = 0.0;
         for (const auto & cl : m_set)
         {
             ++cl->experience;
@@ -144,6 +158,7 @@ namespace xcspp::xcsr
                 cl->epsilon += m_pParams->beta * (std::abs(p - cl->prediction) - cl->epsilon);
                 cl->prediction += m_pParams->beta * (p - cl->prediction);
             }
+            cl->updateAccuracy();
 
             // Update action set size estimate
             if (cl->experience < 1.0 / m_pParams->beta)
@@ -154,14 +169,25 @@ namespace xcspp::xcsr
             {
                 cl->actionSetSize += m_pParams->beta * (numerositySum - cl->actionSetSize);
             }
+
+            // The accuracy of this classifier does not change in the rest of this loop
+            accuracySum += cl->accuracy() * cl->numerosity;
         }
 
-        updateFitness();
+        updateFitness(accuracySum, population);
 
         if (m_pParams->doActionSetSubsumption)
         {
-            doSubsumption(population);
+            doSubsumption<Repr>(population);
         }
     }
 
+    template void ActionSet::runGA<XCSRRepr::kCSR>(const std::vector<double> & situation, Population & population, std::uint64_t timeStamp, Random & random);
+    template void ActionSet::runGA<XCSRRepr::kOBR>(const std::vector<double> & situation, Population & population, std::uint64_t timeStamp, Random & random);
+    template void ActionSet::runGA<XCSRRepr::kUBR>(const std::vector<double> & situation, Population & population, std::uint64_t timeStamp, Random & random);
+
+    template void ActionSet::update<XCSRRepr::kCSR>(double p, Population & population);
+    template void ActionSet::update<XCSRRepr::kOBR>(double p, Population & population);
+    template void ActionSet::update<XCSRRepr::kUBR>(double p, Population & population);
+
 }
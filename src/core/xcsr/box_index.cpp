@@ -0,0 +1,353 @@
+#include "xcspp/core/xcsr/box_index.hpp"
+#include <algorithm> // std::max, std::min, std::sort, std::nth_element, std::partition, std::copy_n
+#include <array>
+#include <cmath> // std::isnan, std::isinf
+
+#include "xcspp/core/xcsr/symbol.hpp"
+
+namespace xcspp::xcsr
+{
+
+    namespace
+    {
+        // Number of the candidate split positions in each dimension is (kBinCount - 1)
+        constexpr std::size_t kBinCount = 16;
+
+        // Each child has at least 1/kMinSplitFraction of the boxes of the parent
+        constexpr std::uint32_t kMinSplitFraction = 4;
+
+        // Maximum number of the boxes used to choose the split of a node
+        constexpr std::uint32_t kMaxSampleCount = 256;
+
+        // Scale of BinOf() for the spread of the centers
+        double BinScale(double spread)
+        {
+            return kBinCount / spread;
+        }
+
+        std::size_t BinOf(double center, double minCenter, double binScale)
+        {
+            // (NaN for a zero or infinite spread goes to the first bin)
+            const double bin = (center - minCenter) * binScale;
+            if (!(bin >= 0.0))
+            {
+                return 0;
+            }
+            return (bin < kBinCount) ? static_cast<std::size_t>(bin) : kBinCount - 1;
+        }
+    }
+
+    BoxIndex::BoxIndex(std::size_t leafSize)
+        : m_dimension(0)
+        , m_leafSize(std::max<std::size_t>(leafSize, 1))
+        , m_addedDimension(0)
+    {
+    }
+
+    BoxIndex::BoxIndex(const std::vector<Classifier> & classifiers, XCSRRepr repr, std::size_t leafSize)
+        : BoxIndex(leafSize)
+    {
+        if (classifiers.size() >= kNoNode)
+        {
+            throw std::length_error("BoxIndex could not index the classifiers since there are too many of them.");
+        }
+
+        const std::size_t dimension = classifiers.empty() ? 0 : classifiers.front().condition.size();
+        m_addedLowerBounds.reserve(classifiers.size() * dimension);
+        m_addedUpperBounds.reserve(classifiers.size() * dimension);
+        m_addedCenters.reserve(classifiers.size() * dimension);
+        m_addedIds.reserve(classifiers.size());
+        for (std::size_t i = 0; i < classifiers.size(); ++i)
+        {
+            add(classifiers[i].condition, repr, static_cast<std::uint32_t>(i));
+        }
+        build();
+    }
+
+    void BoxIndex::add(const Condition & condition, XCSRRepr repr, std::uint32_t id)
+    {
+        if (m_addedIds.empty())
+        {
+            m_addedDimension = condition.size();
+        }
+        else if (condition.size() != m_addedDimension)
+        {
+            throw std::invalid_argument("BoxIndex::add() received a condition with a different length.");
+        }
+
+        DispatchRepr(repr, [&](auto r) {
+            for (const auto & symbol : condition)
+            {
+                const double lower = GetLowerBound<decltype(r)::value>(symbol);
+                const double upper = GetUpperBound<decltype(r)::value>(symbol);
+                m_addedLowerBounds.push_back(lower);
+                m_addedUpperBounds.push_back(upper);
+
+                // (The centers are compared in build(), so NaN from infinite bounds is replaced)
+                const double center = 0.5 * lower + 0.5 * upper;
+                m_addedCenters.push_back(std::isnan(center) ? 0.0 : center);
+            }
+        });
+        m_addedIds.push_back(id);
+    }
+
+    void BoxIndex::build()
+    {
+        const std::size_t count = m_addedIds.size();
+        if (count >= kNoNode)
+        {
+            throw std::length_error("BoxIndex::build() could not index the boxes since there are too many of them.");
+        }
+
+        m_dimension = m_addedDimension;
+        m_nodes.clear();
+        m_nodeLowerBounds.clear();
+        m_nodeUpperBounds.clear();
+
+        std::vector<std::uint32_t> order(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            order[i] = static_cast<std::uint32_t>(i);
+        }
+        if (count > 0)
+        {
+            build(order, 0, static_cast<std::uint32_t>(count), 0);
+        }
+
+        // Store the boxes in the order of the leaves so that each leaf is scanned contiguously
+        m_lowerBounds.resize(count * m_dimension);
+        m_upperBounds.resize(count * m_dimension);
+        m_ids.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t src = order[i];
+            std::copy_n(m_addedLowerBounds.begin() + src * m_dimension, m_dimension, m_lowerBounds.begin() + i * m_dimension);
+            std::copy_n(m_addedUpperBounds.begin() + src * m_dimension, m_dimension, m_upperBounds.begin() + i * m_dimension);
+            m_ids[i] = m_addedIds[src];
+        }
+
+        m_addedLowerBounds.clear();
+        m_addedUpperBounds.clear();
+        m_addedCenters.clear();
+        m_addedIds.clear();
+    }
+
+    std::uint32_t BoxIndex::build(std::vector<std::uint32_t> & order, std::uint32_t begin, std::uint32_t end, std::size_t depth)
+    {
+        const auto nodeIdx = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.push_back({ begin, end, kNoNode, kNoNode });
+        m_nodeLowerBounds.resize(m_nodeLowerBounds.size() + m_dimension, std::numeric_limits<double>::infinity());
+        m_nodeUpperBounds.resize(m_nodeUpperBounds.size() + m_dimension, -std::numeric_limits<double>::infinity());
+        double * const nodeLowerBounds = &m_nodeLowerBounds[nodeIdx * m_dimension];
+        double * const nodeUpperBounds = &m_nodeUpperBounds[nodeIdx * m_dimension];
+
+        const std::uint32_t count = end - begin;
+        const std::uint32_t mid = (count <= m_leafSize || depth + 1 >= kMaxDepth) ? end : findSplit(order, begin, end);
+        if (mid == end)
+        {
+            // BOUNDING BOX of a leaf
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                const std::uint32_t item = order[i];
+                for (std::size_t d = 0; d < m_dimension; ++d)
+                {
+                    nodeLowerBounds[d] = std::min(nodeLowerBounds[d], m_addedLowerBounds[item * m_dimension + d]);
+                    nodeUpperBounds[d] = std::max(nodeUpperBounds[d], m_addedUpperBounds[item * m_dimension + d]);
+                }
+            }
+            return nodeIdx;
+        }
+
+        const std::uint32_t leftChild = build(order, begin, mid, depth + 1);
+        const std::uint32_t rightChild = build(order, mid, end, depth + 1);
+        m_nodes[nodeIdx].leftChild = leftChild;
+        m_nodes[nodeIdx].rightChild = rightChild;
+
+        // BOUNDING BOX of an internal node (the union of the children, so the boxes are read only at the leaves)
+        // (The pointers are taken again since the storage may have been reallocated by the children.)
+        for (const std::uint32_t child : { leftChild, rightChild })
+        {
+            for (std::size_t d = 0; d < m_dimension; ++d)
+            {
+                double & lower = m_nodeLowerBounds[nodeIdx * m_dimension + d];
+                double & upper = m_nodeUpperBounds[nodeIdx * m_dimension + d];
+                lower = std::min(lower, m_nodeLowerBounds[child * m_dimension + d]);
+                upper = std::max(upper, m_nodeUpperBounds[child * m_dimension + d]);
+            }
+        }
+        return nodeIdx;
+    }
+
+    std::uint32_t BoxIndex::findSplit(std::vector<std::uint32_t> & order, std::uint32_t begin, std::uint32_t end) const
+    {
+        const auto center = [this](std::uint32_t item, std::size_t d) {
+            return m_addedCenters[item * m_dimension + d];
+        };
+
+        // CHOOSE THE SPLIT
+        //   The boxes are assigned to kBinCount bins by their centers in each dimension, and each
+        //   boundary between the bins is evaluated by the expected number of the boxes to test:
+        //     |left| * extent(left) / extent(node) + |right| * extent(right) / extent(node)
+        //   (the extents are the ones of the bounding boxes in the dimension, which approximate
+        //   the probability that a point in the node is also in the child). Each child must have
+        //   at least 1/kMinSplitFraction of the boxes to keep the tree shallow. If there is no
+        //   such boundary, the boxes are split at the median along the dimension with the
+        //   largest spread of the centers.
+        //   For a large node, the split is chosen with at most kMaxSampleCount boxes taken at
+        //   regular intervals, since reading all the boxes at every level is memory-bound.
+        const std::uint32_t count = end - begin;
+        const std::uint32_t step = std::max<std::uint32_t>(count / kMaxSampleCount, 1);
+        const std::uint32_t sampleCount = (count + step - 1) / step;
+        const std::uint32_t minChildCount = std::max<std::uint32_t>(sampleCount / kMinSplitFraction, 1);
+
+        std::vector<double> minCenters(m_dimension, std::numeric_limits<double>::infinity());
+        std::vector<double> maxCenters(m_dimension, -std::numeric_limits<double>::infinity());
+        for (std::uint32_t i = begin; i < end; i += step)
+        {
+            const std::uint32_t item = order[i];
+            for (std::size_t d = 0; d < m_dimension; ++d)
+            {
+                minCenters[d] = std::min(minCenters[d], center(item, d));
+                maxCenters[d] = std::max(maxCenters[d], center(item, d));
+            }
+        }
+        std::vector<double> binScales(m_dimension);
+        for (std::size_t d = 0; d < m_dimension; ++d)
+        {
+            binScales[d] = BinScale(maxCenters[d] - minCenters[d]);
+        }
+
+        std::size_t largestSpreadDimension = m_dimension;
+        double largestSpread = 0.0;
+        for (std::size_t d = 0; d < m_dimension; ++d)
+        {
+            const double spread = maxCenters[d] - minCenters[d];
+            if (spread > largestSpread && !std::isinf(spread))
+            {
+                largestSpread = spread;
+                largestSpreadDimension = d;
+            }
+        }
+
+        // Count the boxes and their bounds in each bin (row-major: dimension x bins)
+        // (The boxes are visited once for all the dimensions, since their bounds are stored row by row.)
+        std::vector<std::uint32_t> binCounts(m_dimension * kBinCount, 0);
+        std::vector<double> binLowerBounds(m_dimension * kBinCount, std::numeric_limits<double>::infinity());
+        std::vector<double> binUpperBounds(m_dimension * kBinCount, -std::numeric_limits<double>::infinity());
+        for (std::uint32_t i = begin; i < end; i += step)
+        {
+            const std::uint32_t item = order[i];
+            for (std::size_t d = 0; d < m_dimension; ++d)
+            {
+                const std::size_t cell = d * kBinCount + BinOf(center(item, d), minCenters[d], binScales[d]);
+                ++binCounts[cell];
+                binLowerBounds[cell] = std::min(binLowerBounds[cell], m_addedLowerBounds[item * m_dimension + d]);
+                binUpperBounds[cell] = std::max(binUpperBounds[cell], m_addedUpperBounds[item * m_dimension + d]);
+            }
+        }
+
+        std::size_t bestDimension = m_dimension;
+        std::size_t bestBoundary = 0;
+        double bestCost = std::numeric_limits<double>::infinity();
+        std::array<double, kBinCount> suffixLowerBounds;
+        std::array<double, kBinCount> suffixUpperBounds;
+        for (std::size_t d = 0; d < m_dimension; ++d)
+        {
+            const std::uint32_t * const counts = &binCounts[d * kBinCount];
+            const double * const lowers = &binLowerBounds[d * kBinCount];
+            const double * const uppers = &binUpperBounds[d * kBinCount];
+            suffixLowerBounds[kBinCount - 1] = lowers[kBinCount - 1];
+            suffixUpperBounds[kBinCount - 1] = uppers[kBinCount - 1];
+            for (std::size_t bin = kBinCount - 1; bin > 0; --bin)
+            {
+                suffixLowerBounds[bin - 1] = std::min(suffixLowerBounds[bin], lowers[bin - 1]);
+                suffixUpperBounds[bin - 1] = std::max(suffixUpperBounds[bin], uppers[bin - 1]);
+            }
+
+            const double spread = maxCenters[d] - minCenters[d];
+            const double nodeExtent = suffixUpperBounds[0] - suffixLowerBounds[0];
+            if (!(spread > 0.0) || std::isinf(spread) || !(nodeExtent > 0.0) || std::isinf(nodeExtent))
+            {
+                continue;
+            }
+
+            std::uint32_t leftCount = 0;
+            double leftLower = std::numeric_limits<double>::infinity();
+            double leftUpper = -std::numeric_limits<double>::infinity();
+            for (std::size_t boundary = 1; boundary < kBinCount; ++boundary)
+            {
+                leftCount += counts[boundary - 1];
+                leftLower = std::min(leftLower, lowers[boundary - 1]);
+                leftUpper = std::max(leftUpper, uppers[boundary - 1]);
+                const std::uint32_t rightCount = sampleCount - leftCount;
+                if (leftCount < minChildCount || rightCount < minChildCount)
+                {
+                    continue;
+                }
+
+                const double cost = (leftCount * std::max(leftUpper - leftLower, 0.0) + rightCount * std::max(suffixUpperBounds[boundary] - suffixLowerBounds[boundary], 0.0)) / nodeExtent;
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestDimension = d;
+                    bestBoundary = boundary;
+                }
+            }
+        }
+
+        // PARTITION the boxes (the sampled boxes are on both sides, so neither child is empty)
+        if (bestDimension != m_dimension)
+        {
+            const double minCenter = minCenters[bestDimension];
+            const double binScale = binScales[bestDimension];
+            const auto it = std::partition(order.begin() + begin, order.begin() + end, [&](std::uint32_t item) {
+                return BinOf(center(item, bestDimension), minCenter, binScale) < bestBoundary;
+            });
+            return static_cast<std::uint32_t>(it - order.begin());
+        }
+        else if (largestSpreadDimension != m_dimension)
+        {
+            const std::uint32_t mid = begin + count / 2;
+            std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](std::uint32_t lhs, std::uint32_t rhs) {
+                return center(lhs, largestSpreadDimension) < center(rhs, largestSpreadDimension);
+            });
+            return mid;
+        }
+        else
+        {
+            // All the centers are the same, so splitting does not narrow down the bounding boxes
+            return end;
+        }
+    }
+
+    void BoxIndex::clear() noexcept
+    {
+        m_dimension = 0;
+        m_nodes.clear();
+        m_nodeLowerBounds.clear();
+        m_nodeUpperBounds.clear();
+        m_lowerBounds.clear();
+        m_upperBounds.clear();
+        m_ids.clear();
+        m_addedDimension = 0;
+        m_addedLowerBounds.clear();
+        m_addedUpperBounds.clear();
+        m_addedCenters.clear();
+        m_addedIds.clear();
+    }
+
+    void BoxIndex::findMatching(const std::vector<double> & situation, std::vector<std::size_t> & ids) const
+    {
+        ids.clear();
+        forEachContaining(situation, [&ids](std::uint32_t id) { ids.push_back(id); });
+        std::sort(ids.begin(), ids.end());
+    }
+
+    std::vector<std::size_t> BoxIndex::findMatching(const std::vector<double> & situation) const
+    {
+        std::vector<std::size_t> ids;
+        findMatching(situation, ids);
+        return ids;
+    }
+
+}
@@ -1,7 +1,8 @@
 #include "xcspp/core/xcsr/classifier.hpp"
 #include <utility> // std::move
 #include <cstddef> // std::size_t
-#include <cmath> // std::pow
+
+#include "xcspp/core/accuracy.hpp"
 
 namespace xcspp::xcsr
 {
@@ -66,44 +67,42 @@ namespace xcspp::xcsr
 
     double Classifier::accuracy(double epsilonZero, double alpha, double nu) const
     {
-        if (epsilon < epsilonZero)
-        {
-            return 1.0;
-        }
-        else
-        {
-            return alpha * std::pow(epsilon / epsilonZero, -nu);
-        }
+        return ComputeAccuracy(epsilon, epsilonZero, alpha, nu);
     }
 
     StoredClassifier::StoredClassifier(const Classifier & obj, const XCSRParams *pParams)
         : Classifier(obj)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
     StoredClassifier::StoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSRParams *pParams)
         : Classifier(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
     StoredClassifier::StoredClassifier(const ConditionActionPair & conditionActionPair, std::uint64_t timeStamp, const XCSRParams *pParams)
         : Classifier(conditionActionPair, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
     StoredClassifier::StoredClassifier(ConditionActionPair && conditionActionPair, std::uint64_t timeStamp, const XCSRParams *pParams)
         : Classifier(std::move(conditionActionPair), pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
     StoredClassifier::StoredClassifier(const std::string & condition, int action, std::uint64_t timeStamp, const XCSRParams *pParams)
         : Classifier(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
         , m_pParams(pParams)
     {
+        updateAccuracy();
     }
 
     // COULD SUBSUME
@@ -118,9 +117,19 @@ namespace xcspp::xcsr
         return action == cl.action && isSubsumer() && condition.isMoreGeneral(cl.condition, m_pParams->repr);
     }
 
-    double StoredClassifier::accuracy() const
+    template <XCSRRepr Repr>
+    bool StoredClassifier::subsumes(const Classifier & cl) const
+    {
+        return action == cl.action && isSubsumer() && condition.isMoreGeneral<Repr>(cl.condition);
+    }
+
+    template bool StoredClassifier::subsumes<XCSRRepr::kCSR>(const Classifier & cl) const;
+    template bool StoredClassifier::subsumes<XCSRRepr::kOBR>(const Classifier & cl) const;
+    template bool StoredClassifier::subsumes<XCSRRepr::kUBR>(const Classifier & cl) const;
+
+    void StoredClassifier::updateAccuracy()
     {
-        return Classifier::accuracy(m_pParams->epsilonZero, m_pParams->alpha, m_pParams->nu);
+        m_accuracy = Classifier::accuracy(m_pParams->epsilonZero, m_pParams->alpha, m_pParams->nu);
     }
 
 }
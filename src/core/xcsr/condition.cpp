@@ -44,6 +44,12 @@ namespace xcspp::xcsr
 
     // DOES MATCH
     bool Condition::matches(const std::vector<double> & situation, XCSRRepr repr) const
+    {
+        return DispatchRepr(repr, [&](auto r) { return matches<decltype(r)::value>(situation); });
+    }
+
+    template <XCSRRepr Repr>
+    bool Condition::matches(const std::vector<double> & situation) const
     {
         if (m_symbols.size() != situation.size())
         {
@@ -52,7 +58,7 @@ namespace xcspp::xcsr
 
         for (std::size_t i = 0; i < m_symbols.size(); ++i)
         {
-            if (!m_symbols[i].matches(situation[i], repr))
+            if (!m_symbols[i].matches<Repr>(situation[i]))
             {
                 return false;
             }
@@ -62,6 +68,12 @@ namespace xcspp::xcsr
     }
 
     bool Condition::isMoreGeneral(const Condition & cond, XCSRRepr repr) const
+    {
+        return DispatchRepr(repr, [&](auto r) { return isMoreGeneral<decltype(r)::value>(cond); });
+    }
+
+    template <XCSRRepr Repr>
+    bool Condition::isMoreGeneral(const Condition & cond) const
     {
         if (m_symbols.size() != cond.size())
         {
@@ -72,10 +84,10 @@ namespace xcspp::xcsr
 
         for (std::size_t i = 0; i < m_symbols.size(); ++i)
         {
-            const double otherL = GetLowerBound(cond[i], repr);
-            const double otherU = GetUpperBound(cond[i], repr);
-            const double selfL = GetLowerBound(m_symbols[i], repr);
-            const double selfU = GetUpperBound(m_symbols[i], repr);
+            const double otherL = GetLowerBound<Repr>(cond[i]);
+            const double otherU = GetUpperBound<Repr>(cond[i]);
+            const double selfL = GetLowerBound<Repr>(m_symbols[i]);
+            const double selfU = GetUpperBound<Repr>(m_symbols[i]);
 
             if (otherL < selfL || selfU < otherU)
             {
@@ -96,6 +108,14 @@ namespace xcspp::xcsr
         return true;
     }
 
+    template bool Condition::matches<XCSRRepr::kCSR>(const std::vector<double> & situation) const;
+    template bool Condition::matches<XCSRRepr::kOBR>(const std::vector<double> & situation) const;
+    template bool Condition::matches<XCSRRepr::kUBR>(const std::vector<double> & situation) const;
+
+    template bool Condition::isMoreGeneral<XCSRRepr::kCSR>(const Condition & cond) const;
+    template bool Condition::isMoreGeneral<XCSRRepr::kOBR>(const Condition & cond) const;
+    template bool Condition::isMoreGeneral<XCSRRepr::kUBR>(const Condition & cond) const;
+
     std::ostream & operator<< (std::ostream & os, const Condition & obj)
     {
         return os << obj.toString();
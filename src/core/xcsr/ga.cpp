@@ -1,5 +1,4 @@
 #include "xcspp/core/xcsr/ga.hpp"
-#include <memory> // std::shared_ptr, std::make_shared
 #include <vector>
 #include <unordered_set>
 #include <cstdint> // std::uint64_t
@@ -148,7 +147,8 @@ namespace xcspp::xcsr
         }
 
         // APPLY MUTATION
-        void mutate(Classifier & cl, const std::vector<double> & situation, const std::unordered_set<int> & availableActions, const XCSRParams *pParams, Random & random)
+        template <XCSRRepr Repr>
+        void mutate(Classifier & cl, const std::vector<double> & situation, const AvailableActions & availableActions, const XCSRParams *pParams, Random & random)
         {
             if (cl.condition.size() != situation.size())
             {
@@ -162,73 +162,74 @@ namespace xcspp::xcsr
                     if (random.nextDouble() < 0.5)
                     {
                         symbol.v1 += random.nextDouble(-pParams->m, pParams->m);
-                        symbol.v1 = ClampSymbolValue1(symbol.v1, pParams->repr, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
+                        symbol.v1 = ClampSymbolValue1<Repr>(symbol.v1, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
                     }
                     else
                     {
                         symbol.v2 += random.nextDouble(-pParams->m, pParams->m);
-                        symbol.v2 = ClampSymbolValue2(symbol.v2, pParams->repr, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
+                        symbol.v2 = ClampSymbolValue2<Repr>(symbol.v2, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
                     }
                 }
             }
 
             if (pParams->doActionMutation && (random.nextDouble() < pParams->mu) && (availableActions.size() >= 2))
             {
-                std::unordered_set<int> otherPossibleActions(availableActions);
-                otherPossibleActions.erase(cl.action);
-                cl.action = random.chooseFrom(otherPossibleActions);
+                cl.action = availableActions.chooseOtherThan(cl.action, random);
             }
         }
 
+        template <XCSRRepr Repr>
         void subsumeClassifier(const Classifier & child, Population & population, const XCSRParams *pParams, Random & random)
         {
-            std::vector<ClassifierPtr> choices;
+            std::vector<StoredClassifier *> choices;
 
-            for (const auto & cl : population)
+            for (auto & cl : population)
             {
-                if (cl->subsumes(child))
+                if (cl.template subsumes<Repr>(child))
                 {
-                    choices.push_back(cl);
+                    choices.push_back(&cl);
                 }
             }
 
             if (!choices.empty())
             {
                 std::size_t choice = random.nextInt<std::size_t>(0, choices.size() - 1);
-                ++choices[choice]->numerosity;
+                ++population.modify(*choices[choice])->numerosity;
                 return;
             }
 
-            population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child, pParams));
+            population.insertOrIncrementNumerosity(child);
         }
 
+        template <XCSRRepr Repr>
         void subsumeClassifier(const Classifier & child, const ClassifierPtr & parent1, const ClassifierPtr & parent2, Population & population, const XCSRParams *pParams, Random & random)
         {
-            if (parent1->subsumes(child))
+            if (parent1->template subsumes<Repr>(child))
             {
-                ++parent1->numerosity;
+                ++population.modify(*parent1)->numerosity;
             }
-            else if (parent2->subsumes(child))
+            else if (parent2->template subsumes<Repr>(child))
             {
-                ++parent2->numerosity;
+                ++population.modify(*parent2)->numerosity;
             }
             else
             {
-                subsumeClassifier(child, population, pParams, random); // calls first subsumeClassifier function!
+                subsumeClassifier<Repr>(child, population, pParams, random); // calls first subsumeClassifier function!
             }
         }
 
+        template <XCSRRepr Repr>
         void insertDiscoveredClassifiers(const Classifier & child1, const Classifier & child2, const ClassifierPtr & parent1, const ClassifierPtr & parent2, Population & population, const XCSRParams *pParams, Random & random)
         {
             if (pParams->doGASubsumption)
             {
-                subsumeClassifier(child1, parent1, parent2, population, pParams, random);
-                subsumeClassifier(child2, parent1, parent2, population, pParams, random);
+                subsumeClassifier<Repr>(child1, parent1, parent2, population, pParams, random);
+                subsumeClassifier<Repr>(child2, parent1, parent2, population, pParams, random);
             }
             else
             {
-                population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child1, pParams));
-                population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child2, pParams));
+                population.insertOrIncrementNumerosity(child1);
+                population.insertOrIncrementNumerosity(child2);
             }
 
             while (population.deleteExtraClassifiers(random)) {}
@@ -238,7 +239,13 @@ namespace xcspp::xcsr
     namespace GA
     {
         // RUN GA (refer to ActionSet::runGA() for the former part)
-        void Run(ClassifierPtrSet & actionSet, const std::vector<double> & situation, Population & population, const std::unordered_set<int> & availableActions, const XCSRParams *pParams, Random & random)
+        void Run(ClassifierPtrSet & actionSet, const std::vector<double> & situation, Population & population, const AvailableActions & availableActions, const XCSRParams *pParams, Random & random)
+        {
+            DispatchRepr(pParams->repr, [&](auto r) { Run<decltype(r)::value>(actionSet, situation, population, availableActions, pParams, random); });
+        }
+
+        template <XCSRRepr Repr>
+        void Run(ClassifierPtrSet & actionSet, const std::vector<double> & situation, Population & population, const AvailableActions & availableActions, const XCSRParams *pParams, Random & random)
         {
             const ClassifierPtr parent1 = SelectOffspring(actionSet, pParams->tau, random);
             const ClassifierPtr parent2 = SelectOffspring(actionSet, pParams->tau, random);
@@ -264,8 +271,8 @@ namespace xcspp::xcsr
                 isChangedByCrossover = false;
             }
 
-            mutate(child1, situation, availableActions, pParams, random);
-            mutate(child2, situation, availableActions, pParams, random);
+            mutate<Repr>(child1, situation, availableActions, pParams, random);
+            mutate<Repr>(child2, situation, availableActions, pParams, random);
 
             if (isChangedByCrossover)
             {
@@ -284,8 +291,12 @@ namespace xcspp::xcsr
                 child2.fitness *= 0.1; // fitnessReduction
             }
 
-            insertDiscoveredClassifiers(child1, child2, parent1, parent2, population, pParams, random);
+            insertDiscoveredClassifiers<Repr>(child1, child2, parent1, parent2, population, pParams, random);
         }
+
+        template void Run<XCSRRepr::kCSR>(ClassifierPtrSet & actionSet, const std::vector<double> & situation, Population & population, const AvailableActions & availableActions, const XCSRParams *pParams, Random & random);
+        template void Run<XCSRRepr::kOBR>(ClassifierPtrSet & actionSet, const std::vector<double> & situation, Population & population, const AvailableActions & availableActions, const XCSRParams *pParams, Random & random);
+        template void Run<XCSRRepr::kUBR>(ClassifierPtrSet & actionSet, const std::vector<double> & situation, Population & population, const AvailableActions & availableActions, const XCSRParams *pParams, Random & random);
     }
 
 }
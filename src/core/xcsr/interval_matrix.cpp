@@ -0,0 +1,244 @@
+#include "xcspp/core/xcsr/interval_matrix.hpp"
+#include <limits>
+#include <stdexcept>
+
+#include "xcspp/core/xcsr/symbol.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define XCSPP_XCSR_MATRIX_X86
+#include <immintrin.h>
+#endif
+
+#if defined(XCSPP_XCSR_MATRIX_X86) && (defined(__GNUC__) || defined(__clang__))
+#define XCSPP_XCSR_MATRIX_TARGET(arch) __attribute__((target(arch)))
+#else
+#define XCSPP_XCSR_MATRIX_TARGET(arch)
+#endif
+
+namespace xcspp::xcsr
+{
+
+    namespace
+    {
+        constexpr std::size_t kBlockSize = IntervalMatrix::kBlockSize;
+
+        // The interval of the padding rows (never contains any value)
+        constexpr double kPaddingLowerBound = std::numeric_limits<double>::infinity();
+        constexpr double kPaddingUpperBound = -std::numeric_limits<double>::infinity();
+
+        void MatchScalar(const double *lowerBounds, const double *upperBounds, std::size_t conditionLength, std::size_t blockCount, const double *situation, std::uint64_t *bitmap)
+        {
+            for (std::size_t b = 0; b < blockCount; ++b)
+            {
+                const double *lower = lowerBounds + b * conditionLength * kBlockSize;
+                const double *upper = upperBounds + b * conditionLength * kBlockSize;
+                for (std::size_t lane = 0; lane < kBlockSize; ++lane)
+                {
+                    std::uint64_t matched = 1;
+                    for (std::size_t d = 0; d < conditionLength; ++d)
+                    {
+                        const double value = situation[d];
+                        matched &= static_cast<std::uint64_t>(lower[d * kBlockSize + lane] <= value) & static_cast<std::uint64_t>(value < upper[d * kBlockSize + lane]);
+                    }
+
+                    const std::size_t rowIdx = b * kBlockSize + lane;
+                    bitmap[rowIdx / 64] |= matched << (rowIdx % 64);
+                }
+            }
+        }
+
+#ifdef XCSPP_XCSR_MATRIX_X86
+        XCSPP_XCSR_MATRIX_TARGET("sse2")
+        void MatchSSE2(const double *lowerBounds, const double *upperBounds, std::size_t conditionLength, std::size_t blockCount, const double *situation, std::uint64_t *bitmap)
+        {
+            for (std::size_t b = 0; b < blockCount; ++b)
+            {
+                const double *lower = lowerBounds + b * conditionLength * kBlockSize;
+                const double *upper = upperBounds + b * conditionLength * kBlockSize;
+                __m128d matchedLo = _mm_castsi128_pd(_mm_set1_epi32(-1));
+                __m128d matchedHi = matchedLo;
+                for (std::size_t d = 0; d < conditionLength; ++d)
+                {
+                    const __m128d value = _mm_set1_pd(situation[d]);
+                    const __m128d lLo = _mm_loadu_pd(lower + d * kBlockSize);
+                    const __m128d lHi = _mm_loadu_pd(lower + d * kBlockSize + 2);
+                    const __m128d uLo = _mm_loadu_pd(upper + d * kBlockSize);
+                    const __m128d uHi = _mm_loadu_pd(upper + d * kBlockSize + 2);
+                    matchedLo = _mm_and_pd(matchedLo, _mm_and_pd(_mm_cmple_pd(lLo, value), _mm_cmplt_pd(value, uLo)));
+                    matchedHi = _mm_and_pd(matchedHi, _mm_and_pd(_mm_cmple_pd(lHi, value), _mm_cmplt_pd(value, uHi)));
+
+                    // Stop early if no row in the block can match anymore
+                    if (_mm_movemask_pd(_mm_or_pd(matchedLo, matchedHi)) == 0)
+                    {
+                        break;
+                    }
+                }
+
+                const std::uint64_t matched = static_cast<std::uint64_t>(_mm_movemask_pd(matchedLo) | (_mm_movemask_pd(matchedHi) << 2));
+
+                const std::size_t rowIdx = b * kBlockSize;
+                bitmap[rowIdx / 64] |= matched << (rowIdx % 64);
+            }
+        }
+
+        XCSPP_XCSR_MATRIX_TARGET("avx2")
+        void MatchAVX2(const double *lowerBounds, const double *upperBounds, std::size_t conditionLength, std::size_t blockCount, const double *situation, std::uint64_t *bitmap)
+        {
+            for (std::size_t b = 0; b < blockCount; ++b)
+            {
+                const double *lower = lowerBounds + b * conditionLength * kBlockSize;
+                const double *upper = upperBounds + b * conditionLength * kBlockSize;
+                __m256d matched = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+                for (std::size_t d = 0; d < conditionLength; ++d)
+                {
+                    const __m256d value = _mm256_broadcast_sd(situation + d);
+                    const __m256d l = _mm256_loadu_pd(lower + d * kBlockSize);
+                    const __m256d u = _mm256_loadu_pd(upper + d * kBlockSize);
+                    matched = _mm256_and_pd(matched, _mm256_and_pd(_mm256_cmp_pd(l, value, _CMP_LE_OQ), _mm256_cmp_pd(value, u, _CMP_LT_OQ)));
+
+                    // Stop early if no row in the block can match anymore
+                    if (_mm256_movemask_pd(matched) == 0)
+                    {
+                        break;
+                    }
+                }
+
+                const std::size_t rowIdx = b * kBlockSize;
+                bitmap[rowIdx / 64] |= static_cast<std::uint64_t>(_mm256_movemask_pd(matched)) << (rowIdx % 64);
+            }
+        }
+#endif
+    }
+
+    IntervalMatrix::IntervalMatrix()
+        : m_conditionLength(0)
+        , m_size(0)
+        , m_kernel(DetectSIMDKernel())
+    {
+    }
+
+    void IntervalMatrix::setKernel(Kernel kernel)
+    {
+        if (!IsSIMDKernelSupported(kernel))
+        {
+            throw std::invalid_argument("IntervalMatrix::setKernel() received a kernel that is not supported by the CPU.");
+        }
+        m_kernel = kernel;
+    }
+
+    void IntervalMatrix::pushBack(const Condition & condition, XCSRRepr repr)
+    {
+        if (m_size == 0)
+        {
+            m_conditionLength = condition.size();
+            m_lowerBounds.clear();
+            m_upperBounds.clear();
+        }
+        else if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("IntervalMatrix::pushBack() received a condition with a different length.");
+        }
+
+        if (m_size % kBlockSize == 0)
+        {
+            m_lowerBounds.resize(m_lowerBounds.size() + m_conditionLength * kBlockSize, kPaddingLowerBound);
+            m_upperBounds.resize(m_upperBounds.size() + m_conditionLength * kBlockSize, kPaddingUpperBound);
+        }
+
+        ++m_size;
+        set(m_size - 1, condition, repr);
+    }
+
+    void IntervalMatrix::set(std::size_t rowIdx, const Condition & condition, XCSRRepr repr)
+    {
+        if (rowIdx >= m_size)
+        {
+            throw std::out_of_range("IntervalMatrix::set() received an out-of-range index.");
+        }
+
+        if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("IntervalMatrix::set() received a condition with a different length.");
+        }
+
+        DispatchRepr(repr, [&](auto r) {
+            for (std::size_t d = 0; d < m_conditionLength; ++d)
+            {
+                m_lowerBounds[boundIndex(rowIdx, d)] = GetLowerBound<decltype(r)::value>(condition[d]);
+                m_upperBounds[boundIndex(rowIdx, d)] = GetUpperBound<decltype(r)::value>(condition[d]);
+            }
+        });
+    }
+
+    void IntervalMatrix::swapRemove(std::size_t rowIdx)
+    {
+        if (rowIdx >= m_size)
+        {
+            throw std::out_of_range("IntervalMatrix::swapRemove() received an out-of-range index.");
+        }
+
+        const std::size_t lastIdx = m_size - 1;
+        for (std::size_t d = 0; d < m_conditionLength; ++d)
+        {
+            // Move the last row into the removed row, and make the last row a padding row
+            m_lowerBounds[boundIndex(rowIdx, d)] = m_lowerBounds[boundIndex(lastIdx, d)];
+            m_upperBounds[boundIndex(rowIdx, d)] = m_upperBounds[boundIndex(lastIdx, d)];
+            m_lowerBounds[boundIndex(lastIdx, d)] = kPaddingLowerBound;
+            m_upperBounds[boundIndex(lastIdx, d)] = kPaddingUpperBound;
+        }
+
+        --m_size;
+        if (m_size % kBlockSize == 0)
+        {
+            m_lowerBounds.resize(m_lowerBounds.size() - m_conditionLength * kBlockSize);
+            m_upperBounds.resize(m_upperBounds.size() - m_conditionLength * kBlockSize);
+        }
+    }
+
+    void IntervalMatrix::clear() noexcept
+    {
+        m_size = 0;
+        m_lowerBounds.clear();
+        m_upperBounds.clear();
+    }
+
+    // DOES MATCH (for all rows)
+    void IntervalMatrix::match(const std::vector<double> & situation, std::vector<std::uint64_t> & bitmap) const
+    {
+        bitmap.assign((m_size + 63) / 64, 0);
+        if (m_size == 0)
+        {
+            return;
+        }
+
+        if (situation.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("IntervalMatrix::match() could not process the situation with a different length.");
+        }
+
+        const std::size_t blockCount = (m_size + kBlockSize - 1) / kBlockSize;
+        switch (m_kernel)
+        {
+#ifdef XCSPP_XCSR_MATRIX_X86
+        case Kernel::kAVX2:
+            MatchAVX2(m_lowerBounds.data(), m_upperBounds.data(), m_conditionLength, blockCount, situation.data(), bitmap.data());
+            break;
+
+        case Kernel::kSSE2:
+            MatchSSE2(m_lowerBounds.data(), m_upperBounds.data(), m_conditionLength, blockCount, situation.data(), bitmap.data());
+            break;
+#endif
+
+        default:
+            MatchScalar(m_lowerBounds.data(), m_upperBounds.data(), m_conditionLength, blockCount, situation.data(), bitmap.data());
+            break;
+        }
+
+        // Clear the bits of the padding rows in the last block (they match only if the condition is empty)
+        if (m_size % 64 != 0)
+        {
+            bitmap.back() &= (std::uint64_t{ 1 } << (m_size % 64)) - 1;
+        }
+    }
+
+}
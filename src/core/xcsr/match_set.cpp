@@ -1,6 +1,8 @@
 #include "xcspp/core/xcsr/match_set.hpp"
-#include <memory> // std::make_shared
 #include <sstream> // std::ostringstream
+#include <utility> // std::move
+
+#include "xcspp/core/xcsr/prediction_array.hpp"
 
 namespace xcspp::xcsr
 {
@@ -8,9 +10,10 @@ namespace xcspp::xcsr
     namespace
     {
         // GENERATE COVERING CLASSIFIER
-        ClassifierPtr GenerateCoveringClassifier(
+        template <XCSRRepr Repr>
+        StoredClassifier GenerateCoveringClassifier(
             const std::vector<double> & situation,
-            const std::unordered_set<int> & unselectedActions,
+            const ActionSubset & unselectedActions,
             std::uint64_t timeStamp,
             const XCSRParams *pParams,
             Random & random)
@@ -18,14 +21,26 @@ namespace xcspp::xcsr
             std::vector<Symbol> symbols;
             for (const auto & s : situation)
             {
-                symbols.push_back(MakeCoveringSymbol(s, pParams, random));
+                symbols.push_back(MakeCoveringSymbol<Repr>(s, pParams, random));
             }
 
-            return std::make_shared<StoredClassifier>(symbols, random.chooseFrom(unselectedActions), timeStamp, pParams);
+            return StoredClassifier(symbols, unselectedActions.choose(random), timeStamp, pParams);
         }
+
+        // Accumulator that ignores the classifiers (for generating [M] only)
+        struct NullAccumulator
+        {
+            void clear() noexcept
+            {
+            }
+
+            void accumulate(const Classifier &) noexcept
+            {
+            }
+        };
     }
 
-    MatchSet::MatchSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, const XCSRParams *pParams, const std::unordered_set<int> & availableActions, Random & random)
+    MatchSet::MatchSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, const XCSRParams *pParams, const AvailableActions & availableActions, Random & random)
         : ClassifierPtrSet(pParams, availableActions)
         , m_isCoveringPerformed(false)
     {
@@ -34,32 +49,72 @@ namespace xcspp::xcsr
 
     // GENERATE MATCH SET
     void MatchSet::generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random)
+    {
+        DispatchRepr(m_pParams->repr, [&](auto r) { generateSet<decltype(r)::value>(population, situation, timeStamp, random); });
+    }
+
+    template <XCSRRepr Repr>
+    void MatchSet::generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random)
+    {
+        NullAccumulator accumulator;
+        generateSetImpl<Repr>(population, situation, timeStamp, random, accumulator);
+    }
+
+    template <XCSRRepr Repr>
+    void MatchSet::generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, PredictionArray & predictionArray)
+    {
+        generateSetImpl<Repr>(population, situation, timeStamp, random, predictionArray);
+        predictionArray.finalize();
+    }
+
+    template <XCSRRepr Repr, class Accumulator>
+    void MatchSet::generateSetImpl(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, Accumulator & accumulator)
     {
         // Set theta_mna (the minimal number of actions) to the number of action choices if theta_mna is 0
         auto thetaMna = (m_pParams->thetaMna == 0) ? m_availableActions.size() : m_pParams->thetaMna;
 
-        auto unselectedActions = m_availableActions;
+        ActionSubset unselectedActions(m_availableActions, true);
+
+        // Partition [M] by action in the same scan of [P]
+        m_setsByAction.resize(m_availableActions.size());
+        const auto clearSets = [this]() {
+            m_set.clear();
+            for (auto & set : m_setsByAction)
+            {
+                set.clear();
+            }
+            m_isPartitioned = true;
+        };
 
-        m_set.clear();
+        clearSets();
+        accumulator.clear();
 
         while (m_set.empty())
         {
-            for (const auto & cl : population)
-            {
-                if (cl->condition.matches(situation, m_pParams->repr))
+            population.forEachMatchingClassifier(situation, [&](const auto & cl) {
+                m_set.push_back(cl);
+                accumulator.accumulate(*cl);
+                unselectedActions.erase(cl->action);
+
+                const std::size_t actionIdx = m_availableActions.indexOf(cl->action);
+                if (actionIdx != AvailableActions::npos)
                 {
-                    m_set.insert(cl);
-                    unselectedActions.erase(cl->action);
+                    m_setsByAction[actionIdx].push_back(cl);
                 }
-            }
+                else
+                {
+                    // The classifier has an action that is not available (e.g., loaded from a file)
+                    m_isPartitioned = false;
+                }
+            });
 
             // Generate classifiers covering the unselected actions
             if (m_availableActions.size() - unselectedActions.size() < thetaMna)
             {
-                const auto coveringClassifier = GenerateCoveringClassifier(situation, unselectedActions, timeStamp, m_pParams, random);
+                auto coveringClassifier = GenerateCoveringClassifier<Repr>(situation, unselectedActions, timeStamp, m_pParams, random);
 
                 // Make sure the generated covering classifier covers the given input
-                if (!coveringClassifier->condition.matches(situation, m_pParams->repr))
+                if (!coveringClassifier.condition.template matches<Repr>(situation))
                 {
                     std::ostringstream oss;
                     oss <<
@@ -69,13 +124,14 @@ namespace xcspp::xcsr
                     {
                         oss << s << ' ';
                     }
-                    oss << "\n  - Covering classifier: " << *coveringClassifier << '\n' << std::endl;
+                    oss << "\n  - Covering classifier: " << coveringClassifier << '\n' << std::endl;
                     throw std::runtime_error(oss.str());
                 }
 
-                population.insert(coveringClassifier);
+                population.insert(std::move(coveringClassifier));
                 population.deleteExtraClassifiers(random);
-                m_set.clear();
+                clearSets();
+                accumulator.clear();
                 m_isCoveringPerformed = true;
             }
             else
@@ -85,9 +141,30 @@ namespace xcspp::xcsr
         }
     }
 
+    template void MatchSet::generateSet<XCSRRepr::kCSR>(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random);
+    template void MatchSet::generateSet<XCSRRepr::kOBR>(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random);
+    template void MatchSet::generateSet<XCSRRepr::kUBR>(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random);
+    template void MatchSet::generateSet<XCSRRepr::kCSR>(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, PredictionArray & predictionArray);
+    template void MatchSet::generateSet<XCSRRepr::kOBR>(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, PredictionArray & predictionArray);
+    template void MatchSet::generateSet<XCSRRepr::kUBR>(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, PredictionArray & predictionArray);
+
     bool MatchSet::isCoveringPerformed() const
     {
         return m_isCoveringPerformed;
     }
 
+    bool MatchSet::takeSetForAction(int action, std::vector<ClassifierPtr> & dest)
+    {
+        const std::size_t actionIdx = m_availableActions.indexOf(action);
+        if (!m_isPartitioned || actionIdx == AvailableActions::npos)
+        {
+            return false;
+        }
+
+        dest.swap(m_setsByAction[actionIdx]);
+        m_setsByAction[actionIdx].clear();
+        m_isPartitioned = false;
+        return true;
+    }
+
 }
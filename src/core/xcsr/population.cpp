@@ -1,7 +1,15 @@
 #include "xcspp/core/xcsr/population.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <cmath> // std::abs
+#include <algorithm> // std::max
+#include <utility> // std::move
 #include <cstdint> // std::uint64_t
 
-#include "xcspp/core/xcsr/classifier_ptr_set.hpp"
+#include "xcspp/core/xcsr/population_snapshot.hpp"
+#include "xcspp/util/binary_stream.hpp"
+#include "xcspp/util/csv.hpp"
+#include "xcspp/util/hash.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcsr
@@ -9,81 +17,702 @@ namespace xcspp::xcsr
 
     namespace
     {
-        // DELETION VOTE
-        double DeletionVote(const Classifier & cl, double averageFitness, std::uint64_t thetaDel, double delta)
+        std::size_t HashConditionAction(const ConditionActionPair & cl)
         {
-            double vote = cl.actionSetSize * cl.numerosity;
+            std::size_t seed = cl.condition.size();
+            for (const auto & symbol : cl.condition)
+            {
+                // Adding 0.0 turns -0.0 into +0.0 so that equal values have the same hash
+                HashCombine(seed, symbol.v1 + 0.0);
+                HashCombine(seed, symbol.v2 + 0.0);
+            }
+            HashCombine(seed, cl.action);
+            return seed;
+        }
+
+        // DELETION VOTE (without the fitness factor)
+        //   The vote is multiplied by averageFitness / (fitness / numerosity) if the classifier is
+        //   experienced and its fitness / numerosity is below delta * averageFitness.
+        double BaseDeletionVote(const Classifier & cl)
+        {
+            return cl.actionSetSize * cl.numerosity;
+        }
+
+        bool IsNearlyEqual(double a, double b)
+        {
+            return std::abs(a - b) <= 1e-9 * std::max({ 1.0, std::abs(a), std::abs(b) });
+        }
+
+        // Populations smaller than this are scanned even if useSpatialIndex is true
+        // (the vectorized scan is faster than the tree traversal for them)
+        constexpr std::size_t kMinSizeForBoxIndex = 256;
+
+        // The spatial index is rebuilt when the number of the classifiers inserted or erased
+        // since the last rebuild exceeds (indexed classifiers / kBoxIndexRebuildDivisor + kBoxIndexRebuildMargin)
+        constexpr std::size_t kBoxIndexRebuildDivisor = 8;
+        constexpr std::size_t kBoxIndexRebuildMargin = 32;
+    }
+
+    Population::Population(const XCSRParams *pParams, const std::unordered_set<int> & availableActions)
+        : m_pParams(pParams)
+        , m_availableActions(availableActions)
+        , m_boxIndexErasedCount(0)
+        , m_matchSetCache(pParams->matchSetCacheCapacity)
+        , m_numerositySum(0)
+        , m_fitnessSum(0.0)
+        , m_aggregateUpdateCount(0)
+    {
+    }
+
+    Population::Population(const std::vector<Classifier> & initialClassifiers, const XCSRParams *pParams, const std::unordered_set<int> & availableActions)
+        : m_pParams(pParams)
+        , m_availableActions(availableActions)
+        , m_boxIndexErasedCount(0)
+        , m_matchSetCache(pParams->matchSetCacheCapacity)
+        , m_numerositySum(0)
+        , m_fitnessSum(0.0)
+        , m_aggregateUpdateCount(0)
+    {
+        setClassifiers(initialClassifiers);
+    }
+
+    void Population::setClassifiers(const std::vector<Classifier> & classifiers)
+    {
+        // Replace classifiers
+        clear();
+        m_arena.reserve(classifiers.size());
+        m_aggregateEntries.reserve(classifiers.size());
+        m_baseVoteTree.reserve(classifiers.size());
+        for (const auto & cl : classifiers)
+        {
+            insert(StoredClassifier(cl, m_pParams));
+        }
+
+        if (usesBoxIndex())
+        {
+            rebuildBoxIndex();
+        }
+
+        validateInDebugBuild();
+    }
+
+    void Population::resetClassifierVariables(std::vector<Classifier> & classifiers) const
+    {
+        for (auto & cl : classifiers)
+        {
+            cl.prediction = m_pParams->initialPrediction;
+            cl.epsilon = m_pParams->initialEpsilon;
+            cl.fitness = m_pParams->initialFitness;
+            cl.experience = 0;
+            cl.timeStamp = 0;
+            cl.actionSetSize = 1;
+            //cl.numerosity = 1; // commented out to keep macroclassifier as is
+        }
+    }
+
+    void Population::inputCSV(std::istream & is, bool initClassifierVariables)
+    {
+        auto classifiers = CSV::ReadClassifiers<Classifier>(is);
+        if (initClassifierVariables)
+        {
+            resetClassifierVariables(classifiers);
+        }
+        setClassifiers(classifiers);
+    }
+
+    void Population::outputCSV(std::ostream & os) const
+    {
+        os << "Condition,Action,prediction,epsilon,F,exp,ts,as,n,acc\n";
+        for (const auto & cl : m_arena)
+        {
+            os  << cl.condition << ','
+                << cl.action << ','
+                << cl.prediction << ','
+                << cl.epsilon << ','
+                << cl.fitness << ','
+                << cl.experience << ','
+                << cl.timeStamp << ','
+                << cl.actionSetSize << ','
+                << cl.numerosity << ','
+                << cl.accuracy() << '\n';
+        }
+    }
 
-            // Consider fitness for deletion vote
-            if ((cl.experience >= thetaDel) && (cl.fitness / cl.numerosity < delta * averageFitness))
+    bool Population::loadCSVFile(const std::string & filename, bool initClassifierVariables)
+    {
+        // Open file stream
+        std::ifstream ifs(filename);
+        if (!ifs.good())
+        {
+            return false;
+        }
+
+        // Read CSV
+        inputCSV(ifs, initClassifierVariables);
+        return true;
+    }
+
+    bool Population::saveCSVFile(const std::string & filename) const
+    {
+        // Open file stream
+        std::ofstream ofs(filename);
+        if (!ofs.good())
+        {
+            return false;
+        }
+
+        // Write CSV
+        outputCSV(ofs);
+        return true;
+    }
+
+    bool Population::loadBinaryFile(const std::string & filename, bool initClassifierVariables)
+    {
+        // Check that the file can be opened (PopulationSnapshot throws otherwise)
+        if (!std::ifstream(filename).good())
+        {
+            return false;
+        }
+
+        // Read the snapshot in place
+        auto classifiers = ReadPopulationSnapshot(PopulationSnapshot::FromFile(filename), m_pParams->repr);
+        if (initClassifierVariables)
+        {
+            resetClassifierVariables(classifiers);
+        }
+        setClassifiers(classifiers);
+        return true;
+    }
+
+    bool Population::saveBinaryFile(const std::string & filename) const
+    {
+        return MakePopulationSnapshot(m_arena, m_pParams->repr, HashParams(*m_pParams)).saveFile(filename);
+    }
+
+    void Population::outputCheckpoint(std::ostream & os) const
+    {
+        MakePopulationSnapshot(m_arena, m_pParams->repr, HashParams(*m_pParams)).write(os);
+
+        // Running aggregates
+        std::vector<std::uint64_t> numerosities;
+        std::vector<double> fitnesses;
+        std::vector<std::uint8_t> experiencedFlags;
+        numerosities.reserve(m_aggregateEntries.size());
+        fitnesses.reserve(m_aggregateEntries.size());
+        experiencedFlags.reserve(m_aggregateEntries.size());
+        for (const auto & entry : m_aggregateEntries)
+        {
+            numerosities.push_back(entry.numerosity);
+            fitnesses.push_back(entry.fitness);
+            experiencedFlags.push_back(entry.isExperienced);
+        }
+
+        BinaryWriter writer(os);
+        writer.writeVector(numerosities);
+        writer.writeVector(fitnesses);
+        writer.writeVector(experiencedFlags);
+        writer.write(m_fitnessSum);
+        writer.write<std::uint64_t>(m_aggregateUpdateCount);
+        writer.writeVector(m_baseVoteTree.values());
+        writer.writeVector(m_baseVoteTree.nodes());
+
+        // The cached match sets are not written (they are found again by scanning [P])
+        writer.write(m_matchSetCache.statistics());
+    }
+
+    void Population::inputCheckpoint(std::istream & is)
+    {
+        setClassifiers(ReadPopulationSnapshot(PopulationSnapshot::Read(is), m_pParams->repr));
+
+        BinaryReader reader(is);
+        const auto numerosities = reader.readVector<std::uint64_t>();
+        const auto fitnesses = reader.readVector<double>();
+        const auto experiencedFlags = reader.readVector<std::uint8_t>();
+        const auto fitnessSum = reader.read<double>();
+        const auto aggregateUpdateCount = reader.read<std::uint64_t>();
+        const auto baseVotes = reader.readVector<double>();
+        const auto baseVoteNodes = reader.readVector<double>();
+        const std::size_t size = m_arena.size();
+        if (numerosities.size() != size || fitnesses.size() != size || experiencedFlags.size() != size
+            || baseVotes.size() != size || baseVoteNodes.size() != size)
+        {
+            throw std::runtime_error("Population::inputCheckpoint() could not read the stream (inconsistent sizes of the aggregates).");
+        }
+
+        // Replace the aggregates computed by setClassifiers() with the saved ones
+        m_numerositySum = 0;
+        m_experiencedClassifiers.clear();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_aggregateEntries[i] = { numerosities[i], fitnesses[i], experiencedFlags[i] != 0 };
+            m_numerositySum += numerosities[i];
+            if (experiencedFlags[i])
             {
-                vote *= averageFitness / (cl.fitness / cl.numerosity);
+                m_experiencedClassifiers.emplace(fitnesses[i] / numerosities[i], i);
             }
+        }
+        m_fitnessSum = fitnessSum;
+        m_aggregateUpdateCount = static_cast<std::size_t>(aggregateUpdateCount);
+        m_baseVoteTree.assign(baseVotes, baseVoteNodes);
+        m_matchSetCache.setStatistics(reader.read<MatchSetCacheStatistics>());
 
-            return vote;
+        validateInDebugBuild();
+    }
+
+    bool Population::contains(const ClassifierPtr & cl) const
+    {
+        return cl.get() != nullptr && &*cl == m_arena.get(cl.handle());
+    }
+
+    ClassifierPtr Population::insert(const StoredClassifier & cl)
+    {
+        return insert(StoredClassifier(cl));
+    }
+
+    ClassifierPtr Population::insert(StoredClassifier && cl)
+    {
+        m_intervalMatrix.pushBack(cl.condition, m_pParams->repr);
+        pushBackAggregates(cl);
+        const std::size_t hash = HashConditionAction(cl);
+        const SlotHandle handle = m_arena.insert(std::move(cl));
+        m_index.emplace(hash, handle);
+        if (usesBoxIndex())
+        {
+            m_unindexedHandles.push_back(handle);
         }
+
+        const auto & condition = m_arena[handle].condition;
+        m_matchSetCache.notifyInsert(m_arena.size() - 1, [&](const std::vector<double> & situation) {
+            return condition.matches(situation, m_pParams->repr);
+        });
+        return ClassifierPtr(&m_arena, handle);
     }
 
-    // INSERT IN POPULATION
-    void Population::insertOrIncrementNumerosity(const ClassifierPtr & cl)
+    void Population::eraseAt(std::size_t idx)
     {
-        for (auto & c : m_set)
+        m_intervalMatrix.swapRemove(idx);
+        swapRemoveAggregates(idx);
+        m_matchSetCache.notifySwapRemove(idx, m_arena.size() - 1);
+        if (usesBoxIndex())
         {
-            if (c->condition == cl->condition && c->action == cl->action)
+            ++m_boxIndexErasedCount;
+        }
+
+        const SlotHandle handle = m_arena.handleAt(idx);
+        const auto range = m_index.equal_range(HashConditionAction(m_arena[handle]));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == handle)
             {
-                ++c->numerosity;
-                return;
+                m_index.erase(it);
+                break;
             }
         }
-        m_set.insert(cl);
+
+        m_arena.erase(handle);
     }
 
-    // DELETE FROM POPULATION
-    bool Population::deleteExtraClassifiers(Random & random)
+    void Population::pushBackAggregates(const StoredClassifier & cl)
     {
-        uint64_t numerositySum = 0;
-        double fitnessSum = 0.0;
-        for (const auto & c : m_set)
+        const AggregateEntry entry = { cl.numerosity, cl.fitness, cl.experience >= m_pParams->thetaDel };
+        m_numerositySum += entry.numerosity;
+        m_fitnessSum += entry.fitness;
+        if (entry.isExperienced)
         {
-            numerositySum += c->numerosity;
-            fitnessSum += c->fitness;
+            m_experiencedClassifiers.emplace(entry.fitness / entry.numerosity, m_aggregateEntries.size());
         }
+        m_aggregateEntries.push_back(entry);
+        m_baseVoteTree.pushBack(BaseDeletionVote(cl));
+    }
 
-        // Return false if the sum of numerosity has not met its maximum limit
-        if (numerositySum <= m_pParams->n)
+    void Population::updateAggregatesAt(std::size_t idx)
+    {
+        const auto & cl = m_arena.begin()[idx];
+        auto & entry = m_aggregateEntries[idx];
+
+        m_numerositySum = m_numerositySum - entry.numerosity + cl.numerosity;
+        m_fitnessSum += cl.fitness - entry.fitness;
+        m_baseVoteTree.set(idx, BaseDeletionVote(cl));
+
+        // Reorder the experienced classifier only if its key has changed
+        // (e.g. only the experience or actionSetSize has changed)
+        const AggregateEntry newEntry = { cl.numerosity, cl.fitness, cl.experience >= m_pParams->thetaDel };
+        const bool isKeyUnchanged = entry.isExperienced && newEntry.isExperienced
+            && entry.fitness == newEntry.fitness && entry.numerosity == newEntry.numerosity;
+        if (!isKeyUnchanged)
         {
-            return false;
+            if (entry.isExperienced)
+            {
+                m_experiencedClassifiers.erase({ entry.fitness / entry.numerosity, idx });
+            }
+            if (newEntry.isExperienced)
+            {
+                m_experiencedClassifiers.emplace(newEntry.fitness / newEntry.numerosity, idx);
+            }
+        }
+        entry = newEntry;
+
+        // Discard the rounding errors of the incremental updates once in a while (amortized O(1))
+        if (++m_aggregateUpdateCount > m_arena.size())
+        {
+            recomputeAggregates();
         }
+    }
+
+    void Population::swapRemoveAggregates(std::size_t idx)
+    {
+        const std::size_t lastIdx = m_aggregateEntries.size() - 1;
+        const AggregateEntry entry = m_aggregateEntries[idx];
+        m_numerositySum -= entry.numerosity;
+        m_fitnessSum -= entry.fitness;
+        if (entry.isExperienced)
+        {
+            m_experiencedClassifiers.erase({ entry.fitness / entry.numerosity, idx });
+        }
+
+        // Move the last classifier into the removed position
+        if (idx != lastIdx)
+        {
+            const AggregateEntry lastEntry = m_aggregateEntries[lastIdx];
+            if (lastEntry.isExperienced)
+            {
+                m_experiencedClassifiers.erase({ lastEntry.fitness / lastEntry.numerosity, lastIdx });
+                m_experiencedClassifiers.emplace(lastEntry.fitness / lastEntry.numerosity, idx);
+            }
+            m_aggregateEntries[idx] = lastEntry;
+        }
+        m_aggregateEntries.pop_back();
+        m_baseVoteTree.swapRemove(idx);
+    }
+
+    void Population::recomputeAggregates()
+    {
+        m_fitnessSum = 0.0;
+        for (const auto & entry : m_aggregateEntries)
+        {
+            m_fitnessSum += entry.fitness;
+        }
+        m_baseVoteTree.rebuild();
+        m_aggregateUpdateCount = 0;
+    }
 
+    std::size_t Population::selectDeletionTarget(Random & random) const
+    {
         // The average fitness in the population
-        double averageFitness = fitnessSum / numerositySum;
+        const double averageFitness = m_fitnessSum / m_numerositySum;
 
-        std::vector<const ClassifierPtr *> targets;
-        for (const auto & cl : m_set)
+        // Additional votes of the experienced classifiers with low fitness
+        //   vote = baseVote * averageFitness / (fitness / numerosity)
+        //        = baseVote + baseVote * (averageFitness / (fitness / numerosity) - 1)
+        const double threshold = m_pParams->delta * averageFitness;
+        double additionalVoteSum = 0.0;
+        for (auto it = m_experiencedClassifiers.begin(); it != m_experiencedClassifiers.end() && it->first < threshold; ++it)
         {
-            targets.push_back(&cl);
+            additionalVoteSum += m_baseVoteTree[it->second] * (averageFitness / it->first - 1.0);
         }
 
         // Roulette-wheel selection
-        std::vector<double> votes;
-        votes.reserve(targets.size());
-        for (const auto & target : targets)
+        const double baseVoteSum = m_baseVoteTree.sum();
+        const double voteSum = baseVoteSum + additionalVoteSum;
+        if (voteSum <= 0.0)
+        {
+            throw std::runtime_error("Population::deleteExtraClassifiers() generated an invalid deletion vote sum.");
+        }
+
+        double randValue = random.nextDouble(0.0, voteSum);
+        if (randValue < baseVoteSum)
+        {
+            return m_baseVoteTree.find(randValue);
+        }
+
+        randValue -= baseVoteSum;
+        std::size_t selectedIdx = m_baseVoteTree.size() - 1;
+        for (auto it = m_experiencedClassifiers.begin(); it != m_experiencedClassifiers.end() && it->first < threshold; ++it)
+        {
+            selectedIdx = it->second;
+            randValue -= m_baseVoteTree[it->second] * (averageFitness / it->first - 1.0);
+            if (randValue < 0.0)
+            {
+                break;
+            }
+        }
+        return selectedIdx;
+    }
+
+    Population::ScopedModifier Population::modify(const StoredClassifier & cl)
+    {
+        const auto first = &*m_arena.begin();
+        if (&cl < first || &cl >= first + m_arena.size())
+        {
+            throw std::invalid_argument("Population::modify() received a classifier that is not in the population.");
+        }
+        return ScopedModifier(*this, static_cast<std::size_t>(&cl - first));
+    }
+
+    void Population::validateInDebugBuild() const
+    {
+#ifndef NDEBUG
+        validateIndex();
+        validateAggregates();
+#endif
+    }
+
+    StoredClassifier * Population::findSameConditionAction(const ConditionActionPair & cl)
+    {
+        const auto range = m_index.equal_range(HashConditionAction(cl));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            auto & c = m_arena[it->second];
+            if (c.condition == cl.condition && c.action == cl.action)
+            {
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    std::size_t Population::erase(const ClassifierPtr & cl)
+    {
+        if (!contains(cl))
+        {
+            return 0;
+        }
+
+        eraseAt(m_arena.denseIndex(cl.handle()));
+
+        validateInDebugBuild();
+
+        return 1;
+    }
+
+    void Population::clear()
+    {
+        m_arena.clear();
+        m_intervalMatrix.clear();
+        m_boxIndex.clear();
+        m_boxIndexHandles.clear();
+        m_unindexedHandles.clear();
+        m_boxIndexErasedCount = 0;
+        m_matchSetCache.clear();
+        m_index.clear();
+        m_aggregateEntries.clear();
+        m_baseVoteTree.clear();
+        m_experiencedClassifiers.clear();
+        m_numerositySum = 0;
+        m_fitnessSum = 0.0;
+        m_aggregateUpdateCount = 0;
+    }
+
+    void Population::setMatchKernel(IntervalMatrix::Kernel kernel)
+    {
+        m_intervalMatrix.setKernel(kernel);
+    }
+
+    bool Population::usesBoxIndex() const noexcept
+    {
+        return m_pParams->useSpatialIndex;
+    }
+
+    void Population::refreshBoxIndex()
+    {
+        if (usesBoxIndex() && m_unindexedHandles.size() + m_boxIndexErasedCount > m_boxIndex.size() / kBoxIndexRebuildDivisor + kBoxIndexRebuildMargin)
+        {
+            rebuildBoxIndex();
+        }
+    }
+
+    void Population::rebuildBoxIndex()
+    {
+        // The id of each box is the position of the classifier at the time of the rebuild
+        m_boxIndex.clear();
+        m_boxIndexHandles.clear();
+        m_boxIndexHandles.reserve(m_arena.size());
+        for (std::size_t idx = 0; idx < m_arena.size(); ++idx)
+        {
+            m_boxIndex.add(m_arena.begin()[idx].condition, m_pParams->repr, static_cast<std::uint32_t>(idx));
+            m_boxIndexHandles.push_back(m_arena.handleAt(idx));
+        }
+        m_boxIndex.build();
+
+        m_unindexedHandles.clear();
+        m_boxIndexErasedCount = 0;
+    }
+
+    void Population::match(const std::vector<double> & situation, std::vector<std::uint64_t> & bitmap) const
+    {
+        if (!usesBoxIndex() || m_arena.size() < kMinSizeForBoxIndex)
+        {
+            m_intervalMatrix.match(situation, bitmap);
+            return;
+        }
+
+        // The matching classifiers are marked by their current positions, so that they are
+        // visited in the same order as the scan
+        bitmap.assign((m_arena.size() + 63) / 64, 0);
+        const auto setBit = [&bitmap](std::size_t idx) {
+            bitmap[idx / 64] |= std::uint64_t{ 1 } << (idx % 64);
+        };
+
+        // Classifiers in the index (skipping the erased ones)
+        m_boxIndex.forEachContaining(situation, [&](std::uint32_t id) {
+            const SlotHandle & handle = m_boxIndexHandles[id];
+            if (m_arena.contains(handle))
+            {
+                setBit(m_arena.denseIndex(handle));
+            }
+        });
+
+        // Classifiers inserted since the last rebuild
+        DispatchRepr(m_pParams->repr, [&](auto r) {
+            for (const auto & handle : m_unindexedHandles)
+            {
+                const StoredClassifier * const cl = m_arena.get(handle);
+                if (cl != nullptr && cl->condition.template matches<decltype(r)::value>(situation))
+                {
+                    setBit(m_arena.denseIndex(handle));
+                }
+            }
+        });
+    }
+
+    const std::vector<std::size_t> & Population::cachedMatchingIndices(const std::vector<double> & situation)
+    {
+        if (const auto pIndices = m_matchSetCache.find(situation))
         {
-            votes.push_back(DeletionVote(**target, averageFitness, m_pParams->thetaDel, m_pParams->delta));
+            return *pIndices;
         }
-        std::size_t selectedIdx = random.rouletteWheelSelection(votes);
+
+        refreshBoxIndex();
+        match(situation, m_matchBitmap);
+        auto & indices = m_matchSetCache.emplace(situation);
+        ForEachSetBit(m_matchBitmap, [&indices](std::size_t idx) { indices.push_back(idx); });
+        return indices;
+    }
+
+    // INSERT IN POPULATION
+    void Population::insertOrIncrementNumerosity(const Classifier & cl)
+    {
+        StoredClassifier * const c = findSameConditionAction(cl);
+        if (c != nullptr)
+        {
+            ++modify(*c)->numerosity;
+        }
+        else
+        {
+            insert(StoredClassifier(cl, m_pParams));
+        }
+
+        validateInDebugBuild();
+    }
+
+    // DELETE FROM POPULATION
+    bool Population::deleteExtraClassifiers(Random & random)
+    {
+        // Return false if the sum of numerosity has not met its maximum limit
+        if (m_numerositySum <= m_pParams->n)
+        {
+            return false;
+        }
+
+        const std::size_t selectedIdx = selectDeletionTarget(random);
 
         // Distrust the selected classifier
-        if ((*targets[selectedIdx])->numerosity > 1)
+        auto & selected = m_arena.begin()[selectedIdx];
+        if (selected.numerosity > 1)
         {
-            (*targets[selectedIdx])->numerosity--;
+            selected.numerosity--;
+            updateAggregatesAt(selectedIdx);
         }
         else
         {
-            m_set.erase(*targets[selectedIdx]);
+            eraseAt(selectedIdx);
         }
 
-        return (numerositySum - 1) > m_pParams->n;
+        validateInDebugBuild();
+
+        return m_numerositySum > m_pParams->n;
+    }
+
+    void Population::validateIndex() const
+    {
+        if (m_index.size() != m_arena.size())
+        {
+            throw std::logic_error("Population::validateIndex() detected that the hash index size differs from the population size.");
+        }
+
+        for (std::size_t i = 0; i < m_arena.size(); ++i)
+        {
+            const SlotHandle handle = m_arena.handleAt(i);
+            const auto range = m_index.equal_range(HashConditionAction(m_arena[handle]));
+            bool found = false;
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == handle)
+                {
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                throw std::logic_error("Population::validateIndex() detected a classifier that is missing from the hash index.");
+            }
+        }
+    }
+
+    void Population::validateAggregates() const
+    {
+        if (m_aggregateEntries.size() != m_arena.size() || m_baseVoteTree.size() != m_arena.size())
+        {
+            throw std::logic_error("Population::validateAggregates() detected that the aggregate size differs from the population size.");
+        }
+
+        std::uint64_t numerositySum = 0;
+        double fitnessSum = 0.0;
+        std::size_t experiencedCount = 0;
+        for (std::size_t i = 0; i < m_arena.size(); ++i)
+        {
+            const auto & cl = m_arena.begin()[i];
+            const auto & entry = m_aggregateEntries[i];
+            if (entry.numerosity != cl.numerosity || entry.fitness != cl.fitness || m_baseVoteTree[i] != BaseDeletionVote(cl)
+                || entry.isExperienced != (cl.experience >= m_pParams->thetaDel))
+            {
+                throw std::logic_error("Population::validateAggregates() detected a classifier that was changed without modify().");
+            }
+
+            if (entry.isExperienced)
+            {
+                if (m_experiencedClassifiers.count({ entry.fitness / entry.numerosity, i }) == 0)
+                {
+                    throw std::logic_error("Population::validateAggregates() detected an experienced classifier that is missing from the ordered set.");
+                }
+                ++experiencedCount;
+            }
+
+            numerositySum += cl.numerosity;
+            fitnessSum += cl.fitness;
+        }
+
+        if (experiencedCount != m_experiencedClassifiers.size())
+        {
+            throw std::logic_error("Population::validateAggregates() detected an invalid number of experienced classifiers.");
+        }
+
+        if (numerositySum != m_numerositySum || !IsNearlyEqual(fitnessSum, m_fitnessSum))
+        {
+            throw std::logic_error("Population::validateAggregates() detected invalid running totals.");
+        }
+
+        double baseVoteSum = 0.0;
+        for (std::size_t i = 0; i < m_baseVoteTree.size(); ++i)
+        {
+            baseVoteSum += m_baseVoteTree[i];
+        }
+        if (!IsNearlyEqual(baseVoteSum, m_baseVoteTree.sum()))
+        {
+            throw std::logic_error("Population::validateAggregates() detected an invalid deletion vote sum.");
+        }
     }
 
 }
@@ -0,0 +1,86 @@
+#include "xcspp/core/xcsr/population_snapshot.hpp"
+
+namespace xcspp::xcsr
+{
+
+    std::uint64_t HashParams(const XCSRParams & params)
+    {
+        return ParamsHasher()
+            .add(params.n)
+            .add(params.beta)
+            .add(params.alpha)
+            .add(params.epsilonZero)
+            .add(params.nu)
+            .add(params.gamma)
+            .add(params.thetaGA)
+            .add(params.chi)
+            .add(static_cast<std::uint64_t>(params.crossoverMethod))
+            .add(params.mu)
+            .add(params.thetaDel)
+            .add(params.delta)
+            .add(params.thetaSub)
+            .add(params.tau)
+            .add(params.initialPrediction)
+            .add(params.initialEpsilon)
+            .add(params.initialFitness)
+            .add(params.exploreProbability)
+            .add(params.thetaMna)
+            .add(params.doGASubsumption)
+            .add(params.doActionSetSubsumption)
+            .add(params.doActionMutation)
+            .add(params.useMAM)
+            .add(params.s0)
+            .add(params.m)
+            .add(static_cast<std::uint64_t>(params.repr))
+            .add(params.minValue)
+            .add(params.maxValue)
+            .add(params.doRangeRestriction)
+            .add(params.doCoveringRandomRangeTruncation)
+            .hash();
+    }
+
+    std::vector<Classifier> ReadPopulationSnapshot(const PopulationSnapshot & snapshot, XCSRRepr repr)
+    {
+        using Section = PopulationSnapshot::Section;
+
+        if (snapshot.conditionKind() != PopulationSnapshot::ConditionKind::kInterval)
+        {
+            throw std::invalid_argument("ReadPopulationSnapshot() received a snapshot without interval conditions (saved by XCS?).");
+        }
+
+        // The symbol values mean different intervals in another representation
+        if (snapshot.repr() != static_cast<std::uint32_t>(repr))
+        {
+            throw std::invalid_argument("ReadPopulationSnapshot() received a snapshot saved with another XCSR representation.");
+        }
+
+        const auto * const actions = snapshot.data<std::int32_t>(Section::kAction);
+        const auto * const predictions = snapshot.data<double>(Section::kPrediction);
+        const auto * const epsilons = snapshot.data<double>(Section::kEpsilon);
+        const auto * const fitnesses = snapshot.data<double>(Section::kFitness);
+        const auto * const experiences = snapshot.data<std::uint64_t>(Section::kExperience);
+        const auto * const timeStamps = snapshot.data<std::uint64_t>(Section::kTimeStamp);
+        const auto * const actionSetSizes = snapshot.data<double>(Section::kActionSetSize);
+        const auto * const numerosities = snapshot.data<std::uint64_t>(Section::kNumerosity);
+        const auto * values = snapshot.data<double>(Section::kConditionValue);
+
+        const std::size_t conditionLength = snapshot.conditionLength();
+        std::vector<Classifier> classifiers;
+        classifiers.reserve(snapshot.size());
+        std::vector<Symbol> symbols(conditionLength);
+        for (std::size_t idx = 0; idx < snapshot.size(); ++idx)
+        {
+            for (auto & symbol : symbols)
+            {
+                symbol.v1 = *values++;
+                symbol.v2 = *values++;
+            }
+            auto & cl = classifiers.emplace_back(Condition(symbols), actions[idx], predictions[idx], epsilons[idx], fitnesses[idx], timeStamps[idx]);
+            cl.experience = experiences[idx];
+            cl.actionSetSize = actionSetSizes[idx];
+            cl.numerosity = numerosities[idx];
+        }
+        return classifiers;
+    }
+
+}
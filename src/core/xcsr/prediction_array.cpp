@@ -13,43 +13,105 @@ namespace xcspp::xcsr
         constexpr double kInitialMaxPA = -100000.0;
     }
 
+    PredictionArray::PredictionArray(const AvailableActions & availableActions, const XCSRParams *pParams)
+        : m_pParams(pParams)
+        , m_pAvailableActions(&availableActions)
+        , m_actions(availableActions.begin(), availableActions.end())
+        , m_pa(availableActions.size(), 0.0)
+        , m_fsa(availableActions.size(), 0.0)
+        , m_isInPA(availableActions.size(), false)
+        , m_maxPA(kInitialMaxPA)
+    {
+        m_paActionIds.reserve(availableActions.size());
+        m_paActions.reserve(availableActions.size());
+        m_maxPAActions.reserve(availableActions.size());
+    }
+
     // GENERATE PREDICTION ARRAY
     PredictionArray::PredictionArray(const MatchSet & matchSet, const XCSRParams *pParams)
-        : m_pParams(pParams)
+        : PredictionArray(matchSet.availableActions(), pParams)
     {
-        // FSA (Fitness Sum Array)
-        std::unordered_map<int, double> fsa;
+        generate(matchSet);
+    }
 
+    void PredictionArray::generate(const MatchSet & matchSet)
+    {
+        clear();
         for (const auto & cl : matchSet)
         {
-            if (m_pa.count(cl->action) == 0) {
-                m_paActions.push_back(cl->action);
+            accumulate(*cl);
+        }
+        finalize();
+    }
+
+    std::size_t PredictionArray::findDenseId(int action) const noexcept
+    {
+        const std::size_t id = m_pAvailableActions->indexOf(action);
+        if (id != AvailableActions::npos)
+        {
+            return id;
+        }
+
+        // Actions that are not available (e.g., loaded from a file) are stored after the available ones
+        for (std::size_t i = m_pAvailableActions->size(); i < m_actions.size(); ++i)
+        {
+            if (m_actions[i] == action)
+            {
+                return i;
             }
+        }
+        return AvailableActions::npos;
+    }
+
+    std::size_t PredictionArray::denseIdOf(int action)
+    {
+        const std::size_t id = findDenseId(action);
+        if (id != AvailableActions::npos)
+        {
+            return id;
+        }
 
-            // Note: it is okay to skip zero initialization before these
-            //       because std::unordered_map::operator[] does zero initialization.
-            m_pa[cl->action] += cl->prediction * cl->fitness;
-            fsa[cl->action] += cl->fitness;
+        m_actions.push_back(action);
+        m_pa.push_back(0.0);
+        m_fsa.push_back(0.0);
+        m_isInPA.push_back(false);
+        return m_actions.size() - 1;
+    }
+
+    void PredictionArray::clear()
+    {
+        for (const auto & id : m_paActionIds)
+        {
+            m_isInPA[id] = false;
         }
+        m_paActionIds.clear();
+        m_paActions.clear();
+        m_maxPAActions.clear();
+        m_maxPA = kInitialMaxPA;
+    }
 
+    void PredictionArray::finalize()
+    {
+        m_maxPAActions.clear();
         m_maxPA = kInitialMaxPA;
 
-        for (auto & [ action, prediction ] : m_pa)
+        for (const auto & id : m_paActionIds)
         {
-            if (std::abs(fsa[action]) > 0.0)
+            double & prediction = m_pa[id];
+            if (std::abs(m_fsa[id]) > 0.0)
             {
-                prediction /= fsa[action];
+                prediction /= m_fsa[id];
             }
 
             // Update the best actions
             if (std::abs(m_maxPA - prediction) < DBL_EPSILON) // m_maxPA == prediction
             {
-                m_maxPAActions.push_back(action);
+                m_maxPAActions.push_back(m_actions[id]);
             }
             else if (m_maxPA < prediction)
             {
                 m_maxPAActions.clear();
-                m_maxPAActions.push_back(action);
+                m_maxPAActions.push_back(m_actions[id]);
                 m_maxPA = prediction;
             }
         }
@@ -68,7 +130,8 @@ namespace xcspp::xcsr
 
     double PredictionArray::predictionFor(int action) const
     {
-        return m_pa.count(action) ? m_pa.at(action) : 0.0;
+        const std::size_t id = findDenseId(action);
+        return (id != AvailableActions::npos && m_isInPA[id]) ? m_pa[id] : 0.0;
     }
 
     // SELECT ACTION
@@ -34,7 +34,7 @@ namespace xcspp::xcsr
     // DOES MATCH
     bool Symbol::matches(double value, XCSRRepr repr) const
     {
-        return GetLowerBound(*this, repr) <= value && value < GetUpperBound(*this, repr);
+        return DispatchRepr(repr, [this, value](auto r) { return matches<decltype(r)::value>(value); });
     }
 
     std::ostream & operator<< (std::ostream & os, const Symbol & obj)
@@ -1,31 +1,90 @@
 #include "xcspp/core/xcsr/xcsr.hpp"
 #include <iostream>
-#include <memory> // std::make_shared
+#include <variant> // std::visit
+#include <utility> // std::move, std::swap
+#include <stdexcept>
+#include <cstdint> // std::uint64_t
 
+#include "xcspp/core/checkpoint.hpp"
 #include "xcspp/core/xcsr/match_set.hpp"
+#include "xcspp/core/xcsr/population_snapshot.hpp"
+#include "xcspp/util/binary_stream.hpp"
 #include "xcspp/util/csv.hpp"
 
 namespace xcspp::xcsr
 {
 
-    void XCSR::syncTimeStampWithPopulation()
+    namespace
+    {
+        // Position written for a reference to a classifier that has been deleted from [P]
+        //   Such references are left in [A] and [A]_-1 until they are updated, so they are
+        //   restored as references whose get() returns nullptr.
+        constexpr std::uint64_t kDeletedClassifierPosition = ~std::uint64_t{ 0 };
+
+        void WriteClassifierPositions(BinaryWriter & writer, const ClassifierPtrSet & set, const Population & population)
+        {
+            std::vector<std::uint64_t> positions;
+            positions.reserve(set.size());
+            for (const auto & cl : set)
+            {
+                positions.push_back(population.contains(cl) ? population.indexOf(cl) : kDeletedClassifierPosition);
+            }
+            writer.writeVector(positions);
+        }
+
+        void ReadClassifierPositions(BinaryReader & reader, ClassifierPtrSet & set, Population & population)
+        {
+            set.clear();
+            for (const auto position : reader.readVector<std::uint64_t>())
+            {
+                if (position == kDeletedClassifierPosition)
+                {
+                    set.insert(ClassifierPtr());
+                }
+                else if (position < population.size())
+                {
+                    set.insert(population.ptrAt(static_cast<std::size_t>(position)));
+                }
+                else
+                {
+                    throw std::runtime_error("XCSR::inputCheckpoint() could not read the stream (invalid position of a classifier).");
+                }
+            }
+        }
+    }
+
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::syncTimeStampWithPopulation()
     {
         m_timeStamp = 0;
         for (const auto & cl : m_population)
         {
-            if (m_timeStamp < cl->timeStamp)
+            if (m_timeStamp < cl.timeStamp)
             {
-                m_timeStamp = cl->timeStamp;
+                m_timeStamp = cl.timeStamp;
             }
         }
     }
 
-    XCSR::XCSR(const std::unordered_set<int> & availableActions, const XCSRParams & params)
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::storePredictions()
+    {
+        m_predictions.resize(m_availableActions.size());
+        for (std::size_t i = 0; i < m_availableActions.size(); ++i)
+        {
+            m_predictions[i] = m_predictionArray.predictionFor(m_availableActions[i]);
+        }
+    }
+
+    template <XCSRRepr Repr>
+    BasicXCSR<Repr>::BasicXCSR(const std::unordered_set<int> & availableActions, const XCSRParams & params)
         : m_params(params)
-        , m_population(&m_params, availableActions)
-        , m_actionSet(&m_params, availableActions)
-        , m_prevActionSet(&m_params, availableActions)
         , m_availableActions(availableActions)
+        , m_population(&m_params, availableActions)
+        , m_actionSet(&m_params, m_availableActions)
+        , m_prevActionSet(&m_params, m_availableActions)
+        , m_matchSet(&m_params, m_availableActions)
+        , m_predictionArray(m_availableActions, &m_params)
         , m_timeStamp(0)
         , m_expectsReward(false)
         , m_prevReward(0.0)
@@ -33,10 +92,30 @@ namespace xcspp::xcsr
         , m_prediction(0.0)
         , m_isCoveringPerformed(false)
     {
+        if (m_params.repr != Repr)
+        {
+            throw std::invalid_argument("BasicXCSR<Repr> received XCSRParams whose repr is different from Repr.");
+        }
+    }
+
+    template <XCSRRepr Repr>
+    int BasicXCSR<Repr>::explore(const std::vector<double> & situation)
+    {
+        return explore(Span<const double>(situation));
     }
 
-    int XCSR::explore(const std::vector<double> & situation)
+    template <XCSRRepr Repr>
+    int BasicXCSR<Repr>::explore(Span<const double> situation)
     {
+        m_situation.assign(situation.begin(), situation.end());
+        return exploreImpl();
+    }
+
+    template <XCSRRepr Repr>
+    int BasicXCSR<Repr>::exploreImpl()
+    {
+        const std::vector<double> & situation = m_situation;
+
         if (m_expectsReward)
         {
             throw std::domain_error("XCSR::explore() is called although XCSRexpects reward() to be called.");
@@ -45,36 +124,33 @@ namespace xcspp::xcsr
         // [M]
         //   The match set [M] is formed out of the current [P].
         //   It includes all classifiers that match the current situation.
-        const MatchSet matchSet(m_population, situation, m_timeStamp, &m_params, m_availableActions, m_random);
-        m_isCoveringPerformed = matchSet.isCoveringPerformed();
+        //   The prediction array is accumulated in the same scan of [P].
+        m_matchSet.generateSet<Repr>(m_population, situation, m_timeStamp, m_random, m_predictionArray);
+        m_isCoveringPerformed = m_matchSet.isCoveringPerformed();
 
-        const PredictionArray predictionArray(matchSet, &m_params);
+        const int action = m_predictionArray.selectAction(m_params.exploreProbability, m_random);
+        m_prediction = m_predictionArray.predictionFor(action);
+        storePredictions();
 
-        const int action = predictionArray.selectAction(m_params.exploreProbability, m_random);
-        m_prediction = predictionArray.predictionFor(action);
-        for (const auto & a : m_availableActions)
-        {
-            m_predictions[a] = predictionArray.predictionFor(a);
-        }
-
-        m_actionSet.generateSet(matchSet, action);
+        m_actionSet.generateSet(m_matchSet, action);
 
         m_expectsReward = true;
         m_isPrevModeExplore = true;
 
         if (!m_prevActionSet.empty())
         {
-            double p = m_prevReward + m_params.gamma * predictionArray.max();
-            m_prevActionSet.update(p, m_population);
-            m_prevActionSet.runGA(m_prevSituation, m_population, m_timeStamp, m_random);
+            double p = m_prevReward + m_params.gamma * m_predictionArray.max();
+            m_prevActionSet.update<Repr>(p, m_population);
+            m_prevActionSet.runGA<Repr>(m_prevSituation, m_population, m_timeStamp, m_random);
         }
 
-        m_prevSituation = situation;
+        std::swap(m_prevSituation, m_situation);
 
         return action;
     }
 
-    void XCSR::reward(double value, bool isEndOfProblem)
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::reward(double value, bool isEndOfProblem)
     {
         if (!m_expectsReward)
         {
@@ -83,10 +159,10 @@ namespace xcspp::xcsr
 
         if (isEndOfProblem)
         {
-            m_actionSet.update(value, m_population);
+            m_actionSet.update<Repr>(value, m_population);
             if (m_isPrevModeExplore) // Do not perform GA operations in exploitation
             {
-                m_actionSet.runGA(m_prevSituation, m_population, m_timeStamp, m_random);
+                m_actionSet.runGA<Repr>(m_prevSituation, m_population, m_timeStamp, m_random);
             }
             m_prevActionSet.clear();
         }
@@ -104,8 +180,24 @@ namespace xcspp::xcsr
         m_expectsReward = false;
     }
 
-    int XCSR::exploit(const std::vector<double> & situation, bool update)
+    template <XCSRRepr Repr>
+    int BasicXCSR<Repr>::exploit(const std::vector<double> & situation, bool update)
     {
+        return exploit(Span<const double>(situation), update);
+    }
+
+    template <XCSRRepr Repr>
+    int BasicXCSR<Repr>::exploit(Span<const double> situation, bool update)
+    {
+        m_situation.assign(situation.begin(), situation.end());
+        return exploitImpl(update);
+    }
+
+    template <XCSRRepr Repr>
+    int BasicXCSR<Repr>::exploitImpl(bool update)
+    {
+        const std::vector<double> & situation = m_situation;
+
         if (update)
         {
             if (m_expectsReward)
@@ -116,102 +208,105 @@ namespace xcspp::xcsr
             // [M]
             //   The match set [M] is formed out of the current [P].
             //   It includes all classifiers that match the current situation.
-            const MatchSet matchSet(m_population, situation, m_timeStamp, &m_params, m_availableActions, m_random);
-            m_isCoveringPerformed = matchSet.isCoveringPerformed();
-
-            const PredictionArray predictionArray(matchSet, &m_params);
+            //   The prediction array is accumulated in the same scan of [P].
+            m_matchSet.generateSet<Repr>(m_population, situation, m_timeStamp, m_random, m_predictionArray);
+            m_isCoveringPerformed = m_matchSet.isCoveringPerformed();
 
-            const int action = predictionArray.selectAction(0.0, m_random);
+            const int action = m_predictionArray.selectAction(0.0, m_random);
 
-            m_actionSet.generateSet(matchSet, action);
+            m_actionSet.generateSet(m_matchSet, action);
 
             m_expectsReward = true;
             m_isPrevModeExplore = false;
 
             if (!m_prevActionSet.empty())
             {
-                double p = m_prevReward + m_params.gamma * predictionArray.max();
-                m_prevActionSet.update(p, m_population);
+                double p = m_prevReward + m_params.gamma * m_predictionArray.max();
+                m_prevActionSet.update<Repr>(p, m_population);
 
                 // Do not perform GA operations in exploitation
             }
 
-            m_prevSituation = situation;
+            std::swap(m_prevSituation, m_situation);
 
             return action;
         }
         else
         {
-            // Create new match set as sandbox
-            MatchSet matchSet(&m_params, m_availableActions);
-            for (const auto & cl : m_population)
-            {
-                if (cl->condition.matches(situation, m_params.repr))
-                {
-                    matchSet.insert(cl);
-                }
-            }
+            // Accumulate the prediction array directly from [P] (no match set is needed since [P] is not updated)
+            m_predictionArray.clear();
+            m_population.forEachMatchingClassifier(situation, [this](const auto & cl) {
+                m_predictionArray.accumulate(*cl);
+            });
 
-            if (!matchSet.empty())
+            if (!m_predictionArray.empty())
             {
                 m_isCoveringPerformed = false;
 
-                PredictionArray predictionArray(matchSet, &m_params);
-                const int action = predictionArray.selectAction(0.0, m_random);
-                m_prediction = predictionArray.predictionFor(action);
-                for (const auto & a : m_availableActions)
-                {
-                    m_predictions[a] = predictionArray.predictionFor(a);
-                }
+                m_predictionArray.finalize();
+                const int action = m_predictionArray.selectAction(0.0, m_random);
+                m_prediction = m_predictionArray.predictionFor(action);
+                storePredictions();
                 return action;
             }
             else
             {
                 m_isCoveringPerformed = true;
                 m_prediction = m_params.initialPrediction;
-                for (const auto & action : m_availableActions)
-                {
-                    m_predictions[action] = m_params.initialPrediction;
-                }
-                return m_random.chooseFrom(m_availableActions);
+                m_predictions.assign(m_availableActions.size(), m_params.initialPrediction);
+                return m_availableActions.choose(m_random);
             }
         }
     }
 
-    double XCSR::prediction() const
+    template <XCSRRepr Repr>
+    ExploitBatchResult BasicXCSR<Repr>::exploitBatch(const std::vector<std::vector<double>> & situations) const
+    {
+        return ExploitBatch(m_population, situations.size(), m_availableActions, m_params.initialPrediction,
+            [&situations](const auto & cl, std::size_t idx) { return cl.condition.template matches<Repr>(situations[idx]); });
+    }
+
+    template <XCSRRepr Repr>
+    double BasicXCSR<Repr>::prediction() const
     {
         return m_prediction;
     }
 
-    double XCSR::predictionFor(int action) const
+    template <XCSRRepr Repr>
+    double BasicXCSR<Repr>::predictionFor(int action) const
     {
-        return m_predictions.at(action);
+        const std::size_t idx = m_availableActions.indexOf(action);
+        if (idx == AvailableActions::npos || idx >= m_predictions.size())
+        {
+            throw std::out_of_range("XCSR::predictionFor() received an unavailable action or was called before explore() or exploit().");
+        }
+        return m_predictions[idx];
     }
 
-    bool XCSR::isCoveringPerformed() const
+    template <XCSRRepr Repr>
+    bool BasicXCSR<Repr>::isCoveringPerformed() const
     {
         return m_isCoveringPerformed;
     }
 
-    std::vector<Classifier> XCSR::getMatchingClassifiers(const std::vector<double> & situation) const
+    template <XCSRRepr Repr>
+    std::vector<Classifier> BasicXCSR<Repr>::getMatchingClassifiers(const std::vector<double> & situation) const
     {
         std::vector<Classifier> classifiers;
-        for (const auto & cl : m_population)
-        {
-            if (cl->condition.matches(situation, m_params.repr))
-            {
-                classifiers.emplace_back(*cl);
-            }
-        }
+        m_population.forEachMatchingClassifier(situation, [&classifiers](const auto & cl) {
+            classifiers.emplace_back(cl);
+        });
         return classifiers;
     }
 
-    const Population & XCSR::population() const
+    template <XCSRRepr Repr>
+    const Population & BasicXCSR<Repr>::population() const
     {
         return m_population;
     }
 
-    void XCSR::setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp)
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp)
     {
         m_population.setClassifiers(classifiers);
 
@@ -229,17 +324,20 @@ namespace xcspp::xcsr
     }
 
     // deprecated
-    void XCSR::dumpPopulation(std::ostream & os) const
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::dumpPopulation(std::ostream & os) const
     {
         m_population.outputCSV(os);
     }
 
-    void XCSR::outputPopulationCSV(std::ostream & os) const
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::outputPopulationCSV(std::ostream & os) const
     {
         m_population.outputCSV(os);
     }
 
-    bool XCSR::loadPopulationCSVFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
+    template <XCSRRepr Repr>
+    bool BasicXCSR<Repr>::loadPopulationCSVFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
     {
         bool ret = m_population.loadCSVFile(filename, initClassifierVariables);
 
@@ -258,30 +356,289 @@ namespace xcspp::xcsr
         return ret;
     }
 
-    bool XCSR::savePopulationCSVFile(const std::string & filename) const
+    template <XCSRRepr Repr>
+    bool BasicXCSR<Repr>::savePopulationCSVFile(const std::string & filename) const
     {
         return m_population.saveCSVFile(filename);
     }
 
-    std::size_t XCSR::populationSize() const
+    template <XCSRRepr Repr>
+    bool BasicXCSR<Repr>::loadPopulationBinaryFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
     {
-        return m_population.size();
+        bool ret = m_population.loadBinaryFile(filename, initClassifierVariables);
+
+        // Set system timestamp to the same as latest classifier
+        if (syncTimeStamp)
+        {
+            syncTimeStampWithPopulation();
+        }
+
+        // Clear action set and reset status
+        m_actionSet.clear();
+        m_prevActionSet.clear();
+        m_expectsReward = false;
+        m_isPrevModeExplore = false;
+
+        return ret;
     }
 
-    std::size_t XCSR::numerositySum() const
+    template <XCSRRepr Repr>
+    bool BasicXCSR<Repr>::savePopulationBinaryFile(const std::string & filename) const
     {
-        std::uint64_t sum = 0;
-        for (const auto & cl : m_population)
+        return m_population.saveBinaryFile(filename);
+    }
+
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        WriteCheckpointHeader(writer, CheckpointKind::kXCSR, HashParams(m_params));
+        writer.writeVector(std::vector<int>(m_availableActions.begin(), m_availableActions.end()));
+
+        writer.writeString(m_random.state());
+        writer.write(m_timeStamp);
+        writer.write(m_expectsReward);
+        writer.write(m_prevReward);
+        writer.write(m_isPrevModeExplore);
+        writer.writeVector(m_prevSituation);
+        writer.write(m_prediction);
+        writer.writeVector(m_predictions);
+        writer.write(m_isCoveringPerformed);
+
+        // [P], and [A] and [A]_-1 as the positions in [P]
+        m_population.outputCheckpoint(os);
+        WriteClassifierPositions(writer, m_actionSet, m_population);
+        WriteClassifierPositions(writer, m_prevActionSet, m_population);
+    }
+
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        ReadCheckpointHeader(reader, CheckpointKind::kXCSR, HashParams(m_params));
+        if (reader.readVector<int>() != std::vector<int>(m_availableActions.begin(), m_availableActions.end()))
         {
-            sum += cl->numerosity;
+            throw std::invalid_argument("XCSR::inputCheckpoint() received a checkpoint saved with different available actions.");
         }
-        return sum;
+
+        const std::string randomState = reader.readString();
+        const auto timeStamp = reader.read<std::uint64_t>();
+        const auto expectsReward = reader.read<bool>();
+        const auto prevReward = reader.read<double>();
+        const auto isPrevModeExplore = reader.read<bool>();
+        auto prevSituation = reader.readVector<double>();
+        const auto prediction = reader.read<double>();
+        auto predictions = reader.readVector<double>();
+        const auto isCoveringPerformed = reader.read<bool>();
+
+        m_population.inputCheckpoint(is);
+        ReadClassifierPositions(reader, m_actionSet, m_population);
+        ReadClassifierPositions(reader, m_prevActionSet, m_population);
+
+        m_random.setState(randomState);
+        m_timeStamp = timeStamp;
+        m_expectsReward = expectsReward;
+        m_prevReward = prevReward;
+        m_isPrevModeExplore = isPrevModeExplore;
+        m_prevSituation = std::move(prevSituation);
+        m_prediction = prediction;
+        m_predictions = std::move(predictions);
+        m_isCoveringPerformed = isCoveringPerformed;
     }
 
-    void XCSR::switchToCondensationMode()
+    template <XCSRRepr Repr>
+    bool BasicXCSR<Repr>::saveCheckpointFile(const std::string & filename) const
+    {
+        return SaveCheckpointFile(*this, filename);
+    }
+
+    template <XCSRRepr Repr>
+    bool BasicXCSR<Repr>::loadCheckpointFile(const std::string & filename)
+    {
+        return LoadCheckpointFile(*this, filename);
+    }
+
+    template <XCSRRepr Repr>
+    std::size_t BasicXCSR<Repr>::populationSize() const
+    {
+        return m_population.size();
+    }
+
+    template <XCSRRepr Repr>
+    std::size_t BasicXCSR<Repr>::numerositySum() const
+    {
+        return m_population.numerositySum();
+    }
+
+    template <XCSRRepr Repr>
+    MatchSetCacheStatistics BasicXCSR<Repr>::matchSetCacheStatistics() const
+    {
+        return m_population.matchSetCacheStatistics();
+    }
+
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+    }
+
+    template <XCSRRepr Repr>
+    void BasicXCSR<Repr>::switchToCondensationMode()
     {
         m_params.chi = 0.0;
         m_params.mu = 0.0;
     }
 
+    template class BasicXCSR<XCSRRepr::kCSR>;
+    template class BasicXCSR<XCSRRepr::kOBR>;
+    template class BasicXCSR<XCSRRepr::kUBR>;
+
+    XCSR::XCSR(const std::unordered_set<int> & availableActions, const XCSRParams & params)
+        : m_system(MakeSystem(availableActions, params))
+    {
+    }
+
+    XCSR::SystemVariant XCSR::MakeSystem(const std::unordered_set<int> & availableActions, const XCSRParams & params)
+    {
+        return DispatchRepr(params.repr, [&](auto r) {
+            return SystemVariant(std::in_place_type<BasicXCSR<decltype(r)::value>>, availableActions, params);
+        });
+    }
+
+    int XCSR::explore(const std::vector<double> & situation)
+    {
+        return std::visit([&](auto & system) { return system.explore(situation); }, m_system);
+    }
+
+    int XCSR::explore(Span<const double> situation)
+    {
+        return std::visit([&](auto & system) { return system.explore(situation); }, m_system);
+    }
+
+    void XCSR::reward(double value, bool isEndOfProblem)
+    {
+        std::visit([&](auto & system) { system.reward(value, isEndOfProblem); }, m_system);
+    }
+
+    int XCSR::exploit(const std::vector<double> & situation, bool update)
+    {
+        return std::visit([&](auto & system) { return system.exploit(situation, update); }, m_system);
+    }
+
+    int XCSR::exploit(Span<const double> situation, bool update)
+    {
+        return std::visit([&](auto & system) { return system.exploit(situation, update); }, m_system);
+    }
+
+    ExploitBatchResult XCSR::exploitBatch(const std::vector<std::vector<double>> & situations) const
+    {
+        return std::visit([&](const auto & system) { return system.exploitBatch(situations); }, m_system);
+    }
+
+    double XCSR::prediction() const
+    {
+        return std::visit([](const auto & system) { return system.prediction(); }, m_system);
+    }
+
+    double XCSR::predictionFor(int action) const
+    {
+        return std::visit([action](const auto & system) { return system.predictionFor(action); }, m_system);
+    }
+
+    bool XCSR::isCoveringPerformed() const
+    {
+        return std::visit([](const auto & system) { return system.isCoveringPerformed(); }, m_system);
+    }
+
+    std::vector<Classifier> XCSR::getMatchingClassifiers(const std::vector<double> & situation) const
+    {
+        return std::visit([&](const auto & system) { return system.getMatchingClassifiers(situation); }, m_system);
+    }
+
+    const Population & XCSR::population() const
+    {
+        return std::visit([](const auto & system) -> const Population & { return system.population(); }, m_system);
+    }
+
+    void XCSR::setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp)
+    {
+        std::visit([&](auto & system) { system.setPopulationClassifiers(classifiers, syncTimeStamp); }, m_system);
+    }
+
+    // deprecated
+    void XCSR::dumpPopulation(std::ostream & os) const
+    {
+        outputPopulationCSV(os);
+    }
+
+    void XCSR::outputPopulationCSV(std::ostream & os) const
+    {
+        std::visit([&](const auto & system) { system.outputPopulationCSV(os); }, m_system);
+    }
+
+    bool XCSR::loadPopulationCSVFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
+    {
+        return std::visit([&](auto & system) { return system.loadPopulationCSVFile(filename, initClassifierVariables, syncTimeStamp); }, m_system);
+    }
+
+    bool XCSR::savePopulationCSVFile(const std::string & filename) const
+    {
+        return std::visit([&](const auto & system) { return system.savePopulationCSVFile(filename); }, m_system);
+    }
+
+    bool XCSR::loadPopulationBinaryFile(const std::string & filename, bool initClassifierVariables, bool syncTimeStamp)
+    {
+        return std::visit([&](auto & system) { return system.loadPopulationBinaryFile(filename, initClassifierVariables, syncTimeStamp); }, m_system);
+    }
+
+    bool XCSR::savePopulationBinaryFile(const std::string & filename) const
+    {
+        return std::visit([&](const auto & system) { return system.savePopulationBinaryFile(filename); }, m_system);
+    }
+
+    void XCSR::outputCheckpoint(std::ostream & os) const
+    {
+        std::visit([&](const auto & system) { system.outputCheckpoint(os); }, m_system);
+    }
+
+    void XCSR::inputCheckpoint(std::istream & is)
+    {
+        std::visit([&](auto & system) { system.inputCheckpoint(is); }, m_system);
+    }
+
+    bool XCSR::saveCheckpointFile(const std::string & filename) const
+    {
+        return std::visit([&](const auto & system) { return system.saveCheckpointFile(filename); }, m_system);
+    }
+
+    bool XCSR::loadCheckpointFile(const std::string & filename)
+    {
+        return std::visit([&](auto & system) { return system.loadCheckpointFile(filename); }, m_system);
+    }
+
+    std::size_t XCSR::populationSize() const
+    {
+        return std::visit([](const auto & system) { return system.populationSize(); }, m_system);
+    }
+
+    std::size_t XCSR::numerositySum() const
+    {
+        return std::visit([](const auto & system) { return system.numerositySum(); }, m_system);
+    }
+
+    MatchSetCacheStatistics XCSR::matchSetCacheStatistics() const
+    {
+        return std::visit([](const auto & system) { return system.matchSetCacheStatistics(); }, m_system);
+    }
+
+    void XCSR::seed(std::uint32_t seed)
+    {
+        std::visit([seed](auto & system) { system.seed(seed); }, m_system);
+    }
+
+    void XCSR::switchToCondensationMode()
+    {
+        std::visit([](auto & system) { system.switchToCondensationMode(); }, m_system);
+    }
+
 }
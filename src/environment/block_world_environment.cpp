@@ -1,6 +1,9 @@
 #include "xcspp/environment/block_world_environment.hpp"
 #include <fstream>
 #include <stdexcept>
+#include <cstdint> // std::uint64_t
+
+#include "xcspp/util/binary_stream.hpp"
 
 namespace xcspp
 {
@@ -244,6 +247,61 @@ namespace xcspp
         return reward;
     }
 
+    void BlockWorldEnvironment::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        writer.write(m_initialX);
+        writer.write(m_initialY);
+        writer.write(m_currentX);
+        writer.write(m_currentY);
+        writer.write(m_lastX);
+        writer.write(m_lastY);
+        writer.write(m_lastInitialX);
+        writer.write(m_lastInitialY);
+        writer.write<std::uint64_t>(m_lastStep);
+        writer.write<std::uint64_t>(m_currentStep);
+        writer.write(m_isEndOfProblem);
+        writer.writeString(m_random.state());
+    }
+
+    void BlockWorldEnvironment::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        const auto initialX = reader.read<int>();
+        const auto initialY = reader.read<int>();
+        const auto currentX = reader.read<int>();
+        const auto currentY = reader.read<int>();
+        if (!isEmpty(initialX, initialY) || !isEmpty(currentX, currentY))
+        {
+            throw std::invalid_argument("BlockWorldEnvironment::inputCheckpoint() received a checkpoint of a different map.");
+        }
+        m_initialX = initialX;
+        m_initialY = initialY;
+        m_currentX = currentX;
+        m_currentY = currentY;
+        m_lastX = reader.read<int>();
+        m_lastY = reader.read<int>();
+        m_lastInitialX = reader.read<int>();
+        m_lastInitialY = reader.read<int>();
+        m_lastStep = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        m_currentStep = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        m_isEndOfProblem = reader.read<bool>();
+        m_random.setState(reader.readString());
+    }
+
+    void BlockWorldEnvironment::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+        setToRandomEmptyPosition();
+        m_lastX = m_currentX;
+        m_lastY = m_currentY;
+        m_lastInitialX = m_initialX;
+        m_lastInitialY = m_initialY;
+        m_lastStep = 0;
+        m_currentStep = 0;
+        m_isEndOfProblem = false;
+    }
+
     std::string BlockWorldEnvironment::toString() const
     {
         std::string str;
@@ -1,25 +1,27 @@
 #include "xcspp/environment/even_parity_environment.hpp"
 #include <stdexcept>
 
+#include "xcspp/util/binary_stream.hpp"
+
 namespace xcspp
 {
 
     namespace
     {
-        void SetRandomSituation(std::vector<int> & situation, Random & random)
+        void SetRandomSituation(xcs::PackedSituation & situation, Random & random)
         {
-            for (auto & s : situation)
+            for (std::size_t i = 0; i < situation.size(); ++i)
             {
-                s = random.nextInt(0, 1);
+                situation.set(i, random.nextInt(0, 1));
             }
         }
 
-        int GetAnswerOfSituation(const std::vector<int> & situation)
+        int GetAnswerOfSituation(const xcs::PackedSituation & situation)
         {
-            int sum = 0;
-            for (int s : situation)
+            std::size_t sum = 0;
+            for (std::size_t i = 0; i < situation.size(); ++i)
             {
-                sum += s; // s is 0 or 1 here
+                sum += situation[i];
             }
             return (sum % 2) == 0; // even => 1, odd => 0
         }
@@ -34,6 +36,11 @@ namespace xcspp
     }
 
     std::vector<int> EvenParityEnvironment::situation() const
+    {
+        return m_situation.toVector();
+    }
+
+    const xcs::PackedSituation & EvenParityEnvironment::packedSituation() const
     {
         return m_situation;
     }
@@ -56,6 +63,35 @@ namespace xcspp
         return m_isEndOfProblem;
     }
 
+    void EvenParityEnvironment::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        writer.writeVector(m_situation.toVector());
+        writer.write(m_isEndOfProblem);
+        writer.writeString(m_random.state());
+    }
+
+    void EvenParityEnvironment::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        auto situation = reader.readVector<int>();
+        if (situation.size() != m_situation.size())
+        {
+            throw std::invalid_argument("EvenParityEnvironment::inputCheckpoint() received a checkpoint of the problem with a different length.");
+        }
+        const auto isEndOfProblem = reader.read<bool>();
+        m_random.setState(reader.readString());
+        m_situation = xcs::PackedSituation(situation);
+        m_isEndOfProblem = isEndOfProblem;
+    }
+
+    void EvenParityEnvironment::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+        SetRandomSituation(m_situation, m_random);
+        m_isEndOfProblem = false;
+    }
+
     int EvenParityEnvironment::getAnswer() const
     {
         return GetAnswerOfSituation(m_situation);
@@ -1,25 +1,27 @@
 #include "xcspp/environment/majority_on_environment.hpp"
 #include <stdexcept>
 
+#include "xcspp/util/binary_stream.hpp"
+
 namespace xcspp
 {
 
     namespace
     {
-        void SetRandomSituation(std::vector<int> & situation, Random & random)
+        void SetRandomSituation(xcs::PackedSituation & situation, Random & random)
         {
-            for (auto & s: situation)
+            for (std::size_t i = 0; i < situation.size(); ++i)
             {
-                s = random.nextInt(0, 1);
+                situation.set(i, random.nextInt(0, 1));
             }
         }
 
-        int GetAnswerOfSituation(const std::vector<int> & situation)
+        int GetAnswerOfSituation(const xcs::PackedSituation & situation)
         {
             std::size_t sum = 0;
-            for (const auto & s : situation)
+            for (std::size_t i = 0; i < situation.size(); ++i)
             {
-                sum += static_cast<std::size_t>(s);
+                sum += static_cast<std::size_t>(situation[i]);
             }
             return (sum > situation.size() / 2) ? 1 : 0;
         }
@@ -39,6 +41,11 @@ namespace xcspp
     }
 
     std::vector<int> MajorityOnEnvironment::situation() const
+    {
+        return m_situation.toVector();
+    }
+
+    const xcs::PackedSituation & MajorityOnEnvironment::packedSituation() const
     {
         return m_situation;
     }
@@ -61,6 +68,35 @@ namespace xcspp
         return m_isEndOfProblem;
     }
 
+    void MajorityOnEnvironment::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        writer.writeVector(m_situation.toVector());
+        writer.write(m_isEndOfProblem);
+        writer.writeString(m_random.state());
+    }
+
+    void MajorityOnEnvironment::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        auto situation = reader.readVector<int>();
+        if (situation.size() != m_situation.size())
+        {
+            throw std::invalid_argument("MajorityOnEnvironment::inputCheckpoint() received a checkpoint of the problem with a different length.");
+        }
+        const auto isEndOfProblem = reader.read<bool>();
+        m_random.setState(reader.readString());
+        m_situation = xcs::PackedSituation(situation);
+        m_isEndOfProblem = isEndOfProblem;
+    }
+
+    void MajorityOnEnvironment::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+        SetRandomSituation(m_situation, m_random);
+        m_isEndOfProblem = false;
+    }
+
     int MajorityOnEnvironment::getAnswer() const
     {
         return GetAnswerOfSituation(m_situation);
@@ -2,6 +2,8 @@
 #include <stdexcept>
 #include <cmath> // std::pow
 
+#include "xcspp/util/binary_stream.hpp"
+
 namespace xcspp
 {
 
@@ -13,7 +15,7 @@ namespace xcspp
             return (l == 0) ? c - 1 : AddressBitLength(l >> 1, c + 1);
         }
 
-        int GetAnswerOfSituation(const std::vector<int> & situation)
+        int GetAnswerOfSituation(const xcs::PackedSituation & situation)
         {
             std::size_t address = 0;
             const auto addressBitLength = AddressBitLength(situation.size());
@@ -28,13 +30,13 @@ namespace xcspp
             return situation[addressBitLength + address];
         }
 
-        void SetRandomSituation(std::vector<int> & situation, Random & random, double minorityAcceptanceProbability = 1.0)
+        void SetRandomSituation(xcs::PackedSituation & situation, Random & random, double minorityAcceptanceProbability = 1.0)
         {
             while (true)
             {
-                for (auto & s: situation)
+                for (std::size_t i = 0; i < situation.size(); ++i)
                 {
-                    s = random.nextInt(0, 1);
+                    situation.set(i, random.nextInt(0, 1));
                 }
 
                 if (GetAnswerOfSituation(situation) == 1)
@@ -65,6 +67,11 @@ namespace xcspp
     }
 
     std::vector<int> MultiplexerEnvironment::situation() const
+    {
+        return m_situation.toVector();
+    }
+
+    const xcs::PackedSituation & MultiplexerEnvironment::packedSituation() const
     {
         return m_situation;
     }
@@ -87,6 +94,35 @@ namespace xcspp
         return m_isEndOfProblem;
     }
 
+    void MultiplexerEnvironment::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        writer.writeVector(m_situation.toVector());
+        writer.write(m_isEndOfProblem);
+        writer.writeString(m_random.state());
+    }
+
+    void MultiplexerEnvironment::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        auto situation = reader.readVector<int>();
+        if (situation.size() != m_situation.size())
+        {
+            throw std::invalid_argument("MultiplexerEnvironment::inputCheckpoint() received a checkpoint of the problem with a different length.");
+        }
+        const auto isEndOfProblem = reader.read<bool>();
+        m_random.setState(reader.readString());
+        m_situation = xcs::PackedSituation(situation);
+        m_isEndOfProblem = isEndOfProblem;
+    }
+
+    void MultiplexerEnvironment::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+        SetRandomSituation(m_situation, m_random, m_minorityAcceptanceProbability);
+        m_isEndOfProblem = false;
+    }
+
     int MultiplexerEnvironment::getAnswer() const
     {
         return GetAnswerOfSituation(m_situation);
@@ -1,7 +1,10 @@
 #include "xcspp/environment/real_multiplexer_environment.hpp"
 #include <stdexcept>
+#include <utility> // std::move
 #include <cmath> // std::pow
 
+#include "xcspp/util/binary_stream.hpp"
+
 namespace xcspp
 {
 
@@ -70,6 +73,11 @@ namespace xcspp
         return m_situation;
     }
 
+    Span<const double> RealMultiplexerEnvironment::situationView() const
+    {
+        return m_situation;
+    }
+
     double RealMultiplexerEnvironment::executeAction(int action)
     {
         const double reward = (action == getAnswer()) ? 1000.0 : 0.0;
@@ -88,6 +96,35 @@ namespace xcspp
         return m_isEndOfProblem;
     }
 
+    void RealMultiplexerEnvironment::outputCheckpoint(std::ostream & os) const
+    {
+        BinaryWriter writer(os);
+        writer.writeVector(m_situation);
+        writer.write(m_isEndOfProblem);
+        writer.writeString(m_random.state());
+    }
+
+    void RealMultiplexerEnvironment::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        auto situation = reader.readVector<double>();
+        if (situation.size() != m_situation.size())
+        {
+            throw std::invalid_argument("RealMultiplexerEnvironment::inputCheckpoint() received a checkpoint of the problem with a different length.");
+        }
+        const auto isEndOfProblem = reader.read<bool>();
+        m_random.setState(reader.readString());
+        m_situation = std::move(situation);
+        m_isEndOfProblem = isEndOfProblem;
+    }
+
+    void RealMultiplexerEnvironment::seed(std::uint32_t seed)
+    {
+        m_random.seed(seed);
+        SetRandomSituation(m_situation, m_random, m_minorityAcceptanceProbability);
+        m_isEndOfProblem = false;
+    }
+
     int RealMultiplexerEnvironment::getAnswer() const
     {
         return GetAnswerOfSituation(m_situation, m_binaryThreshold);
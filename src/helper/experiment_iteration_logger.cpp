@@ -1,15 +1,18 @@
 #include "xcspp/helper/experiment_iteration_logger.hpp"
 #include <iostream>
 #include <cmath> // std::abs
+#include <cstdint> // std::uint64_t
+
+#include "xcspp/util/binary_stream.hpp"
 
 namespace xcspp
 {
     
     ExperimentIterationLogger::ExperimentIterationLogger(const ExperimentSettings & settings)
-        : m_rewardLogStream(settings.outputRewardFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputRewardFilename), settings.smaWidth, false)
-        , m_systemErrorLogStream(settings.outputSystemErrorFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputSystemErrorFilename), settings.smaWidth, false)
-        , m_populationSizeLogStream(settings.outputPopulationSizeFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputPopulationSizeFilename), false)
-        , m_stepCountLogStream(settings.outputStepCountFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputStepCountFilename), settings.smaWidth, false)
+        : m_rewardLogStream(settings.outputRewardFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputRewardFilename), settings.smaWidth, false, settings.appendLogFiles)
+        , m_systemErrorLogStream(settings.outputSystemErrorFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputSystemErrorFilename), settings.smaWidth, false, settings.appendLogFiles)
+        , m_populationSizeLogStream(settings.outputPopulationSizeFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputPopulationSizeFilename), false, settings.appendLogFiles)
+        , m_stepCountLogStream(settings.outputStepCountFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputStepCountFilename), settings.smaWidth, false, settings.appendLogFiles)
         , m_exploitationRepeat(settings.exploitationRepeat)
         , m_currentRewardSum(0.0)
         , m_currentSystemErrorSum(0.0)
@@ -43,4 +46,32 @@ namespace xcspp
         m_currentStepCount = 0;
     }
 
+    void ExperimentIterationLogger::outputCheckpoint(std::ostream & os) const
+    {
+        m_rewardLogStream.outputCheckpoint(os);
+        m_systemErrorLogStream.outputCheckpoint(os);
+        m_populationSizeLogStream.outputCheckpoint(os);
+        m_stepCountLogStream.outputCheckpoint(os);
+
+        BinaryWriter writer(os);
+        writer.write(m_currentRewardSum);
+        writer.write(m_currentSystemErrorSum);
+        writer.write(m_currentPopulationSizeSum);
+        writer.write<std::uint64_t>(m_currentStepCount);
+    }
+
+    void ExperimentIterationLogger::inputCheckpoint(std::istream & is)
+    {
+        m_rewardLogStream.inputCheckpoint(is);
+        m_systemErrorLogStream.inputCheckpoint(is);
+        m_populationSizeLogStream.inputCheckpoint(is);
+        m_stepCountLogStream.inputCheckpoint(is);
+
+        BinaryReader reader(is);
+        m_currentRewardSum = reader.read<double>();
+        m_currentSystemErrorSum = reader.read<double>();
+        m_currentPopulationSizeSum = reader.read<double>();
+        m_currentStepCount = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    }
+
 }
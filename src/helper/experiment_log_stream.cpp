@@ -1,16 +1,22 @@
 #include "xcspp/helper/experiment_log_stream.hpp"
 #include <iostream>
+#include <filesystem> // std::filesystem::file_size, std::filesystem::resize_file
+#include <system_error> // std::error_code
+#include <cstdint> // std::uint64_t
+
+#include "xcspp/util/binary_stream.hpp"
 
 namespace xcspp
 {
 
-    ExperimentLogStream::ExperimentLogStream(const std::string & filename, bool useStdoutWhenEmpty)
-        : m_os(
+    ExperimentLogStream::ExperimentLogStream(const std::string & filename, bool useStdoutWhenEmpty, bool appendsToFile)
+        : m_filename(filename)
+        , m_os(
             filename.empty()
                 ? (useStdoutWhenEmpty ? std::cout : m_ofs)
                 : m_ofs)
     {
-        m_ofs.open(filename);
+        m_ofs.open(filename, appendsToFile ? std::ios::app : std::ios::out);
     }
 
     void ExperimentLogStream::write(const std::string & str)
@@ -45,8 +51,31 @@ namespace xcspp
         }
     }
 
-    SMAExperimentLogStream::SMAExperimentLogStream(const std::string & filename, std::size_t smaWidth, bool useStdoutWhenEmpty)
-        : ExperimentLogStream(filename, useStdoutWhenEmpty)
+    void ExperimentLogStream::outputCheckpoint(std::ostream & os) const
+    {
+        // Every line is flushed, so the file size is up to date
+        std::error_code errorCode;
+        const auto fileSize = m_ofs.is_open() ? std::filesystem::file_size(m_filename, errorCode) : 0;
+        BinaryWriter(os).write<std::uint64_t>(errorCode ? 0 : fileSize);
+    }
+
+    void ExperimentLogStream::inputCheckpoint(std::istream & is)
+    {
+        const auto fileSize = BinaryReader(is).read<std::uint64_t>();
+        if (m_ofs.is_open())
+        {
+            m_ofs.close();
+            std::error_code errorCode;
+            if (std::filesystem::file_size(m_filename, errorCode) > fileSize && !errorCode)
+            {
+                std::filesystem::resize_file(m_filename, fileSize);
+            }
+            m_ofs.open(m_filename, std::ios::app);
+        }
+    }
+
+    SMAExperimentLogStream::SMAExperimentLogStream(const std::string & filename, std::size_t smaWidth, bool useStdoutWhenEmpty, bool appendsToFile)
+        : ExperimentLogStream(filename, useStdoutWhenEmpty, appendsToFile)
         , m_sma(smaWidth)
         , m_count(0)
     {
@@ -76,4 +105,18 @@ namespace xcspp
         }
     }
 
+    void SMAExperimentLogStream::outputCheckpoint(std::ostream & os) const
+    {
+        ExperimentLogStream::outputCheckpoint(os);
+        m_sma.outputCheckpoint(os);
+        BinaryWriter(os).write<std::uint64_t>(m_count);
+    }
+
+    void SMAExperimentLogStream::inputCheckpoint(std::istream & is)
+    {
+        ExperimentLogStream::inputCheckpoint(is);
+        m_sma.inputCheckpoint(is);
+        m_count = static_cast<std::size_t>(BinaryReader(is).read<std::uint64_t>());
+    }
+
 }
@@ -1,6 +1,11 @@
 #include "xcspp/helper/experiment_summary_logger.hpp"
 #include <iostream>
 #include <cmath> // std::abs
+#include <filesystem> // std::filesystem::file_size, std::filesystem::resize_file
+#include <system_error> // std::error_code
+#include <cstdint> // std::uint64_t
+
+#include "xcspp/util/binary_stream.hpp"
 
 namespace xcspp
 {
@@ -9,28 +14,55 @@ namespace xcspp
     {
         if (!m_alreadyOutputHeader)
         {
+            m_outputsMatchSetCacheHitRate = (m_matchSetCacheStatistics.lookupCount > 0);
             if (m_outputsToStdout)
             {
-                std::cout
-                    << "  Iteration      Reward      SysErr     PopSize  CovOccRate   TotalStep\n"
-                    << " ========== =========== =========== =========== =========== ===========" << std::endl;
+                if (m_outputsMatchSetCacheHitRate)
+                {
+                    std::cout
+                        << "  Iteration      Reward      SysErr     PopSize  CovOccRate   TotalStep  CacheHitRt\n"
+                        << " ========== =========== =========== =========== =========== =========== ===========" << std::endl;
+                }
+                else
+                {
+                    std::cout
+                        << "  Iteration      Reward      SysErr     PopSize  CovOccRate   TotalStep\n"
+                        << " ========== =========== =========== =========== =========== ===========" << std::endl;
+                }
             }
             if (m_logStream)
             {
-                m_logStream << "Iteration,Reward,SysErr,PopSize,CovOccRate,TotalStep" << std::endl;
+                m_logStream << "Iteration,Reward,SysErr,PopSize,CovOccRate,TotalStep";
+                if (m_outputsMatchSetCacheHitRate)
+                {
+                    m_logStream << ",CacheHitRate";
+                }
+                m_logStream << std::endl;
             }
             m_alreadyOutputHeader = true;
         }
 
+        // Hit rate of the match set cache in this interval
+        const MatchSetCacheStatistics intervalStatistics = {
+            m_matchSetCacheStatistics.lookupCount - m_prevMatchSetCacheStatistics.lookupCount,
+            m_matchSetCacheStatistics.hitCount - m_prevMatchSetCacheStatistics.hitCount,
+        };
+        m_prevMatchSetCacheStatistics = m_matchSetCacheStatistics;
+
         if (m_outputsToStdout)
         {
-            std::printf("%11u %11.3f %11.3f %11.3f  %1.8f %11.3f\n",
+            std::printf("%11u %11.3f %11.3f %11.3f  %1.8f %11.3f",
                 static_cast<unsigned int>(m_currentIterationCount + 1),
                 m_rewardSum / m_intervalIteration,
                 m_systemErrorSum / m_intervalIteration,
                 m_populationSizeSum / m_intervalIteration,
                 m_coveringOccurrenceRateSum / m_intervalIteration,
                 m_stepCountSum / m_intervalIteration);
+            if (m_outputsMatchSetCacheHitRate)
+            {
+                std::printf("  %1.8f", intervalStatistics.hitRate());
+            }
+            std::printf("\n");
             std::fflush(stdout);
         }
 
@@ -42,7 +74,12 @@ namespace xcspp
                 << m_systemErrorSum / m_intervalIteration << ','
                 << m_populationSizeSum / m_intervalIteration << ','
                 << m_coveringOccurrenceRateSum / m_intervalIteration << ','
-                << m_stepCountSum / m_intervalIteration << std::endl;
+                << m_stepCountSum / m_intervalIteration;
+            if (m_outputsMatchSetCacheHitRate)
+            {
+                m_logStream << ',' << intervalStatistics.hitRate();
+            }
+            m_logStream << std::endl;
         }
 
         m_rewardSum = 0.0;
@@ -53,7 +90,8 @@ namespace xcspp
     }
 
     ExperimentSummaryLogger::ExperimentSummaryLogger(const ExperimentSettings & settings)
-        : m_logStream(settings.outputSummaryFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputSummaryFilename))
+        : m_logFilename(settings.outputSummaryFilename.empty() ? "" : (settings.outputFilenamePrefix + settings.outputSummaryFilename))
+        , m_logStream(m_logFilename, settings.appendLogFiles ? std::ios::app : std::ios::out)
         , m_outputsToStdout(settings.outputSummaryToStdout)
         , m_intervalIteration(settings.summaryInterval)
         , m_exploitationRepeat(settings.exploitationRepeat)
@@ -62,6 +100,7 @@ namespace xcspp
         , m_populationSizeSum(0.0)
         , m_coveringOccurrenceRateSum(0.0)
         , m_stepCountSum(0.0)
+        , m_outputsMatchSetCacheHitRate(false)
         , m_alreadyOutputHeader(false)
         , m_currentIterationCount(0)
         , m_currentStepCount(0)
@@ -83,8 +122,10 @@ namespace xcspp
         m_currentStepCount = 0;
     }
 
-    void ExperimentSummaryLogger::oneIteration()
+    void ExperimentSummaryLogger::oneIteration(const MatchSetCacheStatistics & matchSetCacheStatistics)
     {
+        m_matchSetCacheStatistics = matchSetCacheStatistics;
+
         // Periodic log output
         if (m_intervalIteration > 0 && (m_currentIterationCount + 1) % m_intervalIteration == 0)
         {
@@ -94,4 +135,54 @@ namespace xcspp
         ++m_currentIterationCount;
     }
 
+    void ExperimentSummaryLogger::outputCheckpoint(std::ostream & os) const
+    {
+        // Every line is flushed, so the file size is up to date
+        std::error_code errorCode;
+        const auto fileSize = m_logStream.is_open() ? std::filesystem::file_size(m_logFilename, errorCode) : 0;
+
+        BinaryWriter writer(os);
+        writer.write<std::uint64_t>(errorCode ? 0 : fileSize);
+        writer.write(m_rewardSum);
+        writer.write(m_systemErrorSum);
+        writer.write(m_populationSizeSum);
+        writer.write(m_coveringOccurrenceRateSum);
+        writer.write(m_stepCountSum);
+        writer.write(m_matchSetCacheStatistics);
+        writer.write(m_prevMatchSetCacheStatistics);
+        writer.write(m_outputsMatchSetCacheHitRate);
+        writer.write(m_alreadyOutputHeader);
+        writer.write<std::uint64_t>(m_currentIterationCount);
+        writer.write<std::uint64_t>(m_currentStepCount);
+    }
+
+    void ExperimentSummaryLogger::inputCheckpoint(std::istream & is)
+    {
+        BinaryReader reader(is);
+        const auto fileSize = reader.read<std::uint64_t>();
+        m_rewardSum = reader.read<double>();
+        m_systemErrorSum = reader.read<double>();
+        m_populationSizeSum = reader.read<double>();
+        m_coveringOccurrenceRateSum = reader.read<double>();
+        m_stepCountSum = reader.read<double>();
+        m_matchSetCacheStatistics = reader.read<MatchSetCacheStatistics>();
+        m_prevMatchSetCacheStatistics = reader.read<MatchSetCacheStatistics>();
+        m_outputsMatchSetCacheHitRate = reader.read<bool>();
+        m_alreadyOutputHeader = reader.read<bool>();
+        m_currentIterationCount = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        m_currentStepCount = static_cast<std::size_t>(reader.read<std::uint64_t>());
+
+        // Discard the lines written after the checkpoint
+        if (m_logStream.is_open())
+        {
+            m_logStream.close();
+            std::error_code errorCode;
+            if (std::filesystem::file_size(m_logFilename, errorCode) > fileSize && !errorCode)
+            {
+                std::filesystem::resize_file(m_logFilename, fileSize);
+            }
+            m_logStream.open(m_logFilename, std::ios::app);
+        }
+    }
+
 }
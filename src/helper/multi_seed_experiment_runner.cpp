@@ -0,0 +1,116 @@
+#include "xcspp/helper/multi_seed_experiment_runner.hpp"
+#include <fstream>
+#include <sstream>
+#include <filesystem> // std::filesystem::path
+
+#include "xcspp/util/csv.hpp"
+
+namespace xcspp
+{
+
+    namespace
+    {
+        std::vector<std::string> SplitFields(const std::string & line)
+        {
+            std::vector<std::string> fields;
+            std::istringstream iss(line);
+            std::string field;
+            while (std::getline(iss, field, ','))
+            {
+                fields.push_back(field);
+            }
+            return fields;
+        }
+
+        double ParseLogValue(const std::string & field, const std::string & filename)
+        {
+            double value = 0.0;
+            if (!CSV::ParseNumber(field.data(), field.data() + field.size(), value))
+            {
+                throw std::runtime_error("AverageLogFiles: Failed to parse the field '" + field + "' in '" + filename + "'.");
+            }
+            return value;
+        }
+    }
+
+    std::string SeedFilename(const std::string & filename, std::size_t seedIdx)
+    {
+        std::filesystem::path path(filename);
+        const std::string extension = path.extension().string();
+        path.replace_filename(path.stem().string() + "_seed" + std::to_string(seedIdx) + extension);
+        return path.string();
+    }
+
+    void AverageLogFiles(const std::vector<std::string> & inputFilenames, const std::string & outputFilename)
+    {
+        if (inputFilenames.empty())
+        {
+            return;
+        }
+
+        std::vector<std::ifstream> inputs;
+        for (const auto & filename : inputFilenames)
+        {
+            inputs.emplace_back(filename);
+            if (!inputs.back().good())
+            {
+                throw std::runtime_error("AverageLogFiles: Failed to open the file '" + filename + "'.");
+            }
+        }
+
+        std::ofstream ofs(outputFilename);
+        if (!ofs.good())
+        {
+            throw std::runtime_error("AverageLogFiles: Failed to open the file '" + outputFilename + "'.");
+        }
+
+        std::vector<std::vector<std::string>> lineFields(inputs.size());
+        while (true)
+        {
+            std::string line;
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                if (!std::getline(inputs[i], line))
+                {
+                    return;
+                }
+                lineFields[i] = SplitFields(line);
+            }
+
+            const std::size_t fieldCount = lineFields.front().size();
+            for (std::size_t fieldIdx = 0; fieldIdx < fieldCount; ++fieldIdx)
+            {
+                if (fieldIdx > 0)
+                {
+                    ofs << ',';
+                }
+
+                bool isSame = true;
+                for (const auto & fields : lineFields)
+                {
+                    if (fields.size() != fieldCount)
+                    {
+                        throw std::runtime_error("AverageLogFiles: The numbers of the fields differ between the files.");
+                    }
+                    isSame = isSame && (fields[fieldIdx] == lineFields.front()[fieldIdx]);
+                }
+
+                if (isSame)
+                {
+                    ofs << lineFields.front()[fieldIdx];
+                }
+                else
+                {
+                    double sum = 0.0;
+                    for (std::size_t i = 0; i < inputs.size(); ++i)
+                    {
+                        sum += ParseLogValue(lineFields[i][fieldIdx], inputFilenames[i]);
+                    }
+                    ofs << sum / inputs.size();
+                }
+            }
+            ofs << '\n';
+        }
+    }
+
+}
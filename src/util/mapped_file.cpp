@@ -0,0 +1,87 @@
+#include "xcspp/util/mapped_file.hpp"
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define XCSPP_USE_MMAP
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <fcntl.h> // open
+#include <unistd.h> // close
+#endif
+
+namespace xcspp
+{
+
+    namespace
+    {
+        // Placeholder for the data of an empty file (mmap() cannot map zero bytes)
+        const unsigned long long kEmptyData = 0;
+    }
+
+    MappedFile::MappedFile(const std::string & filename)
+        : m_data(reinterpret_cast<const unsigned char *>(&kEmptyData))
+        , m_size(0)
+        , m_isMapped(false)
+    {
+#ifdef XCSPP_USE_MMAP
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("MappedFile could not open '" + filename + "'.");
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("MappedFile could not get the size of '" + filename + "'.");
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+
+        if (m_size > 0)
+        {
+            void * const addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("MappedFile could not map '" + filename + "'.");
+            }
+            m_data = static_cast<const unsigned char *>(addr);
+            m_isMapped = true;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+#else
+        std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+        if (!ifs.good())
+        {
+            throw std::runtime_error("MappedFile could not open '" + filename + "'.");
+        }
+        m_size = static_cast<std::size_t>(ifs.tellg());
+        ifs.seekg(0);
+
+        if (m_size > 0)
+        {
+            m_buffer.resize((m_size + sizeof(unsigned long long) - 1) / sizeof(unsigned long long));
+            if (!ifs.read(reinterpret_cast<char *>(m_buffer.data()), static_cast<std::streamsize>(m_size)))
+            {
+                throw std::runtime_error("MappedFile could not read '" + filename + "'.");
+            }
+            m_data = reinterpret_cast<const unsigned char *>(m_buffer.data());
+        }
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef XCSPP_USE_MMAP
+        if (m_isMapped)
+        {
+            ::munmap(const_cast<unsigned char *>(m_data), m_size);
+        }
+#endif
+    }
+
+}
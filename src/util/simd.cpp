@@ -0,0 +1,82 @@
+#include "xcspp/util/simd.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h> // __cpuid, __cpuidex, _xgetbv
+#endif
+
+namespace xcspp
+{
+
+    namespace
+    {
+        bool CPUSupportsSSE2()
+        {
+#if defined(__x86_64__) || defined(_M_X64)
+            return true; // SSE2 is part of x86-64
+#elif defined(__i386__) && (defined(__GNUC__) || defined(__clang__))
+            return __builtin_cpu_supports("sse2");
+#elif defined(_M_IX86) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[3] & (1 << 26)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        bool CPUSupportsAVX2()
+        {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+            return __builtin_cpu_supports("avx2");
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+            {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return false;
+#endif
+        }
+    }
+
+    bool IsSIMDKernelSupported(SIMDKernel kernel)
+    {
+        switch (kernel)
+        {
+        case SIMDKernel::kScalar:
+            return true;
+
+        case SIMDKernel::kSSE2:
+            return CPUSupportsSSE2();
+
+        case SIMDKernel::kAVX2:
+            return CPUSupportsAVX2();
+
+        default:
+            return false;
+        }
+    }
+
+    SIMDKernel DetectSIMDKernel()
+    {
+        if (IsSIMDKernelSupported(SIMDKernel::kAVX2))
+        {
+            return SIMDKernel::kAVX2;
+        }
+        else if (IsSIMDKernelSupported(SIMDKernel::kSSE2))
+        {
+            return SIMDKernel::kSSE2;
+        }
+        else
+        {
+            return SIMDKernel::kScalar;
+        }
+    }
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include <cstdint> // std::uint32_t
+
+#include <xcspp/xcspp.hpp>
+#include "random_fixture.hpp"
+
+namespace xcspp::test
+{
+
+    // Correct action of the 6-bit multiplexer (a real value is regarded as 1 if it is 0.5 or more)
+    template <typename T>
+    int MultiplexerAnswer(const std::vector<T> & situation)
+    {
+        const int address = (situation[0] >= 0.5) * 2 + (situation[1] >= 0.5);
+        return situation[2 + address] >= 0.5;
+    }
+
+    // All the 64 situations of the 6-bit multiplexer
+    inline std::vector<std::vector<int>> AllMultiplexerSituations()
+    {
+        std::vector<std::vector<int>> situations;
+        for (int bits = 0; bits < 64; ++bits)
+        {
+            std::vector<int> situation;
+            for (int i = 5; i >= 0; --i)
+            {
+                situation.push_back((bits >> i) & 1);
+            }
+            situations.push_back(situation);
+        }
+        return situations;
+    }
+
+    // Train the system on the random situations of the 6-bit multiplexer
+    template <class System>
+    void TrainOnMultiplexer(System & system, int iterations, std::uint32_t seed)
+    {
+        Random random(seed);
+        for (int i = 0; i < iterations; ++i)
+        {
+            const auto situation = RandomSituation<int>(6, random);
+            const int action = system.explore(situation);
+            system.reward((action == MultiplexerAnswer(situation)) ? 1000.0 : 0.0);
+        }
+    }
+
+}
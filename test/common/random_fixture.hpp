@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <type_traits> // std::is_integral_v
+#include <cstddef> // std::size_t
+
+#include <xcspp/xcspp.hpp>
+
+namespace xcspp::test
+{
+
+    // Random situation (each value is 0 or 1 for an integer type, or in [0, 1) for a floating-point type)
+    template <typename T>
+    std::vector<T> RandomSituation(std::size_t length, Random & random)
+    {
+        std::vector<T> situation;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                situation.push_back(random.nextInt<T>(0, 1));
+            }
+            else
+            {
+                situation.push_back(random.nextDouble());
+            }
+        }
+        return situation;
+    }
+
+    // Random ternary symbols ("#" with the probability dontCareProbability, otherwise 0 or 1)
+    inline std::vector<xcs::Symbol> RandomTernarySymbols(std::size_t length, double dontCareProbability, Random & random)
+    {
+        std::vector<xcs::Symbol> symbols;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            symbols.push_back(random.nextDouble() < dontCareProbability ? xcs::Symbol('#') : xcs::Symbol(random.nextInt(0, 1)));
+        }
+        return symbols;
+    }
+
+    // Random XCSR condition
+    //   The centers of CSR are in [0, 1) and the spreads are in [0, maxSpread), and the bounds
+    //   of OBR and UBR are in [-0.2, 1.2), so that some of them are out of the situation range.
+    inline xcsr::Condition RandomRealCondition(std::size_t length, xcsr::XCSRRepr repr, double maxSpread, Random & random)
+    {
+        std::vector<xcsr::Symbol> symbols;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (repr == xcsr::XCSRRepr::kCSR)
+            {
+                symbols.emplace_back(random.nextDouble(), random.nextDouble(0.0, maxSpread));
+            }
+            else
+            {
+                symbols.emplace_back(random.nextDouble(-0.2, 1.2), random.nextDouble(-0.2, 1.2));
+            }
+        }
+        return xcsr::Condition(symbols);
+    }
+
+}
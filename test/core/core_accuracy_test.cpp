@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <cmath>
+
+using namespace xcspp;
+
+TEST(Core_AccuracyTest, MatchesPowerFunction)
+{
+    const double epsilonZero = 10.0;
+    const double alpha = 0.1;
+    for (const double nu : { 0.0, 1.0, 2.0, 5.0, 7.0, 2.5, 70.0 })
+    {
+        for (const double epsilon : { 10.0, 10.5, 37.0, 250.0, 999.9 })
+        {
+            const double expected = alpha * std::pow(epsilon / epsilonZero, -nu);
+            EXPECT_NEAR(ComputeAccuracy(epsilon, epsilonZero, alpha, nu), expected, expected * 1e-12);
+        }
+    }
+}
+
+TEST(Core_AccuracyTest, AccurateBelowEpsilonZero)
+{
+    EXPECT_EQ(ComputeAccuracy(0.0, 10.0, 0.1, 5.0), 1.0);
+    EXPECT_EQ(ComputeAccuracy(9.99, 10.0, 0.1, 5.0), 1.0);
+}
+
+TEST(Core_AccuracyTest, StoredClassifierCache)
+{
+    xcs::XCSParams params;
+    xcs::StoredClassifier cl(xcs::Classifier("0 1 #", 0, 500.0, 100.0, 0.1, 0), &params);
+    EXPECT_DOUBLE_EQ(cl.accuracy(), ComputeAccuracy(100.0, params.epsilonZero, params.alpha, params.nu));
+
+    // The cache is refreshed only by updateAccuracy()
+    cl.epsilon = 1.0;
+    cl.updateAccuracy();
+    EXPECT_EQ(cl.accuracy(), 1.0);
+}
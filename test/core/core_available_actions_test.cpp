@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <map>
+
+using namespace xcspp;
+
+TEST(Core_AvailableActionsTest, SortedActions)
+{
+    const AvailableActions actions({ 5, -1, 3, 0 });
+    ASSERT_EQ(actions.size(), 4);
+    EXPECT_EQ(std::vector<int>(actions.begin(), actions.end()), std::vector<int>({ -1, 0, 3, 5 }));
+    EXPECT_EQ(actions.indexOf(3), 2);
+    EXPECT_EQ(actions.indexOf(4), AvailableActions::npos);
+    EXPECT_TRUE(actions.contains(-1));
+    EXPECT_FALSE(actions.contains(1));
+}
+
+TEST(Core_AvailableActionsTest, ChooseOtherThan)
+{
+    Random random(42);
+    const AvailableActions actions({ 0, 1, 2, 3 });
+    std::map<int, int> counts;
+    for (int i = 0; i < 30000; ++i)
+    {
+        ++counts[actions.chooseOtherThan(2, random)];
+    }
+    EXPECT_EQ(counts.count(2), 0);
+    for (const auto & action : { 0, 1, 3 })
+    {
+        EXPECT_NEAR(counts[action] / 30000.0, 1.0 / 3, 0.02);
+    }
+
+    // Any action can be chosen if the given action is not available
+    EXPECT_TRUE(actions.contains(actions.chooseOtherThan(7, random)));
+
+    const AvailableActions singleAction({ 1 });
+    EXPECT_THROW(singleAction.chooseOtherThan(1, random), std::invalid_argument);
+}
+
+TEST(Core_AvailableActionsTest, ActionSubset)
+{
+    Random random(43);
+    const AvailableActions actions({ 10, 20, 30, 40 });
+    ActionSubset subset(actions, true);
+    EXPECT_EQ(subset.size(), 4);
+    EXPECT_TRUE(subset.erase(20));
+    EXPECT_FALSE(subset.erase(20));
+    EXPECT_FALSE(subset.erase(25));
+    EXPECT_TRUE(subset.erase(40));
+    EXPECT_EQ(subset.size(), 2);
+
+    std::map<int, int> counts;
+    for (int i = 0; i < 20000; ++i)
+    {
+        ++counts[subset.choose(random)];
+    }
+    ASSERT_EQ(counts.size(), 2);
+    EXPECT_NEAR(counts[10] / 20000.0, 0.5, 0.02);
+    EXPECT_NEAR(counts[30] / 20000.0, 0.5, 0.02);
+
+    ActionSubset emptySubset(actions, false);
+    EXPECT_TRUE(emptySubset.empty());
+    EXPECT_THROW(emptySubset.choose(random), std::invalid_argument);
+    EXPECT_TRUE(emptySubset.insert(40));
+    EXPECT_EQ(emptySubset.choose(random), 40);
+}
+
+TEST(Core_AvailableActionsTest, LargeActionSubset)
+{
+    // More actions than the inline capacity of ActionSubset
+    std::unordered_set<int> actionSet;
+    for (int i = 0; i < 300; ++i)
+    {
+        actionSet.insert(i * 2);
+    }
+    const AvailableActions actions(actionSet);
+    ActionSubset subset(actions, true);
+    EXPECT_EQ(subset.size(), 300);
+    for (int i = 0; i < 299; ++i)
+    {
+        EXPECT_TRUE(subset.erase(i * 2));
+    }
+
+    Random random(44);
+    EXPECT_EQ(subset.choose(random), 598);
+    EXPECT_TRUE(subset.contains(598));
+    EXPECT_FALSE(subset.contains(0));
+}
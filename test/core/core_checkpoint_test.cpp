@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <sstream>
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#include <filesystem>
+#include <cstdio> // std::remove
+
+#include "common/multiplexer_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    // Every third problem takes two steps, so that [A]_-1 is used
+    template <typename T, class System>
+    std::vector<int> Train(System & system, Random & random, int steps)
+    {
+        std::vector<int> actions;
+        for (int i = 0; i < steps; ++i)
+        {
+            const auto situation = RandomSituation<T>(6, random);
+            const int action = system.explore(situation);
+            system.reward((action == MultiplexerAnswer(situation)) ? 1000.0 : 0.0, i % 3 != 1);
+            actions.push_back(action);
+        }
+        return actions;
+    }
+
+    // Same classifiers in the same order with bit-identical values
+    template <class Population>
+    void ExpectSamePopulation(const Population & expected, const Population & actual)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        auto it = actual.begin();
+        for (const auto & cl : expected)
+        {
+            EXPECT_EQ(it->condition, cl.condition);
+            EXPECT_EQ(it->action, cl.action);
+            EXPECT_EQ(it->prediction, cl.prediction);
+            EXPECT_EQ(it->epsilon, cl.epsilon);
+            EXPECT_EQ(it->fitness, cl.fitness);
+            EXPECT_EQ(it->experience, cl.experience);
+            EXPECT_EQ(it->timeStamp, cl.timeStamp);
+            EXPECT_EQ(it->actionSetSize, cl.actionSetSize);
+            EXPECT_EQ(it->numerosity, cl.numerosity);
+            ++it;
+        }
+        EXPECT_EQ(actual.numerositySum(), expected.numerositySum());
+        EXPECT_EQ(actual.fitnessSum(), expected.fitnessSum());
+    }
+
+    template <typename T, class System, class Params>
+    void TestResume(const Params & params)
+    {
+        System system({ 0, 1 }, params);
+        Random random(3);
+
+        // Save in the middle of a two-step problem
+        Train<T>(system, random, 2001);
+        std::stringstream checkpoint;
+        system.outputCheckpoint(checkpoint);
+
+        // The random engine of the system is restored as well, so both systems continue in the same way
+        System resumed({ 0, 1 }, params);
+        resumed.inputCheckpoint(checkpoint);
+        ExpectSamePopulation(system.population(), resumed.population());
+
+        Random resumedRandom = random;
+        EXPECT_EQ(Train<T>(resumed, resumedRandom, 3000), Train<T>(system, random, 3000));
+        ExpectSamePopulation(system.population(), resumed.population());
+    }
+
+    std::string ReadFile(const std::string & filename)
+    {
+        std::ifstream ifs(filename);
+        return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+}
+
+TEST(Core_CheckpointTest, XCSResume)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    TestResume<int, xcs::XCS>(params);
+}
+
+TEST(Core_CheckpointTest, PackedXCSResume)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    params.matchSetCacheCapacity = 16;
+    TestResume<int, xcs::PackedXCS>(params);
+}
+
+TEST(Core_CheckpointTest, XCSRResume)
+{
+    xcsr::XCSRParams params;
+    params.n = 400;
+    params.repr = XCSRRepr::kUBR;
+    TestResume<double, XCSR>(params);
+}
+
+TEST(Core_CheckpointTest, InvalidCheckpoint)
+{
+    xcs::XCSParams params;
+    xcs::XCS system({ 0, 1 }, params);
+    std::stringstream checkpoint;
+    system.outputCheckpoint(checkpoint);
+    const std::string bytes = checkpoint.str();
+
+    // Different hyperparameters
+    params.beta = 0.1;
+    xcs::XCS otherSystem({ 0, 1 }, params);
+    std::istringstream iss(bytes);
+    EXPECT_THROW(otherSystem.inputCheckpoint(iss), std::invalid_argument);
+
+    // Checkpoint of another system
+    XCSR xcsr({ 0, 1 }, xcsr::XCSRParams());
+    iss.str(bytes);
+    iss.clear();
+    EXPECT_THROW(xcsr.inputCheckpoint(iss), std::runtime_error);
+
+    // Truncated checkpoint
+    iss.str(bytes.substr(0, bytes.size() - 1));
+    iss.clear();
+    EXPECT_THROW(system.inputCheckpoint(iss), std::runtime_error);
+
+    EXPECT_FALSE(system.loadCheckpointFile("no_such_file.bin"));
+}
+
+TEST(Core_CheckpointTest, ExperimentHelperResume)
+{
+    ExperimentSettings settings;
+    settings.summaryInterval = 100;
+    settings.outputFilenamePrefix = "core_checkpoint_test_a_";
+    settings.outputSummaryFilename = "summary.csv";
+    settings.outputRewardFilename = "reward.csv";
+    settings.outputPopulationSizeFilename = "population_size.csv";
+    settings.smaWidth = 10;
+    xcs::XCSParams params;
+    params.n = 400;
+
+    const std::string checkpointFilename = "core_checkpoint_test.bin";
+    {
+        ExperimentHelper helper(settings);
+        helper.constructTrainEnv<MultiplexerEnvironment>(6);
+        helper.constructTestEnv<MultiplexerEnvironment>(6);
+        helper.constructSystem<xcs::PackedXCS>(std::unordered_set<int>{ 0, 1 }, params);
+        helper.runIteration(1050);
+        ASSERT_TRUE(helper.saveCheckpointFile(checkpointFilename));
+        helper.runIteration(950);
+    }
+
+    // Resume from the log files written to the end (the lines after the checkpoint are discarded)
+    const std::vector<std::string> filenames = { "summary.csv", "reward.csv", "population_size.csv" };
+    for (const auto & filename : filenames)
+    {
+        std::filesystem::copy_file("core_checkpoint_test_a_" + filename, "core_checkpoint_test_b_" + filename, std::filesystem::copy_options::overwrite_existing);
+    }
+    settings.outputFilenamePrefix = "core_checkpoint_test_b_";
+    settings.appendLogFiles = true;
+    {
+        ExperimentHelper helper(settings);
+        helper.constructTrainEnv<MultiplexerEnvironment>(6);
+        helper.constructTestEnv<MultiplexerEnvironment>(6);
+        helper.constructSystem<xcs::PackedXCS>(std::unordered_set<int>{ 0, 1 }, params);
+        ASSERT_TRUE(helper.loadCheckpointFile(checkpointFilename));
+        EXPECT_EQ(helper.iterationCount(), 1050);
+        helper.runIteration(950);
+    }
+    std::remove(checkpointFilename.c_str());
+
+    for (const auto & filename : filenames)
+    {
+        EXPECT_EQ(ReadFile("core_checkpoint_test_b_" + filename), ReadFile("core_checkpoint_test_a_" + filename)) << filename;
+        EXPECT_FALSE(ReadFile("core_checkpoint_test_a_" + filename).empty());
+        std::remove(("core_checkpoint_test_a_" + filename).c_str());
+        std::remove(("core_checkpoint_test_b_" + filename).c_str());
+    }
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <fstream>
+#include <sstream>
+#include <iterator> // std::istreambuf_iterator
+#include <cstdio> // std::remove
+
+using namespace xcspp;
+
+namespace
+{
+    std::string ReadFile(const std::string & filename)
+    {
+        std::ifstream ifs(filename);
+        return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    void WriteFile(const std::string & filename, const std::string & str)
+    {
+        std::ofstream ofs(filename);
+        ofs << str;
+    }
+
+    std::vector<double> ReadColumn(const std::string & filename)
+    {
+        std::vector<double> values;
+        std::ifstream ifs(filename);
+        std::string line;
+        while (std::getline(ifs, line))
+        {
+            values.push_back(std::stod(line));
+        }
+        return values;
+    }
+}
+
+TEST(Core_MultiSeedExperimentRunnerTest, SeedFilename)
+{
+    EXPECT_EQ(SeedFilename("reward.csv", 0), "reward_seed0.csv");
+    EXPECT_EQ(SeedFilename("log/reward.csv", 12), "log/reward_seed12.csv");
+    EXPECT_EQ(SeedFilename("checkpoint", 3), "checkpoint_seed3");
+}
+
+TEST(Core_MultiSeedExperimentRunnerTest, AverageLogFiles)
+{
+    WriteFile("core_multi_seed_test_0.csv", "Iteration,Reward\n100,1\n200,0.5\n300,0\n");
+    WriteFile("core_multi_seed_test_1.csv", "Iteration,Reward\n100,0\n200,0.25\n");
+    AverageLogFiles({ "core_multi_seed_test_0.csv", "core_multi_seed_test_1.csv" }, "core_multi_seed_test_avg.csv");
+
+    // Same fields are copied, and the output ends at the shortest file
+    EXPECT_EQ(ReadFile("core_multi_seed_test_avg.csv"), "Iteration,Reward\n100,0.5\n200,0.375\n");
+
+    WriteFile("core_multi_seed_test_1.csv", "Iteration,Reward\n100,abc\n");
+    EXPECT_THROW(AverageLogFiles({ "core_multi_seed_test_0.csv", "core_multi_seed_test_1.csv" }, "core_multi_seed_test_avg.csv"), std::runtime_error);
+    EXPECT_THROW(AverageLogFiles({ "core_multi_seed_test_0.csv", "no_such_file.csv" }, "core_multi_seed_test_avg.csv"), std::runtime_error);
+
+    std::remove("core_multi_seed_test_0.csv");
+    std::remove("core_multi_seed_test_1.csv");
+    std::remove("core_multi_seed_test_avg.csv");
+}
+
+TEST(Core_MultiSeedExperimentRunnerTest, AveragedLogs)
+{
+    constexpr std::size_t kSeedCount = 3;
+
+    ExperimentSettings settings;
+    settings.summaryInterval = 100;
+    settings.outputFilenamePrefix = "core_multi_seed_test_";
+    settings.outputRewardFilename = "reward.csv";
+    settings.outputPopulationSizeFilename = "population_size.csv";
+    settings.smaWidth = 10;
+    xcs::XCSParams params;
+    params.n = 400;
+
+    std::vector<std::size_t> setupSeedIdxs;
+    {
+        MultiSeedExperimentRunner runner(settings, kSeedCount, [&](ExperimentHelper & helper, std::size_t seedIdx) {
+            helper.constructTrainEnv<MultiplexerEnvironment>(6);
+            helper.constructTestEnv<MultiplexerEnvironment>(6);
+            helper.constructSystem<xcs::PackedXCS>(std::unordered_set<int>{ 0, 1 }, params);
+            setupSeedIdxs.push_back(seedIdx);
+        }, 2);
+        EXPECT_EQ(runner.seedCount(), kSeedCount);
+        EXPECT_EQ(runner.threadCount(), 2);
+
+        runner.runIteration(500);
+        EXPECT_EQ(runner.iterationCount(), 500);
+        for (std::size_t i = 0; i < kSeedCount; ++i)
+        {
+            EXPECT_EQ(runner.helper(i).iterationCount(), 500);
+        }
+        runner.outputAveragedLogs();
+    }
+    EXPECT_EQ(setupSeedIdxs, (std::vector<std::size_t>{ 0, 1, 2 }));
+
+    for (const std::string filename : { "reward.csv", "population_size.csv" })
+    {
+        std::vector<std::vector<double>> seedValues;
+        for (std::size_t i = 0; i < kSeedCount; ++i)
+        {
+            seedValues.push_back(ReadColumn(settings.outputFilenamePrefix + SeedFilename(filename, i)));
+            EXPECT_FALSE(seedValues.back().empty());
+            EXPECT_EQ(seedValues.back().size(), seedValues.front().size());
+        }
+
+        const auto averagedValues = ReadColumn(settings.outputFilenamePrefix + filename);
+        ASSERT_EQ(averagedValues.size(), seedValues.front().size());
+        for (std::size_t j = 0; j < averagedValues.size(); ++j)
+        {
+            const double expected = (seedValues[0][j] + seedValues[1][j] + seedValues[2][j]) / kSeedCount;
+            EXPECT_NEAR(averagedValues[j], expected, 1e-4 * (1.0 + expected)) << filename << ":" << j;
+        }
+
+        for (std::size_t i = 0; i < kSeedCount; ++i)
+        {
+            std::remove((settings.outputFilenamePrefix + SeedFilename(filename, i)).c_str());
+        }
+        std::remove((settings.outputFilenamePrefix + filename).c_str());
+    }
+}
+
+TEST(Core_MultiSeedExperimentRunnerTest, SingleSeed)
+{
+    ExperimentSettings settings;
+    settings.outputFilenamePrefix = "core_multi_seed_test_single_";
+    settings.outputRewardFilename = "reward.csv";
+    {
+        MultiSeedExperimentRunner runner(settings, 1, [](ExperimentHelper & helper, std::size_t) {
+            helper.constructTrainEnv<MultiplexerEnvironment>(6);
+            helper.constructTestEnv<MultiplexerEnvironment>(6);
+            helper.constructSystem<xcs::XCS>(std::unordered_set<int>{ 0, 1 }, xcs::XCSParams());
+        });
+        EXPECT_EQ(runner.seedFilename("population.csv", 0), "population.csv");
+        runner.runIteration(10);
+        runner.outputAveragedLogs();
+    }
+
+    // The filenames are the same as a single ExperimentHelper
+    EXPECT_FALSE(ReadFile("core_multi_seed_test_single_reward.csv").empty());
+    EXPECT_TRUE(ReadFile("core_multi_seed_test_single_" + SeedFilename("reward.csv", 0)).empty());
+    std::remove("core_multi_seed_test_single_reward.csv");
+
+    EXPECT_THROW(MultiSeedExperimentRunner(settings, 0, [](ExperimentHelper &, std::size_t) {}), std::invalid_argument);
+}
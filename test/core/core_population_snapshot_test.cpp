@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <fstream>
+#include <filesystem>
+#include <cstdio> // std::remove
+
+#include "common/multiplexer_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    // Same classifiers in the same order with bit-identical values
+    template <class ClassifierRange, class Classifier>
+    void ExpectSameClassifiers(const ClassifierRange & expected, const std::vector<Classifier> & actual)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        std::size_t i = 0;
+        for (const auto & cl : expected)
+        {
+            EXPECT_EQ(actual[i].condition, cl.condition);
+            EXPECT_EQ(actual[i].action, cl.action);
+            EXPECT_EQ(actual[i].prediction, cl.prediction);
+            EXPECT_EQ(actual[i].epsilon, cl.epsilon);
+            EXPECT_EQ(actual[i].fitness, cl.fitness);
+            EXPECT_EQ(actual[i].experience, cl.experience);
+            EXPECT_EQ(actual[i].timeStamp, cl.timeStamp);
+            EXPECT_EQ(actual[i].actionSetSize, cl.actionSetSize);
+            EXPECT_EQ(actual[i].numerosity, cl.numerosity);
+            ++i;
+        }
+    }
+
+    template <class System>
+    void TestXCSRoundTrip()
+    {
+        using ClassifierType = typename std::decay_t<decltype(std::declval<System>().population())>::ClassifierType;
+
+        xcs::XCSParams params;
+        params.n = 400;
+        System system({ 0, 1 }, params);
+        TrainOnMultiplexer(system, 3000, 11);
+
+        const std::string filename = "core_population_snapshot_test_xcs.bin";
+        ASSERT_TRUE(system.savePopulationBinaryFile(filename));
+
+        System loaded({ 0, 1 }, params);
+        ASSERT_TRUE(loaded.loadPopulationBinaryFile(filename));
+        const auto snapshot = PopulationSnapshot::FromFile(filename);
+        std::remove(filename.c_str());
+
+        EXPECT_TRUE(snapshot.isMapped());
+        EXPECT_EQ(snapshot.paramsHash(), xcs::HashParams(params));
+        EXPECT_EQ(snapshot.conditionLength(), 6);
+        ExpectSameClassifiers(system.population(), std::vector<ClassifierType>(loaded.population().begin(), loaded.population().end()));
+        EXPECT_EQ(loaded.numerositySum(), system.numerositySum());
+    }
+}
+
+TEST(Core_PopulationSnapshotTest, XCSRoundTrip)
+{
+    TestXCSRoundTrip<xcs::XCS>();
+}
+
+TEST(Core_PopulationSnapshotTest, PackedXCSRoundTrip)
+{
+    TestXCSRoundTrip<xcs::PackedXCS>();
+}
+
+TEST(Core_PopulationSnapshotTest, ConvertsTernaryKinds)
+{
+    const std::vector<xcs::Classifier> classifiers = {
+        xcs::Classifier("0 # 1", 0, 1.0 / 3.0, 0.1, 0.2, 7),
+        xcs::Classifier("# # 1", 1, 2.0 / 3.0, 0.3, 0.4, 9),
+    };
+    const auto snapshot = xcs::MakePopulationSnapshot(classifiers, 0);
+    EXPECT_EQ(snapshot.conditionKind(), PopulationSnapshot::ConditionKind::kTernary);
+
+    const auto packedClassifiers = xcs::ReadPopulationSnapshot<xcs::PackedCondition>(snapshot);
+    ASSERT_EQ(packedClassifiers.size(), 2);
+    EXPECT_EQ(packedClassifiers[0].condition, xcs::PackedCondition("0 # 1"));
+    EXPECT_EQ(packedClassifiers[1].condition, xcs::PackedCondition("# # 1"));
+    EXPECT_EQ(packedClassifiers[1].prediction, 2.0 / 3.0);
+
+    const auto packedSnapshot = xcs::MakePopulationSnapshot(packedClassifiers, 0);
+    EXPECT_EQ(packedSnapshot.conditionKind(), PopulationSnapshot::ConditionKind::kPackedTernary);
+    ExpectSameClassifiers(classifiers, xcs::ReadPopulationSnapshot<xcs::Condition>(packedSnapshot));
+
+    // XCS cannot read the snapshot of XCSR
+    const std::vector<xcsr::Classifier> realClassifiers = { xcsr::Classifier("0.5;0.1", 0, 1.0, 0.0, 1.0, 0) };
+    EXPECT_THROW(xcs::ReadPopulationSnapshot<xcs::Condition>(xcsr::MakePopulationSnapshot(realClassifiers, XCSRRepr::kCSR, 0)), std::invalid_argument);
+}
+
+TEST(Core_PopulationSnapshotTest, XCSRRoundTrip)
+{
+    // Values that the CSV text does not round-trip
+    Random random(5);
+    std::vector<xcsr::Classifier> classifiers;
+    for (int i = 0; i < 200; ++i)
+    {
+        std::vector<xcsr::Symbol> symbols;
+        for (int j = 0; j < 4; ++j)
+        {
+            symbols.emplace_back(random.nextDouble(), random.nextDouble() / 3.0);
+        }
+        xcsr::Classifier cl(xcsr::Condition(symbols), random.nextInt(0, 1), random.nextDouble(0.0, 1000.0), random.nextDouble(), random.nextDouble(), i);
+        cl.experience = i * 3;
+        cl.actionSetSize = random.nextDouble(1.0, 50.0);
+        cl.numerosity = 1 + i % 5;
+        classifiers.push_back(cl);
+    }
+
+    xcsr::XCSRParams params;
+    params.n = 1000;
+    params.repr = XCSRRepr::kCSR;
+    XCSR system({ 0, 1 }, params);
+    system.setPopulationClassifiers(classifiers);
+
+    const std::string filename = "core_population_snapshot_test_xcsr.bin";
+    ASSERT_TRUE(system.savePopulationBinaryFile(filename));
+
+    XCSR loaded({ 0, 1 }, params);
+    ASSERT_TRUE(loaded.loadPopulationBinaryFile(filename));
+    const auto snapshot = PopulationSnapshot::FromFile(filename);
+    ExpectSameClassifiers(classifiers, xcsr::ReadPopulationSnapshot(snapshot, XCSRRepr::kCSR));
+    EXPECT_EQ(loaded.populationSize(), classifiers.size());
+    EXPECT_EQ(snapshot.paramsHash(), xcsr::HashParams(params));
+
+    // The values mean different intervals in another representation
+    params.repr = XCSRRepr::kOBR;
+    XCSR obrSystem({ 0, 1 }, params);
+    EXPECT_THROW(obrSystem.loadPopulationBinaryFile(filename), std::invalid_argument);
+    std::remove(filename.c_str());
+}
+
+TEST(Core_PopulationSnapshotTest, InferenceModelFromBinaryFile)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::PackedXCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 11);
+
+    const std::string filename = "core_population_snapshot_test_model.bin";
+    ASSERT_TRUE(system.savePopulationBinaryFile(filename));
+    const auto mappedModel = xcs::PackedInferenceModel::FromBinaryFile(filename, { 0, 1 }, params.initialPrediction);
+    const auto convertedModel = xcs::InferenceModel::FromBinaryFile(filename, { 0, 1 }, params.initialPrediction);
+    std::remove(filename.c_str());
+
+    // The packed model reads the file in place, and the other one converts the conditions
+    EXPECT_TRUE(mappedModel.snapshot().isMapped());
+    EXPECT_FALSE(convertedModel.snapshot().isMapped());
+
+    const xcs::PackedInferenceModel model(system.population(), { 0, 1 }, params.initialPrediction);
+    ASSERT_EQ(mappedModel.size(), model.size());
+    std::vector<std::vector<int>> situations;
+    for (int bits = 0; bits < 64; ++bits)
+    {
+        std::vector<int> situation;
+        for (int i = 5; i >= 0; --i)
+        {
+            situation.push_back((bits >> i) & 1);
+        }
+        situations.push_back(situation);
+    }
+    for (const auto & situation : situations)
+    {
+        const auto expected = model.predict(situation);
+        EXPECT_EQ(mappedModel.predict(situation).predictions, expected.predictions);
+        EXPECT_EQ(convertedModel.predict(situation).predictions, expected.predictions);
+    }
+    EXPECT_EQ(mappedModel.predictBatch(situations).predictions, model.predictBatch(situations).predictions);
+    EXPECT_EQ(convertedModel.predictBatch(situations).predictions, model.predictBatch(situations).predictions);
+}
+
+TEST(Core_PopulationSnapshotTest, InvalidFile)
+{
+    xcs::XCSParams params;
+    xcs::XCS system({ 0, 1 }, params);
+    EXPECT_FALSE(system.loadPopulationBinaryFile("no_such_file.bin"));
+    EXPECT_THROW(PopulationSnapshot::FromFile("no_such_file.bin"), std::runtime_error);
+
+    // Not a snapshot
+    const std::string filename = "core_population_snapshot_test_invalid.bin";
+    {
+        std::ofstream ofs(filename);
+        ofs << "Condition,Action,prediction,epsilon,F,exp,ts,as,n,acc\n";
+    }
+    EXPECT_THROW(system.loadPopulationBinaryFile(filename), std::runtime_error);
+
+    // Truncated snapshot
+    const std::vector<xcs::Classifier> classifiers = { xcs::Classifier("0 # 1", 0, 1.0, 0.1, 0.2, 7) };
+    ASSERT_TRUE(xcs::MakePopulationSnapshot(classifiers, 0).saveFile(filename));
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 8);
+    EXPECT_THROW(PopulationSnapshot::FromFile(filename), std::runtime_error);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#include <cstdio> // std::remove
+
+using namespace xcspp;
+
+namespace
+{
+    std::string ReadFile(const std::string & filename)
+    {
+        std::ifstream ifs(filename);
+        return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    // Situations of the environment after executing the same actions
+    template <class Environment>
+    std::vector<std::vector<typename Environment::type>> Situations(Environment & env, int steps)
+    {
+        std::vector<std::vector<typename Environment::type>> situations;
+        for (int i = 0; i < steps; ++i)
+        {
+            situations.push_back(env.situation());
+            env.executeAction(i % 2);
+        }
+        return situations;
+    }
+
+    template <class Environment, class... Args>
+    void TestEnvironmentSeed(Args && ... args)
+    {
+        Environment env1(args...);
+        Environment env2(args...);
+        env1.seed(1);
+        env2.seed(1);
+        const auto situations = Situations(env1, 100);
+        EXPECT_EQ(Situations(env2, 100), situations);
+
+        // Seeding again starts over
+        env1.seed(1);
+        EXPECT_EQ(Situations(env1, 100), situations);
+
+        env2.seed(2);
+        EXPECT_NE(Situations(env2, 100), situations);
+    }
+
+    // Reward log of an experiment on the 6-bit multiplexer
+    std::string RunExperiment(const std::optional<std::uint64_t> & seed)
+    {
+        ExperimentSettings settings;
+        settings.outputFilenamePrefix = "core_seed_test_";
+        settings.outputRewardFilename = "reward.csv";
+        settings.seed = seed;
+        {
+            ExperimentHelper helper(settings);
+            helper.constructTrainEnv<MultiplexerEnvironment>(6);
+            helper.constructTestEnv<MultiplexerEnvironment>(6);
+            helper.constructSystem<xcs::XCS>(std::unordered_set<int>{ 0, 1 }, xcs::XCSParams());
+            helper.runIteration(1000);
+        }
+        const std::string log = ReadFile("core_seed_test_reward.csv");
+        std::remove("core_seed_test_reward.csv");
+        return log;
+    }
+}
+
+TEST(Core_SeedTest, SeedSequence)
+{
+    constexpr SeedSequence sequence(42);
+    static_assert(sequence.seed(0) == SeedSequence(42).seed(0));
+
+    EXPECT_NE(sequence.seed(0), sequence.seed(1));
+    EXPECT_NE(sequence.seed(0), SeedSequence(43).seed(0));
+    EXPECT_NE(sequence.child(0).masterSeed(), sequence.child(1).masterSeed());
+    EXPECT_NE(sequence.child(0).seed(0), sequence.seed(0));
+
+    // Same seed, same numbers
+    Random random1(sequence.seed(3));
+    Random random2;
+    random2.seed(sequence.seed(3));
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(random1.nextInt(0, 1000000), random2.nextInt(0, 1000000));
+    }
+}
+
+TEST(Core_SeedTest, EnvironmentSeed)
+{
+    TestEnvironmentSeed<MultiplexerEnvironment>(11);
+    TestEnvironmentSeed<EvenParityEnvironment>(10);
+    TestEnvironmentSeed<MajorityOnEnvironment>(11);
+    TestEnvironmentSeed<RealMultiplexerEnvironment>(6);
+    TestEnvironmentSeed<BlockWorldEnvironment>(std::string(XCSPP_TEST_MAZE_MAP_DIR "/woods1.txt"), 50, false, true);
+
+    BasicDataset<int> dataset(4, {}, {});
+    for (int i = 0; i < 16; ++i)
+    {
+        dataset.add(std::vector<int>{ i & 1, (i >> 1) & 1, (i >> 2) & 1, (i >> 3) & 1 }, i % 2);
+    }
+    TestEnvironmentSeed<DatasetEnvironment>(dataset, true);
+}
+
+TEST(Core_SeedTest, ExperimentHelper)
+{
+    const std::string log = RunExperiment(7);
+    EXPECT_FALSE(log.empty());
+    EXPECT_EQ(RunExperiment(7), log);
+    EXPECT_NE(RunExperiment(8), log);
+}
+
+TEST(Core_SeedTest, MultiSeedExperimentRunner)
+{
+    constexpr std::size_t kSeedCount = 4;
+
+    // The log of each seed does not depend on the number of threads
+    std::vector<std::string> logs[2];
+    const std::size_t threadCounts[2] = { 1, 3 };
+    for (int i = 0; i < 2; ++i)
+    {
+        ExperimentSettings settings;
+        settings.outputFilenamePrefix = "core_seed_test_";
+        settings.outputRewardFilename = "reward.csv";
+        settings.seed = 7;
+        {
+            MultiSeedExperimentRunner runner(settings, kSeedCount, [](ExperimentHelper & helper, std::size_t) {
+                helper.constructTrainEnv<MultiplexerEnvironment>(6);
+                helper.constructTestEnv<MultiplexerEnvironment>(6);
+                helper.constructSystem<xcs::PackedXCS>(std::unordered_set<int>{ 0, 1 }, xcs::XCSParams());
+            }, threadCounts[i]);
+            runner.runIteration(1000);
+        }
+        for (std::size_t j = 0; j < kSeedCount; ++j)
+        {
+            const std::string filename = "core_seed_test_" + SeedFilename("reward.csv", j);
+            logs[i].push_back(ReadFile(filename));
+            std::remove(filename.c_str());
+        }
+    }
+    EXPECT_EQ(logs[0], logs[1]);
+
+    // The seeds are different from each other
+    EXPECT_FALSE(logs[0][0].empty());
+    EXPECT_NE(logs[0][0], logs[0][1]);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <sstream>
+#include <memory> // std::unique_ptr, std::make_unique
+
+using namespace xcspp;
+
+namespace
+{
+    // Environment that only implements the required functions
+    class CountingEnvironment : public IEnvironment
+    {
+    private:
+        int m_count = 0;
+
+    public:
+        virtual std::vector<int> situation() const override
+        {
+            return { m_count % 2, m_count / 2 % 2, 1 };
+        }
+
+        virtual double executeAction(int) override
+        {
+            ++m_count;
+            return 0.0;
+        }
+
+        virtual bool isEndOfProblem() const override
+        {
+            return true;
+        }
+
+        virtual std::unordered_set<int> availableActions() const override
+        {
+            return { 0, 1 };
+        }
+    };
+
+    template <class Environment>
+    void ExpectSameSituation(const Environment & env)
+    {
+        const auto view = env.situationView();
+        EXPECT_EQ(std::vector<typename Environment::type>(view.begin(), view.end()), env.situation());
+    }
+
+    // Runs the same steps with vectors on a system and with views on its copy, which restores the random engine as well
+    template <class System, class Params, class Environment>
+    void ExpectSameStepsWithView(const Params & params, Environment & env)
+    {
+        System system({ 0, 1 }, params);
+        std::stringstream checkpoint;
+        system.outputCheckpoint(checkpoint);
+        System viewSystem({ 0, 1 }, params);
+        viewSystem.inputCheckpoint(checkpoint);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            const bool isExploitation = (i % 10 == 9);
+            const int action = isExploitation ? system.exploit(env.situation()) : system.explore(env.situation());
+            const int viewAction = isExploitation ? viewSystem.exploit(env.situationView()) : viewSystem.explore(env.situationView());
+            ASSERT_EQ(viewAction, action);
+            ASSERT_EQ(viewSystem.prediction(), system.prediction());
+
+            const double reward = env.executeAction(action);
+            if (!isExploitation)
+            {
+                system.reward(reward, i % 3 != 1);
+                viewSystem.reward(reward, i % 3 != 1);
+            }
+        }
+        EXPECT_EQ(viewSystem.numerositySum(), system.numerositySum());
+        EXPECT_EQ(viewSystem.populationSize(), system.populationSize());
+    }
+}
+
+TEST(Core_SituationViewTest, DefaultAdapter)
+{
+    CountingEnvironment env;
+    for (int i = 0; i < 4; ++i)
+    {
+        ExpectSameSituation(env);
+        env.executeAction(0);
+    }
+
+    // The view of the user environment is accepted by the interface of the classifier systems
+    xcs::XCSParams params;
+    params.n = 100;
+    std::unique_ptr<IClassifierSystem> system = std::make_unique<xcs::XCS>(std::unordered_set<int>{ 0, 1 }, params);
+    const int action = system->explore(env.situationView());
+    EXPECT_TRUE(action == 0 || action == 1);
+}
+
+TEST(Core_SituationViewTest, EnvironmentViews)
+{
+    MultiplexerEnvironment multiplexerEnv(6);
+    EvenParityEnvironment parityEnv(6);
+    RealMultiplexerEnvironment realMultiplexerEnv(6);
+    for (int i = 0; i < 10; ++i)
+    {
+        ExpectSameSituation(multiplexerEnv);
+        ExpectSameSituation(parityEnv);
+        ExpectSameSituation(realMultiplexerEnv);
+        multiplexerEnv.executeAction(0);
+        parityEnv.executeAction(0);
+        realMultiplexerEnv.executeAction(0);
+    }
+
+    // The real multiplexer returns a view of its own buffer
+    EXPECT_EQ(realMultiplexerEnv.situationView().data(), realMultiplexerEnv.situationView().data());
+}
+
+TEST(Core_SituationViewTest, XCSSameSteps)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    MultiplexerEnvironment env(6);
+    ExpectSameStepsWithView<xcs::XCS>(params, env);
+    ExpectSameStepsWithView<xcs::PackedXCS>(params, env);
+}
+
+TEST(Core_SituationViewTest, XCSRSameSteps)
+{
+    xcsr::XCSRParams params;
+    params.n = 400;
+    RealMultiplexerEnvironment env(6);
+    ExpectSameStepsWithView<XCSR>(params, env);
+}
+
+TEST(Core_SituationViewTest, BracedListSituations)
+{
+    // A braced list of two numbers still selects the overloads taking a vector (0 is not a null pointer for Span)
+    xcs::XCSParams params;
+    params.n = 100;
+    xcs::XCS xcs({ 0, 1 }, params);
+    const int action = xcs.explore({ 0, 1 });
+    EXPECT_TRUE(action == 0 || action == 1);
+    xcs.reward(1000.0);
+    xcs.exploit({ 0, 1 });
+
+    xcs::PackedXCS packedXCS({ 0, 1 }, params);
+    packedXCS.explore({ 0, 1 });
+    packedXCS.reward(1000.0);
+    packedXCS.exploit({ 0, 1 });
+
+    xcsr::XCSRParams realParams;
+    realParams.n = 100;
+    XCSR xcsr({ 0, 1 }, realParams);
+    xcsr.explore({ 0, 8 });
+    xcsr.reward(1000.0);
+    xcsr.exploit({ 0, 8 });
+
+    std::unique_ptr<IClassifierSystem> system = std::make_unique<xcs::XCS>(std::unordered_set<int>{ 0, 1 }, params);
+    system->explore({ 0, 1 });
+    system->reward(1000.0);
+    system->exploit({ 0, 1 });
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <sstream>
+#include <fstream>
+#include <cstdio> // std::remove
+
+using namespace xcspp;
+
+namespace
+{
+    template <typename T>
+    std::vector<std::vector<T>> Situations(const BasicDataset<T> & dataset)
+    {
+        std::vector<std::vector<T>> situations;
+        for (std::size_t i = 0; i < dataset.size(); ++i)
+        {
+            const auto situation = dataset.situation(i);
+            situations.emplace_back(situation.begin(), situation.end());
+        }
+        return situations;
+    }
+}
+
+TEST(Util_CSVTest, ReadDataset)
+{
+    std::istringstream iss("0,1,1,1\n1, 0 ,+1,0\n0,0,0,1\n\n1,1,1,1\n");
+    const auto dataset = CSV::ReadDataset<int>(iss);
+    const std::vector<std::vector<int>> expectedSituations = { { 0, 1, 1 }, { 1, 0, 1 }, { 0, 0, 0 } };
+    EXPECT_EQ(Situations(dataset), expectedSituations);
+    EXPECT_EQ(dataset.actions(), std::vector<int>({ 1, 0, 1 }));
+}
+
+TEST(Util_CSVTest, ReadRealDataset)
+{
+    // CRLF line endings and the last line without a newline
+    std::istringstream iss("0.1,0.25,1e-3,1\r\n0.7,-2.5,0.3333333333333333,0");
+    const auto dataset = CSV::ReadDataset<double>(iss);
+    const std::vector<std::vector<double>> expectedSituations = { { 0.1, 0.25, 0.001 }, { 0.7, -2.5, 0.3333333333333333 } };
+    EXPECT_EQ(Situations(dataset), expectedSituations);
+    EXPECT_EQ(dataset.actions(), std::vector<int>({ 1, 0 }));
+
+    std::istringstream roundedIss("0.4,0.6,1.5,1\n");
+    EXPECT_EQ(Situations(CSV::ReadDataset<int>(roundedIss, true)), std::vector<std::vector<int>>({ { 0, 1, 2 } }));
+}
+
+TEST(Util_CSVTest, ReadDatasetFromFile)
+{
+    const std::string filename = "util_csv_test.csv";
+    {
+        std::ofstream ofs(filename);
+        for (int i = 0; i < 1000; ++i)
+        {
+            ofs << i % 2 << ',' << i % 3 << ',' << i % 5 << '\n';
+        }
+    }
+    const auto dataset = CSV::ReadDatasetFromFile<int>(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(dataset.size(), 1000);
+    ASSERT_EQ(dataset.situationSize(), 2);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(dataset.situation(i)[0], i % 2);
+        EXPECT_EQ(dataset.situation(i)[1], i % 3);
+        EXPECT_EQ(dataset.action(i), i % 5);
+    }
+
+    EXPECT_THROW(CSV::ReadDatasetFromFile<int>("no_such_file.csv"), std::runtime_error);
+}
+
+TEST(Util_CSVTest, InvalidDataset)
+{
+    std::istringstream nonNumberIss("0,1,1\n0,a,1\n");
+    EXPECT_THROW(CSV::ReadDataset<int>(nonNumberIss), std::invalid_argument);
+
+    std::istringstream emptyFieldIss("0,,1\n");
+    EXPECT_THROW(CSV::ReadDataset<int>(emptyFieldIss), std::invalid_argument);
+
+    std::istringstream plusMinusIss("0,+-1,1\n");
+    EXPECT_THROW(CSV::ReadDataset<int>(plusMinusIss), std::invalid_argument);
+
+    std::istringstream doublePlusIss("0,++1,1\n");
+    EXPECT_THROW(CSV::ReadDataset<int>(doublePlusIss), std::invalid_argument);
+
+    std::istringstream plusOnlyIss("0,+,1\n");
+    EXPECT_THROW(CSV::ReadDataset<int>(plusOnlyIss), std::invalid_argument);
+
+    std::istringstream differentSizeIss("0,1,1\n0,1\n");
+    EXPECT_THROW(CSV::ReadDataset<int>(differentSizeIss), std::invalid_argument);
+}
+
+TEST(Util_CSVTest, PlusSign)
+{
+    std::istringstream iss("+1,-1,+0\n");
+    const auto dataset = CSV::ReadDataset<int>(iss);
+    ASSERT_EQ(dataset.size(), 1);
+    EXPECT_EQ(dataset.situation(0)[0], 1);
+    EXPECT_EQ(dataset.situation(0)[1], -1);
+    EXPECT_EQ(dataset.action(0), 0);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+TEST(Util_DatasetTest, RowMajorStorage)
+{
+    const Dataset dataset({ { 0, 1, 1 }, { 1, 0, 1 } }, { 1, 0 });
+    EXPECT_EQ(dataset.size(), 2);
+    EXPECT_EQ(dataset.situationSize(), 3);
+    EXPECT_EQ(dataset.situationValues(), std::vector<int>({ 0, 1, 1, 1, 0, 1 }));
+
+    // Rows are views of the buffer
+    const auto situation = dataset.situation(1);
+    EXPECT_EQ(situation.data(), dataset.situationValues().data() + 3);
+    EXPECT_EQ(std::vector<int>(situation.begin(), situation.end()), std::vector<int>({ 1, 0, 1 }));
+    EXPECT_EQ(dataset.action(1), 0);
+
+    Dataset addedDataset;
+    addedDataset.add(std::vector<int>{ 0, 1, 1 }, 1);
+    addedDataset.add(dataset.situation(1), 0);
+    EXPECT_EQ(addedDataset.situationValues(), dataset.situationValues());
+    EXPECT_EQ(addedDataset.actions(), dataset.actions());
+}
+
+TEST(Util_DatasetTest, InvalidDataset)
+{
+    EXPECT_THROW(Dataset({ { 0, 1 }, { 1 } }, { 1, 0 }), std::invalid_argument);
+    EXPECT_THROW(Dataset({ { 0, 1 } }, { 1, 0 }), std::invalid_argument);
+    EXPECT_THROW(Dataset(2, { 0, 1, 1 }, { 1, 0 }), std::invalid_argument);
+
+    Dataset dataset;
+    dataset.add(std::vector<int>{ 0, 1 }, 1);
+    EXPECT_THROW(dataset.add(std::vector<int>{ 0 }, 1), std::invalid_argument);
+}
+
+TEST(Util_DatasetTest, EnvironmentSituationView)
+{
+    const RealDataset dataset({ { 0.1, 0.2 }, { 0.3, 0.4 }, { 0.5, 0.6 } }, { 0, 1, 0 });
+    RealDatasetEnvironment env(dataset, false);
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        const auto view = env.situationView();
+        const auto expected = dataset.situation(i % 3);
+        EXPECT_EQ(std::vector<double>(view.begin(), view.end()), std::vector<double>(expected.begin(), expected.end()));
+        EXPECT_EQ(env.situation(), std::vector<double>(view.begin(), view.end()));
+        EXPECT_EQ(env.executeAction(dataset.action(i % 3)), 1000.0);
+    }
+}
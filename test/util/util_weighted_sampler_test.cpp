@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <numeric> // std::accumulate
+
+using namespace xcspp;
+
+namespace
+{
+    std::vector<double> SampleFrequencies(const WeightedSampler & sampler, Random & random, int trialCount)
+    {
+        std::vector<double> frequencies(sampler.size(), 0.0);
+        for (int trial = 0; trial < trialCount; ++trial)
+        {
+            frequencies[sampler.sample(random)] += 1.0 / trialCount;
+        }
+        return frequencies;
+    }
+
+    void ExpectFrequencies(const std::vector<double> & frequencies, const std::vector<double> & weights)
+    {
+        const double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+        ASSERT_EQ(frequencies.size(), weights.size());
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            if (weights[i] == 0.0)
+            {
+                EXPECT_EQ(frequencies[i], 0.0);
+            }
+            else
+            {
+                EXPECT_NEAR(frequencies[i], weights[i] / sum, 0.01);
+            }
+        }
+    }
+}
+
+TEST(Util_WeightedSamplerTest, SumTreePrefixSums)
+{
+    SumTree<int> tree;
+    std::vector<int> values;
+    for (int i = 0; i < 37; ++i)
+    {
+        tree.pushBack(i % 5);
+        values.push_back(i % 5);
+    }
+    tree.set(10, 7);
+    values[10] = 7;
+    tree.swapRemove(3);
+    values[3] = values.back();
+    values.pop_back();
+
+    int sum = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(tree.prefixSum(i), sum);
+        sum += values[i];
+    }
+    EXPECT_EQ(tree.sum(), sum);
+
+    // find() returns the smallest index whose prefix sum exceeds the value
+    for (int value = 0; value < sum; ++value)
+    {
+        const std::size_t idx = tree.find(value);
+        EXPECT_LE(tree.prefixSum(idx), value);
+        EXPECT_GT(tree.prefixSum(idx + 1), value);
+    }
+}
+
+TEST(Util_WeightedSamplerTest, SumTreeMode)
+{
+    Random random(1234);
+    std::vector<double> weights = { 1.0, 0.0, 3.0, 0.5, 2.5, 0.0, 3.0 };
+    WeightedSampler sampler(weights);
+    ExpectFrequencies(SampleFrequencies(sampler, random, 100000), weights);
+
+    // Point updates
+    sampler.set(0, 0.0);
+    weights[0] = 0.0;
+    sampler.set(5, 4.0);
+    weights[5] = 4.0;
+    sampler.pushBack(2.0);
+    weights.push_back(2.0);
+    EXPECT_DOUBLE_EQ(sampler.sum(), std::accumulate(weights.begin(), weights.end(), 0.0));
+    ExpectFrequencies(SampleFrequencies(sampler, random, 100000), weights);
+
+    sampler.popBack();
+    weights.pop_back();
+    ExpectFrequencies(SampleFrequencies(sampler, random, 100000), weights);
+}
+
+TEST(Util_WeightedSamplerTest, AliasTableMode)
+{
+    Random random(5678);
+    const std::vector<double> weights = { 1.0, 0.0, 3.0, 0.5, 2.5, 0.0, 3.0 };
+    WeightedSampler sampler(weights, WeightedSampler::Mode::kAliasTable);
+    ExpectFrequencies(SampleFrequencies(sampler, random, 100000), weights);
+
+    EXPECT_THROW(sampler.set(0, 1.0), std::logic_error);
+    EXPECT_THROW(sampler.pushBack(1.0), std::logic_error);
+
+    const std::vector<double> newWeights = { 0.0, 2.0, 1.0 };
+    sampler.assign(newWeights);
+    ExpectFrequencies(SampleFrequencies(sampler, random, 100000), newWeights);
+}
+
+TEST(Util_WeightedSamplerTest, InvalidWeights)
+{
+    Random random(9012);
+    EXPECT_THROW(WeightedSampler({ 1.0, -1.0 }), std::invalid_argument);
+
+    WeightedSampler sampler({ 0.0, 0.0 });
+    EXPECT_THROW(sampler.sample(random), std::runtime_error);
+    EXPECT_THROW(sampler.set(2, 1.0), std::out_of_range);
+
+    WeightedSampler emptySampler;
+    EXPECT_THROW(emptySampler.sample(random), std::runtime_error);
+}
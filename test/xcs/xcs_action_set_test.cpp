@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <cmath>
+
+using namespace xcspp;
+
+namespace
+{
+    xcs::Classifier MakeClassifier(const std::string & condition, int action, double prediction, double epsilon, double fitness)
+    {
+        return xcs::Classifier(condition, action, prediction, epsilon, fitness, 0);
+    }
+
+    const std::vector<xcs::Classifier> & TestClassifiers()
+    {
+        static const std::vector<xcs::Classifier> classifiers = {
+            MakeClassifier("0 # #", 2, 100.0, 5.0, 0.5),
+            MakeClassifier("# 1 #", 0, 300.0, 20.0, 0.2),
+            MakeClassifier("0 1 #", 2, 400.0, 0.0, 0.25),
+            MakeClassifier("# # 1", 3, 900.0, 50.0, 0.1),
+            MakeClassifier("1 # #", 1, 1000.0, 1.0, 0.9),
+            MakeClassifier("# 1 1", 0, 500.0, 15.0, 0.6),
+            MakeClassifier("# # #", 2, 200.0, 30.0, 0.3),
+        };
+        return classifiers;
+    }
+}
+
+TEST(XCS_ActionSetTest, PartitionedGenerationMatchesFiltering)
+{
+    xcs::XCSParams params;
+    params.thetaMna = 1;
+    const std::unordered_set<int> actions = { 0, 1, 2, 3 };
+    const AvailableActions availableActions(actions);
+    xcs::Population population(TestClassifiers(), &params, actions);
+
+    Random random(1);
+    xcs::MatchSet matchSet(&params, availableActions);
+    xcs::ActionSet partitioned(&params, availableActions);
+    xcs::ActionSet filtered(&params, availableActions);
+    for (const auto & situation : std::vector<std::vector<int>>{ { 0, 1, 1 }, { 1, 1, 0 }, { 0, 0, 1 }, { 0, 1, 0 } })
+    {
+        matchSet.generateSet(population, situation, 0, random);
+        const std::size_t matchSetSize = matchSet.size();
+        for (const auto & action : availableActions)
+        {
+            partitioned.generateSet(matchSet, action);
+            filtered.generateSet(static_cast<const xcs::MatchSet &>(matchSet), action);
+
+            ASSERT_EQ(partitioned.size(), filtered.size());
+            EXPECT_TRUE(std::equal(partitioned.begin(), partitioned.end(), filtered.begin()));
+
+            // [M] itself is not changed
+            EXPECT_EQ(matchSet.size(), matchSetSize);
+        }
+
+        // The partition has been consumed, so [A] is generated by filtering [M]
+        partitioned.generateSet(matchSet, 2);
+        filtered.generateSet(static_cast<const xcs::MatchSet &>(matchSet), 2);
+        ASSERT_EQ(partitioned.size(), filtered.size());
+        EXPECT_TRUE(std::equal(partitioned.begin(), partitioned.end(), filtered.begin()));
+    }
+}
+
+TEST(XCS_ActionSetTest, FusedUpdateMatchesReference)
+{
+    xcs::XCSParams params;
+    params.thetaMna = 1;
+    params.doActionSetSubsumption = false;
+    const std::unordered_set<int> actions = { 0, 1, 2, 3 };
+    const AvailableActions availableActions(actions);
+    xcs::Population population(TestClassifiers(), &params, actions);
+
+    Random random(1);
+    const std::vector<int> situation = { 0, 1, 1 };
+    xcs::MatchSet matchSet(population, situation, 0, &params, availableActions, random);
+    xcs::ActionSet actionSet(matchSet, 2, &params, availableActions);
+    ASSERT_EQ(actionSet.size(), 3u);
+
+    // Reference: the original two-pass update
+    std::vector<xcs::StoredClassifier> expected;
+    for (const auto & cl : actionSet)
+    {
+        expected.push_back(*cl);
+    }
+    const double p = 600.0;
+    std::uint64_t numerositySum = 0;
+    for (const auto & cl : expected)
+    {
+        numerositySum += cl.numerosity;
+    }
+    for (auto & cl : expected)
+    {
+        ++cl.experience;
+        cl.epsilon += (std::abs(p - cl.prediction) - cl.epsilon) / cl.experience;
+        cl.prediction += (p - cl.prediction) / cl.experience;
+        cl.updateAccuracy();
+        cl.actionSetSize += (numerositySum - cl.actionSetSize) / cl.experience;
+    }
+    double accuracySum = 0.0;
+    for (const auto & cl : expected)
+    {
+        accuracySum += cl.accuracy() * cl.numerosity;
+    }
+    for (auto & cl : expected)
+    {
+        cl.fitness += params.beta * (cl.accuracy() * cl.numerosity / accuracySum - cl.fitness);
+    }
+
+    actionSet.update(p, population);
+
+    std::size_t i = 0;
+    for (const auto & cl : actionSet)
+    {
+        EXPECT_EQ(cl->experience, expected[i].experience);
+        EXPECT_DOUBLE_EQ(cl->epsilon, expected[i].epsilon);
+        EXPECT_DOUBLE_EQ(cl->prediction, expected[i].prediction);
+        EXPECT_DOUBLE_EQ(cl->actionSetSize, expected[i].actionSetSize);
+        EXPECT_DOUBLE_EQ(cl->fitness, expected[i].fitness);
+        ++i;
+    }
+
+    // The running aggregates of [P] reflect the updated fitness
+    EXPECT_NO_THROW(population.validateAggregates());
+}
+
+TEST(XCS_ActionSetTest, RunGASkipsSetWithAllClassifiersDeleted)
+{
+    xcs::XCSParams params;
+    params.thetaMna = 1;
+    const std::unordered_set<int> actions = { 0, 1, 2, 3 };
+    const AvailableActions availableActions(actions);
+    xcs::Population population(TestClassifiers(), &params, actions);
+
+    Random random(1);
+    const std::vector<int> situation = { 1, 0, 0 };
+    xcs::MatchSet matchSet(population, situation, 0, &params, availableActions, random);
+    xcs::ActionSet actionSet(matchSet, 1, &params, availableActions);
+    ASSERT_EQ(actionSet.size(), 1u);
+
+    // The classifiers of [A]_-1 can be deleted from [P] before the GA is applied in multi-step problems
+    EXPECT_EQ(population.erase(*actionSet.begin()), 1u);
+    const std::size_t populationSize = population.size();
+    EXPECT_NO_THROW(actionSet.runGA(situation, population, 100, random));
+    EXPECT_EQ(actionSet.size(), 0u);
+    EXPECT_EQ(population.size(), populationSize);
+}
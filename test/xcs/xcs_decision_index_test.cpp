@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+namespace
+{
+    std::vector<std::size_t> LinearScan(const std::vector<xcs::Classifier> & classifiers, const std::vector<int> & situation)
+    {
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < classifiers.size(); ++i)
+        {
+            if (classifiers[i].condition.matches(situation))
+            {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+
+    std::vector<int> RandomSituation(std::size_t length, int maxValue, Random & random)
+    {
+        std::vector<int> situation(length);
+        for (auto & s : situation)
+        {
+            s = random.nextInt(0, maxValue);
+        }
+        return situation;
+    }
+}
+
+TEST(XCS_DecisionIndexTest, SameAsLinearScan)
+{
+    Random random(3);
+    for (const int maxValue : { 1, 3 })
+    {
+        for (const double dontCareProbability : { 0.3, 0.7, 0.95 })
+        {
+            std::vector<xcs::Classifier> classifiers;
+            for (int i = 0; i < 2000; ++i)
+            {
+                std::vector<xcs::Symbol> symbols;
+                for (int j = 0; j < 12; ++j)
+                {
+                    symbols.emplace_back(random.nextInt(0, maxValue));
+                    if (random.nextDouble() < dontCareProbability)
+                    {
+                        symbols.back().setToDontCare();
+                    }
+                }
+                classifiers.emplace_back(xcs::Condition(symbols), random.nextInt(0, 1), 0.0, 0.0, 0.0, 0);
+            }
+
+            const xcs::DecisionIndex index(classifiers);
+            EXPECT_LT(index.nodeCount(), classifiers.size());
+
+            std::vector<std::size_t> indices;
+            for (int i = 0; i < 500; ++i)
+            {
+                const auto situation = RandomSituation(12, maxValue, random);
+                index.findMatching(situation, indices);
+                EXPECT_EQ(indices, LinearScan(classifiers, situation));
+            }
+        }
+    }
+}
+
+TEST(XCS_DecisionIndexTest, SameAsGetMatchingClassifiers)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::XCS system({ 0, 1 }, params);
+    Random random(7);
+    for (int i = 0; i < 2000; ++i)
+    {
+        const auto situation = RandomSituation(6, 1, random);
+        const int action = system.explore(situation);
+        system.reward((action == situation[2 + situation[0] * 2 + situation[1]]) ? 1000.0 : 0.0);
+    }
+
+    const xcs::DecisionIndex index(system.population(), 4);
+    for (int bits = 0; bits < 64; ++bits)
+    {
+        std::vector<int> situation;
+        for (int i = 5; i >= 0; --i)
+        {
+            situation.push_back((bits >> i) & 1);
+        }
+
+        const auto expected = system.getMatchingClassifiers(situation);
+        const auto actual = index.getMatchingClassifiers(situation);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i)
+        {
+            EXPECT_EQ(actual[i].condition.toString(), expected[i].condition.toString());
+            EXPECT_EQ(actual[i].action, expected[i].action);
+            EXPECT_EQ(actual[i].prediction, expected[i].prediction);
+        }
+    }
+}
+
+TEST(XCS_DecisionIndexTest, InvalidInput)
+{
+    const std::vector<xcs::Classifier> classifiers = {
+        xcs::Classifier("0 1 #", 0, 0.0, 0.0, 0.0, 0),
+        xcs::Classifier("0 1", 0, 0.0, 0.0, 0.0, 0),
+    };
+    EXPECT_THROW(xcs::DecisionIndex index(classifiers), std::invalid_argument);
+
+    const xcs::DecisionIndex index(std::vector<xcs::Classifier>{ classifiers[0] });
+    EXPECT_THROW(index.findMatching({ 0, 1 }), std::invalid_argument);
+
+    const xcs::DecisionIndex emptyIndex(std::vector<xcs::Classifier>{});
+    EXPECT_TRUE(emptyIndex.findMatching({ 0, 1 }).empty());
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <thread>
+
+#include "common/multiplexer_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    // Situations of the 6-bit multiplexer in more than one tile
+    std::vector<std::vector<int>> AllSituations()
+    {
+        auto situations = AllMultiplexerSituations();
+        const auto copy = situations;
+        situations.insert(situations.end(), copy.begin(), copy.end());
+        return situations;
+    }
+
+    // Classifier system that implements only the pure virtual functions of IClassifierSystem
+    class MinimalClassifierSystem : public IClassifierSystem
+    {
+    private:
+        xcs::XCS m_system;
+
+    public:
+        MinimalClassifierSystem(const std::unordered_set<int> & availableActions, const xcs::XCSParams & params)
+            : m_system(availableActions, params)
+        {
+        }
+
+        using IClassifierSystem::explore;
+        using IClassifierSystem::exploit;
+
+        virtual int explore(const std::vector<int> & situation) override
+        {
+            return m_system.explore(situation);
+        }
+
+        virtual void reward(double value, bool isEndOfProblem = true) override
+        {
+            m_system.reward(value, isEndOfProblem);
+        }
+
+        virtual int exploit(const std::vector<int> & situation, bool update = false) override
+        {
+            return m_system.exploit(situation, update);
+        }
+
+        virtual ExploitBatchResult exploitBatch(const std::vector<std::vector<int>> & situations) const override
+        {
+            return m_system.exploitBatch(situations);
+        }
+
+        virtual double prediction() const override
+        {
+            return m_system.prediction();
+        }
+
+        virtual double predictionFor(int action) const override
+        {
+            return m_system.predictionFor(action);
+        }
+
+        virtual bool isCoveringPerformed() const override
+        {
+            return m_system.isCoveringPerformed();
+        }
+
+        virtual void outputPopulationCSV(std::ostream & os) const override
+        {
+            m_system.outputPopulationCSV(os);
+        }
+
+        virtual bool loadPopulationCSVFile(const std::string & filename, bool initClassifierVariables = false, bool syncTimeStamp = true) override
+        {
+            return m_system.loadPopulationCSVFile(filename, initClassifierVariables, syncTimeStamp);
+        }
+
+        virtual bool savePopulationCSVFile(const std::string & filename) const override
+        {
+            return m_system.savePopulationCSVFile(filename);
+        }
+
+        virtual std::size_t populationSize() const override
+        {
+            return m_system.populationSize();
+        }
+
+        virtual std::size_t numerositySum() const override
+        {
+            return m_system.numerositySum();
+        }
+
+        virtual void switchToCondensationMode() override
+        {
+            m_system.switchToCondensationMode();
+        }
+    };
+
+    template <class System>
+    void ExpectSameAsExploit(System & system)
+    {
+        const std::unordered_set<int> actions = { 0, 1 };
+        const auto situations = AllSituations();
+        const ExploitBatchResult result = system.exploitBatch(situations);
+        ASSERT_EQ(result.size(), situations.size());
+        ASSERT_EQ(result.actionChoices, std::vector<int>({ 0, 1 }));
+
+        for (std::size_t i = 0; i < situations.size(); ++i)
+        {
+            const int action = system.exploit(situations[i]);
+            EXPECT_EQ(result.isMatchSetEmpty[i], system.isCoveringPerformed());
+            for (const auto & a : actions)
+            {
+                EXPECT_EQ(result.predictionFor(i, a), system.predictionFor(a));
+            }
+
+            // The actions differ only if exploit() has broken a tie at random
+            if (result.predictionFor(i, 0) != result.predictionFor(i, 1))
+            {
+                EXPECT_EQ(result.actions[i], action);
+            }
+        }
+    }
+}
+
+TEST(XCS_ExploitBatchTest, SameAsExploit)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::XCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+    ExpectSameAsExploit(system);
+}
+
+TEST(XCS_ExploitBatchTest, DefaultImplementations)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    MinimalClassifierSystem system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+    ExpectSameAsExploit(system);
+
+    // The default implementations of the other functions added to IClassifierSystem
+    EXPECT_EQ(system.matchSetCacheStatistics().lookupCount, 0);
+    EXPECT_THROW(system.seed(1), std::domain_error);
+    EXPECT_THROW(system.saveCheckpointFile("checkpoint.bin"), std::domain_error);
+    EXPECT_THROW(system.savePopulationBinaryFile("population.bin"), std::domain_error);
+}
+
+TEST(XCS_ExploitBatchTest, PackedSameAsExploit)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::PackedXCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+    ExpectSameAsExploit(system);
+}
+
+TEST(XCS_ExploitBatchTest, ConcurrentCalls)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::PackedXCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+
+    const auto situations = AllSituations();
+    const ExploitBatchResult expected = system.exploitBatch(situations);
+
+    std::vector<ExploitBatchResult> results(4);
+    std::vector<std::thread> threads;
+    for (auto & result : results)
+    {
+        threads.emplace_back([&system, &situations, &result]() { result = system.exploitBatch(situations); });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto & result : results)
+    {
+        EXPECT_EQ(result.actions, expected.actions);
+        EXPECT_EQ(result.predictions, expected.predictions);
+    }
+}
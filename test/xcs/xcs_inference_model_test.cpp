@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <cstdio> // std::remove
+#include <thread>
+
+#include "common/multiplexer_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    template <class Model>
+    void ExpectSameAsBatch(const Model & model, const ExploitBatchResult & expected, const std::vector<std::vector<int>> & situations)
+    {
+        ASSERT_EQ(model.actionChoices(), expected.actionChoices);
+        for (std::size_t i = 0; i < situations.size(); ++i)
+        {
+            const xcs::InferenceResult result = model.predict(situations[i]);
+            EXPECT_EQ(result.action, expected.actions[i]);
+            EXPECT_EQ(result.isMatchSetEmpty, expected.isMatchSetEmpty[i]);
+            EXPECT_EQ(result.prediction, expected.predictionFor(i, result.action));
+            for (std::size_t col = 0; col < model.actionChoices().size(); ++col)
+            {
+                EXPECT_EQ(result.predictions[col], expected.predictions[i * model.actionChoices().size() + col]);
+            }
+        }
+    }
+}
+
+TEST(XCS_InferenceModelTest, SameAsExploitBatch)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::XCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+
+    const xcs::InferenceModel model(system.population(), { 0, 1 }, params.initialPrediction);
+    ASSERT_EQ(model.size(), system.populationSize());
+
+    const auto situations = AllMultiplexerSituations();
+    const ExploitBatchResult expected = system.exploitBatch(situations);
+    ExpectSameAsBatch(model, expected, situations);
+    EXPECT_EQ(model.predictBatch(situations).predictions, expected.predictions);
+}
+
+TEST(XCS_InferenceModelTest, PackedSameAsExploitBatch)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::PackedXCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+
+    const xcs::PackedInferenceModel model(system.population(), { 0, 1 }, params.initialPrediction);
+    const auto situations = AllMultiplexerSituations();
+    ExpectSameAsBatch(model, system.exploitBatch(situations), situations);
+}
+
+TEST(XCS_InferenceModelTest, EmptyMatchSet)
+{
+    const xcs::InferenceModel model(std::vector<xcs::Classifier>{ xcs::Classifier("1 1 1", 1, 500.0, 0.0, 1.0, 0) }, { 0, 1 }, 10.0);
+
+    const xcs::InferenceResult result = model.predict({ 0, 0, 0 });
+    EXPECT_TRUE(result.isMatchSetEmpty);
+    EXPECT_EQ(result.action, 0);
+    EXPECT_EQ(result.prediction, 10.0);
+    EXPECT_EQ(result.predictions, std::vector<double>({ 10.0, 10.0 }));
+
+    const xcs::InferenceResult matched = model.predict({ 1, 1, 1 });
+    EXPECT_FALSE(matched.isMatchSetEmpty);
+    EXPECT_EQ(matched.action, 1);
+    EXPECT_EQ(matched.predictions, std::vector<double>({ 0.0, 500.0 }));
+}
+
+TEST(XCS_InferenceModelTest, FromCSVFile)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::XCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+
+    const std::string filename = "xcs_inference_model_test_population.csv";
+    ASSERT_TRUE(system.savePopulationCSVFile(filename));
+    const auto model = xcs::PackedInferenceModel::FromCSVFile(filename, { 0, 1 }, params.initialPrediction);
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(model.size(), system.populationSize());
+    for (const auto & situation : AllMultiplexerSituations())
+    {
+        const auto result = model.predict(situation);
+        EXPECT_EQ(result.isMatchSetEmpty, system.getMatchingClassifiers(situation).empty());
+    }
+
+    EXPECT_THROW(xcs::InferenceModel::FromCSVFile("no_such_file.csv", { 0, 1 }, 0.0), std::runtime_error);
+}
+
+TEST(XCS_InferenceModelTest, ConcurrentPredict)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    xcs::PackedXCS system({ 0, 1 }, params);
+    TrainOnMultiplexer(system, 3000, 7);
+
+    const xcs::PackedInferenceModel model(system.population(), { 0, 1 }, params.initialPrediction);
+    const auto situations = AllMultiplexerSituations();
+    const ExploitBatchResult expected = model.predictBatch(situations);
+
+    std::vector<std::vector<int>> actions(4);
+    std::vector<std::thread> threads;
+    for (auto & threadActions : actions)
+    {
+        threads.emplace_back([&model, &situations, &threadActions]() {
+            for (int repeat = 0; repeat < 20; ++repeat)
+            {
+                threadActions.clear();
+                for (const auto & situation : situations)
+                {
+                    threadActions.push_back(model.predict(situation).action);
+                }
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto & threadActions : actions)
+    {
+        EXPECT_EQ(threadActions, expected.actions);
+    }
+}
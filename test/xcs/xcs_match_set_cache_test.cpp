@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+
+#include "common/random_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    template <class Population>
+    std::vector<const typename Population::StoredClassifierType *> MatchingClassifiers(Population & population, const typename Population::SituationType & situation)
+    {
+        std::vector<const typename Population::StoredClassifierType *> classifiers;
+        population.forEachMatchingClassifier(situation, [&classifiers](const auto & cl) {
+            classifiers.push_back(cl.get());
+        });
+        return classifiers;
+    }
+
+    // Applies the same random changes to [P] with and without the cache and compares [M]
+    template <class Condition>
+    void TestConsistentWithScan()
+    {
+        using Population = xcs::BasicPopulation<Condition>;
+        using SituationType = typename Population::SituationType;
+
+        const std::unordered_set<int> availableActions = { 0, 1 };
+        const std::size_t length = 6;
+        Random random(12345);
+
+        xcs::XCSParams scanParams;
+        scanParams.n = 150;
+        xcs::XCSParams cacheParams = scanParams;
+        cacheParams.matchSetCacheCapacity = 8; // smaller than the number of the situations below
+
+        std::vector<xcs::BasicClassifier<Condition>> classifiers;
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            classifiers.emplace_back(Condition(RandomTernarySymbols(length, 0.7, random)), random.nextInt(0, 1), 0.01, 0.01, 0.01, 0);
+        }
+        Population scanPopulation(classifiers, &scanParams, availableActions);
+        Population cachePopulation(classifiers, &cacheParams, availableActions);
+
+        std::vector<SituationType> situations;
+        for (int i = 0; i < 12; ++i)
+        {
+            situations.emplace_back(RandomSituation<int>(length, random));
+        }
+
+        for (int step = 0; step < 2000; ++step)
+        {
+            const double r = random.nextDouble();
+            if (r < 0.3)
+            {
+                const Condition condition(RandomTernarySymbols(length, 0.7, random));
+                const int action = random.nextInt(0, 1);
+                scanPopulation.insertOrIncrementNumerosity(xcs::BasicClassifier<Condition>(condition, action, 0.01, 0.01, 0.01, 0));
+                cachePopulation.insertOrIncrementNumerosity(xcs::BasicClassifier<Condition>(condition, action, 0.01, 0.01, 0.01, 0));
+
+                // Deletion uses the same random numbers for both
+                Random scanRandom(step);
+                Random cacheRandom(step);
+                scanPopulation.deleteExtraClassifiers(scanRandom);
+                cachePopulation.deleteExtraClassifiers(cacheRandom);
+            }
+            else if (r < 0.5 && !scanPopulation.empty())
+            {
+                const auto idx = random.nextInt<std::size_t>(0, scanPopulation.size() - 1);
+                EXPECT_EQ(scanPopulation.erase(scanPopulation.ptrAt(idx)), 1);
+                EXPECT_EQ(cachePopulation.erase(cachePopulation.ptrAt(idx)), 1);
+            }
+            ASSERT_EQ(scanPopulation.size(), cachePopulation.size());
+
+            // Same classifiers in the same order
+            const auto & situation = situations[random.nextInt<std::size_t>(0, situations.size() - 1)];
+            const auto expected = MatchingClassifiers(scanPopulation, situation);
+            const auto matched = MatchingClassifiers(cachePopulation, situation);
+            ASSERT_EQ(matched.size(), expected.size());
+            for (std::size_t i = 0; i < matched.size(); ++i)
+            {
+                EXPECT_EQ(matched[i]->condition, expected[i]->condition);
+                EXPECT_EQ(matched[i]->action, expected[i]->action);
+            }
+        }
+
+        EXPECT_EQ(scanPopulation.matchSetCacheStatistics().lookupCount, 0);
+        const auto & statistics = cachePopulation.matchSetCacheStatistics();
+        EXPECT_EQ(statistics.lookupCount, 2000);
+        EXPECT_GT(statistics.hitCount, 0);
+        EXPECT_LT(statistics.hitCount, statistics.lookupCount);
+    }
+}
+
+TEST(XCS_MatchSetCacheTest, PopulationConsistentWithScan)
+{
+    TestConsistentWithScan<xcs::Condition>();
+}
+
+TEST(XCS_MatchSetCacheTest, PackedPopulationConsistentWithScan)
+{
+    TestConsistentWithScan<xcs::PackedCondition>();
+}
+
+TEST(XCS_MatchSetCacheTest, EvictsLeastRecentlyUsed)
+{
+    MatchSetCache<std::vector<int>> cache(2);
+    EXPECT_TRUE(cache.enabled());
+
+    EXPECT_EQ(cache.find({ 0 }), nullptr);
+    cache.emplace({ 0 }) = { 1, 3 };
+    EXPECT_EQ(cache.find({ 1 }), nullptr);
+    cache.emplace({ 1 }) = { 2 };
+
+    ASSERT_NE(cache.find({ 0 }), nullptr);
+    EXPECT_EQ(cache.find({ 2 }), nullptr);
+    cache.emplace({ 2 }) = {}; // evicts { 1 }
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.find({ 1 }), nullptr);
+    ASSERT_NE(cache.find({ 0 }), nullptr);
+    EXPECT_EQ(*cache.find({ 0 }), (std::vector<std::size_t>{ 1, 3 }));
+
+    // Insert at the position 4 a classifier that matches { 2 } only, and move it to the position 1
+    cache.notifyInsert(4, [](const std::vector<int> & situation) { return situation[0] == 2; });
+    cache.notifySwapRemove(1, 4);
+    EXPECT_EQ(*cache.find({ 0 }), (std::vector<std::size_t>{ 3 }));
+    EXPECT_EQ(*cache.find({ 2 }), (std::vector<std::size_t>{ 1 }));
+
+    const auto & statistics = cache.statistics();
+    EXPECT_EQ(statistics.lookupCount, 9);
+    EXPECT_EQ(statistics.hitCount, 5);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.find({ 0 }), nullptr);
+    EXPECT_EQ(cache.statistics().lookupCount, 10);
+}
+
+TEST(XCS_MatchSetCacheTest, SystemReportsStatistics)
+{
+    xcs::XCSParams params;
+    params.n = 400;
+    params.matchSetCacheCapacity = 64;
+    xcs::XCS xcs({ 0, 1 }, params);
+
+    // 6-bit multiplexer (64 distinct situations)
+    Random random(2468);
+    for (int i = 0; i < 3000; ++i)
+    {
+        const auto situation = RandomSituation<int>(6, random);
+        const int action = xcs.explore(situation);
+        xcs.reward(action == situation[2 + situation[0] * 2 + situation[1]] ? 1000.0 : 0.0);
+    }
+
+    const auto statistics = xcs.matchSetCacheStatistics();
+    EXPECT_GE(statistics.lookupCount, 3000);
+    EXPECT_GT(statistics.hitRate(), 0.9);
+}
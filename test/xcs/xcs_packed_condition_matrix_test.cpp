@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+
+#include "common/random_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    std::vector<xcs::PackedConditionMatrix::Kernel> SupportedKernels()
+    {
+        std::vector<xcs::PackedConditionMatrix::Kernel> kernels;
+        for (const auto kernel : { xcs::PackedConditionMatrix::Kernel::kScalar, xcs::PackedConditionMatrix::Kernel::kSSE2, xcs::PackedConditionMatrix::Kernel::kAVX2 })
+        {
+            if (xcs::PackedConditionMatrix::IsKernelSupported(kernel))
+            {
+                kernels.push_back(kernel);
+            }
+        }
+        return kernels;
+    }
+
+    bool BitmapTest(const std::vector<std::uint64_t> & bitmap, std::size_t idx)
+    {
+        return (bitmap[idx / 64] >> (idx % 64)) & 1;
+    }
+}
+
+TEST(XCS_PackedConditionMatrixTest, KernelsConsistentWithScalar)
+{
+    Random random(12345);
+    for (const std::size_t length : { 1, 6, 11, 63, 64, 65, 128, 135 })
+    {
+        for (const std::size_t rowCount : { 0, 1, 3, 4, 5, 63, 64, 65, 200 })
+        {
+            std::vector<xcs::PackedCondition> conditions;
+            xcs::PackedConditionMatrix matrix;
+            for (std::size_t i = 0; i < rowCount; ++i)
+            {
+                conditions.push_back(xcs::PackedCondition(RandomTernarySymbols(length, 0.9, random)));
+                matrix.pushBack(conditions.back());
+            }
+
+            // Remove some rows in the same way as the matrix
+            for (std::size_t i = 0; i < rowCount / 3; ++i)
+            {
+                const auto rowIdx = random.nextInt<std::size_t>(0, conditions.size() - 1);
+                matrix.swapRemove(rowIdx);
+                conditions[rowIdx] = conditions.back();
+                conditions.pop_back();
+            }
+            ASSERT_EQ(matrix.size(), conditions.size());
+
+            for (int trial = 0; trial < 10; ++trial)
+            {
+                const auto situation = RandomSituation<int>(length, random);
+                const xcs::PackedSituation packedSituation(situation);
+
+                for (const auto kernel : SupportedKernels())
+                {
+                    matrix.setKernel(kernel);
+                    std::vector<std::uint64_t> bitmap;
+                    matrix.match(packedSituation, bitmap);
+                    ASSERT_EQ(bitmap.size(), (conditions.size() + 63) / 64);
+
+                    for (std::size_t i = 0; i < conditions.size(); ++i)
+                    {
+                        EXPECT_EQ(BitmapTest(bitmap, i), conditions[i].matches(situation));
+                    }
+
+                    // Padding bits are never set
+                    for (std::size_t i = conditions.size(); i < bitmap.size() * 64; ++i)
+                    {
+                        EXPECT_FALSE(BitmapTest(bitmap, i));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(XCS_PackedConditionMatrixTest, RejectDifferentLength)
+{
+    xcs::PackedConditionMatrix matrix;
+    matrix.pushBack(xcs::PackedCondition("0 1 # #"));
+    EXPECT_THROW(matrix.pushBack(xcs::PackedCondition("0 1 #")), std::invalid_argument);
+
+    std::vector<std::uint64_t> bitmap;
+    EXPECT_THROW(matrix.match(xcs::PackedSituation(std::vector<int>{ 0, 1, 0 }), bitmap), std::invalid_argument);
+}
+
+TEST(XCS_PackedConditionMatrixTest, PopulationScanConsistentWithMatches)
+{
+    const xcs::XCSParams params;
+    const std::unordered_set<int> availableActions = { 0, 1 };
+    Random random(54321);
+    const std::size_t length = 70;
+
+    std::vector<xcs::PackedClassifier> classifiers;
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        classifiers.emplace_back(xcs::PackedCondition(RandomTernarySymbols(length, 0.9, random)), random.nextInt(0, 1), params.initialPrediction, params.initialEpsilon, params.initialFitness, 0);
+    }
+    xcs::PackedPopulation population(classifiers, &params, availableActions);
+
+    // Erase some classifiers so that rows are moved
+    std::vector<xcs::PackedClassifierPtr> erased;
+    for (std::size_t i = 0; i < population.size(); ++i)
+    {
+        if (random.nextDouble() < 0.3)
+        {
+            erased.push_back(population.ptrAt(i));
+        }
+    }
+    for (const auto & cl : erased)
+    {
+        EXPECT_EQ(population.erase(cl), 1);
+    }
+
+    for (const auto kernel : SupportedKernels())
+    {
+        population.setMatchKernel(kernel);
+        for (int trial = 0; trial < 20; ++trial)
+        {
+            const xcs::PackedSituation situation(RandomSituation<int>(length, random));
+            std::unordered_set<const xcs::PackedStoredClassifier *> matched;
+            population.forEachMatchingClassifier(situation, [&matched](const auto & cl) {
+                matched.insert(cl.get());
+            });
+
+            std::unordered_set<const xcs::PackedStoredClassifier *> expected;
+            for (const auto & cl : population)
+            {
+                if (cl.condition.matches(situation))
+                {
+                    expected.insert(&cl);
+                }
+            }
+            EXPECT_EQ(matched, expected);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+
+using namespace xcspp;
+
+TEST(XCS_PackedConditionTest, ConstructWithString)
+{
+    const xcs::PackedCondition cond("0 1 # #");
+    EXPECT_TRUE(cond.matches({ 0, 1, 0, 0 }));
+    EXPECT_TRUE(cond.matches({ 0, 1, 0, 1 }));
+    EXPECT_TRUE(cond.matches({ 0, 1, 1, 0 }));
+    EXPECT_TRUE(cond.matches({ 0, 1, 1, 1 }));
+    EXPECT_FALSE(cond.matches({ 0, 0, 1, 1 }));
+    EXPECT_FALSE(cond.matches({ 1, 1, 1, 1 }));
+    EXPECT_FALSE(cond.matches({ 1, 0, 1, 1 }));
+    EXPECT_EQ(cond.dontCareCount(), 2);
+}
+
+TEST(XCS_PackedConditionTest, RejectNonBinarySymbol)
+{
+    EXPECT_THROW(xcs::PackedCondition("0 2 # #"), std::invalid_argument);
+}
+
+TEST(XCS_PackedConditionTest, ConsistentWithCondition)
+{
+    // Compare with xcs::Condition across word boundaries (length 1-130)
+    Random random(12345);
+    for (std::size_t length = 1; length <= 130; ++length)
+    {
+        std::vector<xcs::Symbol> symbols1, symbols2;
+        std::vector<int> situation;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            symbols1.push_back(random.nextDouble() < 0.5 ? xcs::Symbol('#') : xcs::Symbol(random.nextInt(0, 1)));
+            symbols2.push_back(random.nextDouble() < 0.1 ? xcs::Symbol('#') : symbols1.back());
+            situation.push_back(symbols1.back().isDontCare() ? random.nextInt(0, 1) : symbols1.back().value());
+        }
+        if (random.nextDouble() < 0.5)
+        {
+            situation[random.nextInt<std::size_t>(0, length - 1)] ^= 1;
+        }
+
+        const xcs::Condition cond1(symbols1), cond2(symbols2);
+        const xcs::PackedCondition packedCond1(symbols1), packedCond2(symbols2);
+        EXPECT_EQ(cond1.matches(situation), packedCond1.matches(situation));
+        EXPECT_EQ(cond1.matches(situation), packedCond1.matches(xcs::PackedSituation(situation)));
+        EXPECT_EQ(cond1.isMoreGeneral(cond2), packedCond1.isMoreGeneral(packedCond2));
+        EXPECT_EQ(cond2.isMoreGeneral(cond1), packedCond2.isMoreGeneral(packedCond1));
+        EXPECT_EQ(cond1.dontCareCount(), packedCond1.dontCareCount());
+        EXPECT_EQ(cond1.toString(), packedCond1.toString());
+        EXPECT_EQ(cond1 == cond2, packedCond1 == packedCond2);
+    }
+}
+
+TEST(XCS_PackedConditionTest, PackedSituation)
+{
+    const std::vector<int> situationVec = { 0, 1, 1, 0, 1 };
+    const xcs::PackedSituation situation(situationVec);
+    EXPECT_EQ(situation.size(), 5);
+    EXPECT_EQ(situation.toVector(), situationVec);
+    EXPECT_THROW(xcs::PackedSituation({ 0, 2 }), std::invalid_argument);
+
+    // Covering condition built from the situation
+    const xcs::PackedCondition cond(situation);
+    EXPECT_EQ(cond.toString(), "0 1 1 0 1");
+    EXPECT_EQ(cond.dontCareCount(), 0);
+    EXPECT_TRUE(cond.matches(situation));
+    EXPECT_FALSE(xcs::PackedCondition("0 1 1 0 0").matches(situation));
+    EXPECT_TRUE(xcs::PackedCondition("# 1 # # #").matches(situation));
+}
+
+TEST(XCS_PackedConditionTest, IsMoreGeneral)
+{
+    const xcs::PackedCondition cond1("0 1 # #");
+    const xcs::PackedCondition cond2("0 1 # 1");
+    const xcs::PackedCondition cond3("1 1 # #");
+    const xcs::PackedCondition allDontCare("# # # #");
+
+    EXPECT_FALSE(cond1.isMoreGeneral(cond1));
+    EXPECT_TRUE(cond1.isMoreGeneral(cond2));
+    EXPECT_FALSE(cond2.isMoreGeneral(cond1));
+    EXPECT_FALSE(cond1.isMoreGeneral(cond3));
+    EXPECT_FALSE(cond3.isMoreGeneral(cond1));
+    EXPECT_TRUE(allDontCare.isMoreGeneral(cond1));
+    EXPECT_FALSE(cond1.isMoreGeneral(allDontCare));
+}
+
+TEST(XCS_PackedConditionTest, WordLevelOperations)
+{
+    xcs::PackedCondition cond1("0 1 # # 1");
+    xcs::PackedCondition cond2("1 # 0 1 #");
+
+    // Swap the 2nd-4th symbols
+    cond1.swapMasked(cond2, 0, 0b01110);
+    EXPECT_EQ(cond1.toString(), "0 # 0 1 1");
+    EXPECT_EQ(cond2.toString(), "1 1 # # #");
+
+    cond1.setToDontCareMasked(0, 0b00011);
+    EXPECT_EQ(cond1.toString(), "# # 0 1 1");
+
+    // "#" becomes the situation value, and "0"/"1" becomes "#"
+    cond1.toggleMasked(0, 0b10011, 0b11110);
+    EXPECT_EQ(cond1.toString(), "0 1 0 1 #");
+    EXPECT_EQ(cond1, xcs::PackedCondition("0 1 0 1 #"));
+}
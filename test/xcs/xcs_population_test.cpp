@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <numeric> // std::accumulate
+
+#include "common/random_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    template <class Condition>
+    xcs::BasicClassifier<Condition> RandomClassifier(std::size_t length, const xcs::XCSParams & params, Random & random)
+    {
+        // Only a few distinct conditions so that duplicates are frequent
+        return xcs::BasicClassifier<Condition>(Condition(RandomTernarySymbols(length, 0.5, random)), random.nextInt(0, 1), params.initialPrediction, params.initialEpsilon, params.initialFitness, 0);
+    }
+
+    template <class Condition>
+    std::size_t CountSameConditionAction(const xcs::BasicPopulation<Condition> & population, const xcs::BasicClassifier<Condition> & cl)
+    {
+        std::size_t count = 0;
+        for (const auto & c : population)
+        {
+            if (c.condition == cl.condition && c.action == cl.action)
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    template <class Condition>
+    void TestIndexConsistency()
+    {
+        xcs::XCSParams params;
+        params.n = 40;
+        const std::unordered_set<int> availableActions = { 0, 1 };
+        Random random(24680);
+        const std::size_t length = 4;
+
+        std::vector<xcs::BasicClassifier<Condition>> initialClassifiers;
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            initialClassifiers.push_back(RandomClassifier<Condition>(length, params, random));
+        }
+        xcs::BasicPopulation<Condition> population(initialClassifiers, &params, availableActions);
+        EXPECT_NO_THROW(population.validateIndex());
+
+        for (int trial = 0; trial < 2000; ++trial)
+        {
+            const double r = random.nextDouble();
+            if (r < 0.5)
+            {
+                // Duplicates are merged into the existing classifier
+                const auto cl = RandomClassifier<Condition>(length, params, random);
+                const std::size_t countBefore = CountSameConditionAction(population, cl);
+                const std::size_t sizeBefore = population.size();
+                population.insertOrIncrementNumerosity(cl);
+                EXPECT_EQ(CountSameConditionAction(population, cl), std::max(countBefore, std::size_t{ 1 }));
+                EXPECT_EQ(population.size(), sizeBefore + (countBefore == 0 ? 1 : 0));
+            }
+            else if (r < 0.8)
+            {
+                population.deleteExtraClassifiers(random);
+            }
+            else if (r < 0.99)
+            {
+                if (!population.empty())
+                {
+                    EXPECT_EQ(population.erase(population.ptrAt(random.nextInt<std::size_t>(0, population.size() - 1))), 1);
+                }
+            }
+            else
+            {
+                std::vector<xcs::BasicClassifier<Condition>> classifiers(population.begin(), population.end());
+                population.setClassifiers(classifiers);
+            }
+            ASSERT_NO_THROW(population.validateIndex());
+            ASSERT_NO_THROW(population.validateAggregates());
+        }
+    }
+
+    template <class Condition>
+    void TestDeletionDistribution()
+    {
+        xcs::XCSParams params;
+        params.n = 9;
+        const std::unordered_set<int> availableActions = { 0, 1 };
+        Random random(13579);
+
+        // The last two classifiers are experienced and their fitness is below delta * averageFitness
+        const std::vector<std::string> conditions = { "0 0 #", "0 1 #", "1 0 #", "1 1 #", "# # #" };
+        const std::vector<double> fitnesses = { 0.8, 0.6, 0.5, 0.01, 0.002 };
+        const std::vector<double> actionSetSizes = { 10.0, 20.0, 5.0, 10.0, 30.0 };
+        const std::vector<std::uint64_t> experiences = { 100, 0, 100, 100, 100 };
+
+        std::vector<xcs::BasicClassifier<Condition>> classifiers;
+        for (std::size_t i = 0; i < conditions.size(); ++i)
+        {
+            xcs::BasicClassifier<Condition> cl(conditions[i], 0, params.initialPrediction, params.initialEpsilon, fitnesses[i], 0);
+            cl.actionSetSize = actionSetSizes[i];
+            cl.experience = experiences[i];
+            cl.numerosity = 2;
+            classifiers.push_back(cl);
+        }
+
+        // Deletion votes in the original definition
+        double fitnessSum = 0.0;
+        std::uint64_t numerositySum = 0;
+        for (const auto & cl : classifiers)
+        {
+            fitnessSum += cl.fitness;
+            numerositySum += cl.numerosity;
+        }
+        const double averageFitness = fitnessSum / numerositySum;
+        std::vector<double> votes;
+        for (const auto & cl : classifiers)
+        {
+            double vote = cl.actionSetSize * cl.numerosity;
+            if (cl.experience >= params.thetaDel && cl.fitness / cl.numerosity < params.delta * averageFitness)
+            {
+                vote *= averageFitness / (cl.fitness / cl.numerosity);
+            }
+            votes.push_back(vote);
+        }
+        const double voteSum = std::accumulate(votes.begin(), votes.end(), 0.0);
+
+        const int trialCount = 20000;
+        std::vector<int> deletionCounts(classifiers.size(), 0);
+        xcs::BasicPopulation<Condition> population(&params, availableActions);
+        for (int trial = 0; trial < trialCount; ++trial)
+        {
+            population.setClassifiers(classifiers);
+            population.deleteExtraClassifiers(random);
+            ASSERT_EQ(population.numerositySum(), numerositySum - 1);
+            for (const auto & cl : population)
+            {
+                for (std::size_t i = 0; i < classifiers.size(); ++i)
+                {
+                    if (cl.numerosity == 1 && cl.condition == classifiers[i].condition)
+                    {
+                        ++deletionCounts[i];
+                    }
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < classifiers.size(); ++i)
+        {
+            EXPECT_NEAR(static_cast<double>(deletionCounts[i]) / trialCount, votes[i] / voteSum, 0.015);
+        }
+    }
+}
+
+TEST(XCS_PopulationTest, InsertOrIncrementNumerosity)
+{
+    const xcs::XCSParams params;
+    const std::unordered_set<int> availableActions = { 0, 1 };
+    xcs::Population population(&params, availableActions);
+
+    population.insertOrIncrementNumerosity(xcs::Classifier("0 # 1", 0, params.initialPrediction, params.initialEpsilon, params.initialFitness, 0));
+    population.insertOrIncrementNumerosity(xcs::Classifier("0 # 1", 0, params.initialPrediction, params.initialEpsilon, params.initialFitness, 0));
+    population.insertOrIncrementNumerosity(xcs::Classifier("0 # 1", 1, params.initialPrediction, params.initialEpsilon, params.initialFitness, 0));
+    population.insertOrIncrementNumerosity(xcs::Classifier("0 1 1", 0, params.initialPrediction, params.initialEpsilon, params.initialFitness, 0));
+
+    ASSERT_EQ(population.size(), 3);
+    for (const auto & cl : population)
+    {
+        EXPECT_EQ(cl.numerosity, (cl.condition == xcs::Condition("0 # 1") && cl.action == 0) ? 2 : 1);
+    }
+}
+
+TEST(XCS_PopulationTest, ModifyUpdatesAggregates)
+{
+    xcs::XCSParams params;
+    params.thetaDel = 10;
+    const std::unordered_set<int> availableActions = { 0, 1 };
+    xcs::Population population(&params, availableActions);
+    population.insert(xcs::StoredClassifier("0 # 1", 0, 0, &params));
+    population.insert(xcs::StoredClassifier("1 # 1", 0, 0, &params));
+    const auto cl = population.ptrAt(0);
+
+    {
+        const auto modifier = population.modify(*cl);
+        modifier->numerosity = 3;
+        modifier->fitness = 0.5;
+        modifier->experience = params.thetaDel;
+    }
+    EXPECT_EQ(population.numerositySum(), 4);
+    EXPECT_DOUBLE_EQ(population.fitnessSum(), 0.5 + params.initialFitness);
+    EXPECT_NO_THROW(population.validateAggregates());
+
+    // The experienced classifier keeps its order if only the experience and actionSetSize change
+    {
+        const auto modifier = population.modify(*cl);
+        ++modifier->experience;
+        modifier->actionSetSize = 5.0;
+    }
+    EXPECT_NO_THROW(population.validateAggregates());
+
+    // Changes made without modify() are detected
+    cl->fitness = 1.0;
+    EXPECT_THROW(population.validateAggregates(), std::logic_error);
+
+    const xcs::StoredClassifier outsider("0 0 0", 0, 0, &params);
+    EXPECT_THROW(population.modify(outsider), std::invalid_argument);
+}
+
+TEST(XCS_PopulationTest, IndexConsistentAfterModification)
+{
+    TestIndexConsistency<xcs::Condition>();
+}
+
+TEST(XCS_PopulationTest, PackedIndexConsistentAfterModification)
+{
+    TestIndexConsistency<xcs::PackedCondition>();
+}
+
+TEST(XCS_PopulationTest, DeletionDistribution)
+{
+    TestDeletionDistribution<xcs::Condition>();
+}
+
+TEST(XCS_PopulationTest, PackedDeletionDistribution)
+{
+    TestDeletionDistribution<xcs::PackedCondition>();
+}
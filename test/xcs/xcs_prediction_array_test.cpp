@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <map>
+
+using namespace xcspp;
+
+namespace
+{
+    xcs::Classifier MakeClassifier(const std::string & condition, int action, double prediction, double fitness)
+    {
+        return xcs::Classifier(condition, action, prediction, 0.0, fitness, 0);
+    }
+
+    // Fitness-weighted prediction of each action in the original definition
+    std::map<int, double> ReferencePredictions(const std::vector<xcs::Classifier> & classifiers, const std::vector<int> & situation)
+    {
+        std::map<int, double> pa;
+        std::map<int, double> fsa;
+        for (const auto & cl : classifiers)
+        {
+            if (cl.condition.matches(situation))
+            {
+                pa[cl.action] += cl.prediction * cl.fitness;
+                fsa[cl.action] += cl.fitness;
+            }
+        }
+        for (auto & [ action, prediction ] : pa)
+        {
+            prediction /= fsa[action];
+        }
+        return pa;
+    }
+}
+
+TEST(XCS_PredictionArrayTest, FusedAccumulation)
+{
+    xcs::XCSParams params;
+    params.thetaMna = 1;
+    const std::unordered_set<int> actionSet = { 0, 1, 2, 3 };
+    const AvailableActions availableActions(actionSet);
+    const std::vector<xcs::Classifier> classifiers = {
+        MakeClassifier("0 # #", 2, 100.0, 0.5),
+        MakeClassifier("# 1 #", 0, 300.0, 0.2),
+        MakeClassifier("0 1 #", 2, 400.0, 0.25),
+        MakeClassifier("# # 1", 3, 900.0, 0.1),
+        MakeClassifier("1 # #", 1, 1000.0, 0.9),
+        MakeClassifier("# 1 1", 0, 500.0, 0.6),
+    };
+    xcs::Population population(classifiers, &params, actionSet);
+
+    Random random(1);
+    xcs::PredictionArray fusedPA(availableActions, &params);
+    xcs::MatchSet matchSet(&params, availableActions);
+    for (const auto & situation : std::vector<std::vector<int>>{ { 0, 1, 1 }, { 1, 1, 0 }, { 0, 0, 1 }, { 0, 1, 0 } })
+    {
+        // Reuses the storage of the previous situation
+        matchSet.generateSet(population, situation, 0, random, fusedPA);
+        const xcs::PredictionArray pa(matchSet, &params);
+
+        const auto reference = ReferencePredictions(classifiers, situation);
+        double maxPrediction = -1.0;
+        for (const auto & action : availableActions)
+        {
+            const double expected = reference.count(action) ? reference.at(action) : 0.0;
+            EXPECT_DOUBLE_EQ(fusedPA.predictionFor(action), expected);
+            EXPECT_DOUBLE_EQ(pa.predictionFor(action), expected);
+            maxPrediction = std::max(maxPrediction, expected);
+        }
+        EXPECT_DOUBLE_EQ(fusedPA.max(), maxPrediction);
+
+        // The best action is unique in these situations
+        EXPECT_DOUBLE_EQ(fusedPA.predictionFor(fusedPA.selectAction(0.0, random)), maxPrediction);
+    }
+}
+
+TEST(XCS_PredictionArrayTest, RandomSelectionFollowsMatchSetOrder)
+{
+    xcs::XCSParams params;
+    const std::unordered_set<int> actionSet = { 0, 1, 2 };
+    const AvailableActions availableActions(actionSet);
+    const std::vector<xcs::Classifier> classifiers = {
+        MakeClassifier("# #", 2, 10.0, 0.5),
+        MakeClassifier("# #", 0, 20.0, 0.5),
+        MakeClassifier("# #", 1, 30.0, 0.5),
+    };
+    xcs::Population population(classifiers, &params, actionSet);
+    xcs::MatchSet matchSet(&params, availableActions);
+    Random random(2);
+    matchSet.generateSet(population, { 0, 1 }, 0, random);
+    const xcs::PredictionArray pa(matchSet, &params);
+
+    // The actions are chosen from the order of first appearance in [M] as before
+    std::vector<int> matchSetActions;
+    for (const auto & cl : matchSet)
+    {
+        matchSetActions.push_back(cl->action);
+    }
+    Random random1(3);
+    Random random2(3);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(pa.selectAction(1.0, random1), (random2.nextDouble(), random2.chooseFrom(matchSetActions)));
+    }
+}
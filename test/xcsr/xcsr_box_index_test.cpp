@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+
+#include "common/random_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    // Situations on the boundaries of the conditions, which test the half-open intervals
+    std::vector<double> BoundarySituation(const xcsr::Condition & condition, xcsr::XCSRRepr repr, Random & random)
+    {
+        std::vector<double> situation;
+        for (const auto & symbol : condition)
+        {
+            situation.push_back(random.nextDouble() < 0.5 ? xcsr::GetLowerBound(symbol, repr) : xcsr::GetUpperBound(symbol, repr));
+        }
+        return situation;
+    }
+}
+
+TEST(XCSR_BoxIndexTest, ConsistentWithMatches)
+{
+    Random random(12345);
+    for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+    {
+        for (const std::size_t length : { 1, 2, 6, 20 })
+        {
+            for (const std::size_t classifierCount : { 0, 1, 8, 9, 100, 2000 })
+            {
+                std::vector<xcsr::Classifier> classifiers;
+                for (std::size_t i = 0; i < classifierCount; ++i)
+                {
+                    classifiers.emplace_back(RandomRealCondition(length, repr, 0.5, random), 0, 0.0, 0.0, 0.0, 0);
+                }
+
+                for (const std::size_t leafSize : { std::size_t{ 1 }, xcsr::BoxIndex::kDefaultLeafSize })
+                {
+                    const xcsr::BoxIndex index(classifiers, repr, leafSize);
+                    EXPECT_EQ(index.size(), classifierCount);
+
+                    for (int trial = 0; trial < 20; ++trial)
+                    {
+                        const auto situation = (classifierCount > 0 && trial % 2 == 1)
+                            ? BoundarySituation(classifiers[random.nextInt<std::size_t>(0, classifierCount - 1)].condition, repr, random)
+                            : RandomSituation<double>(length, random);
+
+                        std::vector<std::size_t> expected;
+                        for (std::size_t i = 0; i < classifierCount; ++i)
+                        {
+                            if (classifiers[i].condition.matches(situation, repr))
+                            {
+                                expected.push_back(i);
+                            }
+                        }
+                        EXPECT_EQ(index.findMatching(situation), expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(XCSR_BoxIndexTest, RebuildReplacesBoxes)
+{
+    const auto repr = xcsr::XCSRRepr::kOBR;
+    xcsr::BoxIndex index;
+    index.add(xcsr::Condition({ xcsr::Symbol(0.0, 0.5) }), repr, 10);
+    index.add(xcsr::Condition({ xcsr::Symbol(0.25, 1.0) }), repr, 20);
+
+    // The added boxes are not queried until build()
+    EXPECT_TRUE(index.findMatching({ 0.3 }).empty());
+
+    index.build();
+    EXPECT_EQ(index.findMatching({ 0.3 }), (std::vector<std::size_t>{ 10, 20 }));
+    EXPECT_EQ(index.findMatching({ 0.5 }), (std::vector<std::size_t>{ 20 }));
+    EXPECT_TRUE(index.findMatching({ 1.0 }).empty());
+
+    index.add(xcsr::Condition({ xcsr::Symbol(0.5, 1.5) }), repr, 30);
+    index.build();
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(index.findMatching({ 1.0 }), (std::vector<std::size_t>{ 30 }));
+    EXPECT_TRUE(index.findMatching({ 0.3 }).empty());
+
+    EXPECT_THROW(index.findMatching({ 1.0, 1.0 }), std::invalid_argument);
+
+    // All the conditions must have the same length
+    index.add(xcsr::Condition({ xcsr::Symbol(0.0, 1.0), xcsr::Symbol(0.0, 1.0) }), repr, 40);
+    EXPECT_THROW(index.add(xcsr::Condition({ xcsr::Symbol(0.0, 1.0) }), repr, 50), std::invalid_argument);
+}
+
+TEST(XCSR_BoxIndexTest, PopulationWithSpatialIndexConsistentWithScan)
+{
+    const std::unordered_set<int> availableActions = { 0, 1 };
+    const std::size_t length = 6;
+    Random random(54321);
+    for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+    {
+        xcsr::XCSRParams scanParams;
+        scanParams.repr = repr;
+        xcsr::XCSRParams indexParams = scanParams;
+        indexParams.useSpatialIndex = true;
+
+        std::vector<xcsr::Classifier> classifiers;
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            classifiers.emplace_back(RandomRealCondition(length, repr, 0.5, random), random.nextInt(0, 1), 0.0, 0.0, 0.0, 0);
+        }
+        xcsr::Population scanPopulation(classifiers, &scanParams, availableActions);
+        xcsr::Population indexPopulation(classifiers, &indexParams, availableActions);
+
+        // Insert and erase classifiers in the same way, so that both the unindexed classifiers
+        // and the lazy rebuilds are tested
+        for (int step = 0; step < 600; ++step)
+        {
+            if (random.nextDouble() < 0.5)
+            {
+                const xcsr::Classifier cl(RandomRealCondition(length, repr, 0.5, random), random.nextInt(0, 1), 0.0, 0.0, 0.0, 0);
+                scanPopulation.insert(xcsr::StoredClassifier(cl, &scanParams));
+                indexPopulation.insert(xcsr::StoredClassifier(cl, &indexParams));
+            }
+            else
+            {
+                const auto idx = random.nextInt<std::size_t>(0, scanPopulation.size() - 1);
+                scanPopulation.erase(scanPopulation.ptrAt(idx));
+                indexPopulation.erase(indexPopulation.ptrAt(idx));
+            }
+            ASSERT_EQ(scanPopulation.size(), indexPopulation.size());
+
+            const auto situation = RandomSituation<double>(length, random);
+            std::vector<const xcsr::StoredClassifier *> expected;
+            scanPopulation.forEachMatchingClassifier(situation, [&expected](const auto & cl) {
+                expected.push_back(cl.get());
+            });
+
+            // Same classifiers in the same order
+            std::vector<const xcsr::StoredClassifier *> matched;
+            indexPopulation.forEachMatchingClassifier(situation, [&matched](const auto & cl) {
+                matched.push_back(cl.get());
+            });
+            ASSERT_EQ(matched.size(), expected.size());
+            for (std::size_t i = 0; i < matched.size(); ++i)
+            {
+                EXPECT_EQ(matched[i]->condition, expected[i]->condition);
+                EXPECT_EQ(matched[i]->action, expected[i]->action);
+            }
+
+            // Const version (without rebuilding)
+            const xcsr::Population & constPopulation = indexPopulation;
+            std::size_t constMatchedCount = 0;
+            constPopulation.forEachMatchingClassifier(situation, [&](const auto & cl) {
+                ASSERT_LT(constMatchedCount, matched.size());
+                EXPECT_EQ(&cl, matched[constMatchedCount]);
+                ++constMatchedCount;
+            });
+            EXPECT_EQ(constMatchedCount, matched.size());
+        }
+    }
+}
@@ -209,3 +209,28 @@ TEST(XCSR_ConditionTest, IsMoreGeneral_UBR)
     EXPECT_FALSE(cond2.isMoreGeneral(allDontCare, XCSRRepr::kUBR));
     EXPECT_FALSE(cond3.isMoreGeneral(allDontCare, XCSRRepr::kUBR));
 }
+
+TEST(XCSR_ConditionTest, CompileTimeRepr)
+{
+    const xcsr::Condition cond1("0.0;0.5 0.5;1.0 0.0;1.0 0.0;1.0");
+    const xcsr::Condition cond2("0.0;0.5 0.5;1.0 0.0;1.0 0.5;1.0");
+    const xcsr::Condition allDontCare("1.0;0.0 0.0;1.0 1.0;0.0 0.0;1.0");
+
+    // The template versions must agree with the runtime versions
+    EXPECT_EQ(cond1.isMoreGeneral<XCSRRepr::kUBR>(cond2), cond1.isMoreGeneral(cond2, XCSRRepr::kUBR));
+    EXPECT_EQ(allDontCare.isMoreGeneral<XCSRRepr::kUBR>(cond1), allDontCare.isMoreGeneral(cond1, XCSRRepr::kUBR));
+    EXPECT_EQ(cond1.isMoreGeneral<XCSRRepr::kOBR>(cond2), cond1.isMoreGeneral(cond2, XCSRRepr::kOBR));
+    EXPECT_EQ(cond2.isMoreGeneral<XCSRRepr::kCSR>(cond1), cond2.isMoreGeneral(cond1, XCSRRepr::kCSR));
+
+    const std::vector<double> situation = { 0.2, 0.7, 0.4, 0.9 };
+    EXPECT_EQ(cond1.matches<XCSRRepr::kOBR>(situation), cond1.matches(situation, XCSRRepr::kOBR));
+    EXPECT_EQ(cond2.matches<XCSRRepr::kUBR>(situation), cond2.matches(situation, XCSRRepr::kUBR));
+    EXPECT_EQ(cond1.matches<XCSRRepr::kCSR>(situation), cond1.matches(situation, XCSRRepr::kCSR));
+
+    // BasicXCSR<Repr> rejects params with a different representation
+    XCSRParams params;
+    params.repr = XCSRRepr::kOBR;
+    EXPECT_THROW(xcsr::BasicXCSR<XCSRRepr::kCSR>({ 0, 1 }, params), std::invalid_argument);
+    EXPECT_NO_THROW(xcsr::BasicXCSR<XCSRRepr::kOBR>({ 0, 1 }, params));
+    EXPECT_NO_THROW(XCSR({ 0, 1 }, params));
+}
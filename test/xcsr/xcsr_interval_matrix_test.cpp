@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+
+#include "common/random_fixture.hpp"
+
+using namespace xcspp;
+using namespace xcspp::test;
+
+namespace
+{
+    std::vector<xcsr::IntervalMatrix::Kernel> SupportedKernels()
+    {
+        std::vector<xcsr::IntervalMatrix::Kernel> kernels;
+        for (const auto kernel : { SIMDKernel::kScalar, SIMDKernel::kSSE2, SIMDKernel::kAVX2 })
+        {
+            if (IsSIMDKernelSupported(kernel))
+            {
+                kernels.push_back(kernel);
+            }
+        }
+        return kernels;
+    }
+
+    bool BitmapTest(const std::vector<std::uint64_t> & bitmap, std::size_t idx)
+    {
+        return (bitmap[idx / 64] >> (idx % 64)) & 1;
+    }
+}
+
+TEST(XCSR_IntervalMatrixTest, KernelsConsistentWithScalar)
+{
+    Random random(12345);
+    for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+    {
+        for (const std::size_t length : { 1, 2, 5, 6, 20 })
+        {
+            for (const std::size_t rowCount : { 0, 1, 3, 4, 5, 64, 65, 300 })
+            {
+                std::vector<xcsr::Condition> conditions;
+                xcsr::IntervalMatrix matrix;
+                for (std::size_t i = 0; i < rowCount; ++i)
+                {
+                    conditions.push_back(RandomRealCondition(length, repr, 0.8, random));
+                    matrix.pushBack(conditions.back(), repr);
+                }
+
+                // Remove some rows in the same way as the matrix
+                for (std::size_t i = 0; i < rowCount / 3; ++i)
+                {
+                    const auto rowIdx = random.nextInt<std::size_t>(0, conditions.size() - 1);
+                    matrix.swapRemove(rowIdx);
+                    conditions[rowIdx] = conditions.back();
+                    conditions.pop_back();
+                }
+                ASSERT_EQ(matrix.size(), conditions.size());
+
+                for (int trial = 0; trial < 10; ++trial)
+                {
+                    const auto situation = RandomSituation<double>(length, random);
+
+                    for (const auto kernel : SupportedKernels())
+                    {
+                        matrix.setKernel(kernel);
+                        std::vector<std::uint64_t> bitmap;
+                        matrix.match(situation, bitmap);
+                        ASSERT_EQ(bitmap.size(), (conditions.size() + 63) / 64);
+
+                        for (std::size_t i = 0; i < conditions.size(); ++i)
+                        {
+                            EXPECT_EQ(BitmapTest(bitmap, i), conditions[i].matches(situation, repr));
+                        }
+
+                        // Padding bits are never set
+                        for (std::size_t i = conditions.size(); i < bitmap.size() * 64; ++i)
+                        {
+                            EXPECT_FALSE(BitmapTest(bitmap, i));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(XCSR_IntervalMatrixTest, HalfOpenInterval)
+{
+    // [0.2, 0.6) in OBR
+    const xcsr::Condition cond({ xcsr::Symbol(0.2, 0.6) });
+    xcsr::IntervalMatrix matrix;
+    matrix.pushBack(cond, xcsr::XCSRRepr::kOBR);
+
+    for (const auto kernel : SupportedKernels())
+    {
+        matrix.setKernel(kernel);
+        for (const double value : { 0.1, 0.2, 0.4, 0.6, 0.7 })
+        {
+            std::vector<std::uint64_t> bitmap;
+            matrix.match({ value }, bitmap);
+            EXPECT_EQ(BitmapTest(bitmap, 0), cond.matches({ value }, xcsr::XCSRRepr::kOBR));
+        }
+    }
+}
+
+TEST(XCSR_IntervalMatrixTest, PopulationScanConsistentWithMatches)
+{
+    xcsr::XCSRParams params;
+    params.repr = xcsr::XCSRRepr::kCSR;
+    const std::unordered_set<int> availableActions = { 0, 1 };
+    Random random(54321);
+    const std::size_t length = 6;
+
+    std::vector<xcsr::Classifier> classifiers;
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        classifiers.emplace_back(RandomRealCondition(length, params.repr, 0.8, random), random.nextInt(0, 1), params.initialPrediction, params.initialEpsilon, params.initialFitness, 0);
+    }
+    xcsr::Population population(classifiers, &params, availableActions);
+
+    // Erase some classifiers so that rows are moved
+    std::vector<xcsr::ClassifierPtr> erased;
+    for (std::size_t i = 0; i < population.size(); ++i)
+    {
+        if (random.nextDouble() < 0.3)
+        {
+            erased.push_back(population.ptrAt(i));
+        }
+    }
+    for (const auto & cl : erased)
+    {
+        EXPECT_EQ(population.erase(cl), 1);
+    }
+
+    for (const auto kernel : SupportedKernels())
+    {
+        population.setMatchKernel(kernel);
+        for (int trial = 0; trial < 20; ++trial)
+        {
+            const auto situation = RandomSituation<double>(length, random);
+            std::unordered_set<const xcsr::StoredClassifier *> matched;
+            population.forEachMatchingClassifier(situation, [&matched](const auto & cl) {
+                matched.insert(cl.get());
+            });
+
+            std::unordered_set<const xcsr::StoredClassifier *> expected;
+            for (const auto & cl : population)
+            {
+                if (cl.condition.matches(situation, params.repr))
+                {
+                    expected.insert(&cl);
+                }
+            }
+            EXPECT_EQ(matched, expected);
+        }
+    }
+}
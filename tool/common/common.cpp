@@ -13,6 +13,7 @@ namespace xcspp::tool
             ("p,prefix", "The filename prefix for log file output", cxxopts::value<std::string>()->default_value(""), "PREFIX")
             ("S,soutput", "The filename of summary log csv output", cxxopts::value<std::string>()->default_value("summary.csv"), "FILENAME")
             ("o,coutput", "The filename of classifier csv output", cxxopts::value<std::string>()->default_value("classifier.csv"), "FILENAME")
+            ("cbinoutput", "The filename of classifier binary snapshot output (exact values; not saved if empty)", cxxopts::value<std::string>()->default_value(""), "FILENAME")
             ("r,routput", "The filename of reward log csv output", cxxopts::value<std::string>()->default_value(""), "FILENAME")
             ("E,seoutput", "The filename of system error log csv output", cxxopts::value<std::string>()->default_value(""), "FILENAME")
             ("n,noutput", "The filename of macro-classifier count log csv output", cxxopts::value<std::string>()->default_value(""), "FILENAME")
@@ -21,7 +22,12 @@ namespace xcspp::tool
             ("cinput-init", "Whether to initialize p/epsilon/F/exp/ts/as to defaults", cxxopts::value<bool>()->default_value("false"), "true/false")
             ("i,iter", "The number of iterations", cxxopts::value<uint64_t>()->default_value("100000"), "COUNT")
             ("condense-iter", "The number of iterations for the Wilson's rule condensation method (chi=0, mu=0) after normal iterations", cxxopts::value<uint64_t>()->default_value("0"), "COUNT")
-            //("avg-seeds", "The number of different random seeds for averaging the reward and the macro-classifier count", cxxopts::value<uint64_t>()->default_value("1"), "COUNT")
+            ("checkpoint", "The filename of the checkpoint to save and resume the whole training state", cxxopts::value<std::string>()->default_value("checkpoint.bin"), "FILENAME")
+            ("checkpoint-interval", "The iteration interval of checkpoint output (not saved if \"0\")", cxxopts::value<uint64_t>()->default_value("0"), "COUNT")
+            ("resume", "Whether to resume the experiment from the checkpoint (the log files are truncated to the checkpoint and appended)", cxxopts::value<bool>()->default_value("false"), "true/false")
+            ("avg-seeds", "The number of different random seeds for averaging the logs (the log of each seed is output with the suffix \"_seed<N>\")", cxxopts::value<uint64_t>()->default_value("1"), "COUNT")
+            ("seed", "The master seed of the random engines to reproduce the experiment (seeded randomly if not specified)", cxxopts::value<uint64_t>(), "SEED")
+            ("threads", "The number of threads that run the seeds in parallel (\"0\": the number of hardware threads)", cxxopts::value<uint64_t>()->default_value("0"), "COUNT")
             ("explore", "The number of exploration performed in each train iteration", cxxopts::value<uint64_t>()->default_value("1"), "COUNT")
             ("exploit", "The number of exploitation (= test mode) performed in each test iteration (set \"0\" if you don't need evaluation)", cxxopts::value<uint64_t>()->default_value("1"), "COUNT")
             ("exploit-upd", "Whether to update classifier parameters in test mode (\"auto\": false for single-step & true for multi-step)", cxxopts::value<std::string>()->default_value("auto"), "auto/true/false")
@@ -64,6 +70,11 @@ namespace xcspp::tool
         settings.inputClassifierFilename = parsedOptions["cinput"].as<std::string>();
         settings.initializeInputClassifier = parsedOptions["cinput-init"].as<bool>();
         settings.smaWidth = parsedOptions["sma"].as<uint64_t>();
+        settings.appendLogFiles = parsedOptions["resume"].as<bool>();
+        if (parsedOptions.count("seed"))
+        {
+            settings.seed = parsedOptions["seed"].as<uint64_t>();
+        }
 
         return settings;
     }
@@ -82,13 +93,11 @@ namespace xcspp::tool
         }
     }
 
-    void RunExperiment(IExperimentHelper & experimentHelper, std::uint64_t iterationCount, std::uint64_t condensationIterationCount)
+    void OutputPopulationBinary(const IExperimentHelper & experimentHelper, const std::string & filename)
     {
-        experimentHelper.runIteration(iterationCount);
-        if (condensationIterationCount > 0)
+        if (!experimentHelper.savePopulationBinaryFile(filename))
         {
-            experimentHelper.switchToCondensationMode();
-            experimentHelper.runIteration(condensationIterationCount);
+            std::cerr << "Error: Could not save the population to '" << filename << "'." << std::endl;
         }
     }
 
@@ -1,4 +1,8 @@
 #pragma once
+#include <iostream>
+#include <string>
+#include <algorithm> // std::min
+#include <cstdlib> // std::exit
 #include <cstdint> // std::uint64_t
 #include <cxxopts.hpp>
 #include <xcspp/xcspp.hpp>
@@ -12,6 +16,53 @@ namespace xcspp::tool
 
     void OutputPopulation(const IExperimentHelper & experimentHelper, const std::string & filename);
 
-    void RunExperiment(IExperimentHelper & experimentHelper, std::uint64_t iterationCount, std::uint64_t condensationIterationCount);
+    void OutputPopulationBinary(const IExperimentHelper & experimentHelper, const std::string & filename);
+
+    // Run the normal iterations followed by the condensation iterations
+    // (Resumes from the checkpoint with --resume, and saves it every --checkpoint-interval iterations.
+    //  ExperimentRunner is either an IExperimentHelper or a BasicMultiSeedExperimentRunner.)
+    template <class ExperimentRunner>
+    void RunExperiment(ExperimentRunner & experimentHelper, const cxxopts::ParseResult & parsedOptions)
+    {
+        const std::uint64_t iterationCount = parsedOptions["iter"].as<std::uint64_t>();
+        const std::uint64_t condensationIterationCount = parsedOptions["condense-iter"].as<std::uint64_t>();
+        const std::uint64_t checkpointInterval = parsedOptions["checkpoint-interval"].as<std::uint64_t>();
+        const std::string checkpointFilename = parsedOptions["prefix"].as<std::string>() + parsedOptions["checkpoint"].as<std::string>();
+
+        if (parsedOptions["resume"].as<bool>())
+        {
+            if (!experimentHelper.loadCheckpointFile(checkpointFilename))
+            {
+                std::cerr << "Error: Could not load the checkpoint from '" << checkpointFilename << "'." << std::endl;
+                std::exit(1);
+            }
+        }
+
+        // Run until the total iteration count reaches the end (the condensation iterations follow the normal ones)
+        const std::uint64_t totalIterationCount = iterationCount + condensationIterationCount;
+        while (experimentHelper.iterationCount() < totalIterationCount)
+        {
+            const std::uint64_t currentIterationCount = experimentHelper.iterationCount();
+            if (currentIterationCount >= iterationCount)
+            {
+                experimentHelper.switchToCondensationMode();
+            }
+
+            std::uint64_t endIterationCount = (currentIterationCount < iterationCount) ? iterationCount : totalIterationCount;
+            if (checkpointInterval > 0)
+            {
+                endIterationCount = std::min(endIterationCount, (currentIterationCount / checkpointInterval + 1) * checkpointInterval);
+            }
+            experimentHelper.runIteration(endIterationCount - currentIterationCount);
+
+            if (checkpointInterval > 0 && experimentHelper.iterationCount() % checkpointInterval == 0)
+            {
+                if (!experimentHelper.saveCheckpointFile(checkpointFilename))
+                {
+                    std::cerr << "Error: Could not save the checkpoint to '" << checkpointFilename << "'." << std::endl;
+                }
+            }
+        }
+    }
 
 }
@@ -31,89 +31,113 @@ int main(int argc, char *argv[])
     const XCSParams params = tool::xcs::ParseXCSParams(parsedOptions);
     tool::xcs::OutputXCSParams(params);
 
-    // Initialize experiment helper
+    // Initialize experiment helper of each seed
     const ExperimentSettings settings = tool::ParseExperimentSettings(parsedOptions);
-    ExperimentHelper experimentHelper(settings);
+    const std::size_t seedCount = parsedOptions["avg-seeds"].as<uint64_t>();
+    const std::size_t threadCount = parsedOptions["threads"].as<uint64_t>();
 
-    if (parsedOptions.count("mux"))
+    // Prepare trace output of the block world problem
+    std::ofstream traceLogStream;
+    const bool outputTraceLog = parsedOptions.count("blc") && !parsedOptions["blc-output-trace"].as<std::string>().empty();
+    if (outputTraceLog)
     {
-        // Multiplexer problem
-        const auto & env = experimentHelper.constructTrainEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>(), parsedOptions["mux-i"].as<unsigned int>());
-        experimentHelper.constructTestEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>());
-
-        experimentHelper.constructSystem<XCS>(env.availableActions(), params);
-
-        tool::RunExperiment(experimentHelper, parsedOptions["iter"].as<std::uint64_t>(), parsedOptions["condense-iter"].as<std::uint64_t>());
+        traceLogStream.open(parsedOptions["blc-output-trace"].as<std::string>());
     }
-    else if (parsedOptions.count("parity"))
-    {
-        // Even-parity problem
-        const auto & env = experimentHelper.constructTrainEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>());
-        experimentHelper.constructTestEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>());
+    const BlockWorldEnvironment * pBlockWorldTestEnv = nullptr;
+    XCS * pBlockWorldXCS = nullptr;
 
-        experimentHelper.constructSystem<XCS>(env.availableActions(), params);
+    MultiSeedExperimentRunner runner(settings, seedCount, [&](ExperimentHelper & experimentHelper, std::size_t seedIdx) {
+        if (parsedOptions.count("mux"))
+        {
+            // Multiplexer problem
+            const auto & env = experimentHelper.constructTrainEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>(), parsedOptions["mux-i"].as<unsigned int>());
+            experimentHelper.constructTestEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>());
 
-        tool::RunExperiment(experimentHelper, parsedOptions["iter"].as<std::uint64_t>(), parsedOptions["condense-iter"].as<std::uint64_t>());
-    }
-    else if (parsedOptions.count("majority"))
-    {
-        // Majority-on problem
-        const auto & env = experimentHelper.constructTrainEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>());
-        experimentHelper.constructTestEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>());
+            experimentHelper.constructSystem<PackedXCS>(env.availableActions(), params);
+        }
+        else if (parsedOptions.count("parity"))
+        {
+            // Even-parity problem
+            const auto & env = experimentHelper.constructTrainEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>());
+            experimentHelper.constructTestEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>());
 
-        experimentHelper.constructSystem<XCS>(env.availableActions(), params);
+            experimentHelper.constructSystem<PackedXCS>(env.availableActions(), params);
+        }
+        else if (parsedOptions.count("majority"))
+        {
+            // Majority-on problem
+            const auto & env = experimentHelper.constructTrainEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>());
+            experimentHelper.constructTestEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>());
 
-        tool::RunExperiment(experimentHelper, parsedOptions["iter"].as<std::uint64_t>(), parsedOptions["condense-iter"].as<std::uint64_t>());
-    }
-    else if (parsedOptions.count("blc"))
-    {
-        // Block world problem
-        const auto & trainEnv = experimentHelper.constructTrainEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>());
-        const auto & testEnv = experimentHelper.constructTestEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>());
+            experimentHelper.constructSystem<PackedXCS>(env.availableActions(), params);
+        }
+        else if (parsedOptions.count("blc"))
+        {
+            // Block world problem
+            const auto & trainEnv = experimentHelper.constructTrainEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>());
+            const auto & testEnv = experimentHelper.constructTestEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>());
 
-        auto & xcs = experimentHelper.constructSystem<XCS>(trainEnv.availableActions(), params);
+            auto & xcs = experimentHelper.constructSystem<XCS>(trainEnv.availableActions(), params);
 
-        // Prepare trace output
-        std::ofstream traceLogStream;
-        const bool outputTraceLog = !parsedOptions["blc-output-trace"].as<std::string>().empty();
-        if (outputTraceLog)
-        {
-            traceLogStream.open(parsedOptions["blc-output-trace"].as<std::string>());
-        }
-        experimentHelper.setTrainCallback([outputTraceLog, &traceLogStream, &env = trainEnv]() {
-            if (outputTraceLog)
+            // Trace and best action map are output for the first seed
+            if (seedIdx == 0)
             {
-                if (env.lastStep() <= 1)
-                {
-                    traceLogStream << "(" << env.lastInitialX() << "," << env.lastInitialY() << ")";
-                }
-                traceLogStream << "(" << env.lastX() << "," << env.lastY() << ")";
-                if (env.isEndOfProblem())
-                {
-                    traceLogStream << " Explore" << std::endl;
-                }
-            }
-        });
-        experimentHelper.setTestCallback([outputTraceLog, &traceLogStream, &env = testEnv]() {
-            if (outputTraceLog)
-            {
-                if (env.lastStep() <= 1)
-                {
-                    traceLogStream << "(" << env.lastInitialX() << "," << env.lastInitialY() << ")";
-                }
-                traceLogStream << "(" << env.lastX() << "," << env.lastY() << ")";
-                if (env.isEndOfProblem())
-                {
-                    traceLogStream << " Exploit" << std::endl;
-                }
+                pBlockWorldTestEnv = &testEnv;
+                pBlockWorldXCS = &xcs;
+
+                experimentHelper.setTrainCallback([outputTraceLog, &traceLogStream, &env = trainEnv]() {
+                    if (outputTraceLog)
+                    {
+                        if (env.lastStep() <= 1)
+                        {
+                            traceLogStream << "(" << env.lastInitialX() << "," << env.lastInitialY() << ")";
+                        }
+                        traceLogStream << "(" << env.lastX() << "," << env.lastY() << ")";
+                        if (env.isEndOfProblem())
+                        {
+                            traceLogStream << " Explore" << std::endl;
+                        }
+                    }
+                });
+                experimentHelper.setTestCallback([outputTraceLog, &traceLogStream, &env = testEnv]() {
+                    if (outputTraceLog)
+                    {
+                        if (env.lastStep() <= 1)
+                        {
+                            traceLogStream << "(" << env.lastInitialX() << "," << env.lastInitialY() << ")";
+                        }
+                        traceLogStream << "(" << env.lastX() << "," << env.lastY() << ")";
+                        if (env.isEndOfProblem())
+                        {
+                            traceLogStream << " Exploit" << std::endl;
+                        }
+                    }
+                });
             }
-        });
+        }
+        else if (parsedOptions.count("csv"))
+        {
+            // CSV file
+            const std::string trainFilename = parsedOptions["csv"].as<std::string>();
+            const std::string testFilename = parsedOptions.count("csv-test") ? parsedOptions["csv-test"].as<std::string>() : trainFilename;
+
+            const auto & env = experimentHelper.constructTrainEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(trainFilename), parsedOptions["csv-random"].as<bool>());
+            experimentHelper.constructTestEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(testFilename), parsedOptions["csv-random"].as<bool>());
+
+            experimentHelper.constructSystem<XCS>(env.availableActions(), params);
+        }
+    }, threadCount);
 
-        tool::RunExperiment(experimentHelper, parsedOptions["iter"].as<std::uint64_t>(), parsedOptions["condense-iter"].as<std::uint64_t>());
+    tool::RunExperiment(runner, parsedOptions);
 
+    if (parsedOptions.count("blc"))
+    {
         // Output best action map
         if (!parsedOptions["blc-output-best"].as<std::string>().empty())
         {
+            const auto & testEnv = *pBlockWorldTestEnv;
+            auto & xcs = *pBlockWorldXCS;
+
             std::ofstream ofs(parsedOptions["blc-output-best"].as<std::string>());
 
             const bool useUnicode = parsedOptions["blc-output-best-uni"].as<bool>();
@@ -206,21 +230,16 @@ int main(int argc, char *argv[])
             }
         }
     }
-    else if (parsedOptions.count("csv"))
-    {
-        // CSV file
-        const std::string trainFilename = parsedOptions["csv"].as<std::string>();
-        const std::string testFilename = parsedOptions.count("csv-test") ? parsedOptions["csv-test"].as<std::string>() : trainFilename;
 
-        const auto & env = experimentHelper.constructTrainEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(trainFilename), parsedOptions["csv-random"].as<bool>());
-        experimentHelper.constructTestEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(testFilename), parsedOptions["csv-random"].as<bool>());
-
-        experimentHelper.constructSystem<XCS>(env.availableActions(), params);
-
-        tool::RunExperiment(experimentHelper, parsedOptions["iter"].as<std::uint64_t>(), parsedOptions["condense-iter"].as<std::uint64_t>());
+    for (std::size_t i = 0; i < runner.seedCount(); ++i)
+    {
+        tool::OutputPopulation(runner.helper(i), runner.seedFilename(settings.outputFilenamePrefix + parsedOptions["coutput"].as<std::string>(), i));
+        if (!parsedOptions["cbinoutput"].as<std::string>().empty())
+        {
+            tool::OutputPopulationBinary(runner.helper(i), runner.seedFilename(settings.outputFilenamePrefix + parsedOptions["cbinoutput"].as<std::string>(), i));
+        }
     }
-
-    tool::OutputPopulation(experimentHelper, settings.outputFilenamePrefix + parsedOptions["coutput"].as<std::string>());
+    runner.outputAveragedLogs();
 
     return 0;
 }
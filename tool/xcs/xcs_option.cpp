@@ -3,6 +3,7 @@
 #include <string>
 #include <sstream>
 #include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 #include "common/common.hpp"
 
 namespace xcspp::tool::xcs
@@ -56,7 +57,8 @@ namespace xcspp::tool::xcs
             ("do-ga-subsumption", "Whether offspring are to be tested for possible logical subsumption by parents", cxxopts::value<bool>()->default_value(defaultParams.doGASubsumption ? "true" : "false"), "true/false")
             ("do-as-subsumption", "Whether action sets are to be tested for subsuming classifiers", cxxopts::value<bool>()->default_value(defaultParams.doActionSetSubsumption ? "true" : "false"), "true/false")
             ("do-action-mutation", "Whether to apply mutation to the action", cxxopts::value<bool>()->default_value(defaultParams.doActionMutation ? "true" : "false"), "true/false")
-            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false");
+            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false")
+            ("match-set-cache", "The maximum number of situations whose matching classifiers are cached to skip the population scan for repeated situations (the result is the same; set \"0\" to disable the cache)", cxxopts::value<std::size_t>()->default_value(std::to_string(defaultParams.matchSetCacheCapacity)), "SIZE");
     }
 
     void AddOptions(cxxopts::Options & options)
@@ -94,6 +96,7 @@ namespace xcspp::tool::xcs
         params.doActionSetSubsumption = parsedOptions["do-as-subsumption"].as<bool>();
         params.doActionMutation = parsedOptions["do-action-mutation"].as<bool>();
         params.useMAM = parsedOptions["mam"].as<bool>();
+        params.matchSetCacheCapacity = parsedOptions["match-set-cache"].as<std::size_t>();
 
         // Determine crossover method
         if (parsedOptions["x-method"].as<std::string>() == "uniform")
@@ -166,6 +169,8 @@ namespace xcspp::tool::xcs
             ss << "doActionMutation = false\n";
         if (!params.useMAM)
             ss << "             MAM = false\n";
+        if (params.matchSetCacheCapacity > 0)
+            ss << "   matchSetCache = " << params.matchSetCacheCapacity << '\n';
         const std::string str = ss.str();
         if (!str.empty())
         {
@@ -31,35 +31,44 @@ int main(int argc, char *argv[])
     const XCSRParams params = tool::xcsr::ParseXCSRParams(parsedOptions);
     tool::xcsr::OutputXCSRParams(params);
 
-    // Initialize experiment helper
+    // Initialize experiment helper of each seed
     const ExperimentSettings settings = tool::ParseExperimentSettings(parsedOptions);
-    RealExperimentHelper experimentHelper(settings);
-
-    if (parsedOptions.count("rmux"))
+    const std::size_t seedCount = parsedOptions["avg-seeds"].as<uint64_t>();
+    const std::size_t threadCount = parsedOptions["threads"].as<uint64_t>();
+
+    RealMultiSeedExperimentRunner runner(settings, seedCount, [&](RealExperimentHelper & experimentHelper, std::size_t) {
+        if (parsedOptions.count("rmux"))
+        {
+            // Real multiplexer problem
+            const auto & env = experimentHelper.constructTrainEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>(), parsedOptions["rmux-i"].as<unsigned int>());
+            experimentHelper.constructTestEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>());
+
+            experimentHelper.constructSystem<XCSR>(env.availableActions(), params);
+        }
+        else if (parsedOptions.count("csv"))
+        {
+            // CSV file
+            const std::string trainFilename = parsedOptions["csv"].as<std::string>();
+            const std::string testFilename = parsedOptions.count("csv-test") ? parsedOptions["csv-test"].as<std::string>() : trainFilename;
+
+            const auto & env = experimentHelper.constructTrainEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(trainFilename), parsedOptions["csv-random"].as<bool>());
+            experimentHelper.constructTestEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(testFilename), parsedOptions["csv-random"].as<bool>());
+
+            experimentHelper.constructSystem<XCSR>(env.availableActions(), params);
+        }
+    }, threadCount);
+
+    tool::RunExperiment(runner, parsedOptions);
+
+    for (std::size_t i = 0; i < runner.seedCount(); ++i)
     {
-        // Real multiplexer problem
-        const auto & env = experimentHelper.constructTrainEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>(), parsedOptions["rmux-i"].as<unsigned int>());
-        experimentHelper.constructTestEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>());
-
-        experimentHelper.constructSystem<XCSR>(env.availableActions(), params);
-
-        tool::RunExperiment(experimentHelper, parsedOptions["iter"].as<std::uint64_t>(), parsedOptions["condense-iter"].as<std::uint64_t>());
+        tool::OutputPopulation(runner.helper(i), runner.seedFilename(settings.outputFilenamePrefix + parsedOptions["coutput"].as<std::string>(), i));
+        if (!parsedOptions["cbinoutput"].as<std::string>().empty())
+        {
+            tool::OutputPopulationBinary(runner.helper(i), runner.seedFilename(settings.outputFilenamePrefix + parsedOptions["cbinoutput"].as<std::string>(), i));
+        }
     }
-    else if (parsedOptions.count("csv"))
-    {
-        // CSV file
-        const std::string trainFilename = parsedOptions["csv"].as<std::string>();
-        const std::string testFilename = parsedOptions.count("csv-test") ? parsedOptions["csv-test"].as<std::string>() : trainFilename;
-
-        const auto & env = experimentHelper.constructTrainEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(trainFilename), parsedOptions["csv-random"].as<bool>());
-        experimentHelper.constructTestEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(testFilename), parsedOptions["csv-random"].as<bool>());
-
-        experimentHelper.constructSystem<XCSR>(env.availableActions(), params);
-
-        tool::RunExperiment(experimentHelper, parsedOptions["iter"].as<std::uint64_t>(), parsedOptions["condense-iter"].as<std::uint64_t>());
-    }
-
-    tool::OutputPopulation(experimentHelper, settings.outputFilenamePrefix + parsedOptions["coutput"].as<std::string>());
+    runner.outputAveragedLogs();
 
     return 0;
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include <sstream>
 #include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 #include "common/common.hpp"
 
 namespace xcspp::tool::xcsr
@@ -54,7 +55,9 @@ namespace xcspp::tool::xcsr
             ("do-action-mutation", "Whether to apply mutation to the action", cxxopts::value<bool>()->default_value(defaultParams.doActionMutation ? "true" : "false"), "true/false")
             ("do-range-restriction", "Whether to restrict the range of the condition to the interval [min-value, max-value) in the covering and mutation operator (ignored when --repr=csr)", cxxopts::value<bool>()->default_value(defaultParams.doRangeRestriction ? "true" : "false"), "true/false")
             ("do-covering-random-range-truncation", "Whether to truncate the covering random range before generating random intervals if the interval [x-s_0, x+s_0) is not contained in [min-value, max-value).  \"false\" is common for this option, but the covering operator can generate too many maximum-range intervals if s_0 is larger than (max-value - min-value) / 2.  Choose \"true\" to avoid the random bias in this situation.  (ignored when --repr=csr)", cxxopts::value<bool>()->default_value(defaultParams.doCoveringRandomRangeTruncation ? "true" : "false"), "true/false")
-            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false");
+            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false")
+            ("spatial-index", "Whether to find the matching classifiers with a spatial index over the condition boxes instead of scanning the whole population (the result is the same; this pays off only for large populations)", cxxopts::value<bool>()->default_value(defaultParams.useSpatialIndex ? "true" : "false"), "true/false")
+            ("match-set-cache", "The maximum number of situations whose matching classifiers are cached to skip the population scan for repeated situations (the result is the same; set \"0\" to disable the cache)", cxxopts::value<std::size_t>()->default_value(std::to_string(defaultParams.matchSetCacheCapacity)), "SIZE");
     }
 
     void AddOptions(cxxopts::Options & options)
@@ -97,6 +100,8 @@ namespace xcspp::tool::xcsr
         params.doRangeRestriction = parsedOptions["do-range-restriction"].as<bool>();
         params.doCoveringRandomRangeTruncation = parsedOptions["do-covering-random-range-truncation"].as<bool>();
         params.useMAM = parsedOptions["mam"].as<bool>();
+        params.useSpatialIndex = parsedOptions["spatial-index"].as<bool>();
+        params.matchSetCacheCapacity = parsedOptions["match-set-cache"].as<std::size_t>();
 
         const std::string reprStr = parsedOptions["repr"].as<std::string>();
         if (reprStr == "csr")
@@ -205,6 +210,10 @@ namespace xcspp::tool::xcsr
             ss << "doActionMutation = false\n";
         if (!params.useMAM)
             ss << "             MAM = false\n";
+        if (params.useSpatialIndex)
+            ss << "    spatialIndex = true\n";
+        if (params.matchSetCacheCapacity > 0)
+            ss << "   matchSetCache = " << params.matchSetCacheCapacity << '\n';
         const std::string str = ss.str();
         if (!str.empty())
         {